@@ -0,0 +1,246 @@
+///
+/// @file      ar/extraction_benchmarks.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Benchmarks for the @c extraction module.
+///
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "ar/ar.h"
+
+namespace {
+
+/// Number of bytes allocated through the global operator new.
+std::atomic<std::size_t> allocatedBytes{0};
+
+} // anonymous namespace
+
+// Count the allocated bytes to find out whether the content of the members is
+// copied. GCC cannot see that the replaced operators are used in pairs.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+	allocatedBytes += size;
+	if (auto ptr = std::malloc(size > 0 ? size : 1)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+namespace ar {
+namespace benchmarks {
+
+namespace {
+
+///
+/// Returns an archive with @a memberCount members of @a memberSize bytes.
+///
+std::string createArchive(std::size_t memberCount, std::size_t memberSize) {
+	std::string archive{"!<arch>\n"};
+	for (std::size_t j = 0; j < memberCount; ++j) {
+		char header[61];
+		std::snprintf(header, sizeof(header), "%-16s%-12d%-6d%-6d%-8d%-10zu`\n",
+			("m" + std::to_string(j) + "/").c_str(), 0, 0, 0, 644, memberSize);
+		archive += header;
+		archive.append(memberSize, 'x');
+		if (memberSize % 2 == 1) {
+			archive += '\n';
+		}
+	}
+	return archive;
+}
+
+///
+/// Extracts an archive and reads the content of every member twice.
+///
+/// The @c allocatedBytes counter tells how many bytes were allocated from the
+/// heap per extraction (the first extraction, which may set things up, is not
+/// counted), and the @c contentBytes counter how many bytes of content there
+/// are. When the archive content is shared, the first counter has to be far
+/// below the second one. With a memory resource, only the bookkeeping of the
+/// header scan and the container of the files are allocated from the heap,
+/// and with a session as well, only the container is.
+///
+void extractAndReadMembers(benchmark::State& state,
+		ExtractionOptions options, bool useSession = false) {
+	const auto memberCount = static_cast<std::size_t>(state.range(0));
+	const auto memberSize = static_cast<std::size_t>(state.range(1));
+	const auto archiveContent = createArchive(memberCount, memberSize);
+
+	// With a memory resource, every extraction starts with an empty arena
+	// over a buffer that is allocated only once.
+	std::vector<char> arenaBuffer(options.memoryResource
+		? 2 * archiveContent.size() + 1024 * memberCount
+		: 0);
+	std::pmr::monotonic_buffer_resource arena{arenaBuffer.data(),
+		arenaBuffer.size()};
+	if (options.memoryResource) {
+		options.memoryResource = &arena;
+	}
+	ExtractionSession session{options};
+
+	std::size_t allocatedInExtraction = 0;
+	std::size_t extractionCount = 0;
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto archive = File::fromContentWithName(archiveContent, "archive.a");
+		state.ResumeTiming();
+
+		const std::size_t allocatedBefore = allocatedBytes;
+		{
+			auto files = useSession
+				? session.extract(std::move(archive))
+				: extract(std::move(archive), options);
+			for (auto& file : files) {
+				benchmark::DoNotOptimize(file->getContentView().data());
+				benchmark::DoNotOptimize(file->getContentView().data());
+			}
+			// The files are destroyed before the arena is released.
+		}
+		if (extractionCount++ > 0) {
+			allocatedInExtraction += allocatedBytes - allocatedBefore;
+		}
+
+		state.PauseTiming();
+		arena.release();
+		state.ResumeTiming();
+	}
+
+	const auto contentBytes = memberCount * memberSize;
+	const auto allocatedPerIteration = extractionCount > 1
+		? allocatedInExtraction / (extractionCount - 1)
+		: 0;
+	if (options.shareArchiveContent &&
+			allocatedPerIteration >= contentBytes) {
+		state.SkipWithError("the content of the members has been copied");
+	} else if (useSession && options.memoryResource &&
+			allocatedPerIteration > memberCount * sizeof(Files::value_type)) {
+		state.SkipWithError(
+			"the session has allocated more than the container from the heap");
+	}
+	state.counters["allocatedBytes"] =
+		static_cast<double>(allocatedPerIteration);
+	state.counters["contentBytes"] = static_cast<double>(contentBytes);
+	state.SetBytesProcessed(static_cast<std::int64_t>(
+		state.iterations() * contentBytes));
+}
+
+void BM_ExtractCopyingContent(benchmark::State& state) {
+	extractAndReadMembers(state, ExtractionOptions());
+}
+BENCHMARK(BM_ExtractCopyingContent)
+	->Args({20000, 64})
+	->Args({1000, 4096})
+	->Args({10, 1024 * 1024});
+
+void BM_ExtractSharingContent(benchmark::State& state) {
+	ExtractionOptions options;
+	options.shareArchiveContent = true;
+	extractAndReadMembers(state, options);
+}
+BENCHMARK(BM_ExtractSharingContent)
+	->Args({1000, 4096})
+	->Args({10, 1024 * 1024});
+
+void BM_ExtractIntoMonotonicResource(benchmark::State& state) {
+	ExtractionOptions options;
+	options.memoryResource = std::pmr::null_memory_resource();
+	extractAndReadMembers(state, options);
+}
+BENCHMARK(BM_ExtractIntoMonotonicResource)
+	->Args({20000, 64})
+	->Args({1000, 4096});
+
+void BM_ExtractWithSession(benchmark::State& state) {
+	extractAndReadMembers(state, ExtractionOptions(), true);
+}
+BENCHMARK(BM_ExtractWithSession)
+	->Args({20000, 64})
+	->Args({1000, 4096});
+
+void BM_ExtractWithSessionIntoMonotonicResource(benchmark::State& state) {
+	ExtractionOptions options;
+	options.memoryResource = std::pmr::null_memory_resource();
+	extractAndReadMembers(state, options, true);
+}
+BENCHMARK(BM_ExtractWithSessionIntoMonotonicResource)
+	->Args({20000, 64})
+	->Args({1000, 4096});
+
+void BM_ScanMembersComputingChecksums(benchmark::State& state) {
+	const auto memberCount = static_cast<std::size_t>(state.range(0));
+	const auto memberSize = static_cast<std::size_t>(state.range(1));
+	const auto archiveContent = createArchive(memberCount, memberSize);
+	ExtractionOptions options;
+	options.computeChecksums = true;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto archive = File::fromContentWithName(archiveContent, "archive.a");
+		state.ResumeTiming();
+
+		auto table = scanMembers(std::move(archive), options);
+		benchmark::DoNotOptimize(table.getChecksums().data());
+	}
+	state.SetBytesProcessed(static_cast<std::int64_t>(
+		state.iterations() * memberCount * memberSize));
+}
+BENCHMARK(BM_ScanMembersComputingChecksums)
+	->Args({20000, 64})
+	->Args({10, 1024 * 1024});
+
+///
+/// Extracts an archive generated by generateArchive() from a file.
+///
+/// Unlike the archives above, the generated archive is shaped like the ones
+/// from production: its members have random sizes (with padding), some of
+/// them have long names, and it has a symbol table.
+///
+void BM_ExtractGeneratedArchive(benchmark::State& state) {
+	GenerationOptions generation;
+	generation.memberCount = static_cast<std::size_t>(state.range(0));
+	generation.maxMemberSize = static_cast<std::uint64_t>(state.range(1));
+	generation.longNameCount = generation.memberCount / 10;
+	generation.symbolCount = generation.memberCount;
+	ExtractionOptions options;
+	options.threadCount = static_cast<std::size_t>(state.range(2));
+	const std::string archivePath{"ar-benchmarks-generated.a"};
+	const auto report = generateArchive(archivePath, generation);
+
+	for (auto _ : state) {
+		auto files = extract(File::fromFilesystem(archivePath), options);
+		benchmark::DoNotOptimize(files.size());
+	}
+
+	std::remove(archivePath.c_str());
+	state.SetBytesProcessed(static_cast<std::int64_t>(
+		state.iterations() * report.contentSize));
+}
+BENCHMARK(BM_ExtractGeneratedArchive)
+	->Args({100000, 512, 1})
+	->Args({100000, 512, 0})
+	->Args({100, 1024 * 1024, 0});
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace ar
@@ -11,8 +11,19 @@
 #ifndef AR_AR_H
 #define AR_AR_H
 
+#include "ar/archive_editor.h"
+#include "ar/batch.h"
+#include "ar/byte_source.h"
+#include "ar/comparison.h"
+#include "ar/content_stream_buf.h"
+#include "ar/deduplication.h"
 #include "ar/exceptions.h"
 #include "ar/extraction.h"
 #include "ar/file.h"
+#include "ar/generation.h"
+#include "ar/member_table.h"
+#include "ar/memory_accounting.h"
+#include "ar/merging.h"
+#include "ar/tracing.h"
 
 #endif
@@ -0,0 +1,154 @@
+///
+/// @file      ar/archive_editor.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     In-place modification of archives.
+///
+
+#ifndef AR_ARCHIVE_EDITOR_H
+#define AR_ARCHIVE_EDITOR_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ar {
+
+///
+/// Attributes stored in the header of a member.
+///
+struct MemberAttributes {
+	/// Modification time (in seconds since the epoch).
+	std::uint64_t timestamp = 0;
+
+	/// ID of the owner.
+	std::uint32_t ownerId = 0;
+
+	/// ID of the group.
+	std::uint32_t groupId = 0;
+
+	/// File mode.
+	std::uint32_t mode = 0644;
+};
+
+///
+/// Modifies an archive in a filesystem in place.
+///
+/// Every modification is written to the archive right away. Only the part of
+/// the archive that changes is written:
+///
+/// - A member is appended by writing it after the end of the archive. When
+///   its name has to be stored in the filename table (@c //) and the table
+///   does not contain it yet, the table grows, so the archive is rewritten
+///   from the table onward.
+/// - A member is replaced or removed by rewriting the archive from the member
+///   onward. The unchanged members after it are moved by @c copy_file_range
+///   on Linux (see internal::moveFileRange()), so their content is not read.
+///
+/// The offsets in the symbol table (@c / or @c /SYM64/) are patched in place
+/// whenever members are moved. Symbols of a removed member are removed from
+/// the table, which is then rewritten. However, symbols of appended or
+/// replaced members are not added, as their content is not parsed; run
+/// @c ranlib on archives of object files after modifying them.
+///
+/// Only GNU archives (and archives without long names) are supported.
+///
+class ArchiveEditor {
+public:
+	explicit ArchiveEditor(const std::string& path);
+	~ArchiveEditor();
+
+	static ArchiveEditor create(const std::string& path);
+
+	/// @name Members
+	/// @{
+	std::vector<std::string> getMemberNames() const;
+	bool hasMember(std::string_view name) const;
+	std::uint64_t getArchiveSize() const noexcept;
+	/// @}
+
+	/// @name Modifications
+	/// @{
+	void append(const std::string& name, std::string_view content);
+	void append(const std::string& name, std::string_view content,
+		const MemberAttributes& attributes);
+	void replace(const std::string& name, std::string_view content);
+	void replace(const std::string& name, std::string_view content,
+		const MemberAttributes& attributes);
+	void remove(const std::string& name);
+	/// @}
+
+	/// @name Disabled
+	/// @{
+	ArchiveEditor(const ArchiveEditor&) = delete;
+	ArchiveEditor(ArchiveEditor&&) = delete;
+	ArchiveEditor& operator=(const ArchiveEditor&) = delete;
+	ArchiveEditor& operator=(ArchiveEditor&&) = delete;
+	/// @}
+
+private:
+	/// A member of the archive.
+	struct Member {
+		/// Name of the member.
+		std::string name;
+
+		/// Offset of the header of the member from the start of the archive.
+		std::uint64_t headerOffset;
+
+		/// Size of the content of the member.
+		std::uint64_t size;
+
+		/// The name field of the header (as stored in the archive).
+		std::string nameField;
+
+		/// Attributes from the header of the member.
+		MemberAttributes attributes;
+	};
+
+	/// A table stored as a special member (the symbol or filename table).
+	struct Table {
+		/// Offset of the header of the table (0 when there is no table).
+		std::uint64_t headerOffset = 0;
+
+		/// Content of the table.
+		std::string content;
+	};
+
+private:
+	void readArchive();
+	std::vector<Member>::iterator findMember(std::string_view name);
+	std::string nameFieldFor(const std::string& name);
+	void storeLongName(const std::string& name);
+	void replaceRange(std::uint64_t offset, std::uint64_t size,
+		const std::string& bytes);
+	void removeSymbolsOf(std::uint64_t headerOffset);
+	void writeSymbolTable();
+	std::size_t getSymbolOffsetSize() const noexcept;
+	std::uint64_t getSymbolOffset(std::size_t index) const;
+	void setSymbolOffset(std::size_t index, std::uint64_t offset);
+	std::size_t getSymbolCount() const;
+
+private:
+	/// Path to the archive.
+	std::string path;
+
+	/// Size of the archive.
+	std::uint64_t archiveSize = 0;
+
+	/// Members of the archive (in the order in which they are stored).
+	std::vector<Member> members;
+
+	/// The symbol table.
+	Table symbolTable;
+
+	/// Does the symbol table store 64-bit offsets (@c /SYM64/)?
+	bool symbolTableIs64Bit = false;
+
+	/// The filename table.
+	Table nameTable;
+};
+
+} // namespace ar
+
+#endif
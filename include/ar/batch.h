@@ -0,0 +1,85 @@
+///
+/// @file      ar/batch.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Processing of many archives at once.
+///
+
+#ifndef AR_BATCH_H
+#define AR_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ar {
+
+class File;
+
+///
+/// Options controlling the processing of a batch of archives.
+///
+struct BatchOptions {
+	/// Number of threads processing the archives.
+	///
+	/// Zero means the number of threads that the hardware can run
+	/// concurrently.
+	std::size_t threadCount = 0;
+};
+
+///
+/// Result of processing a single archive of a batch.
+///
+struct BatchArchiveResult {
+	/// Path to the archive.
+	std::string path;
+
+	/// Number of files in the archive.
+	std::size_t fileCount = 0;
+
+	/// Total size of the content of the files in the archive.
+	std::uint64_t contentSize = 0;
+
+	/// Description of the error that made the processing of the archive fail
+	/// (empty when the archive has been processed successfully).
+	std::string error;
+};
+
+///
+/// Report about the processing of a batch of archives.
+///
+struct BatchReport {
+	/// Results for the archives, in the order in which they were given.
+	std::vector<BatchArchiveResult> archives;
+
+	/// Number of archives whose processing failed.
+	std::size_t failedArchiveCount = 0;
+
+	/// Number of files in all successfully processed archives.
+	std::size_t fileCount = 0;
+
+	/// Total size of the content of the files in all successfully processed
+	/// archives.
+	std::uint64_t contentSize = 0;
+
+	/// Time spent on processing the batch (in seconds).
+	double elapsedSeconds = 0.0;
+};
+
+/// Function called for every file of every archive in a batch.
+///
+/// The function is called concurrently from several threads, also for files
+/// of the same archive.
+using BatchFileHandler = std::function<
+	void (const std::string& archivePath, File& file)>;
+
+BatchReport processArchives(const std::vector<std::string>& archivePaths,
+	const BatchFileHandler& handler);
+BatchReport processArchives(const std::vector<std::string>& archivePaths,
+	const BatchFileHandler& handler, const BatchOptions& options);
+
+} // namespace ar
+
+#endif
@@ -0,0 +1,58 @@
+///
+/// @file      ar/byte_source.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Source of bytes supporting positioned reads.
+///
+
+#ifndef AR_BYTE_SOURCE_H
+#define AR_BYTE_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ar {
+
+///
+/// Base class and factory for sources of bytes supporting positioned reads.
+///
+/// A source provides the content of an archive to scanMembers(). Subclass it
+/// to read archives from custom storage. Only headers of members (and the
+/// filename table) are read while scanning, and content of members is read
+/// only when it is asked for.
+///
+/// Sources are read concurrently from several threads, so readAt() has to be
+/// thread-safe.
+///
+class ByteSource {
+public:
+	virtual ~ByteSource() = 0;
+
+	virtual std::uint64_t size() const = 0;
+	virtual std::size_t readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const = 0;
+	virtual const char* data() const noexcept;
+
+	static std::shared_ptr<ByteSource> fromString(std::string content);
+	static std::shared_ptr<ByteSource> fromFileDescriptor(int fd);
+	static std::shared_ptr<ByteSource> fromFilesystem(const std::string& path);
+	static std::shared_ptr<ByteSource> fromCompressedFile(
+		const std::string& path);
+
+	/// @name Disabled
+	/// @{
+	ByteSource(const ByteSource&) = delete;
+	ByteSource(ByteSource&&) = delete;
+	ByteSource& operator=(const ByteSource&) = delete;
+	ByteSource& operator=(ByteSource&&) = delete;
+	/// @}
+
+protected:
+	ByteSource();
+};
+
+} // namespace ar
+
+#endif
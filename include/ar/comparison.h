@@ -0,0 +1,75 @@
+///
+/// @file      ar/comparison.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Comparison of archives.
+///
+
+#ifndef AR_COMPARISON_H
+#define AR_COMPARISON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ar {
+
+class MemberTable;
+
+///
+/// A kind of a difference between members of two archives.
+///
+enum class MemberChange {
+	Added,   ///< The member is only in the new archive.
+	Removed, ///< The member is only in the old archive.
+	Modified ///< The member is in both archives, but its content differs.
+};
+
+///
+/// A difference between members of two archives.
+///
+struct MemberDifference {
+	/// Kind of the difference.
+	MemberChange change;
+
+	/// Name of the member.
+	std::string name;
+
+	/// Size of the member in the old archive (zero when it was added).
+	std::uint64_t oldSize = 0;
+
+	/// Size of the member in the new archive (zero when it was removed).
+	std::uint64_t newSize = 0;
+};
+
+///
+/// Differences between two archives.
+///
+struct ArchiveDiff {
+	/// Removed and modified members (in the order of the old archive),
+	/// followed by added members (in the order of the new archive).
+	std::vector<MemberDifference> differences;
+
+	/// Number of members that are the same in both archives.
+	std::size_t unchangedCount = 0;
+
+	/// Number of members whose content had to be compared (members of the
+	/// same name and size).
+	std::size_t comparedCount = 0;
+
+	/// Total size of the content of the compared members.
+	///
+	/// It is an upper bound of the number of bytes read from each archive, as
+	/// the comparison of a member stops at its first differing byte.
+	std::uint64_t comparedSize = 0;
+
+	bool empty() const noexcept;
+};
+
+ArchiveDiff diff(const std::string& oldPath, const std::string& newPath);
+ArchiveDiff diff(const MemberTable& oldMembers, const MemberTable& newMembers);
+
+} // namespace ar
+
+#endif
@@ -0,0 +1,69 @@
+///
+/// @file      ar/content_stream_buf.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Stream buffer reading the content of a file.
+///
+
+#ifndef AR_CONTENT_STREAM_BUF_H
+#define AR_CONTENT_STREAM_BUF_H
+
+#include <cstddef>
+#include <ios>
+#include <streambuf>
+#include <vector>
+
+namespace ar {
+
+class File;
+
+///
+/// Stream buffer reading the content of a file.
+///
+/// The content is read through File::readContentAt() into a buffer of a fixed
+/// size, so a file whose content is stored in a filesystem (e.g. a member of
+/// a large archive) can be read by a @c std::istream without holding the
+/// whole content in memory. Seeking is supported relatively to the beginning
+/// and to the current position.
+///
+/// The file has to exist for as long as the stream buffer is used.
+///
+class ContentStreamBuf: public std::streambuf {
+public:
+	/// Default size of the buffer.
+	static constexpr std::size_t DefaultBufferSize = 256 * 1024;
+
+public:
+	explicit ContentStreamBuf(File& file,
+		std::size_t bufferSize = DefaultBufferSize);
+	virtual ~ContentStreamBuf() override;
+
+	/// @name Disabled
+	/// @{
+	ContentStreamBuf(const ContentStreamBuf&) = delete;
+	ContentStreamBuf(ContentStreamBuf&&) = delete;
+	ContentStreamBuf& operator=(const ContentStreamBuf&) = delete;
+	ContentStreamBuf& operator=(ContentStreamBuf&&) = delete;
+	/// @}
+
+protected:
+	virtual int_type underflow() override;
+	virtual pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+		std::ios_base::openmode which) override;
+	virtual pos_type seekpos(pos_type position,
+		std::ios_base::openmode which) override;
+
+private:
+	/// File whose content is read.
+	File& file;
+
+	/// Buffer holding a part of the content.
+	std::vector<char> buffer;
+
+	/// Offset of the part of the content in the buffer.
+	std::size_t bufferOffset;
+};
+
+} // namespace ar
+
+#endif
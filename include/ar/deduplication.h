@@ -0,0 +1,145 @@
+///
+/// @file      ar/deduplication.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Detection and deduplicated extraction of identical members of
+///            archives.
+///
+
+#ifndef AR_DEDUPLICATION_H
+#define AR_DEDUPLICATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ar/batch.h"
+
+namespace ar {
+
+///
+/// How duplicate files are created by a deduplicated extraction.
+///
+enum class DuplicateLinking {
+	/// Clone the first copy of the file (@c FICLONE). The clone shares the
+	/// content with the first copy on the disk but is otherwise independent of
+	/// it. When the filesystem does not support cloning, the file is written.
+	Reflink,
+
+	/// Create a hard link to the first copy of the file. All the copies then
+	/// refer to the same file, so modifying one of them modifies all of them.
+	/// When a hard link cannot be created, the file is written.
+	HardLink
+};
+
+///
+/// Options controlling the deduplication.
+///
+struct DeduplicationOptions {
+	/// Number of threads scanning the archives.
+	///
+	/// Zero means the number of threads that the hardware can run
+	/// concurrently.
+	std::size_t threadCount = 0;
+
+	/// How duplicate files are created by extractDeduplicated().
+	DuplicateLinking linking = DuplicateLinking::Reflink;
+};
+
+///
+/// Member of an archive.
+///
+struct MemberLocation {
+	/// Index of the archive in the list of archives given to the
+	/// deduplication.
+	std::size_t archiveIndex = 0;
+
+	/// Name of the member.
+	std::string name;
+};
+
+///
+/// Members of archives having identical content.
+///
+struct DuplicateGroup {
+	/// Size of the content of each of the members.
+	std::uint64_t size = 0;
+
+	/// CRC-32C checksum of the content of each of the members.
+	std::uint32_t checksum = 0;
+
+	/// The members, in the order of the archives and of the members in them.
+	std::vector<MemberLocation> members;
+};
+
+///
+/// Report about identical members of archives.
+///
+struct DeduplicationReport {
+	/// Results for the archives, in the order in which they were given.
+	std::vector<BatchArchiveResult> archives;
+
+	/// Number of archives that cannot be read or that are invalid.
+	std::size_t failedArchiveCount = 0;
+
+	/// Groups of members with identical content (each group has at least two
+	/// members), ordered by the first of their members.
+	std::vector<DuplicateGroup> duplicateGroups;
+
+	/// Number of members in all successfully read archives.
+	std::size_t memberCount = 0;
+
+	/// Number of members with distinct content.
+	std::size_t uniqueMemberCount = 0;
+
+	/// Total size of the content of all the members.
+	std::uint64_t contentSize = 0;
+
+	/// Total size of the distinct content of the members.
+	std::uint64_t uniqueContentSize = 0;
+};
+
+///
+/// Report about a deduplicated extraction.
+///
+struct DeduplicatedExtractionReport {
+	/// Results for the archives, in the order in which they were given.
+	std::vector<BatchArchiveResult> archives;
+
+	/// Number of archives that cannot be read or that are invalid.
+	std::size_t failedArchiveCount = 0;
+
+	/// Number of files whose content has been written.
+	std::size_t writtenFileCount = 0;
+
+	/// Number of bytes that have been written.
+	std::uint64_t writtenSize = 0;
+
+	/// Number of files that have been created as clones of other files.
+	std::size_t reflinkedFileCount = 0;
+
+	/// Number of files that have been created as hard links to other files.
+	std::size_t hardLinkedFileCount = 0;
+
+	/// Number of bytes that have not been written thanks to clones and hard
+	/// links.
+	std::uint64_t savedSize = 0;
+};
+
+DeduplicationReport findDuplicateMembers(
+	const std::vector<std::string>& archivePaths);
+DeduplicationReport findDuplicateMembers(
+	const std::vector<std::string>& archivePaths,
+	const DeduplicationOptions& options);
+
+DeduplicatedExtractionReport extractDeduplicated(
+	const std::vector<std::string>& archivePaths,
+	const std::string& directoryPath);
+DeduplicatedExtractionReport extractDeduplicated(
+	const std::vector<std::string>& archivePaths,
+	const std::string& directoryPath, const DeduplicationOptions& options);
+
+} // namespace ar
+
+#endif
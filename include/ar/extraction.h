@@ -8,14 +8,316 @@
 #ifndef AR_EXTRACTION_H
 #define AR_EXTRACTION_H
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "ar/memory_accounting.h"
 
 namespace ar {
 
+class ByteSource;
 class File;
 class Files;
+class MemberTable;
+struct ExtractionStats;
+
+namespace internal {
+
+class ArchiveBuffer;
+class Extractor;
+
+} // namespace internal
+
+///
+/// Options controlling the extraction of archives.
+///
+struct ExtractionOptions {
+	/// Number of threads used by the extraction.
+	///
+	/// The threads materialize the extracted files, and also scan the archive
+	/// for headers when @c speculativeHeaderScan is enabled and parse nested
+	/// archives when @c recursive is enabled. Otherwise, the headers are
+	/// walked in a single thread. extractToDirectory() also writes the files
+	/// by these threads when @c batchedWrites is enabled. The calling thread
+	/// is one of them, so the value 1 means that everything is done in the
+	/// calling thread (the pipelined extraction is an exception, see
+	/// @c pipelined). The value 0 means to use as many threads as the hardware
+	/// can run concurrently.
+	std::size_t threadCount = 1;
+
+	/// Discover the headers by scanning the archive in parallel?
+	///
+	/// When enabled, the archive is split into chunks that are scanned for
+	/// anything that looks like a member header, and the found candidates are
+	/// then verified to form the chain of headers. This avoids the serial walk
+	/// over the headers of large archives with many members. When the
+	/// verification fails (e.g. when the headers do not have the standard
+	/// 60-byte layout), the headers are walked serially.
+	bool speculativeHeaderScan = false;
+
+	/// Overlap the parsing of headers with the writing of files?
+	///
+	/// Only extractToDirectory() is affected. When enabled, the headers are
+	/// parsed in the calling thread, which passes the found files through a
+	/// bounded queue to @c threadCount writer threads. When the queue is
+	/// full, the parsing waits, so the memory use stays bounded.
+	bool pipelined = false;
+
+	/// Maximal number of files waiting in the queue of the pipelined
+	/// extraction (rounded up to a power of two).
+	std::size_t queueCapacity = 64;
+
+	/// Write the extracted files in batches?
+	///
+	/// Only extractToDirectory() is affected. When enabled, the files are
+	/// written in batches through io_uring when the running kernel supports
+	/// it, and by a pool of @c threadCount threads otherwise. This lowers the
+	/// cost of system calls when extracting archives with many small files.
+	bool batchedWrites = false;
+
+	/// Maximal number of bytes of extracted files that may be held in memory
+	/// (0 means no limit).
+	///
+	/// When non-zero, an archive stored in a filesystem is mapped into memory
+	/// instead of being read, so its pages can be dropped by the system at any
+	/// time. extract() then keeps files in memory only as long as their total
+	/// size fits into the budget; the content of the remaining files is read
+	/// from the archive on demand. extractToDirectory() writes the files
+	/// straight from the archive, copying the files that do not fit into the
+	/// budget in chunks. The archive must not be modified until the
+	/// extracted files are no longer used. Archives that are not stored in a
+	/// filesystem are always held in memory as a whole.
+	std::size_t memoryBudget = 0;
+
+	/// Let the extracted files share the content of the archive?
+	///
+	/// Only extract() is affected. When enabled, the content of the files is
+	/// not copied out of the archive; the files refer to it instead, so
+	/// File::getContentView() returns a view into the archive. The archive
+	/// is kept alive (in memory or mapped) for as long as any of its files
+	/// exists. When the archive is stored in a filesystem, it has to be
+	/// extracted with a memory budget for it to be mapped.
+	bool shareArchiveContent = false;
+
+	/// Memory resource from which extract() allocates the files and their
+	/// names and content (the null pointer means the usual heap).
+	///
+	/// The container holding the files is always allocated from the heap.
+	///
+	/// When a monotonic resource (such as
+	/// @c std::pmr::monotonic_buffer_resource) is used, the whole result of an
+	/// extraction is released at once when the resource is destroyed. The
+	/// resource is only used from the calling thread, so it does not have to
+	/// be thread-safe; the files are then materialized serially. The resource
+	/// has to outlive the returned files.
+	std::pmr::memory_resource* memoryResource = nullptr;
+
+	/// Write only files that are not up to date?
+	///
+	/// Only extractToDirectory() is affected. When enabled, a file is not
+	/// written when the directory already contains a file of the same name,
+	/// size, and modification time as the member in the archive. The
+	/// modification time of written files is set to the one of the member, so
+	/// extracting an unchanged archive again writes nothing. An archive stored
+	/// in a filesystem is mapped into memory, so the content of skipped files
+	/// is not even read. A zero timestamp of a member (deterministic archives)
+	/// is taken as unknown, so the content of such a member is always
+	/// compared, as if @c compareContent was enabled. The files are written
+	/// one by one (@c pipelined and @c batchedWrites are ignored).
+	bool incremental = false;
+
+	/// Compute checksums of the content of members?
+	///
+	/// Only scanMembers() is affected. When enabled, the CRC-32C checksum of
+	/// the content of every member is computed right after its header has
+	/// been read, so the archive is passed only once (see
+	/// MemberTable::getChecksum()). The checksums are computed by the crc32
+	/// instruction of SSE4.2 when the processor supports it.
+	bool computeChecksums = false;
+
+	/// Compare also the content of existing files in the incremental
+	/// extraction?
+	///
+	/// Detects files that were changed without changing their size and
+	/// modification time, at the cost of reading them.
+	bool compareContent = false;
+
+	/// Extract also the members of nested archives?
+	///
+	/// Only extract() and ExtractionSession are affected; extractToDirectory()
+	/// stores nested archives as files. When enabled, every member whose
+	/// content starts with the magic string of archives is not extracted as a
+	/// file. Instead, it is extracted as an archive, recursively, and its
+	/// files are named by the path through the nested archives (e.g.
+	/// @c libouter.a/inner.o). The nested archives are parsed in place, as
+	/// ranges of the outermost archive, so their content is never copied, and
+	/// they are parsed in parallel by @c threadCount threads. Their files are
+	/// then materialized like the other files (e.g. they share the content
+	/// of the outermost archive when @c shareArchiveContent is enabled).
+	bool recursive = false;
+
+	/// Statistics into which the extraction adds what it has done (the null
+	/// pointer means that no statistics are collected).
+	///
+	/// Collected by extract(), scanMembers(), ExtractionSession, and
+	/// extractToDirectory() (except for the pipelined extraction). The
+	/// statistics are added to the ones already stored in the struct, so a
+	/// single struct can gather the statistics of several extractions. When
+	/// the library is built without statistics (@c -DAR_STATS=OFF), nothing
+	/// is collected, and the recording costs nothing.
+	ExtractionStats* stats = nullptr;
+};
+
+///
+/// Report about an extraction into a directory.
+///
+struct ExtractionReport {
+	/// Names of the extracted files, in the order of the archive.
+	std::vector<std::string> fileNames;
+
+	/// The largest number of files that were waiting in the queue of the
+	/// pipelined extraction at once (zero when the extraction was not
+	/// pipelined).
+	std::size_t queueHighWaterMark = 0;
+
+	/// Capacity of the queue of the pipelined extraction (zero when the
+	/// extraction was not pipelined).
+	std::size_t queueCapacity = 0;
+
+	/// Have the files been written through io_uring?
+	bool ioUringUsed = false;
+
+	/// Number of files that were not written because they were up to date
+	/// (zero when the extraction was not incremental).
+	std::size_t unchangedFileCount = 0;
+};
+
+///
+/// Statistics about extractions (see ExtractionOptions::stats).
+///
+struct ExtractionStats {
+	/// Have the statistics been collected? They are not when the library has
+	/// been built without statistics.
+	bool collected = false;
+
+	/// Number of bytes read from archives by read calls (pages of mapped
+	/// archives are read by the system when accessed, so they are not
+	/// counted).
+	std::uint64_t bytesRead = 0;
+
+	/// Number of parsed headers (including the headers of the symbol and
+	/// filename tables).
+	std::size_t headersParsed = 0;
+
+	/// Number of names that have been looked up in filename tables.
+	std::size_t nameTableHits = 0;
+
+	/// Number of allocations of extracted files and of buffers into which
+	/// their content has been copied (their names are not counted).
+	std::size_t allocations = 0;
+
+	/// Number of bytes of content copied into extracted files.
+	std::uint64_t bytesCopied = 0;
+
+	/// Time spent by reading archives into memory (or mapping them).
+	std::chrono::nanoseconds readTime{0};
+
+	/// Time spent by parsing headers.
+	std::chrono::nanoseconds scanTime{0};
+
+	/// Time spent by parsing nested archives (see
+	/// ExtractionOptions::recursive).
+	std::chrono::nanoseconds expandTime{0};
+
+	/// Time spent by creating the extracted files.
+	std::chrono::nanoseconds materializeTime{0};
+
+	/// Memory used in the phases of extractions (see the times above).
+	///
+	/// Recorded only when a memory counter is registered by
+	/// setMemoryCounter(). The numbers of allocations and allocated bytes
+	/// are added, the peak is the largest peak of the phase, and the held
+	/// bytes are the ones at the end of the last phase of the kind.
+	/// @{
+	MemoryUsage readMemory;
+	MemoryUsage scanMemory;
+	MemoryUsage expandMemory;
+	MemoryUsage materializeMemory;
+	/// @}
+};
+
+///
+/// Session for extracting many archives one after another.
+///
+/// The session keeps the memory used while extracting an archive (its
+/// content, the tables of names and members, and the threads) and reuses it
+/// for the next archive. When extracting a large number of archives of
+/// similar sizes, only the extracted files are allocated.
+///
+/// A session extracts one archive at a time, so use a separate session in
+/// every thread.
+///
+class ExtractionSession {
+public:
+	ExtractionSession();
+	explicit ExtractionSession(const ExtractionOptions& options);
+	ExtractionSession(ExtractionSession&& other) noexcept;
+	~ExtractionSession();
+
+	ExtractionSession& operator=(ExtractionSession&& other) noexcept;
+
+	Files extract(std::unique_ptr<File> archive);
+	void reset() noexcept;
+
+	const ExtractionOptions& getOptions() const noexcept;
+
+	/// @name Disabled
+	/// @{
+	ExtractionSession(const ExtractionSession&) = delete;
+	ExtractionSession& operator=(const ExtractionSession&) = delete;
+	/// @}
+
+private:
+	std::shared_ptr<const internal::ArchiveBuffer> loadArchive(File& archive);
+
+private:
+	/// Options used for every extraction.
+	ExtractionOptions options;
+
+	/// The reused extractor.
+	std::unique_ptr<internal::Extractor> extractor;
+
+	/// Content of the last archive (its capacity is reused).
+	std::string archiveContent;
+
+	/// Buffer viewing @c archiveContent.
+	std::shared_ptr<internal::ArchiveBuffer> archiveBuffer;
+};
 
 Files extract(std::unique_ptr<File> archive);
+Files extract(std::unique_ptr<File> archive,
+	const ExtractionOptions& options);
+
+MemberTable scanMembers(std::unique_ptr<File> archive);
+MemberTable scanMembers(std::unique_ptr<File> archive,
+	const ExtractionOptions& options);
+MemberTable scanMembers(std::shared_ptr<const ByteSource> archive);
+MemberTable scanMembers(std::shared_ptr<const ByteSource> archive,
+	const ExtractionOptions& options);
+
+ExtractionReport extractToDirectory(std::unique_ptr<File> archive,
+	const std::string& directoryPath);
+ExtractionReport extractToDirectory(std::unique_ptr<File> archive,
+	const std::string& directoryPath, const ExtractionOptions& options);
+ExtractionReport extractToDirectory(std::shared_ptr<const ByteSource> archive,
+	const std::string& directoryPath);
+ExtractionReport extractToDirectory(std::shared_ptr<const ByteSource> archive,
+	const std::string& directoryPath, const ExtractionOptions& options);
 
 } // namespace ar
 
@@ -8,8 +8,12 @@
 #ifndef AR_FILE_H
 #define AR_FILE_H
 
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ar {
@@ -18,17 +22,27 @@ namespace ar {
 /// Base class and factory for files.
 ///
 class File {
+public:
+	/// Function called for consecutive chunks of the content of a file.
+	using ChunkCallback = std::function<void (std::string_view chunk)>;
+
 public:
 	virtual ~File() = 0;
 
 	virtual std::string getName() const = 0;
 	virtual std::string getContent() = 0;
+	virtual std::string_view getNameView() const;
+	virtual std::string_view getContentView();
+	virtual void forEachChunk(std::size_t chunkSize,
+		const ChunkCallback& callback);
+	virtual std::size_t readContentAt(std::size_t offset, char* buffer,
+		std::size_t size);
 	virtual void saveCopyTo(const std::string& directoryPath) = 0;
 	virtual void saveCopyTo(const std::string& directoryPath,
 		const std::string& name) = 0;
 
 	static std::unique_ptr<File> fromContentWithName(
-		const std::string& content, const std::string& name);
+		std::string content, std::string name);
 	static std::unique_ptr<File> fromFilesystem(const std::string& path);
 	static std::unique_ptr<File> fromFilesystemWithOtherName(
 		const std::string& path, const std::string& name);
@@ -43,6 +57,19 @@ public:
 
 protected:
 	File();
+
+private:
+	struct ViewCache;
+
+	ViewCache& getViewCache() const;
+
+private:
+	/// Ensures that the cache of the views is created only once.
+	mutable std::once_flag viewCacheCreated;
+
+	/// Copies of the name and content backing the default implementations
+	/// of the views (created upon the first use of a view).
+	mutable std::unique_ptr<ViewCache> viewCache;
 };
 
 ///
@@ -80,6 +107,7 @@ public:
 	/// @{
 	bool empty() const noexcept;
 	size_type size() const noexcept;
+	void reserve(size_type count);
 	/// @}
 
 	/// @name Modifiers
@@ -0,0 +1,89 @@
+///
+/// @file      ar/generation.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Generation of synthetic archives.
+///
+
+#ifndef AR_GENERATION_H
+#define AR_GENERATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace ar {
+
+///
+/// Options controlling the generation of synthetic archives.
+///
+struct GenerationOptions {
+	/// Seed of the generator.
+	///
+	/// The same seed and options always give the same archive (byte for
+	/// byte, on every platform).
+	std::uint64_t seed = 0;
+
+	/// Number of members.
+	std::size_t memberCount = 100;
+
+	/// The smallest size of the content of a member.
+	std::uint64_t minMemberSize = 0;
+
+	/// The largest size of the content of a member.
+	///
+	/// The sizes are spread uniformly between the smallest and the largest
+	/// size, so about half of them are odd and their content is padded.
+	std::uint64_t maxMemberSize = 4096;
+
+	/// Number of members whose names are stored in the filename table.
+	///
+	/// The members with long names are spread evenly over the archive. The
+	/// other members have short names stored right in their headers.
+	std::size_t longNameCount = 0;
+
+	/// Size of the long names (it has to be greater than 15).
+	std::size_t longNameSize = 100;
+
+	/// Number of symbols in the symbol table (0 means that the archive has no
+	/// symbol table).
+	///
+	/// The symbols are spread evenly over the members.
+	std::size_t symbolCount = 0;
+
+	/// Store the symbol table as @c /SYM64/ (with 64-bit offsets)?
+	///
+	/// A 64-bit symbol table is always stored when a member with a symbol
+	/// starts after 4 GB.
+	bool sym64 = false;
+};
+
+///
+/// Report about a generation of an archive.
+///
+struct GenerationReport {
+	/// Number of members in the archive.
+	std::size_t memberCount = 0;
+
+	/// Number of symbols in the symbol table of the archive.
+	std::size_t symbolCount = 0;
+
+	/// Is the symbol table stored as @c /SYM64/?
+	bool sym64 = false;
+
+	/// Total size of the content of the members.
+	std::uint64_t contentSize = 0;
+
+	/// Size of the archive.
+	std::uint64_t archiveSize = 0;
+};
+
+GenerationReport generateArchive(const std::string& outputPath,
+	const GenerationOptions& options);
+GenerationReport generateArchive(std::ostream& output,
+	const GenerationOptions& options);
+
+} // namespace ar
+
+#endif
@@ -0,0 +1,82 @@
+///
+/// @file      ar/internal/archive_buffer.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Content of an archive shared by the parts of the extraction.
+///
+
+#ifndef AR_INTERNAL_ARCHIVE_BUFFER_H
+#define AR_INTERNAL_ARCHIVE_BUFFER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace ar {
+
+class ByteSource;
+
+namespace internal {
+
+class MappedFile;
+
+///
+/// Immutable content of an archive.
+///
+/// The content is either held in a string or, for archives stored in a
+/// filesystem, mapped into memory. Buffers are shared, so the content stays
+/// alive for as long as anything refers to it. The only exception are buffers
+/// created by fromView(), whose content is owned by the creator.
+///
+class ArchiveBuffer {
+public:
+	~ArchiveBuffer();
+
+	static std::shared_ptr<const ArchiveBuffer> fromContent(
+		std::string content);
+	static std::shared_ptr<const ArchiveBuffer> fromFilesystem(
+		const std::string& path);
+	static std::shared_ptr<ArchiveBuffer> fromView(std::string_view content);
+	static std::shared_ptr<const ArchiveBuffer> fromByteSource(
+		std::shared_ptr<const ByteSource> source);
+
+	void assignView(std::string_view content) noexcept;
+
+	std::string_view getContent() const noexcept;
+	const std::string& getPath() const noexcept;
+
+	void release(std::size_t offset, std::size_t size) const noexcept;
+
+	/// @name Disabled
+	/// @{
+	ArchiveBuffer(const ArchiveBuffer&) = delete;
+	ArchiveBuffer(ArchiveBuffer&&) = delete;
+	ArchiveBuffer& operator=(const ArchiveBuffer&) = delete;
+	ArchiveBuffer& operator=(ArchiveBuffer&&) = delete;
+	/// @}
+
+private:
+	ArchiveBuffer();
+
+private:
+	/// Content held in memory (when the archive is not mapped).
+	std::string heldContent;
+
+	/// The mapped archive (if any).
+	std::unique_ptr<MappedFile> mappedFile;
+
+	/// Source whose bytes are the content (if any).
+	std::shared_ptr<const ByteSource> source;
+
+	/// Path to the mapped archive (empty when the archive is not mapped).
+	std::string path;
+
+	/// View of the content, wherever it is stored.
+	std::string_view content;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,63 @@
+///
+/// @file      ar/internal/archive_format.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Creation of the parts of GNU archives.
+///
+
+#ifndef AR_INTERNAL_ARCHIVE_FORMAT_H
+#define AR_INTERNAL_ARCHIVE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ar {
+namespace internal {
+
+/// String at the beginning of every archive.
+constexpr std::string_view ArchiveMagicString{"!<arch>\n"};
+
+/// Longest name that is stored right in the header of a member (the name is
+/// followed by @c /). Longer names are stored in the filename table.
+constexpr std::size_t MaxShortNameSize = 15;
+
+///
+/// A symbol from the symbol table of an archive.
+///
+struct Symbol {
+	/// Name of the symbol.
+	std::string name;
+
+	/// Offset of the header of the member defining the symbol.
+	std::uint64_t headerOffset;
+};
+
+/// @name Archive Format
+/// @{
+
+std::uint64_t paddedSize(std::uint64_t size);
+std::string formatMemberHeader(const std::string& nameField,
+	std::uint64_t timestamp, std::uint32_t ownerId, std::uint32_t groupId,
+	std::uint32_t mode, std::uint64_t size);
+std::string formatNameTableHeader(std::uint64_t size);
+void ensureIsValidMemberName(std::string_view name);
+
+bool isSymbolTableName(std::string_view nameField);
+std::uint64_t readBigEndian(const char* bytes, std::size_t size);
+void writeBigEndian(std::uint64_t value, char* bytes, std::size_t size);
+std::vector<Symbol> parseSymbolTable(std::string_view content, bool is64Bit);
+std::string formatSymbolTableHeader(std::uint64_t size, bool is64Bit);
+std::string formatSymbolTable(const std::vector<Symbol>& symbols,
+	bool is64Bit);
+std::uint64_t symbolTableSize(std::size_t symbolCount,
+	std::uint64_t namesSize, bool is64Bit);
+
+/// @}
+
+} // namespace internal
+} // namespace ar
+
+#endif
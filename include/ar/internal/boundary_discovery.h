@@ -0,0 +1,54 @@
+///
+/// @file      ar/internal/boundary_discovery.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Speculative discovery of member boundaries in archives.
+///
+
+#ifndef AR_INTERNAL_BOUNDARY_DISCOVERY_H
+#define AR_INTERNAL_BOUNDARY_DISCOVERY_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace ar {
+namespace internal {
+
+class ThreadPool;
+
+/// Size of a header of a member in an archive.
+constexpr std::size_t MemberHeaderSize = 60;
+
+///
+/// A position in an archive that looks like the start of a member header.
+///
+struct HeaderCandidate {
+	/// Offset of the header from the start of the archive.
+	std::size_t offset;
+
+	/// Size of the member's content, as stated in the header.
+	std::size_t size;
+};
+
+/// Candidates for member headers, ordered by their offsets.
+using HeaderCandidates = std::vector<HeaderCandidate>;
+
+/// @name Boundary Discovery
+/// @{
+
+bool isHeaderCandidateAt(std::string_view content, std::size_t offset,
+	std::size_t& size);
+HeaderCandidates findHeaderCandidates(std::string_view content,
+	std::size_t start, std::size_t end);
+HeaderCandidates findHeaderCandidatesInParallel(std::string_view content,
+	std::size_t start, ThreadPool* pool);
+bool stitchHeaderChain(std::string_view content, std::size_t firstHeader,
+	const HeaderCandidates& candidates, HeaderCandidates& chain);
+
+/// @}
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,114 @@
+///
+/// @file      ar/internal/byte_sources/decompressing_byte_source.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Source of bytes decompressed from a file.
+///
+
+#ifndef AR_INTERNAL_BYTE_SOURCES_DECOMPRESSING_BYTE_SOURCE_H
+#define AR_INTERNAL_BYTE_SOURCES_DECOMPRESSING_BYTE_SOURCE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ar/byte_source.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Source of the bytes of a compressed file, decompressed in a thread of its
+/// own.
+///
+/// The decompression starts in the constructor and runs while the source is
+/// read, so parsing of the archive is pipelined with its decompression.
+/// readAt() waits until the requested bytes have been decompressed, and
+/// size() waits until the whole file has been decompressed. The decompressed
+/// bytes are kept in memory until the source is destroyed.
+///
+class DecompressingByteSource: public ByteSource {
+public:
+	/// Supported compression formats.
+	enum class Format {
+		Gzip, ///< gzip (or zlib), requires zlib.
+		Zstd  ///< Zstandard, requires libzstd.
+	};
+
+	/// Size of the chunks holding the decompressed bytes.
+	static constexpr std::size_t ChunkSize = 1024 * 1024;
+
+	/// Size of the chunks in which the compressed file is read.
+	static constexpr std::size_t InputChunkSize = 256 * 1024;
+
+public:
+	explicit DecompressingByteSource(const std::string& path);
+	virtual ~DecompressingByteSource() override;
+
+	virtual std::uint64_t size() const override;
+	virtual std::size_t readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const override;
+
+	Format getFormat() const noexcept;
+
+	static std::optional<Format> detectFormat(std::string_view prefix);
+	static bool isSupported(Format format) noexcept;
+
+private:
+	void decompress();
+	void decompressGzip();
+	void decompressZstd();
+	std::size_t readInput(char* buffer, std::size_t size);
+	char* reserveOutput(std::size_t& size);
+	void publishOutput(std::size_t size);
+	void waitUntilAvailable(std::uint64_t end) const;
+
+private:
+	/// Path to the compressed file.
+	std::string path;
+
+	/// The compressed file.
+	std::ifstream input;
+
+	/// Compression format of the file.
+	Format format;
+
+	/// Chunks holding the decompressed bytes (each of @c ChunkSize bytes).
+	std::vector<std::unique_ptr<char[]>> chunks;
+
+	/// Number of decompressed bytes available for reading.
+	std::uint64_t availableSize = 0;
+
+	/// Has the decompression finished (successfully or not)?
+	bool finished = false;
+
+	/// Description of the error that stopped the decompression (if any).
+	std::string error;
+
+	/// Mutex guarding @c chunks, @c availableSize, @c finished, and @c error.
+	mutable std::mutex mutex;
+
+	/// Signals that more bytes are available or that the decompression has
+	/// finished.
+	mutable std::condition_variable availableChanged;
+
+	/// Should the decompression stop (because the source is being destroyed)?
+	std::atomic<bool> stopRequested{false};
+
+	/// Thread running the decompression.
+	std::thread decompressor;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,53 @@
+///
+/// @file      ar/internal/byte_sources/file_descriptor_byte_source.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Source of bytes read from a file descriptor.
+///
+
+#ifndef AR_INTERNAL_BYTE_SOURCES_FILE_DESCRIPTOR_BYTE_SOURCE_H
+#define AR_INTERNAL_BYTE_SOURCES_FILE_DESCRIPTOR_BYTE_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "ar/byte_source.h"
+#include "ar/internal/utilities/os.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Source of bytes read from a file descriptor by positioned reads.
+///
+/// Nothing is held in memory; every read goes to the file. The descriptor is
+/// not owned by the source, so it has to stay open while the source exists.
+///
+class FileDescriptorByteSource: public ByteSource {
+public:
+	explicit FileDescriptorByteSource(int fd);
+	virtual ~FileDescriptorByteSource() override;
+
+	virtual std::uint64_t size() const override;
+	virtual std::size_t readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const override;
+
+private:
+	/// The file descriptor.
+	int fd;
+
+	/// Size of the file.
+	std::uint64_t fileSize;
+
+#ifdef AR_OS_WINDOWS
+	/// Mutex serializing the seeks and reads (Windows has no positioned
+	/// reads on file descriptors).
+	mutable std::mutex readMutex;
+#endif
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,44 @@
+///
+/// @file      ar/internal/byte_sources/mapped_file_byte_source.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Source of bytes of a file mapped into memory.
+///
+
+#ifndef AR_INTERNAL_BYTE_SOURCES_MAPPED_FILE_BYTE_SOURCE_H
+#define AR_INTERNAL_BYTE_SOURCES_MAPPED_FILE_BYTE_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ar/byte_source.h"
+#include "ar/internal/utilities/mapped_file.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Source of bytes of a file mapped into memory.
+///
+/// The file must not be modified while the source exists.
+///
+class MappedFileByteSource: public ByteSource {
+public:
+	explicit MappedFileByteSource(const std::string& path);
+	virtual ~MappedFileByteSource() override;
+
+	virtual std::uint64_t size() const override;
+	virtual std::size_t readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const override;
+	virtual const char* data() const noexcept override;
+
+private:
+	/// The mapped file.
+	MappedFile mappedFile;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
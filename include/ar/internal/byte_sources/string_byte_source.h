@@ -0,0 +1,41 @@
+///
+/// @file      ar/internal/byte_sources/string_byte_source.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Source of bytes stored in a string.
+///
+
+#ifndef AR_INTERNAL_BYTE_SOURCES_STRING_BYTE_SOURCE_H
+#define AR_INTERNAL_BYTE_SOURCES_STRING_BYTE_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ar/byte_source.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Source of bytes stored in a string.
+///
+class StringByteSource: public ByteSource {
+public:
+	explicit StringByteSource(std::string content);
+	virtual ~StringByteSource() override;
+
+	virtual std::uint64_t size() const override;
+	virtual std::size_t readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const override;
+	virtual const char* data() const noexcept override;
+
+private:
+	/// The bytes.
+	std::string content;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -9,25 +9,66 @@
 #define AR_INTERNAL_EXTRACTOR_H
 
 #include <cstddef>
-#include <map>
+#include <cstdint>
+#include <functional>
+#include <system_error>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ar/extraction.h"
+#include "ar/internal/archive_buffer.h"
+#include "ar/internal/member.h"
+#include "ar/internal/utilities/stats_recorder.h"
+#include "ar/member_table.h"
 
 namespace ar {
 
+class ByteSource;
 class Files;
 
 namespace internal {
 
+class ThreadPool;
+
 ///
 /// %Extractor of files from an archive.
 ///
 class Extractor {
+public:
+	/// Function called for every member found by scan().
+	using MemberHandler = std::function<void (Member&&)>;
+
 public:
 	Extractor();
 	~Extractor();
 
-	Files extract(const std::string& archiveContent);
+	Files extract(std::string archiveContent);
+	Files extract(std::string archiveContent,
+		const ExtractionOptions& options);
+	Files extract(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options);
+	Members scan(std::string archiveContent);
+	Members scan(std::string archiveContent,
+		const ExtractionOptions& options);
+	Members scan(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options);
+	void scan(std::string archiveContent, const MemberHandler& handler);
+	void scan(std::shared_ptr<const ArchiveBuffer> archive,
+		const MemberHandler& handler);
+	void scan(std::shared_ptr<const ByteSource> source,
+		const MemberHandler& handler);
+	MemberTable scanIntoTable(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options);
+	MemberTable scanIntoTable(std::shared_ptr<const ByteSource> source,
+		const ExtractionOptions& options);
+
+	std::string_view getArchiveContent() const noexcept;
+
+	void reset() noexcept;
 
 	/// @name Disabled
 	/// @{
@@ -38,11 +79,18 @@ public:
 	/// @}
 
 private:
-	/// Mapping of an index into a file name.
-	using FileNameTable = std::map<std::size_t, std::string>;
+	/// Mapping of an index into a file name, sorted by the index.
+	///
+	/// The names are views into the content of the archive.
+	using FileNameTable = std::vector<std::pair<std::size_t, std::string_view>>;
 
 private:
-	void initializeWith(const std::string& archiveContent);
+	ThreadPool* poolFor(const ExtractionOptions& options);
+
+	void initializeWith(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options);
+	void scanUsing(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options, ThreadPool* pool, Members& members);
 
 	/// @name Reading
 	/// @{
@@ -51,19 +99,56 @@ private:
 	bool hasLookupTableAt(std::size_t i) const;
 	void readFileNameTable();
 	void readFileNameIntoFileNameTable(std::size_t startOfTable);
-	Files readFiles();
-	std::unique_ptr<File> readFile();
+	void readHeadersBeforeMembers();
+	void readMembers(Members& members);
+	void readMembers(const MemberHandler& handler);
+	bool readMembersSpeculatively(ThreadPool* pool, Members& members);
+	bool readMemberNameAt(std::size_t offset, std::string& name) const;
+	Member readMember();
 	std::string readFileName();
 	bool hasNameSpecifiedViaIndexIntoFileNameTableAt(std::size_t j) const;
-	std::string readFileNameEndedWithSlash();
+	std::string_view readFileNameEndedWithSlash();
 	std::string nameFromFileNameTableOnIndex(std::size_t index) const;
-	void readFileTimestamp();
-	void readFileOwnerId();
-	void readFileGroupId();
-	void readFileMode();
+	FileNameTable::const_iterator findInFileNameTable(std::size_t index) const;
+	bool readMemberMetadataAt(std::size_t offset, Member& member) const;
+	std::size_t readFileTimestamp();
+	std::size_t readFileOwnerId();
+	std::size_t readFileGroupId();
+	std::size_t readFileMode();
 	std::size_t readFileSize();
 	void readUntilEndOfFileHeader();
-	std::string readFileContent(std::size_t fileSize);
+	void skipFileContent(std::size_t fileSize);
+	void skipFileContentPadding(std::size_t fileSize);
+	/// @}
+
+	/// @name Reading From Sources
+	/// @{
+	void readSourceMembers(const ByteSource& source,
+		const MemberHandler& handler);
+	bool readSourceHeaderAt(const ByteSource& source, std::uint64_t offset,
+		std::size_t& size);
+	void ensureSourceContains(const ByteSource& source, std::uint64_t offset,
+		std::size_t size);
+	void readSourceFileNameTable(const ByteSource& source,
+		std::uint64_t offset, std::size_t tableSize);
+	std::uint32_t computeSourceChecksum(const ByteSource& source,
+		const Member& member);
+	/// @}
+
+	/// @name Materialization
+	/// @{
+	void expandNestedArchives(Members& members, ThreadPool* pool);
+	Files materialize(Members& members, ThreadPool* pool);
+	Files materializeWithinBudget(Members& members, std::size_t memoryBudget,
+		ThreadPool* pool);
+	Files createFiles(std::size_t count) const;
+	template <typename FileType, typename... Args>
+	std::unique_ptr<File> createFile(Args&&... args) const;
+	Files materializeSerially(Members& members);
+	Files materializeInParallel(Members& members, ThreadPool& pool);
+	Files materializeAsArchiveMembers(Members& members);
+	void appendToTable(MemberTable& table, const Member& member) const;
+	/// @}
 
 	/// @name Utilities
 	/// @{
@@ -72,31 +157,64 @@ private:
 	void skipSpaces();
 	void skipEndsOfLines();
 	void skipSuccessiveChars(char c);
-	std::size_t readNumber(const std::string& name);
+	std::size_t readNumber(std::string_view name);
 	/// @}
 
 	/// @name Validation
 	/// @{
-	void ensureFileNameIsNonEmpty(const std::string& fileName) const;
+	void ensureFileNameIsNonEmpty(std::string_view fileName) const;
 	void ensureIsValidFileNameTableIndex(FileNameTable::const_iterator it,
 		std::size_t index) const;
 	void ensureContainsSlashOnPosition(std::string::size_type pos) const;
 	void ensureContainsFileHeaderOnPosition(std::string::size_type pos) const;
 	void ensureContentOfGivenSizeWasRead(std::size_t readContentSize,
 		std::size_t expectedContentSize) const;
-	void ensureNumberWasRead(const std::string& numAsStr,
-		const std::string& name) const;
+	void ensureNumberWasRead(std::string_view numAsStr,
+		std::string_view name) const;
+	void ensureNumberIsInRange(std::errc parseResult,
+		std::string_view numAsStr, std::string_view name) const;
 	/// @}
 
 private:
+	/// The archive being extracted.
+	std::shared_ptr<const ArchiveBuffer> archive;
+
 	/// Content of the archive.
-	std::string content;
+	std::string_view content;
 
 	/// Current index to @c content.
 	std::size_t i;
 
 	/// Table containing names of files.
 	FileNameTable fileNameTable;
+
+	/// Header of a member read from a source.
+	std::string sourceHeader;
+
+	/// Header and content of the filename table read from a source (the
+	/// names in @c fileNameTable refer to it).
+	std::string sourceFileNameTable;
+
+	/// Chunk of the content of a member read from a source.
+	std::string sourceChunk;
+
+	/// Compute checksums of the content of members?
+	bool checksumsEnabled;
+
+	/// Recorder of statistics about the current extraction.
+	StatsRecorder stats;
+
+	/// Resource from which the extracted files are allocated (the null
+	/// pointer means the heap).
+	std::pmr::memory_resource* memoryResource;
+
+	/// Members of the archive being extracted (kept between extractions to
+	/// retain the capacity).
+	Members scannedMembers;
+
+	/// Pool of threads (kept between extractions to avoid recreating the
+	/// threads).
+	std::unique_ptr<ThreadPool> pool;
 };
 
 } // namespace internal
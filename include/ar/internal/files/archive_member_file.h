@@ -0,0 +1,59 @@
+///
+/// @file      ar/internal/files/archive_member_file.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     File referring to its content in an archive.
+///
+
+#ifndef AR_INTERNAL_FILES_ARCHIVE_MEMBER_FILE_H
+#define AR_INTERNAL_FILES_ARCHIVE_MEMBER_FILE_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "ar/file.h"
+#include "ar/internal/archive_buffer.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// File referring to its content in an archive.
+///
+/// The content is not copied. Instead, the file shares the buffer of the
+/// archive, which stays alive for as long as any of its files exists.
+///
+class ArchiveMemberFile: public File {
+public:
+	ArchiveMemberFile(std::shared_ptr<const ArchiveBuffer> archive,
+		std::size_t offset, std::size_t size, std::string_view name,
+		std::pmr::memory_resource* resource =
+			std::pmr::new_delete_resource());
+	virtual ~ArchiveMemberFile() override;
+
+	virtual std::string getName() const override;
+	virtual std::string getContent() override;
+	virtual std::string_view getNameView() const override;
+	virtual std::string_view getContentView() override;
+	virtual void saveCopyTo(const std::string& directoryPath) override;
+	virtual void saveCopyTo(const std::string& directoryPath,
+		const std::string& name) override;
+
+private:
+	/// The archive containing the content.
+	std::shared_ptr<const ArchiveBuffer> archive;
+
+	/// Content of the file.
+	std::string_view content;
+
+	/// File name.
+	std::pmr::string name;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,72 @@
+///
+/// @file      ar/internal/files/byte_source_range_file.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     File stored in a range of a source of bytes.
+///
+
+#ifndef AR_INTERNAL_FILES_BYTE_SOURCE_RANGE_FILE_H
+#define AR_INTERNAL_FILES_BYTE_SOURCE_RANGE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "ar/byte_source.h"
+#include "ar/file.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// File stored in a range of a source of bytes.
+///
+/// When the bytes of the source are in memory, the content is viewed without
+/// copying. Otherwise, it is read from the source whenever it is needed, and
+/// in chunks when the file is processed chunk by chunk or saved.
+///
+class ByteSourceRangeFile: public File {
+public:
+	ByteSourceRangeFile(std::shared_ptr<const ByteSource> source,
+		std::uint64_t offset, std::size_t size, std::string name);
+	virtual ~ByteSourceRangeFile() override;
+
+	virtual std::string getName() const override;
+	virtual std::string getContent() override;
+	virtual std::string_view getNameView() const override;
+	virtual std::string_view getContentView() override;
+	virtual void forEachChunk(std::size_t chunkSize,
+		const ChunkCallback& callback) override;
+	virtual std::size_t readContentAt(std::size_t offset, char* buffer,
+		std::size_t size) override;
+	virtual void saveCopyTo(const std::string& directoryPath) override;
+	virtual void saveCopyTo(const std::string& directoryPath,
+		const std::string& name) override;
+
+private:
+	std::string readRange() const;
+
+private:
+	/// Source containing the content.
+	std::shared_ptr<const ByteSource> source;
+
+	/// Offset of the content in the source.
+	std::uint64_t offset;
+
+	/// Size of the content.
+	std::size_t size;
+
+	/// File name.
+	std::string name;
+
+	/// Content read by getContentView() (if any).
+	std::optional<std::string> readContent;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -8,7 +8,9 @@
 #ifndef AR_INTERNAL_FILES_FILESYSTEM_FILE_H
 #define AR_INTERNAL_FILES_FILESYSTEM_FILE_H
 
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "ar/file.h"
 
@@ -26,16 +28,27 @@ public:
 
 	virtual std::string getName() const override;
 	virtual std::string getContent() override;
+	virtual std::string_view getNameView() const override;
+	virtual std::string_view getContentView() override;
+	virtual void forEachChunk(std::size_t chunkSize,
+		const ChunkCallback& callback) override;
+	virtual std::size_t readContentAt(std::size_t offset, char* buffer,
+		std::size_t size) override;
 	virtual void saveCopyTo(const std::string& directoryPath) override;
 	virtual void saveCopyTo(const std::string& directoryPath,
 		const std::string& name) override;
 
+	const std::string& getPath() const noexcept;
+
 private:
 	/// Path to the file in a filesystem.
 	std::string path;
 
 	/// Name of the file to be used.
 	std::string name;
+
+	/// Content read by getContentView() (if any).
+	std::optional<std::string> readContent;
 };
 
 } // namespace internal
@@ -0,0 +1,65 @@
+///
+/// @file      ar/internal/files/filesystem_range_file.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     File stored in a range of another file in a filesystem.
+///
+
+#ifndef AR_INTERNAL_FILES_FILESYSTEM_RANGE_FILE_H
+#define AR_INTERNAL_FILES_FILESYSTEM_RANGE_FILE_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "ar/file.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// File stored in a range of another file in a filesystem.
+///
+/// The content is not kept in memory. It is read from the other file whenever
+/// it is needed, and copied in chunks when the file is saved.
+///
+class FilesystemRangeFile: public File {
+public:
+	FilesystemRangeFile(std::string path, std::size_t offset,
+		std::size_t size, std::string name);
+	virtual ~FilesystemRangeFile() override;
+
+	virtual std::string getName() const override;
+	virtual std::string getContent() override;
+	virtual std::string_view getNameView() const override;
+	virtual std::string_view getContentView() override;
+	virtual void forEachChunk(std::size_t chunkSize,
+		const ChunkCallback& callback) override;
+	virtual std::size_t readContentAt(std::size_t offset, char* buffer,
+		std::size_t size) override;
+	virtual void saveCopyTo(const std::string& directoryPath) override;
+	virtual void saveCopyTo(const std::string& directoryPath,
+		const std::string& name) override;
+
+private:
+	/// Path to the file containing the content.
+	std::string path;
+
+	/// Offset of the content in the file.
+	std::size_t offset;
+
+	/// Size of the content.
+	std::size_t size;
+
+	/// File name.
+	std::string name;
+
+	/// Content read by getContentView() (if any).
+	std::optional<std::string> readContent;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,49 @@
+///
+/// @file      ar/internal/files/pmr_string_file.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     File storing its content in a string from a memory resource.
+///
+
+#ifndef AR_INTERNAL_FILES_PMR_STRING_FILE_H
+#define AR_INTERNAL_FILES_PMR_STRING_FILE_H
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+#include "ar/file.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// File storing its content and name in strings allocated from a memory
+/// resource.
+///
+class PmrStringFile: public File {
+public:
+	PmrStringFile(std::string_view content, std::string_view name,
+		std::pmr::memory_resource* resource);
+	virtual ~PmrStringFile() override;
+
+	virtual std::string getName() const override;
+	virtual std::string getContent() override;
+	virtual std::string_view getNameView() const override;
+	virtual std::string_view getContentView() override;
+	virtual void saveCopyTo(const std::string& directoryPath) override;
+	virtual void saveCopyTo(const std::string& directoryPath,
+		const std::string& name) override;
+
+private:
+	/// File content.
+	std::pmr::string content;
+
+	/// File name.
+	std::pmr::string name;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
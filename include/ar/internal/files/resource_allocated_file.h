@@ -0,0 +1,56 @@
+///
+/// @file      ar/internal/files/resource_allocated_file.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     File allocated from a memory resource.
+///
+
+#ifndef AR_INTERNAL_FILES_RESOURCE_ALLOCATED_FILE_H
+#define AR_INTERNAL_FILES_RESOURCE_ALLOCATED_FILE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace ar {
+namespace internal {
+
+void* allocateFromResource(std::size_t size,
+	std::pmr::memory_resource* resource);
+void deallocateFromResource(void* ptr) noexcept;
+
+///
+/// File of the given type allocated from a memory resource.
+///
+/// Create it as <tt>new (resource) ResourceAllocatedFile<SomeFile>(...)</tt>.
+/// The file remembers the resource, so it can be deleted as usual (e.g. by
+/// @c std::unique_ptr<File>), which returns its memory to the resource. The
+/// resource has to outlive the file. Files of other types are allocated from
+/// the heap as usual.
+///
+template <typename FileType>
+class ResourceAllocatedFile: public FileType {
+public:
+	using FileType::FileType;
+
+	/// @name Allocation
+	/// @{
+	static void* operator new(std::size_t size,
+			std::pmr::memory_resource* resource) {
+		return allocateFromResource(size, resource);
+	}
+
+	static void operator delete(void* ptr) noexcept {
+		deallocateFromResource(ptr);
+	}
+
+	static void operator delete(void* ptr,
+			std::pmr::memory_resource*) noexcept {
+		deallocateFromResource(ptr);
+	}
+	/// @}
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -9,6 +9,7 @@
 #define AR_INTERNAL_FILES_STRING_FILE_H
 
 #include <string>
+#include <string_view>
 
 #include "ar/file.h"
 
@@ -20,16 +21,20 @@ namespace internal {
 ///
 class StringFile: public File {
 public:
-	explicit StringFile(const std::string& content);
-	StringFile(const std::string& content, const std::string& name);
+	explicit StringFile(std::string content);
+	StringFile(std::string content, std::string name);
 	virtual ~StringFile() override;
 
 	virtual std::string getName() const override;
 	virtual std::string getContent() override;
+	virtual std::string_view getNameView() const override;
+	virtual std::string_view getContentView() override;
 	virtual void saveCopyTo(const std::string& directoryPath) override;
 	virtual void saveCopyTo(const std::string& directoryPath,
 		const std::string& name) override;
 
+	std::string takeContent() noexcept;
+
 private:
 	/// File content.
 	std::string content;
@@ -0,0 +1,54 @@
+///
+/// @file      ar/internal/member.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Description of a member of an archive.
+///
+
+#ifndef AR_INTERNAL_MEMBER_H
+#define AR_INTERNAL_MEMBER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ar {
+namespace internal {
+
+///
+/// Description of a member (file) of an archive, as obtained from its header.
+///
+struct Member {
+	/// Name of the member.
+	std::string name;
+
+	/// Offset of the member's content from the start of the archive.
+	std::size_t offset = 0;
+
+	/// Size of the member's content.
+	std::size_t size = 0;
+
+	/// Modification time (in seconds since the epoch).
+	std::size_t timestamp = 0;
+
+	/// ID of the owner.
+	std::size_t ownerId = 0;
+
+	/// ID of the group.
+	std::size_t groupId = 0;
+
+	/// File mode (permissions and file type).
+	std::size_t mode = 0;
+
+	/// CRC-32C checksum of the member's content (zero when not computed).
+	std::uint32_t checksum = 0;
+};
+
+/// Members of an archive, in the order in which they appear in the archive.
+using Members = std::vector<Member>;
+
+} // namespace internal
+} // namespace ar
+
+#endif
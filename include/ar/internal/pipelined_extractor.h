@@ -0,0 +1,84 @@
+///
+/// @file      ar/internal/pipelined_extractor.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     %Extractor overlapping the parsing of archives with writing.
+///
+
+#ifndef AR_INTERNAL_PIPELINED_EXTRACTOR_H
+#define AR_INTERNAL_PIPELINED_EXTRACTOR_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "ar/extraction.h"
+#include "ar/internal/archive_buffer.h"
+#include "ar/internal/extractor.h"
+#include "ar/internal/member.h"
+
+namespace ar {
+
+class ByteSource;
+
+namespace internal {
+
+///
+/// %Extractor overlapping the parsing of archives with writing of files.
+///
+/// The headers are parsed in the calling thread, which pushes descriptions of
+/// the found members into a bounded lock-free queue. Writer threads take the
+/// members from the queue and write them to disk.
+///
+/// An archive in a source whose bytes are not in memory is scanned as it is
+/// being read (see Extractor::scan()), and writers read the content of
+/// members from the source. When the source is being decompressed, the
+/// extraction thus takes about as long as the decompression.
+///
+class PipelinedExtractor {
+public:
+	explicit PipelinedExtractor(const ExtractionOptions& options);
+	~PipelinedExtractor();
+
+	ExtractionReport extractTo(std::string archiveContent,
+		const std::string& directoryPath);
+	ExtractionReport extractTo(std::shared_ptr<const ArchiveBuffer> archive,
+		const std::string& directoryPath);
+	ExtractionReport extractTo(std::shared_ptr<const ByteSource> source,
+		const std::string& directoryPath);
+
+	/// @name Disabled
+	/// @{
+	PipelinedExtractor(const PipelinedExtractor&) = delete;
+	PipelinedExtractor(PipelinedExtractor&&) = delete;
+	PipelinedExtractor& operator=(const PipelinedExtractor&) = delete;
+	PipelinedExtractor& operator=(PipelinedExtractor&&) = delete;
+	/// @}
+
+private:
+	/// Function scanning the archive and passing its members to the handler.
+	using Scanner = std::function<
+		void (Extractor& extractor, const Extractor::MemberHandler& handler)
+	>;
+
+	/// Function returning the content of the given member, possibly read into
+	/// the given buffer.
+	using ContentReader = std::function<
+		std::string_view (const Member& member, std::string& buffer)
+	>;
+
+private:
+	ExtractionReport extractUsing(const Scanner& scan,
+		const ContentReader& readContent, bool contentIsInArchive,
+		const std::string& directoryPath);
+
+private:
+	/// Options of the extraction.
+	const ExtractionOptions options;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,38 @@
+///
+/// @file      ar/internal/utilities/backoff.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Exponential backoff for threads waiting on lock-free structures.
+///
+
+#ifndef AR_INTERNAL_UTILITIES_BACKOFF_H
+#define AR_INTERNAL_UTILITIES_BACKOFF_H
+
+#include <cstddef>
+
+namespace ar {
+namespace internal {
+
+///
+/// Exponential backoff for threads waiting on lock-free structures.
+///
+/// The first few pauses only yield the processor. Subsequent pauses sleep for
+/// exponentially longer periods, up to a limit, so that a thread waiting for a
+/// slow producer or consumer does not burn a whole core.
+///
+class Backoff {
+public:
+	Backoff();
+
+	void pause();
+	void reset() noexcept;
+
+private:
+	/// Number of pauses since the last reset.
+	std::size_t pauseCount;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,200 @@
+///
+/// @file      ar/internal/utilities/bounded_queue.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Bounded lock-free queue.
+///
+
+#ifndef AR_INTERNAL_UTILITIES_BOUNDED_QUEUE_H
+#define AR_INTERNAL_UTILITIES_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace ar {
+namespace internal {
+
+///
+/// Bounded lock-free multi-producer multi-consumer queue.
+///
+/// The queue is an array of cells, each of which carries a sequence number
+/// telling whether the cell is ready to be written or read in the current lap
+/// around the array (the algorithm by Dmitry Vyukov). Neither pushing nor
+/// popping blocks; when the queue is full or empty, the operation fails and
+/// the caller decides how to wait.
+///
+template <typename T>
+class BoundedQueue {
+public:
+	explicit BoundedQueue(std::size_t capacity);
+
+	bool tryPush(T& value);
+	bool tryPop(T& value);
+
+	std::size_t getCapacity() const noexcept;
+	std::size_t getHighWaterMark() const noexcept;
+
+	/// @name Disabled
+	/// @{
+	BoundedQueue(const BoundedQueue&) = delete;
+	BoundedQueue(BoundedQueue&&) = delete;
+	BoundedQueue& operator=(const BoundedQueue&) = delete;
+	BoundedQueue& operator=(BoundedQueue&&) = delete;
+	/// @}
+
+private:
+	/// A cell of the queue.
+	struct Cell {
+		/// Sequence number of the cell.
+		std::atomic<std::size_t> sequence;
+
+		/// Value stored in the cell.
+		T value;
+	};
+
+	/// Size of a cache line, used to keep the positions apart.
+	static constexpr std::size_t CacheLineSize = 64;
+
+private:
+	void updateHighWaterMark(std::size_t pos) noexcept;
+
+private:
+	/// Cells of the queue.
+	std::unique_ptr<Cell[]> cells;
+
+	/// Number of cells minus one (the number of cells is a power of two).
+	std::size_t mask;
+
+	/// Padding to place @c enqueuePos into its own cache line.
+	char padding1[CacheLineSize];
+
+	/// Position of the next push.
+	std::atomic<std::size_t> enqueuePos;
+
+	/// Padding to place @c dequeuePos into its own cache line.
+	char padding2[CacheLineSize];
+
+	/// Position of the next pop.
+	std::atomic<std::size_t> dequeuePos;
+
+	/// Padding to place @c highWaterMark into its own cache line.
+	char padding3[CacheLineSize];
+
+	/// The largest number of values observed in the queue.
+	std::atomic<std::size_t> highWaterMark;
+};
+
+///
+/// Creates a queue that can hold at least @a capacity values.
+///
+/// The capacity is rounded up to a power of two.
+///
+template <typename T>
+BoundedQueue<T>::BoundedQueue(std::size_t capacity):
+		mask(0), enqueuePos(0), dequeuePos(0), highWaterMark(0) {
+	std::size_t cellCount = 2;
+	while (cellCount < capacity) {
+		cellCount *= 2;
+	}
+
+	cells = std::make_unique<Cell[]>(cellCount);
+	mask = cellCount - 1;
+	for (std::size_t j = 0; j < cellCount; ++j) {
+		cells[j].sequence.store(j, std::memory_order_relaxed);
+	}
+}
+
+///
+/// Moves the given value into the queue.
+///
+/// @return @c true when the value has been pushed, @c false when the queue is
+///         full (in which case @a value is left untouched).
+///
+template <typename T>
+bool BoundedQueue<T>::tryPush(T& value) {
+	auto pos = enqueuePos.load(std::memory_order_relaxed);
+	for (;;) {
+		auto& cell = cells[pos & mask];
+		const auto sequence = cell.sequence.load(std::memory_order_acquire);
+		const auto difference = static_cast<std::ptrdiff_t>(sequence - pos);
+		if (difference == 0) {
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+					std::memory_order_relaxed)) {
+				cell.value = std::move(value);
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				updateHighWaterMark(pos + 1);
+				return true;
+			}
+		} else if (difference < 0) {
+			return false;
+		} else {
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+///
+/// Moves the oldest value in the queue into @a value.
+///
+/// @return @c true when a value has been popped, @c false when the queue is
+///         empty.
+///
+template <typename T>
+bool BoundedQueue<T>::tryPop(T& value) {
+	auto pos = dequeuePos.load(std::memory_order_relaxed);
+	for (;;) {
+		auto& cell = cells[pos & mask];
+		const auto sequence = cell.sequence.load(std::memory_order_acquire);
+		const auto difference =
+			static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+		if (difference == 0) {
+			if (dequeuePos.compare_exchange_weak(pos, pos + 1,
+					std::memory_order_relaxed)) {
+				value = std::move(cell.value);
+				cell.sequence.store(pos + mask + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (difference < 0) {
+			return false;
+		} else {
+			pos = dequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+///
+/// Returns the maximal number of values the queue can hold.
+///
+template <typename T>
+std::size_t BoundedQueue<T>::getCapacity() const noexcept {
+	return mask + 1;
+}
+
+///
+/// Returns the largest number of values that were in the queue at once.
+///
+/// As the queue is lock-free, the value is only approximate when there are
+/// concurrent consumers.
+///
+template <typename T>
+std::size_t BoundedQueue<T>::getHighWaterMark() const noexcept {
+	return highWaterMark.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void BoundedQueue<T>::updateHighWaterMark(std::size_t pos) noexcept {
+	const auto popped = dequeuePos.load(std::memory_order_relaxed);
+	const auto size = pos > popped ? pos - popped : 0;
+	auto mark = highWaterMark.load(std::memory_order_relaxed);
+	while (size > mark && !highWaterMark.compare_exchange_weak(mark, size,
+			std::memory_order_relaxed)) {
+		// Retry with the updated mark.
+	}
+}
+
+} // namespace internal
+} // namespace ar
+
+#endif
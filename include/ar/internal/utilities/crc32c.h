@@ -0,0 +1,30 @@
+///
+/// @file      ar/internal/utilities/crc32c.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     CRC-32C checksums.
+///
+
+#ifndef AR_INTERNAL_UTILITIES_CRC32C_H
+#define AR_INTERNAL_UTILITIES_CRC32C_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace ar {
+namespace internal {
+
+/// @name CRC-32C
+/// @{
+
+std::uint32_t crc32c(std::string_view data, std::uint32_t crc = 0) noexcept;
+std::uint32_t crc32cInSoftware(std::string_view data,
+	std::uint32_t crc = 0) noexcept;
+bool crc32cUsesHardware() noexcept;
+
+/// @}
+
+} // namespace internal
+} // namespace ar
+
+#endif
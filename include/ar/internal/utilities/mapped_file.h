@@ -0,0 +1,56 @@
+///
+/// @file      ar/internal/utilities/mapped_file.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     File mapped into memory.
+///
+
+#ifndef AR_INTERNAL_UTILITIES_MAPPED_FILE_H
+#define AR_INTERNAL_UTILITIES_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace ar {
+namespace internal {
+
+///
+/// Read-only file mapped into memory.
+///
+/// The pages of the file are loaded on demand and, as they are backed by the
+/// file, the system can drop them whenever it runs short of memory. On systems
+/// without memory mapping, the file is read into memory instead.
+///
+class MappedFile {
+public:
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+
+	const char* getData() const noexcept;
+	std::size_t getSize() const noexcept;
+
+	void release(std::size_t offset, std::size_t size) const noexcept;
+
+	/// @name Disabled
+	/// @{
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+	/// @}
+
+private:
+	/// Start of the mapped content.
+	const char* data;
+
+	/// Size of the mapped content.
+	std::size_t size;
+
+	/// Content of the file when it cannot be mapped.
+	std::string readContent;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
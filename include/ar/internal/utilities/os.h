@@ -8,7 +8,12 @@
 #ifndef AR_INTERNAL_UTILITIES_OS_H
 #define AR_INTERNAL_UTILITIES_OS_H
 
+#include <cstddef>
+#include <ctime>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // Are we on Windows?
 #if defined(_WIN32) || defined(_WIN64) || defined(__WIN32__) \
@@ -19,14 +24,55 @@
 namespace ar {
 namespace internal {
 
+///
+/// A range of a file to be copied into another file.
+///
+struct FileRangeCopy {
+	/// Offset of the range in the source file.
+	std::size_t srcOffset;
+
+	/// Offset to which the range is copied in the destination file.
+	std::size_t dstOffset;
+
+	/// Size of the range.
+	std::size_t size;
+};
+
 /// @name Operating System
 /// @{
 
 std::string fileNameFromPath(const std::string& path);
 std::string readFile(const std::string& path);
+void readFileInto(const std::string& path, std::string& content);
+std::string readFileRange(const std::string& path, std::size_t offset,
+	std::size_t size);
+std::size_t readFileRangeInto(const std::string& path, std::size_t offset,
+	char* buffer, std::size_t size);
+void readFileRangeInChunks(const std::string& path, std::size_t offset,
+	std::size_t size, std::size_t chunkSize,
+	const std::function<void (std::string_view)>& callback);
 void writeFile(const std::string& path, const std::string& content);
+void writeFile(const std::string& path, const char* content, std::size_t size);
 void copyFile(const std::string& srcPath, const std::string& dstPath);
+void copyFileRange(const std::string& srcPath, std::size_t offset,
+	std::size_t size, const std::string& dstPath);
+void copyFileRanges(const std::string& srcPath, const std::string& dstPath,
+	const std::vector<FileRangeCopy>& ranges);
+void writeFileAt(const std::string& path, std::size_t offset,
+	const char* content, std::size_t size);
+void moveFileRange(const std::string& path, std::size_t srcOffset,
+	std::size_t dstOffset, std::size_t size);
+void resizeFile(const std::string& path, std::size_t size);
 std::string joinPaths(const std::string& path1, const std::string& path2);
+bool getFileSizeAndModificationTime(const std::string& path, std::size_t& size,
+	std::time_t& modificationTime);
+void setFileModificationTime(const std::string& path, std::time_t time);
+bool fileHasContent(const std::string& path, const char* content,
+	std::size_t size);
+void createDirectory(const std::string& path);
+void removeFile(const std::string& path);
+bool createHardLink(const std::string& srcPath, const std::string& dstPath);
+bool cloneFile(const std::string& srcPath, const std::string& dstPath);
 
 /// @}
 
@@ -0,0 +1,191 @@
+///
+/// @file      ar/internal/utilities/stats_recorder.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Recording of statistics about extractions.
+///
+
+#ifndef AR_INTERNAL_UTILITIES_STATS_RECORDER_H
+#define AR_INTERNAL_UTILITIES_STATS_RECORDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "ar/extraction.h"
+#include "ar/memory_accounting.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Recorder of statistics about extractions into ExtractionStats.
+///
+/// The policy is chosen at compile time by @a Enabled. The enabled recorder
+/// adds to the statistics it has been given (nothing is recorded when it has
+/// been given the null pointer). The disabled recorder does nothing, so its
+/// calls are compiled away. The library uses StatsRecorder, which is enabled
+/// unless the library is built without statistics (@c -DAR_STATS=OFF).
+///
+/// The recorder is not thread-safe. Counts from parallel parts of the
+/// extraction are recorded by the calling thread.
+///
+template <bool Enabled>
+class BasicStatsRecorder {
+public:
+	/// Duration of a phase of the extraction (and the memory used in it),
+	/// recorded when the phase goes out of scope.
+	class Phase {
+	public:
+		Phase(ExtractionStats* stats,
+				std::chrono::nanoseconds ExtractionStats::* time,
+				MemoryUsage ExtractionStats::* memory) noexcept:
+				stats(stats), time(time), memory(memory),
+				counter(stats ? getMemoryCounter() : nullptr),
+				start(stats ? Clock::now() : Clock::time_point()) {
+			if (counter) {
+				startUsage = counter->getUsage();
+				previousPeak = counter->resetPeak();
+			}
+		}
+
+		~Phase() {
+			if (stats) {
+				stats->*time += std::chrono::duration_cast<
+					std::chrono::nanoseconds>(Clock::now() - start);
+			}
+			if (counter) {
+				const auto usage = counter->getUsage();
+				auto& phaseUsage = stats->*memory;
+				phaseUsage.allocations +=
+					usage.allocations - startUsage.allocations;
+				phaseUsage.allocatedBytes +=
+					usage.allocatedBytes - startUsage.allocatedBytes;
+				phaseUsage.heldBytes = usage.heldBytes;
+				if (usage.peakHeldBytes > phaseUsage.peakHeldBytes) {
+					phaseUsage.peakHeldBytes = usage.peakHeldBytes;
+				}
+				counter->raisePeak(previousPeak);
+			}
+		}
+
+		/// @name Disabled
+		/// @{
+		Phase(const Phase&) = delete;
+		Phase& operator=(const Phase&) = delete;
+		/// @}
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+	private:
+		/// Statistics into which the duration is added.
+		ExtractionStats* stats;
+
+		/// The field of @c stats into which the duration is added.
+		std::chrono::nanoseconds ExtractionStats::* time;
+
+		/// The field of @c stats into which the used memory is added.
+		MemoryUsage ExtractionStats::* memory;
+
+		/// Counter of memory registered by setMemoryCounter() (the null
+		/// pointer when there is none or when nothing is recorded).
+		MemoryCounter* counter;
+
+		/// Start of the phase.
+		Clock::time_point start;
+
+		/// Usage of memory at the start of the phase.
+		MemoryUsage startUsage;
+
+		/// Peak of the counter before the start of the phase.
+		std::uint64_t previousPeak = 0;
+	};
+
+public:
+	explicit BasicStatsRecorder(ExtractionStats* stats = nullptr) noexcept:
+			stats(stats) {
+		if (stats) {
+			stats->collected = true;
+		}
+	}
+
+	/// Are the statistics being recorded?
+	bool isRecording() const noexcept { return stats != nullptr; }
+
+	/// Starts a phase whose duration and used memory are added to the given
+	/// fields.
+	Phase startPhase(std::chrono::nanoseconds ExtractionStats::* time,
+			MemoryUsage ExtractionStats::* memory) const noexcept {
+		return Phase(stats, time, memory);
+	}
+
+	void addBytesRead(std::uint64_t count) noexcept {
+		if (stats) {
+			stats->bytesRead += count;
+		}
+	}
+
+	void addParsedHeaders(std::size_t count) noexcept {
+		if (stats) {
+			stats->headersParsed += count;
+		}
+	}
+
+	void addNameTableHits(std::size_t count) noexcept {
+		if (stats) {
+			stats->nameTableHits += count;
+		}
+	}
+
+	void addAllocations(std::size_t count) noexcept {
+		if (stats) {
+			stats->allocations += count;
+		}
+	}
+
+	void addBytesCopied(std::uint64_t count) noexcept {
+		if (stats) {
+			stats->bytesCopied += count;
+		}
+	}
+
+private:
+	/// Statistics to which the recorded values are added.
+	ExtractionStats* stats;
+};
+
+///
+/// Recorder that records nothing.
+///
+template <>
+class BasicStatsRecorder<false> {
+public:
+	/// A phase whose duration is not measured.
+	struct Phase {
+		~Phase() {}
+	};
+
+public:
+	explicit BasicStatsRecorder(ExtractionStats* = nullptr) noexcept {}
+
+	bool isRecording() const noexcept { return false; }
+	Phase startPhase(std::chrono::nanoseconds ExtractionStats::*,
+		MemoryUsage ExtractionStats::*) const noexcept { return Phase(); }
+	void addBytesRead(std::uint64_t) noexcept {}
+	void addParsedHeaders(std::size_t) noexcept {}
+	void addNameTableHits(std::size_t) noexcept {}
+	void addAllocations(std::size_t) noexcept {}
+	void addBytesCopied(std::uint64_t) noexcept {}
+};
+
+#ifdef AR_STATS
+using StatsRecorder = BasicStatsRecorder<true>;
+#else
+using StatsRecorder = BasicStatsRecorder<false>;
+#endif
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,111 @@
+///
+/// @file      ar/internal/utilities/thread_pool.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Work-stealing thread pool.
+///
+
+#ifndef AR_INTERNAL_UTILITIES_THREAD_POOL_H
+#define AR_INTERNAL_UTILITIES_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ar {
+namespace internal {
+
+///
+/// Work-stealing thread pool.
+///
+/// Every worker has its own queue of tasks. A worker takes tasks from the back
+/// of its own queue and, when it runs out of work, steals tasks from the front
+/// of the queues of other workers. Tasks submitted from a worker thread are
+/// placed into the queue of that worker, so a task may split itself into
+/// smaller tasks that idle workers then steal.
+///
+/// The thread calling wait() runs tasks as well, so a pool used by @c N
+/// threads is created with <tt>N - 1</tt> workers (see createPoolForCaller()).
+///
+class ThreadPool {
+public:
+	/// Task to be run by the pool.
+	using Task = std::function<void ()>;
+
+public:
+	explicit ThreadPool(std::size_t threadCount);
+	~ThreadPool();
+
+	void submit(Task task);
+	void wait();
+
+	std::size_t getThreadCount() const noexcept;
+
+	static std::size_t defaultThreadCount() noexcept;
+
+	/// @name Disabled
+	/// @{
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+	/// @}
+
+private:
+	/// Queue of tasks belonging to a single worker.
+	struct WorkerQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+private:
+	void workerLoop(std::size_t workerIndex);
+	bool tryRunTask(std::size_t preferredQueue);
+	bool tryPopTask(std::size_t queueIndex, Task& task, bool fromBack);
+	void runTask(Task& task);
+
+private:
+	/// Queues of the workers.
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+	/// Worker threads.
+	std::vector<std::thread> workers;
+
+	/// Number of tasks that have been submitted but not yet finished.
+	std::atomic<std::size_t> pendingTasks;
+
+	/// Number of tasks that are waiting in the queues.
+	std::atomic<std::size_t> queuedTasks;
+
+	/// Index of the queue into which the next external task is submitted.
+	std::atomic<std::size_t> nextQueue;
+
+	/// Should the workers terminate?
+	bool stopping;
+
+	/// Mutex guarding the sleeping of workers and waiters.
+	std::mutex sleepMutex;
+
+	/// Signalled when there is new work or when the pool stops.
+	std::condition_variable workAvailable;
+
+	/// Signalled when all pending tasks have finished.
+	std::condition_variable allTasksDone;
+
+	/// The first exception thrown by a task (if any).
+	std::exception_ptr firstException;
+};
+
+std::unique_ptr<ThreadPool> createPoolForCaller(std::size_t threadCount);
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,83 @@
+///
+/// @file      ar/internal/utilities/tracing.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Spans of traced operations.
+///
+
+#ifndef AR_INTERNAL_UTILITIES_TRACING_H
+#define AR_INTERNAL_UTILITIES_TRACING_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace ar {
+namespace internal {
+
+/// Is a trace being written? (see ar::startTracing())
+extern std::atomic<bool> tracingEnabled;
+
+void openTrace(const std::string& path);
+void closeTrace();
+std::uint64_t traceClockNow() noexcept;
+void recordTraceSpan(const char* name, std::string_view detail,
+	std::uint64_t start, std::uint64_t end);
+
+///
+/// A traced operation, which lasts from the creation of the span until its
+/// destruction.
+///
+/// When no trace is being written, creating a span costs a single relaxed
+/// load of a flag (and the initialization of an empty string), and nothing is
+/// recorded. Otherwise, the span is written into the trace as a complete
+/// event of the calling thread.
+///
+class TraceSpan {
+public:
+	///
+	/// Starts a span of the operation of the given name.
+	///
+	/// The name has to be a string literal. The optional @a detail (e.g. the
+	/// name of the processed file) is copied only when the span is traced.
+	///
+	explicit TraceSpan(const char* name, std::string_view detail = {}):
+			name(tracingEnabled.load(std::memory_order_relaxed)
+				? name : nullptr),
+			start(0) {
+		if (this->name) {
+			this->detail.assign(detail);
+			start = traceClockNow();
+		}
+	}
+
+	~TraceSpan() {
+		if (name) {
+			recordTraceSpan(name, detail, start, traceClockNow());
+		}
+	}
+
+	/// @name Disabled
+	/// @{
+	TraceSpan(const TraceSpan&) = delete;
+	TraceSpan(TraceSpan&&) = delete;
+	TraceSpan& operator=(const TraceSpan&) = delete;
+	TraceSpan& operator=(TraceSpan&&) = delete;
+	/// @}
+
+private:
+	/// Name of the operation (the null pointer when the span is not traced).
+	const char* name;
+
+	/// Detail of the operation.
+	std::string detail;
+
+	/// Start of the span (see traceClockNow()).
+	std::uint64_t start;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
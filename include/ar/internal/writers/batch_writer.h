@@ -0,0 +1,83 @@
+///
+/// @file      ar/internal/writers/batch_writer.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Base class and factory for writers of files in batches.
+///
+
+#ifndef AR_INTERNAL_WRITERS_BATCH_WRITER_H
+#define AR_INTERNAL_WRITERS_BATCH_WRITER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace ar {
+namespace internal {
+
+///
+/// Base class and factory for writers of files in batches.
+///
+/// Files to be written are collected and then written all at once, which
+/// allows the subclasses to amortize the cost of system calls over many files.
+///
+class BatchWriter {
+public:
+	virtual ~BatchWriter() = 0;
+
+	void write(std::string path, const char* content, std::size_t size);
+	void flush();
+
+	std::size_t getPendingCount() const noexcept;
+	virtual bool usesIoUring() const noexcept;
+
+	static std::unique_ptr<BatchWriter> create(std::size_t threadCount);
+
+	/// @name Disabled
+	/// @{
+	BatchWriter(const BatchWriter&) = delete;
+	BatchWriter(BatchWriter&&) = delete;
+	BatchWriter& operator=(const BatchWriter&) = delete;
+	BatchWriter& operator=(BatchWriter&&) = delete;
+	/// @}
+
+protected:
+	///
+	/// A file waiting to be written.
+	///
+	struct PendingWrite {
+		/// Path to the file.
+		std::string path;
+
+		/// Content of the file (owned by the caller).
+		const char* content;
+
+		/// Size of the content.
+		std::size_t size;
+	};
+
+	/// Files waiting to be written.
+	using PendingWrites = std::vector<PendingWrite>;
+
+protected:
+	explicit BatchWriter(std::size_t batchSize);
+
+	virtual void writeBatch(const PendingWrites& writes) = 0;
+
+private:
+	/// Number of files that are written at once.
+	std::size_t batchSize;
+
+	/// Files waiting to be written.
+	PendingWrites pendingWrites;
+
+	/// Paths of the files waiting to be written.
+	std::unordered_set<std::string> pendingPaths;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,52 @@
+///
+/// @file      ar/internal/writers/io_uring_batch_writer.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Writer of files in batches by using io_uring.
+///
+
+#ifndef AR_INTERNAL_WRITERS_IO_URING_BATCH_WRITER_H
+#define AR_INTERNAL_WRITERS_IO_URING_BATCH_WRITER_H
+
+#include <memory>
+
+#include "ar/internal/writers/batch_writer.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Writer of files in batches by using io_uring (Linux).
+///
+/// Instead of issuing the open/write/close triple of system calls for every
+/// file, the openat requests for a whole batch are submitted at once, followed
+/// by write requests for all the opened files and, once the files have been
+/// fully written, by close requests.
+///
+/// Use isSupported() to check whether the running kernel supports everything
+/// that is needed.
+///
+class IoUringBatchWriter: public BatchWriter {
+public:
+	IoUringBatchWriter();
+	virtual ~IoUringBatchWriter() override;
+
+	virtual bool usesIoUring() const noexcept override;
+
+	static bool isSupported();
+
+protected:
+	virtual void writeBatch(const PendingWrites& writes) override;
+
+private:
+	class Ring;
+
+private:
+	/// The submission and completion queues.
+	std::unique_ptr<Ring> ring;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,40 @@
+///
+/// @file      ar/internal/writers/thread_pool_batch_writer.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Writer of files in batches by using a pool of threads.
+///
+
+#ifndef AR_INTERNAL_WRITERS_THREAD_POOL_BATCH_WRITER_H
+#define AR_INTERNAL_WRITERS_THREAD_POOL_BATCH_WRITER_H
+
+#include <cstddef>
+#include <memory>
+
+#include "ar/internal/utilities/thread_pool.h"
+#include "ar/internal/writers/batch_writer.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Writer of files in batches by using a pool of threads.
+///
+class ThreadPoolBatchWriter: public BatchWriter {
+public:
+	explicit ThreadPoolBatchWriter(std::size_t threadCount);
+	virtual ~ThreadPoolBatchWriter() override;
+
+protected:
+	virtual void writeBatch(const PendingWrites& writes) override;
+
+private:
+	/// Threads writing the files together with the calling thread (null when
+	/// the files are written only in the calling thread).
+	std::unique_ptr<ThreadPool> pool;
+};
+
+} // namespace internal
+} // namespace ar
+
+#endif
@@ -0,0 +1,168 @@
+///
+/// @file      ar/member_table.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Table of members of an archive.
+///
+
+#ifndef AR_MEMBER_TABLE_H
+#define AR_MEMBER_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ar {
+
+class ByteSource;
+class Files;
+
+namespace internal {
+
+class ArchiveBuffer;
+class Extractor;
+
+} // namespace internal
+
+///
+/// Table of members of an archive, stored column by column.
+///
+/// Every column (names, offsets and sizes of the content, and the metadata from
+/// the headers) is stored in contiguous memory, so iterating over, filtering,
+/// or sorting large tables does not chase pointers. Members are accessed by
+/// their index, which follows the order of the archive (until the table is
+/// sorted).
+///
+/// The table refers to the archive it has been obtained from, so it can be
+/// converted into files without copying their content. When the archive has
+/// been scanned from a ByteSource whose bytes are not in memory, the content
+/// of members is read from the source only when it is asked for.
+///
+class MemberTable {
+public:
+	using size_type = std::size_t;
+
+	/// Index returned by find() when no member is found.
+	static constexpr size_type npos = static_cast<size_type>(-1);
+
+public:
+	MemberTable();
+	MemberTable(const MemberTable& other);
+	MemberTable(MemberTable&& other) noexcept;
+	~MemberTable();
+
+	MemberTable& operator=(const MemberTable& other);
+	MemberTable& operator=(MemberTable&& other) noexcept;
+
+	/// @name Capacity
+	/// @{
+	bool empty() const noexcept;
+	size_type size() const noexcept;
+	/// @}
+
+	/// @name Member Access
+	/// @{
+	std::string_view getName(size_type index) const;
+	std::uint64_t getOffset(size_type index) const;
+	std::uint64_t getSize(size_type index) const;
+	std::uint64_t getTimestamp(size_type index) const;
+	std::uint32_t getOwnerId(size_type index) const;
+	std::uint32_t getGroupId(size_type index) const;
+	std::uint32_t getMode(size_type index) const;
+	std::uint32_t getChecksum(size_type index) const;
+	/// @}
+
+	/// @name Content Access
+	/// @{
+	std::string_view getContentView(size_type index) const;
+	std::string_view readRange(size_type index, std::uint64_t offset,
+		std::uint64_t length) const;
+	void readRange(size_type index, std::uint64_t offset,
+		std::uint64_t length, char* buffer) const;
+	bool isContentInMemory() const noexcept;
+	/// @}
+
+	/// @name Columns
+	/// @{
+	const std::vector<std::uint64_t>& getOffsets() const noexcept;
+	const std::vector<std::uint64_t>& getSizes() const noexcept;
+	const std::vector<std::uint64_t>& getTimestamps() const noexcept;
+	const std::vector<std::uint32_t>& getOwnerIds() const noexcept;
+	const std::vector<std::uint32_t>& getGroupIds() const noexcept;
+	const std::vector<std::uint32_t>& getModes() const noexcept;
+	const std::vector<std::uint32_t>& getChecksums() const noexcept;
+	bool hasChecksums() const noexcept;
+	/// @}
+
+	/// @name Lookup
+	/// @{
+	size_type find(std::string_view name) const noexcept;
+	/// @}
+
+	/// @name Modifiers
+	/// @{
+	void sortByName();
+	/// @}
+
+	/// @name Conversions
+	/// @{
+	Files toFiles() const;
+	/// @}
+
+private:
+	friend class internal::Extractor;
+
+private:
+	void reserve(size_type count);
+	void append(std::string_view name, std::uint64_t offset,
+		std::uint64_t size, std::uint64_t timestamp, std::uint32_t ownerId,
+		std::uint32_t groupId, std::uint32_t mode);
+	void appendChecksum(std::uint32_t checksum);
+	void setArchive(std::shared_ptr<const internal::ArchiveBuffer> archive);
+	void setSource(std::shared_ptr<const ByteSource> source);
+	void ensureIsValidRange(size_type index, std::uint64_t offset,
+		std::uint64_t length) const;
+
+private:
+	/// The archive containing the members (when its content is in memory).
+	std::shared_ptr<const internal::ArchiveBuffer> archive;
+
+	/// Source of the archive containing the members (when the content of the
+	/// archive is not in memory).
+	std::shared_ptr<const ByteSource> source;
+
+	/// Names of all members, one right after another.
+	std::string names;
+
+	/// End of the name of every member in @c names.
+	std::vector<std::size_t> nameEnds;
+
+	/// Offsets of the content of members from the start of the archive.
+	std::vector<std::uint64_t> offsets;
+
+	/// Sizes of the content of members.
+	std::vector<std::uint64_t> sizes;
+
+	/// Modification times of members (in seconds since the epoch).
+	std::vector<std::uint64_t> timestamps;
+
+	/// IDs of the owners of members.
+	std::vector<std::uint32_t> ownerIds;
+
+	/// IDs of the groups of members.
+	std::vector<std::uint32_t> groupIds;
+
+	/// File modes of members.
+	std::vector<std::uint32_t> modes;
+
+	/// CRC-32C checksums of the content of members (empty when they have not
+	/// been computed).
+	std::vector<std::uint32_t> checksums;
+};
+
+} // namespace ar
+
+#endif
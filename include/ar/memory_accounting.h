@@ -0,0 +1,115 @@
+///
+/// @file      ar/memory_accounting.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Accounting of allocated memory.
+///
+
+#ifndef AR_MEMORY_ACCOUNTING_H
+#define AR_MEMORY_ACCOUNTING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace ar {
+
+///
+/// Usage of memory counted by a MemoryCounter.
+///
+struct MemoryUsage {
+	/// Number of allocations.
+	std::size_t allocations = 0;
+
+	/// Total number of allocated bytes (including the freed ones).
+	std::uint64_t allocatedBytes = 0;
+
+	/// Number of bytes that are held (allocated and not yet freed).
+	std::uint64_t heldBytes = 0;
+
+	/// The largest number of bytes that have been held at once.
+	std::uint64_t peakHeldBytes = 0;
+};
+
+///
+/// Thread-safe counter of allocated and freed memory.
+///
+/// The counter only counts what it is told. It is fed either by
+/// CountingMemoryResource or by a replacement of the global operator new and
+/// delete (see the @c ar-info tool). When it is registered by
+/// setMemoryCounter(), the extraction statistics record the memory used in
+/// each phase of an extraction (see ExtractionStats).
+///
+class MemoryCounter {
+public:
+	MemoryCounter() = default;
+
+	void recordAllocation(std::size_t size) noexcept;
+	void recordDeallocation(std::size_t size) noexcept;
+
+	MemoryUsage getUsage() const noexcept;
+
+	std::uint64_t resetPeak() noexcept;
+	void raisePeak(std::uint64_t bytes) noexcept;
+
+	/// @name Disabled
+	/// @{
+	MemoryCounter(const MemoryCounter&) = delete;
+	MemoryCounter& operator=(const MemoryCounter&) = delete;
+	/// @}
+
+private:
+	/// Counts of the usage (see MemoryUsage).
+	/// @{
+	std::atomic<std::size_t> allocations{0};
+	std::atomic<std::uint64_t> allocatedBytes{0};
+	std::atomic<std::uint64_t> heldBytes{0};
+	std::atomic<std::uint64_t> peakHeldBytes{0};
+	/// @}
+};
+
+///
+/// Memory resource that counts the memory allocated from another resource.
+///
+/// Pass it as ExtractionOptions::memoryResource to count the memory held by
+/// the extracted files.
+///
+class CountingMemoryResource: public std::pmr::memory_resource {
+public:
+	CountingMemoryResource() noexcept;
+	explicit CountingMemoryResource(
+		std::pmr::memory_resource* upstream) noexcept;
+
+	std::pmr::memory_resource* getUpstream() const noexcept;
+	MemoryCounter& getCounter() noexcept;
+	MemoryUsage getUsage() const noexcept;
+
+	/// @name Disabled
+	/// @{
+	CountingMemoryResource(const CountingMemoryResource&) = delete;
+	CountingMemoryResource& operator=(
+		const CountingMemoryResource&) = delete;
+	/// @}
+
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+	void do_deallocate(void* p, std::size_t bytes,
+		std::size_t alignment) override;
+	bool do_is_equal(
+		const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+	/// Resource from which the memory is allocated.
+	std::pmr::memory_resource* upstream;
+
+	/// Counter of the allocated memory.
+	MemoryCounter counter;
+};
+
+void setMemoryCounter(MemoryCounter* counter) noexcept;
+MemoryCounter* getMemoryCounter() noexcept;
+
+} // namespace ar
+
+#endif
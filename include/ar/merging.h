@@ -0,0 +1,54 @@
+///
+/// @file      ar/merging.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Merging of archives.
+///
+
+#ifndef AR_MERGING_H
+#define AR_MERGING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ar {
+
+///
+/// Options controlling the merging of archives.
+///
+struct MergeOptions {
+	/// Store the combined symbol table in the merged archive?
+	///
+	/// When disabled, the merged archive has no symbol table (like archives
+	/// created by <tt>ar S</tt>), and the symbol tables of the merged
+	/// archives are not read.
+	bool symbolTable = true;
+};
+
+///
+/// Report about a merging of archives.
+///
+struct MergeReport {
+	/// Number of members in the merged archive.
+	std::size_t memberCount = 0;
+
+	/// Number of symbols in the symbol table of the merged archive.
+	std::size_t symbolCount = 0;
+
+	/// Total size of the content of the members.
+	std::uint64_t contentSize = 0;
+
+	/// Size of the merged archive.
+	std::uint64_t archiveSize = 0;
+};
+
+MergeReport mergeArchives(const std::vector<std::string>& archivePaths,
+	const std::string& outputPath);
+MergeReport mergeArchives(const std::vector<std::string>& archivePaths,
+	const std::string& outputPath, const MergeOptions& options);
+
+} // namespace ar
+
+#endif
@@ -0,0 +1,21 @@
+///
+/// @file      ar/tracing.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tracing of operations of the library.
+///
+
+#ifndef AR_TRACING_H
+#define AR_TRACING_H
+
+#include <string>
+
+namespace ar {
+
+void startTracing(const std::string& tracePath);
+void stopTracing();
+bool isTracing() noexcept;
+
+} // namespace ar
+
+#endif
@@ -0,0 +1,14 @@
+##
+## Project:   ar-cpp
+## Copyright: (c) 2015 by Petr Zemek <s3rvac@gmail.com> and contributors
+## License:   MIT, see the LICENSE file for more details
+##
+## CMake package configuration file for the library.
+##
+
+include(CMakeFindDependencyMacro)
+
+# The library uses threads internally.
+find_dependency(Threads)
+
+include("${CMAKE_CURRENT_LIST_DIR}/ar-targets.cmake")
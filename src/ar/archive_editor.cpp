@@ -0,0 +1,536 @@
+///
+/// @file      ar/archive_editor.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the in-place modification of archives.
+///
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <limits>
+
+#include "ar/archive_editor.h"
+#include "ar/exceptions.h"
+#include "ar/internal/archive_format.h"
+#include "ar/internal/boundary_discovery.h"
+#include "ar/internal/utilities/os.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+namespace {
+
+///
+/// Returns the given content followed by its padding.
+///
+std::string padded(std::string_view content) {
+	std::string result{content};
+	if (result.size() % 2 != 0) {
+		result += '\n';
+	}
+	return result;
+}
+
+///
+/// Returns the header of a member with the given name field, attributes, and
+/// size of content.
+///
+std::string memberHeader(const std::string& nameField,
+		const MemberAttributes& attributes, std::uint64_t size) {
+	return formatMemberHeader(nameField, attributes.timestamp,
+		attributes.ownerId, attributes.groupId, attributes.mode, size);
+}
+
+///
+/// Parses a number from a (space-padded) field of a header. An empty field
+/// means zero.
+///
+template<typename Number>
+Number parseHeaderNumber(std::string_view field, int base,
+		std::string_view name) {
+	const auto end = field.find(' ');
+	if (end != std::string_view::npos) {
+		if (field.find_first_not_of(' ', end) != std::string_view::npos) {
+			throw InvalidArchiveError{
+				"invalid " + std::string{name} + ": " + std::string{field}
+			};
+		}
+		field = field.substr(0, end);
+	}
+
+	Number number = 0;
+	if (field.empty()) {
+		return number;
+	}
+	const auto result = std::from_chars(field.data(),
+		field.data() + field.size(), number, base);
+	if (result.ec != std::errc() || result.ptr != field.data() + field.size()) {
+		throw InvalidArchiveError{
+			"invalid " + std::string{name} + ": " + std::string{field}
+		};
+	}
+	return number;
+}
+
+///
+/// Reads @a size bytes at @a offset of the given archive.
+///
+std::string readArchiveRange(std::ifstream& file, std::uint64_t offset,
+		std::uint64_t size) {
+	std::string bytes(size, '\0');
+	file.seekg(offset);
+	file.read(&bytes[0], bytes.size());
+	if (static_cast<std::uint64_t>(file.gcount()) != size) {
+		throw InvalidArchiveError{
+			"premature end of file (expected " + std::to_string(size) +
+			" bytes at offset " + std::to_string(offset) + ")"
+		};
+	}
+	return bytes;
+}
+
+} // anonymous namespace
+
+///
+/// Opens the archive in the given path for modification.
+///
+/// Only the headers of the archive (and its symbol and filename tables) are
+/// read.
+///
+/// @throws IOError When the archive cannot be opened.
+/// @throws InvalidArchiveError When the archive is invalid.
+/// @throws Error When the archive is in an unsupported format.
+///
+ArchiveEditor::ArchiveEditor(const std::string& path): path(path) {
+	readArchive();
+}
+
+ArchiveEditor::~ArchiveEditor() = default;
+
+///
+/// Creates an empty archive in the given path (overwriting any existing file)
+/// and opens it for modification.
+///
+/// @throws IOError When the archive cannot be written.
+///
+ArchiveEditor ArchiveEditor::create(const std::string& path) {
+	writeFile(path, std::string{ArchiveMagicString});
+	return ArchiveEditor{path};
+}
+
+///
+/// Returns the names of all members (in the order in which they are stored).
+///
+std::vector<std::string> ArchiveEditor::getMemberNames() const {
+	std::vector<std::string> names;
+	names.reserve(members.size());
+	for (const auto& member : members) {
+		names.push_back(member.name);
+	}
+	return names;
+}
+
+///
+/// Does the archive contain a member of the given name?
+///
+bool ArchiveEditor::hasMember(std::string_view name) const {
+	return std::any_of(members.begin(), members.end(),
+		[name](const auto& member) { return member.name == name; });
+}
+
+///
+/// Returns the size of the archive (in bytes).
+///
+std::uint64_t ArchiveEditor::getArchiveSize() const noexcept {
+	return archiveSize;
+}
+
+///
+/// Appends a member of the given name and content with default attributes
+/// (see MemberAttributes).
+///
+/// @throws Error When the name cannot be stored.
+/// @throws IOError When the archive cannot be written.
+///
+void ArchiveEditor::append(const std::string& name, std::string_view content) {
+	append(name, content, MemberAttributes());
+}
+
+///
+/// Appends a member of the given name, content, and attributes.
+///
+/// An already existing member of the same name is kept (like by <tt>ar
+/// q</tt>).
+///
+/// @throws Error When the name cannot be stored (it is empty or contains
+///               @c / or a newline) or when an attribute does not fit into
+///               the header.
+/// @throws IOError When the archive cannot be written.
+///
+void ArchiveEditor::append(const std::string& name, std::string_view content,
+		const MemberAttributes& attributes) {
+	const auto header = memberHeader(nameFieldFor(name), attributes,
+		content.size());
+
+	// The last member may lack its padding.
+	std::string bytes(archiveSize % 2, '\n');
+	const auto headerOffset = archiveSize + bytes.size();
+	bytes += header;
+	bytes += padded(content);
+	writeFileAt(path, archiveSize, bytes.data(), bytes.size());
+	archiveSize += bytes.size();
+
+	members.push_back(Member{name, headerOffset, content.size(),
+		header.substr(0, 16), attributes});
+}
+
+///
+/// Replaces the content of the first member of the given name, keeping its
+/// attributes.
+///
+/// @throws Error When there is no such member.
+/// @throws IOError When the archive cannot be written.
+///
+void ArchiveEditor::replace(const std::string& name,
+		std::string_view content) {
+	const auto member = findMember(name);
+	replace(name, content, member->attributes);
+}
+
+///
+/// Replaces the content and attributes of the first member of the given name.
+///
+/// The member stays in its place, so the archive is rewritten from the member
+/// onward (when the size of the member changes, the subsequent members are
+/// moved).
+///
+/// @throws Error When there is no such member or when an attribute does not
+///               fit into the header.
+/// @throws IOError When the archive cannot be written.
+///
+void ArchiveEditor::replace(const std::string& name, std::string_view content,
+		const MemberAttributes& attributes) {
+	const auto member = findMember(name);
+	auto bytes = memberHeader(member->nameField, attributes, content.size());
+	bytes += padded(content);
+	const auto storedSize = std::min(
+		MemberHeaderSize + paddedSize(member->size),
+		archiveSize - member->headerOffset);
+	replaceRange(member->headerOffset, storedSize, bytes);
+
+	member->size = content.size();
+	member->attributes = attributes;
+}
+
+///
+/// Removes the first member of the given name.
+///
+/// The archive is rewritten from the member onward. When the symbol table
+/// refers to the member, its symbols are removed from the table, which is
+/// rewritten as well. The name of the member is kept in the filename table.
+///
+/// @throws Error When there is no such member.
+/// @throws IOError When the archive cannot be written.
+///
+void ArchiveEditor::remove(const std::string& name) {
+	const auto index = findMember(name) - members.begin();
+	removeSymbolsOf(members[index].headerOffset);
+
+	// The member may have been moved by the removal of its symbols.
+	const auto& member = members[index];
+	const auto storedSize = std::min(
+		MemberHeaderSize + paddedSize(member.size),
+		archiveSize - member.headerOffset);
+	replaceRange(member.headerOffset, storedSize, "");
+	members.erase(members.begin() + index);
+}
+
+void ArchiveEditor::readArchive() {
+	std::ifstream file{path, std::ios::binary};
+	if (!file) {
+		throw IOError{"cannot open file \"" + path + "\""};
+	}
+	file.seekg(0, std::ios::end);
+	archiveSize = static_cast<std::uint64_t>(file.tellg());
+
+	if (archiveSize < ArchiveMagicString.size() || readArchiveRange(file, 0,
+			ArchiveMagicString.size()) != ArchiveMagicString) {
+		throw InvalidArchiveError{"missing magic string"};
+	}
+
+	auto offset = static_cast<std::uint64_t>(ArchiveMagicString.size());
+	while (offset < archiveSize) {
+		const auto header = readArchiveRange(file, offset, MemberHeaderSize);
+		if (header.compare(58, 2, "`\n") != 0) {
+			throw InvalidArchiveError{
+				"invalid header of member at offset " + std::to_string(offset)
+			};
+		}
+		const auto nameField = std::string_view{header}.substr(0, 16);
+		const auto size = parseHeaderNumber<std::uint64_t>(
+			std::string_view{header}.substr(48, 10), 10, "file size");
+		const auto contentOffset = offset + MemberHeaderSize;
+		if (size > archiveSize - contentOffset) {
+			throw InvalidArchiveError{
+				"premature end of file (expected " + std::to_string(size) +
+				" bytes at offset " + std::to_string(contentOffset) + ")"
+			};
+		}
+
+		if (nameField.substr(0, 2) == "//") {
+			nameTable.headerOffset = offset;
+			nameTable.content = readArchiveRange(file, contentOffset, size);
+		} else if (nameField[0] == '/' && isSymbolTableName(nameField)) {
+			if (offset != ArchiveMagicString.size()) {
+				throw Error{"symbol table that is not the first member"};
+			}
+			symbolTable.headerOffset = offset;
+			symbolTable.content = readArchiveRange(file, contentOffset, size);
+			symbolTableIs64Bit = nameField[1] == 'S';
+			getSymbolCount(); // Validates the table.
+		} else if (nameField.substr(0, 3) == "#1/") {
+			throw Error{"BSD archives are not supported"};
+		} else {
+			Member member;
+			if (nameField[0] == '/') {
+				const auto index = parseHeaderNumber<std::size_t>(
+					nameField.substr(1), 10, "index into filename table");
+				const auto end = nameTable.content.find("/\n", index);
+				if (index >= nameTable.content.size() ||
+						end == std::string::npos) {
+					throw InvalidArchiveError{
+						"invalid index into filename table: " +
+						std::to_string(index)
+					};
+				}
+				member.name = nameTable.content.substr(index, end - index);
+			} else {
+				const auto end = nameField.find('/');
+				if (end == std::string_view::npos) {
+					throw InvalidArchiveError{"missing '/' after file name"};
+				}
+				member.name = nameField.substr(0, end);
+			}
+			if (member.name.empty()) {
+				throw InvalidArchiveError{"file has an empty name"};
+			}
+			member.headerOffset = offset;
+			member.size = size;
+			member.nameField = nameField;
+			const auto fields = std::string_view{header};
+			member.attributes.timestamp = parseHeaderNumber<std::uint64_t>(
+				fields.substr(16, 12), 10, "timestamp");
+			member.attributes.ownerId = parseHeaderNumber<std::uint32_t>(
+				fields.substr(28, 6), 10, "owner ID");
+			member.attributes.groupId = parseHeaderNumber<std::uint32_t>(
+				fields.substr(34, 6), 10, "group ID");
+			member.attributes.mode = parseHeaderNumber<std::uint32_t>(
+				fields.substr(40, 8), 8, "file mode");
+			members.push_back(std::move(member));
+		}
+
+		// The padding of the last member may be missing.
+		offset = std::min(contentOffset + paddedSize(size), archiveSize);
+	}
+}
+
+///
+/// Returns the first member of the given name.
+///
+/// @throws Error When there is no such member.
+///
+std::vector<ArchiveEditor::Member>::iterator ArchiveEditor::findMember(
+		std::string_view name) {
+	const auto it = std::find_if(members.begin(), members.end(),
+		[name](const auto& member) { return member.name == name; });
+	if (it == members.end()) {
+		throw Error{"no member named " + std::string{name}};
+	}
+	return it;
+}
+
+///
+/// Returns the name field of the header of a member of the given name.
+///
+/// Names longer than 15 characters are stored in the filename table, which
+/// grows when it does not contain the name yet.
+///
+std::string ArchiveEditor::nameFieldFor(const std::string& name) {
+	ensureIsValidMemberName(name);
+	if (name.size() <= MaxShortNameSize) {
+		return name + "/";
+	}
+
+	const auto entry = name + "/\n";
+	auto index = nameTable.content.find(entry);
+	while (index != std::string::npos && index != 0 &&
+			nameTable.content[index - 1] != '\n') {
+		index = nameTable.content.find(entry, index + 1);
+	}
+	if (index == std::string::npos) {
+		index = nameTable.content.size();
+		storeLongName(name);
+	}
+	return "/" + std::to_string(index);
+}
+
+///
+/// Adds the given name to the end of the filename table (creating the table
+/// when there is none), which moves all the members.
+///
+void ArchiveEditor::storeLongName(const std::string& name) {
+	const auto oldContentSize = nameTable.content.size();
+	auto content = nameTable.content + name + "/\n";
+	const auto bytes = formatNameTableHeader(content.size()) + padded(content);
+
+	// The filename table follows the symbol table.
+	auto offset = static_cast<std::uint64_t>(ArchiveMagicString.size());
+	std::uint64_t storedSize = 0;
+	if (nameTable.headerOffset != 0) {
+		offset = nameTable.headerOffset;
+		storedSize = MemberHeaderSize + paddedSize(oldContentSize);
+	} else if (symbolTable.headerOffset != 0) {
+		offset = symbolTable.headerOffset + MemberHeaderSize +
+			paddedSize(symbolTable.content.size());
+	}
+	replaceRange(offset, storedSize, bytes);
+	nameTable.headerOffset = offset;
+	nameTable.content = std::move(content);
+}
+
+///
+/// Replaces @a size bytes at @a offset of the archive with the given bytes.
+///
+/// The rest of the archive is moved when the size of the range changes, and
+/// the offsets of the moved members in the symbol table are patched.
+///
+void ArchiveEditor::replaceRange(std::uint64_t offset, std::uint64_t size,
+		const std::string& bytes) {
+	const auto end = offset + size;
+	const auto newEnd = offset + bytes.size();
+	moveFileRange(path, end, newEnd, archiveSize - end);
+	writeFileAt(path, offset, bytes.data(), bytes.size());
+	if (newEnd < end) {
+		resizeFile(path, archiveSize - (end - newEnd));
+	}
+	archiveSize = archiveSize - end + newEnd;
+	if (newEnd == end) {
+		return;
+	}
+
+	const auto moved = [&](std::uint64_t headerOffset) {
+		return headerOffset - end + newEnd;
+	};
+	for (auto& member : members) {
+		if (member.headerOffset >= end) {
+			member.headerOffset = moved(member.headerOffset);
+		}
+	}
+	if (nameTable.headerOffset >= end) {
+		nameTable.headerOffset = moved(nameTable.headerOffset);
+	}
+	if (symbolTable.headerOffset != 0) {
+		bool patched = false;
+		for (std::size_t k = 0, e = getSymbolCount(); k < e; ++k) {
+			const auto symbolOffset = getSymbolOffset(k);
+			if (symbolOffset >= end) {
+				setSymbolOffset(k, moved(symbolOffset));
+				patched = true;
+			}
+		}
+		if (patched) {
+			writeSymbolTable();
+		}
+	}
+}
+
+///
+/// Removes the symbols of the member whose header is at the given offset from
+/// the symbol table.
+///
+void ArchiveEditor::removeSymbolsOf(std::uint64_t headerOffset) {
+	if (symbolTable.headerOffset == 0) {
+		return;
+	}
+
+	auto symbols = parseSymbolTable(symbolTable.content, symbolTableIs64Bit);
+	const auto symbolCount = symbols.size();
+	symbols.erase(std::remove_if(symbols.begin(), symbols.end(),
+		[headerOffset](const auto& symbol) {
+			return symbol.headerOffset == headerOffset;
+		}), symbols.end());
+	if (symbols.size() == symbolCount) {
+		return;
+	}
+
+	// The offsets are patched by replaceRange() as the table shrinks.
+	const auto storedSize = MemberHeaderSize +
+		paddedSize(symbolTable.content.size());
+	symbolTable.content = formatSymbolTable(symbols, symbolTableIs64Bit);
+	const auto bytes = formatSymbolTableHeader(symbolTable.content.size(),
+		symbolTableIs64Bit) + padded(symbolTable.content);
+	replaceRange(symbolTable.headerOffset, storedSize, bytes);
+}
+
+///
+/// Writes the content of the symbol table into the archive (the size of the
+/// table has to be unchanged).
+///
+void ArchiveEditor::writeSymbolTable() {
+	writeFileAt(path, symbolTable.headerOffset + MemberHeaderSize,
+		symbolTable.content.data(), symbolTable.content.size());
+}
+
+///
+/// Returns the size of the offsets in the symbol table.
+///
+std::size_t ArchiveEditor::getSymbolOffsetSize() const noexcept {
+	return symbolTableIs64Bit ? 8 : 4;
+}
+
+///
+/// Returns the offset of the header of the member defining the symbol of the
+/// given index.
+///
+std::uint64_t ArchiveEditor::getSymbolOffset(std::size_t index) const {
+	const auto offsetSize = getSymbolOffsetSize();
+	return readBigEndian(&symbolTable.content[(index + 1) * offsetSize],
+		offsetSize);
+}
+
+///
+/// Sets the offset of the header of the member defining the symbol of the
+/// given index.
+///
+/// @throws Error When the offset does not fit into the table.
+///
+void ArchiveEditor::setSymbolOffset(std::size_t index, std::uint64_t offset) {
+	const auto offsetSize = getSymbolOffsetSize();
+	if (!symbolTableIs64Bit &&
+			offset > std::numeric_limits<std::uint32_t>::max()) {
+		throw Error{"archive is too large for a 32-bit symbol table"};
+	}
+	writeBigEndian(offset, &symbolTable.content[(index + 1) * offsetSize],
+		offsetSize);
+}
+
+///
+/// Returns the number of symbols in the symbol table.
+///
+/// @throws InvalidArchiveError When the table is too small for the number.
+///
+std::size_t ArchiveEditor::getSymbolCount() const {
+	const auto offsetSize = getSymbolOffsetSize();
+	if (symbolTable.content.size() < offsetSize) {
+		throw InvalidArchiveError{"invalid symbol table"};
+	}
+	const auto count = readBigEndian(symbolTable.content.data(), offsetSize);
+	if (count > symbolTable.content.size() / offsetSize - 1) {
+		throw InvalidArchiveError{"invalid symbol table"};
+	}
+	return static_cast<std::size_t>(count);
+}
+
+} // namespace ar
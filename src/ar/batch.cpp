@@ -0,0 +1,194 @@
+///
+/// @file      ar/batch.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the processing of many archives at once.
+///
+
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+#include "ar/batch.h"
+#include "ar/exceptions.h"
+#include "ar/file.h"
+#include "ar/internal/archive_buffer.h"
+#include "ar/internal/extractor.h"
+#include "ar/internal/utilities/thread_pool.h"
+#include "ar/member_table.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+namespace {
+
+/// The files of an archive are passed to the handler in tasks of at most this
+/// many files...
+const std::size_t MaxFilesPerTask = 256;
+
+/// ...or of at most this many bytes of content.
+const std::uint64_t MaxContentSizePerTask = 4 * 1024 * 1024;
+
+///
+/// Processor of a batch of archives.
+///
+/// Every archive gets its own task. The task scans the headers of the archive
+/// and splits its files into ranges, which are handled by further tasks. The
+/// ranges are submitted from within a worker of the pool, so idle workers
+/// steal them. In this way, a few large archives among many small ones do not
+/// leave the other workers without work.
+///
+class BatchProcessor {
+public:
+	BatchProcessor(const std::vector<std::string>& archivePaths,
+		const BatchFileHandler& handler, const BatchOptions& options);
+
+	BatchReport process();
+
+	/// @name Disabled
+	/// @{
+	BatchProcessor(const BatchProcessor&) = delete;
+	BatchProcessor(BatchProcessor&&) = delete;
+	BatchProcessor& operator=(const BatchProcessor&) = delete;
+	BatchProcessor& operator=(BatchProcessor&&) = delete;
+	/// @}
+
+private:
+	void processArchive(BatchArchiveResult& result);
+	void handleFiles(const std::string& archivePath,
+		const std::shared_ptr<Files>& files, std::size_t from,
+		std::size_t to);
+	void run(ThreadPool::Task task);
+
+private:
+	const std::vector<std::string>& archivePaths;
+	const BatchFileHandler& handler;
+	BatchReport report;
+	std::unique_ptr<ThreadPool> pool;
+};
+
+BatchProcessor::BatchProcessor(const std::vector<std::string>& archivePaths,
+		const BatchFileHandler& handler, const BatchOptions& options):
+		archivePaths(archivePaths), handler(handler),
+		pool(createPoolForCaller(options.threadCount)) {}
+
+BatchReport BatchProcessor::process() {
+	const auto start = std::chrono::steady_clock::now();
+
+	report.archives.resize(archivePaths.size());
+	for (std::size_t j = 0; j < archivePaths.size(); ++j) {
+		auto& result = report.archives[j];
+		result.path = archivePaths[j];
+		run([this, &result]() { processArchive(result); });
+	}
+	if (pool) {
+		pool->wait();
+	}
+
+	for (const auto& result : report.archives) {
+		if (!result.error.empty()) {
+			report.failedArchiveCount++;
+			continue;
+		}
+		report.fileCount += result.fileCount;
+		report.contentSize += result.contentSize;
+	}
+	report.elapsedSeconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count();
+	return std::move(report);
+}
+
+void BatchProcessor::processArchive(BatchArchiveResult& result) {
+	// The archives are mapped and their files refer to the mapping, so no
+	// content is copied.
+	MemberTable table;
+	try {
+		table = Extractor().scanIntoTable(
+			ArchiveBuffer::fromFilesystem(result.path), ExtractionOptions());
+	} catch (const Error& ex) {
+		result.error = ex.what();
+		return;
+	}
+
+	const auto& sizes = table.getSizes();
+	result.fileCount = table.size();
+	result.contentSize = std::accumulate(sizes.begin(), sizes.end(),
+		std::uint64_t{0});
+	if (!handler || table.empty()) {
+		return;
+	}
+
+	// The files are shared by the tasks handling their ranges and destroyed
+	// (together with the mapping) after the last of them.
+	auto files = std::make_shared<Files>(table.toFiles());
+	std::size_t from = 0;
+	while (from < files->size()) {
+		auto to = from;
+		std::uint64_t rangeContentSize = 0;
+		while (to < files->size() && to - from < MaxFilesPerTask &&
+				rangeContentSize < MaxContentSizePerTask) {
+			rangeContentSize += sizes[to];
+			++to;
+		}
+		run([this, &result, files, from, to]() {
+			handleFiles(result.path, files, from, to);
+		});
+		from = to;
+	}
+}
+
+void BatchProcessor::handleFiles(const std::string& archivePath,
+		const std::shared_ptr<Files>& files, std::size_t from,
+		std::size_t to) {
+	auto it = files->begin() + static_cast<std::ptrdiff_t>(from);
+	const auto end = files->begin() + static_cast<std::ptrdiff_t>(to);
+	for (; it != end; ++it) {
+		handler(archivePath, **it);
+	}
+}
+
+void BatchProcessor::run(ThreadPool::Task task) {
+	if (pool) {
+		pool->submit(std::move(task));
+	} else {
+		task();
+	}
+}
+
+} // anonymous namespace
+
+///
+/// Processes the given archives and calls @a handler for each of their files.
+///
+/// @throws Any exception thrown by @a handler. Errors of individual archives
+///         (for example, an archive that cannot be read or that is invalid)
+///         are reported in the returned report instead.
+///
+BatchReport processArchives(const std::vector<std::string>& archivePaths,
+		const BatchFileHandler& handler) {
+	return processArchives(archivePaths, handler, BatchOptions());
+}
+
+///
+/// Processes the given archives by using the given options and calls
+/// @a handler for each of their files.
+///
+/// The archives are processed by a pool of threads. A thread that runs out
+/// of work takes it over from the other threads, either whole archives or
+/// ranges of files of an archive. The files refer to the content of their
+/// archive, which is mapped into memory, so they do not occupy memory on
+/// their own. They stay valid only while the handler runs.
+///
+/// @throws Any exception thrown by @a handler. Errors of individual archives
+///         (for example, an archive that cannot be read or that is invalid)
+///         are reported in the returned report instead.
+///
+BatchReport processArchives(const std::vector<std::string>& archivePaths,
+		const BatchFileHandler& handler, const BatchOptions& options) {
+	BatchProcessor processor{archivePaths, handler, options};
+	return processor.process();
+}
+
+} // namespace ar
@@ -0,0 +1,109 @@
+///
+/// @file      ar/byte_source.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the source of bytes supporting positioned
+///            reads.
+///
+
+#include <utility>
+
+#include "ar/byte_source.h"
+#include "ar/internal/byte_sources/decompressing_byte_source.h"
+#include "ar/internal/byte_sources/file_descriptor_byte_source.h"
+#include "ar/internal/byte_sources/mapped_file_byte_source.h"
+#include "ar/internal/byte_sources/string_byte_source.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+ByteSource::ByteSource() = default;
+
+ByteSource::~ByteSource() = default;
+
+/// @fn ByteSource::size()
+///
+/// Returns the number of bytes in the source.
+///
+
+/// @fn ByteSource::readAt(std::uint64_t offset, char* buffer,
+///     std::size_t length)
+///
+/// Reads at most @a length bytes starting at @a offset into @a buffer.
+///
+/// @return Number of read bytes, which is less than @a length only when the
+///         source ends sooner (zero when @a offset is past its end).
+///
+/// @throws IOError When the bytes cannot be read.
+///
+
+///
+/// Returns a pointer to all the bytes of the source when they are accessible
+/// in memory, and the null pointer otherwise.
+///
+/// Sources held in memory (or mapped into it) should override this function,
+/// so their bytes are used without copying them. The default implementation
+/// returns the null pointer.
+///
+const char* ByteSource::data() const noexcept {
+	return nullptr;
+}
+
+///
+/// Returns a source of the given bytes.
+///
+std::shared_ptr<ByteSource> ByteSource::fromString(std::string content) {
+	return std::make_shared<StringByteSource>(std::move(content));
+}
+
+///
+/// Returns a source of the bytes of the file open as @a fd.
+///
+/// The bytes are read by positioned reads, so nothing is held in memory. On
+/// POSIX systems, the position of the descriptor is left intact (@c pread is
+/// used). The descriptor is not closed by the source, so it has to stay open
+/// while the source exists.
+///
+/// @throws IOError When the size of the file cannot be obtained.
+///
+std::shared_ptr<ByteSource> ByteSource::fromFileDescriptor(int fd) {
+	return std::make_shared<FileDescriptorByteSource>(fd);
+}
+
+///
+/// Returns a source of the bytes of the file in the given path, mapped into
+/// memory.
+///
+/// The file must not be modified while the source exists.
+///
+/// @throws IOError When the file cannot be opened or mapped.
+///
+std::shared_ptr<ByteSource> ByteSource::fromFilesystem(
+		const std::string& path) {
+	return std::make_shared<MappedFileByteSource>(path);
+}
+
+///
+/// Returns a source of the decompressed bytes of the file in the given path,
+/// which is compressed by gzip or zstd.
+///
+/// The format is detected from the content of the file. The file is
+/// decompressed in a thread of its own, which starts right away, and reading
+/// of the source waits only for the requested bytes. Thus, an archive can be
+/// scanned or extracted while it is being decompressed. The decompressed
+/// bytes are held in memory until the source is destroyed.
+///
+/// The support of the formats depends on the libraries (zlib and libzstd)
+/// that were available when the library was built.
+///
+/// @throws IOError When the file cannot be opened. Errors of the
+///                 decompression are thrown when the source is read.
+/// @throws Error When the file is not compressed in a supported format.
+///
+std::shared_ptr<ByteSource> ByteSource::fromCompressedFile(
+		const std::string& path) {
+	return std::make_shared<DecompressingByteSource>(path);
+}
+
+} // namespace ar
@@ -0,0 +1,169 @@
+///
+/// @file      ar/comparison.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the comparison of archives.
+///
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+#include "ar/byte_source.h"
+#include "ar/comparison.h"
+#include "ar/extraction.h"
+#include "ar/member_table.h"
+
+namespace ar {
+
+namespace {
+
+/// Size of chunks in which the content of members is compared when it is not
+/// in memory.
+constexpr std::uint64_t ComparedChunkSize = 64 * 1024;
+
+///
+/// Returns a view of the given range of the content of a member, reading it
+/// into @a buffer when the content of the archive is not in memory.
+///
+std::string_view contentRange(const MemberTable& members,
+		MemberTable::size_type index, std::uint64_t offset,
+		std::uint64_t length, std::string& buffer) {
+	if (members.isContentInMemory()) {
+		return members.readRange(index, offset, length);
+	}
+
+	buffer.resize(length);
+	members.readRange(index, offset, length, &buffer[0]);
+	return buffer;
+}
+
+///
+/// Do the given members (of the same size) have the same content?
+///
+bool haveSameContent(const MemberTable& oldMembers,
+		MemberTable::size_type oldIndex, const MemberTable& newMembers,
+		MemberTable::size_type newIndex) {
+	// Different checksums (computed during the scanning) prove a difference
+	// without accessing the content. Equal checksums prove nothing.
+	if (oldMembers.hasChecksums() && newMembers.hasChecksums() &&
+			oldMembers.getChecksum(oldIndex) !=
+				newMembers.getChecksum(newIndex)) {
+		return false;
+	}
+
+	// Mapped archives are compared directly, so only the pages up to the
+	// first difference are read from the disk.
+	const auto size = oldMembers.getSize(oldIndex);
+	if (oldMembers.isContentInMemory() && newMembers.isContentInMemory()) {
+		return oldMembers.getContentView(oldIndex) ==
+			newMembers.getContentView(newIndex);
+	}
+
+	std::string oldBuffer;
+	std::string newBuffer;
+	for (std::uint64_t offset = 0; offset < size;
+			offset += ComparedChunkSize) {
+		const auto length = std::min(ComparedChunkSize, size - offset);
+		if (contentRange(oldMembers, oldIndex, offset, length, oldBuffer) !=
+				contentRange(newMembers, newIndex, offset, length, newBuffer)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+///
+/// Are the archives the same?
+///
+bool ArchiveDiff::empty() const noexcept {
+	return differences.empty();
+}
+
+///
+/// Compares the archives in the given paths.
+///
+/// The archives are mapped into memory, so only their headers and the content
+/// of members that need to be compared are read from the disk. See the
+/// description of the overload accepting member tables for more details.
+///
+/// @throws IOError When an archive cannot be read.
+/// @throws InvalidArchiveError When an archive is invalid.
+///
+ArchiveDiff diff(const std::string& oldPath, const std::string& newPath) {
+	return diff(
+		scanMembers(ByteSource::fromFilesystem(oldPath)),
+		scanMembers(ByteSource::fromFilesystem(newPath))
+	);
+}
+
+///
+/// Compares the archives whose members are in the given tables.
+///
+/// Members are matched by their names (the n-th member of a name in the old
+/// archive is matched with the n-th member of the same name in the new
+/// archive). Matched members of different sizes are reported as modified
+/// straight from their headers. Only the content of matched members of the
+/// same size is compared, and the comparison of each of them stops at the
+/// first difference. When both tables have checksums (see
+/// ExtractionOptions::computeChecksums), members with different checksums are
+/// reported as modified without comparing their content.
+///
+/// Attributes of members (timestamps, owners, groups, modes) are not compared.
+///
+/// @throws IOError When the content of a member cannot be read.
+///
+ArchiveDiff diff(const MemberTable& oldMembers, const MemberTable& newMembers) {
+	// Indexes of the members of the new archive of each name, in the order of
+	// the archive.
+	std::unordered_map<std::string_view, std::vector<MemberTable::size_type>>
+		newIndexes;
+	for (MemberTable::size_type i = 0; i < newMembers.size(); ++i) {
+		newIndexes[newMembers.getName(i)].push_back(i);
+	}
+	std::unordered_map<std::string_view, std::size_t> oldOccurrences;
+	std::vector<bool> matched(newMembers.size(), false);
+
+	ArchiveDiff result;
+	for (MemberTable::size_type i = 0; i < oldMembers.size(); ++i) {
+		const auto name = oldMembers.getName(i);
+		const auto oldSize = oldMembers.getSize(i);
+		const auto occurrence = oldOccurrences[name]++;
+		const auto it = newIndexes.find(name);
+		if (it == newIndexes.end() || occurrence >= it->second.size()) {
+			result.differences.push_back(MemberDifference{
+				MemberChange::Removed, std::string{name}, oldSize, 0
+			});
+			continue;
+		}
+
+		const auto j = it->second[occurrence];
+		const auto newSize = newMembers.getSize(j);
+		matched[j] = true;
+		if (oldSize == newSize) {
+			++result.comparedCount;
+			result.comparedSize += oldSize;
+			if (haveSameContent(oldMembers, i, newMembers, j)) {
+				++result.unchangedCount;
+				continue;
+			}
+		}
+		result.differences.push_back(MemberDifference{
+			MemberChange::Modified, std::string{name}, oldSize, newSize
+		});
+	}
+
+	for (MemberTable::size_type j = 0; j < newMembers.size(); ++j) {
+		if (!matched[j]) {
+			result.differences.push_back(MemberDifference{
+				MemberChange::Added, std::string{newMembers.getName(j)}, 0,
+				newMembers.getSize(j)
+			});
+		}
+	}
+	return result;
+}
+
+} // namespace ar
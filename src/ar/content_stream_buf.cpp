@@ -0,0 +1,82 @@
+///
+/// @file      ar/content_stream_buf.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the stream buffer reading the content of a
+///            file.
+///
+
+#include "ar/content_stream_buf.h"
+#include "ar/file.h"
+
+namespace ar {
+
+namespace {
+
+/// Position returned when seeking fails.
+const std::streambuf::pos_type InvalidPosition =
+	std::streambuf::pos_type(std::streambuf::off_type(-1));
+
+} // anonymous namespace
+
+///
+/// Creates a stream buffer reading the content of the given file.
+///
+/// @param[in] file File whose content is read.
+/// @param[in] bufferSize Number of bytes read from the file at once. Zero is
+///                       treated as one.
+///
+ContentStreamBuf::ContentStreamBuf(File& file, std::size_t bufferSize):
+		file(file), buffer(bufferSize > 0 ? bufferSize : 1), bufferOffset(0) {
+	setg(buffer.data(), buffer.data(), buffer.data());
+}
+
+ContentStreamBuf::~ContentStreamBuf() = default;
+
+ContentStreamBuf::int_type ContentStreamBuf::underflow() {
+	if (gptr() < egptr()) {
+		return traits_type::to_int_type(*gptr());
+	}
+
+	bufferOffset += static_cast<std::size_t>(egptr() - eback());
+	const auto count = file.readContentAt(bufferOffset, buffer.data(),
+		buffer.size());
+	setg(buffer.data(), buffer.data(), buffer.data() + count);
+	return count > 0 ? traits_type::to_int_type(*gptr()) : traits_type::eof();
+}
+
+ContentStreamBuf::pos_type ContentStreamBuf::seekoff(off_type offset,
+		std::ios_base::seekdir dir, std::ios_base::openmode which) {
+	// The size of the content is not known without reading it, so seeking
+	// relatively to the end is not supported.
+	if (dir == std::ios_base::cur) {
+		const auto current = bufferOffset +
+			static_cast<std::size_t>(gptr() - eback());
+		return seekpos(pos_type(off_type(current) + offset), which);
+	} else if (dir == std::ios_base::beg) {
+		return seekpos(pos_type(offset), which);
+	}
+	return InvalidPosition;
+}
+
+ContentStreamBuf::pos_type ContentStreamBuf::seekpos(pos_type position,
+		std::ios_base::openmode which) {
+	if (!(which & std::ios_base::in) || off_type(position) < 0) {
+		return InvalidPosition;
+	}
+
+	// When the position lies in the buffer, it is reused. Otherwise, the
+	// next read starts at the position.
+	const auto newOffset = static_cast<std::size_t>(off_type(position));
+	const auto bufferedSize = static_cast<std::size_t>(egptr() - eback());
+	if (newOffset >= bufferOffset &&
+			newOffset - bufferOffset < bufferedSize) {
+		setg(eback(), eback() + (newOffset - bufferOffset), egptr());
+	} else {
+		bufferOffset = newOffset;
+		setg(buffer.data(), buffer.data(), buffer.data());
+	}
+	return position;
+}
+
+} // namespace ar
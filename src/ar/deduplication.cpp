@@ -0,0 +1,353 @@
+///
+/// @file      ar/deduplication.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the detection and deduplicated extraction of
+///            identical members of archives.
+///
+
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "ar/deduplication.h"
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/internal/archive_buffer.h"
+#include "ar/internal/extractor.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/thread_pool.h"
+#include "ar/member_table.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+namespace {
+
+///
+/// Archive whose headers have been scanned.
+///
+struct ScannedArchive {
+	/// Content of the archive (mapped into memory).
+	std::shared_ptr<const ArchiveBuffer> buffer;
+
+	/// Members of the archive, including their checksums.
+	MemberTable table;
+};
+
+///
+/// Reference to a member of a scanned archive.
+///
+struct MemberRef {
+	/// Index of the archive.
+	std::size_t archiveIndex;
+
+	/// Index of the member in the table of the archive.
+	std::size_t memberIndex;
+};
+
+/// Members with identical content, in the order of their archives and of the
+/// members in them.
+using ContentClass = std::vector<MemberRef>;
+
+std::vector<ScannedArchive> scanArchives(
+		const std::vector<std::string>& archivePaths,
+		std::vector<BatchArchiveResult>& results, std::size_t threadCount) {
+	std::vector<ScannedArchive> archives(archivePaths.size());
+	results.resize(archivePaths.size());
+	auto scanArchive = [&](std::size_t j) {
+		auto& result = results[j];
+		result.path = archivePaths[j];
+		ExtractionOptions options;
+		options.computeChecksums = true;
+		try {
+			archives[j].buffer = ArchiveBuffer::fromFilesystem(result.path);
+			archives[j].table = Extractor().scanIntoTable(archives[j].buffer,
+				options);
+		} catch (const Error& ex) {
+			archives[j] = ScannedArchive();
+			result.error = ex.what();
+			return;
+		}
+
+		const auto& sizes = archives[j].table.getSizes();
+		result.fileCount = archives[j].table.size();
+		result.contentSize = std::accumulate(sizes.begin(), sizes.end(),
+			std::uint64_t{0});
+	};
+
+	auto pool = archivePaths.size() > 1
+		? createPoolForCaller(threadCount)
+		: nullptr;
+	if (!pool) {
+		for (std::size_t j = 0; j < archivePaths.size(); ++j) {
+			scanArchive(j);
+		}
+		return archives;
+	}
+
+	for (std::size_t j = 0; j < archivePaths.size(); ++j) {
+		pool->submit([&scanArchive, j]() { scanArchive(j); });
+	}
+	pool->wait();
+	return archives;
+}
+
+std::string_view contentOf(const std::vector<ScannedArchive>& archives,
+		const MemberRef& member) {
+	const auto& archive = archives[member.archiveIndex];
+	return archive.buffer->getContent().substr(
+		archive.table.getOffset(member.memberIndex),
+		archive.table.getSize(member.memberIndex));
+}
+
+///
+/// Splits the members of the given archives into classes of members with
+/// identical content.
+///
+/// The members are first grouped by their sizes and checksums. As different
+/// content may have the same checksum, the content of the members of a group
+/// is then compared, so the classes are exact.
+///
+std::vector<ContentClass> classifyMembers(
+		const std::vector<ScannedArchive>& archives) {
+	std::vector<ContentClass> classes;
+	std::unordered_map<std::uint64_t, std::vector<std::size_t>> classesByKey;
+	for (std::size_t j = 0; j < archives.size(); ++j) {
+		const auto& table = archives[j].table;
+		for (std::size_t k = 0; k < table.size(); ++k) {
+			const MemberRef member{j, k};
+			const auto content = contentOf(archives, member);
+			const auto key = (content.size() * 0x9e3779b97f4a7c15u) ^
+				table.getChecksum(k);
+			auto& candidates = classesByKey[key];
+			auto found = false;
+			for (auto candidate : candidates) {
+				if (contentOf(archives, classes[candidate].front()) ==
+						content) {
+					classes[candidate].push_back(member);
+					found = true;
+					break;
+				}
+			}
+			if (!found) {
+				candidates.push_back(classes.size());
+				classes.push_back({member});
+			}
+		}
+	}
+	return classes;
+}
+
+std::size_t countFailedArchives(
+		const std::vector<BatchArchiveResult>& results) {
+	std::size_t count = 0;
+	for (const auto& result : results) {
+		if (!result.error.empty()) {
+			count++;
+		}
+	}
+	return count;
+}
+
+///
+/// Ensures that no two archives are extracted into the same directory.
+///
+void checkArchiveNamesAreDistinct(
+		const std::vector<std::string>& archivePaths) {
+	std::unordered_map<std::string, std::size_t> archivesByName;
+	for (std::size_t j = 0; j < archivePaths.size(); ++j) {
+		const auto name = fileNameFromPath(archivePaths[j]);
+		const auto inserted = archivesByName.emplace(name, j).second;
+		if (!inserted) {
+			throw Error{
+				"archives \"" + archivePaths[archivesByName[name]] +
+				"\" and \"" + archivePaths[j] + "\" have the same name"
+			};
+		}
+	}
+}
+
+} // anonymous namespace
+
+///
+/// Finds members with identical content in the given archives.
+///
+/// See the description of findDuplicateMembers(const std::vector<std::string>&,
+/// const DeduplicationOptions&) for more details.
+///
+DeduplicationReport findDuplicateMembers(
+		const std::vector<std::string>& archivePaths) {
+	return findDuplicateMembers(archivePaths, DeduplicationOptions());
+}
+
+///
+/// Finds members with identical content in the given archives by using the
+/// given options.
+///
+/// The archives are mapped into memory and their headers are scanned in
+/// parallel, computing checksums of the members. Members with the same size
+/// and checksum are then compared byte by byte, so members that merely share
+/// a checksum are never reported as identical.
+///
+/// Errors of individual archives (for example, an archive that cannot be read
+/// or that is invalid) are reported in the returned report.
+///
+DeduplicationReport findDuplicateMembers(
+		const std::vector<std::string>& archivePaths,
+		const DeduplicationOptions& options) {
+	DeduplicationReport report;
+	const auto archives = scanArchives(archivePaths, report.archives,
+		options.threadCount);
+	report.failedArchiveCount = countFailedArchives(report.archives);
+
+	for (const auto& contentClass : classifyMembers(archives)) {
+		const auto& first = contentClass.front();
+		const auto& table = archives[first.archiveIndex].table;
+		const auto size = table.getSize(first.memberIndex);
+		report.memberCount += contentClass.size();
+		report.uniqueMemberCount++;
+		report.contentSize += size * contentClass.size();
+		report.uniqueContentSize += size;
+		if (contentClass.size() < 2) {
+			continue;
+		}
+
+		DuplicateGroup group;
+		group.size = size;
+		group.checksum = table.getChecksum(first.memberIndex);
+		for (const auto& member : contentClass) {
+			group.members.push_back({
+				member.archiveIndex,
+				std::string{archives[member.archiveIndex].table.getName(
+					member.memberIndex)}
+			});
+		}
+		report.duplicateGroups.push_back(std::move(group));
+	}
+	return report;
+}
+
+///
+/// Extracts the given archives into the given directory, writing identical
+/// files only once.
+///
+/// See the description of extractDeduplicated(const std::vector<std::string>&,
+/// const std::string&, const DeduplicationOptions&) for more details.
+///
+DeduplicatedExtractionReport extractDeduplicated(
+		const std::vector<std::string>& archivePaths,
+		const std::string& directoryPath) {
+	return extractDeduplicated(archivePaths, directoryPath,
+		DeduplicationOptions());
+}
+
+///
+/// Extracts the given archives into the given directory by using the given
+/// options, writing identical files only once.
+///
+/// Every archive is extracted into a subdirectory of @a directoryPath named
+/// after the archive. The directories are created when they do not exist.
+/// Only the first file with the given content is written. The other files
+/// with the same content (from the same or other archives) are created as
+/// clones of it or hard links to it, depending on
+/// DeduplicationOptions::linking. When neither is possible, they are written
+/// as well. Existing files are replaced, not overwritten, so files hard-linked
+/// by a previous extraction are left intact.
+///
+/// Errors of individual archives (for example, an archive that cannot be read
+/// or that is invalid) are reported in the returned report, and such archives
+/// are skipped.
+///
+/// @throws Error When two archives have the same name.
+/// @throws IOError When a directory cannot be created or a file cannot be
+///                 written.
+///
+DeduplicatedExtractionReport extractDeduplicated(
+		const std::vector<std::string>& archivePaths,
+		const std::string& directoryPath, const DeduplicationOptions& options) {
+	checkArchiveNamesAreDistinct(archivePaths);
+
+	DeduplicatedExtractionReport report;
+	const auto archives = scanArchives(archivePaths, report.archives,
+		options.threadCount);
+	report.failedArchiveCount = countFailedArchives(report.archives);
+
+	const auto classes = classifyMembers(archives);
+	std::vector<std::vector<std::size_t>> classOfMember(archives.size());
+	for (std::size_t j = 0; j < archives.size(); ++j) {
+		classOfMember[j].resize(archives[j].table.size());
+	}
+	for (std::size_t j = 0; j < classes.size(); ++j) {
+		for (const auto& member : classes[j]) {
+			classOfMember[member.archiveIndex][member.memberIndex] = j;
+		}
+	}
+
+	// Path to the written copy of every class and, conversely, the class
+	// whose content is in a written path. An archive may contain several
+	// members of the same name, so a written copy may be replaced by a file
+	// with different content.
+	std::vector<std::string> writtenPaths(classes.size());
+	std::unordered_map<std::string, std::size_t> classesByWrittenPath;
+
+	createDirectory(directoryPath);
+	for (std::size_t j = 0; j < archives.size(); ++j) {
+		if (!report.archives[j].error.empty()) {
+			continue;
+		}
+
+		const auto archiveDirectoryPath = joinPaths(directoryPath,
+			fileNameFromPath(archivePaths[j]));
+		createDirectory(archiveDirectoryPath);
+		const auto& table = archives[j].table;
+		for (std::size_t k = 0; k < table.size(); ++k) {
+			const auto contentClass = classOfMember[j][k];
+			const auto path = joinPaths(archiveDirectoryPath,
+				std::string{table.getName(k)});
+			if (writtenPaths[contentClass] == path) {
+				continue;
+			}
+
+			auto written = classesByWrittenPath.find(path);
+			if (written != classesByWrittenPath.end()) {
+				writtenPaths[written->second].clear();
+				classesByWrittenPath.erase(written);
+			}
+			removeFile(path);
+
+			const auto& srcPath = writtenPaths[contentClass];
+			const auto size = table.getSize(k);
+			if (!srcPath.empty()) {
+				if (options.linking == DuplicateLinking::Reflink &&
+						cloneFile(srcPath, path)) {
+					report.reflinkedFileCount++;
+					report.savedSize += size;
+					continue;
+				}
+				if (options.linking == DuplicateLinking::HardLink &&
+						createHardLink(srcPath, path)) {
+					report.hardLinkedFileCount++;
+					report.savedSize += size;
+					continue;
+				}
+			}
+
+			const auto content = contentOf(archives, {j, k});
+			writeFile(path, content.data(), content.size());
+			report.writtenFileCount++;
+			report.writtenSize += size;
+			if (srcPath.empty()) {
+				writtenPaths[contentClass] = path;
+				classesByWrittenPath.emplace(path, contentClass);
+			}
+		}
+	}
+	return report;
+}
+
+} // namespace ar
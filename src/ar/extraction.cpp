@@ -5,22 +5,423 @@
 /// @brief     Implementation of archive extraction.
 ///
 
+#include <ctime>
+#include <string_view>
+#include <utility>
+
+#include "ar/byte_source.h"
 #include "ar/extraction.h"
 #include "ar/file.h"
+#include "ar/internal/archive_buffer.h"
 #include "ar/internal/extractor.h"
+#include "ar/internal/files/filesystem_file.h"
+#include "ar/internal/files/string_file.h"
+#include "ar/internal/pipelined_extractor.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/stats_recorder.h"
+#include "ar/internal/utilities/tracing.h"
+#include "ar/internal/writers/batch_writer.h"
+#include "ar/member_table.h"
 
 using namespace ar::internal;
 
 namespace ar {
 
+namespace {
+
+///
+/// Returns the content of the given archive.
+///
+/// When @a map is @c true, an archive stored in a filesystem is mapped into
+/// memory instead of read. Its pages are then read only when accessed, and
+/// they can be dropped by the system at any time.
+///
+/// The reading is recorded into the given statistics (if any).
+///
+std::shared_ptr<const ArchiveBuffer> readArchive(File& archive, bool map,
+		ExtractionStats* statistics) {
+	TraceSpan span{"readArchive"};
+	StatsRecorder stats{statistics};
+	const auto phase = stats.startPhase(&ExtractionStats::readTime,
+		&ExtractionStats::readMemory);
+	if (map) {
+		if (auto file = dynamic_cast<FilesystemFile*>(&archive)) {
+			return ArchiveBuffer::fromFilesystem(file->getPath());
+		}
+	}
+
+	// The archive is not needed after the extraction, so its content can be
+	// taken instead of copied.
+	if (auto file = dynamic_cast<StringFile*>(&archive)) {
+		return ArchiveBuffer::fromContent(file->takeContent());
+	}
+	auto content = archive.getContent();
+	stats.addBytesRead(content.size());
+	return ArchiveBuffer::fromContent(std::move(content));
+}
+
+bool isUpToDate(const std::string& path, const Member& member,
+		std::string_view content, const ExtractionOptions& options) {
+	std::size_t size = 0;
+	std::time_t modificationTime = 0;
+	if (!getFileSizeAndModificationTime(path, size, modificationTime) ||
+			size != member.size ||
+			modificationTime != static_cast<std::time_t>(member.timestamp)) {
+		return false;
+	}
+	// Deterministic archives (e.g. those created by GNU ar by default) store
+	// zero timestamps, so the modification time says nothing about whether
+	// the file has changed. In such a case, the content has to be compared.
+	const bool timestampIsKnown = member.timestamp != 0;
+	return (timestampIsKnown && !options.compareContent) ||
+		fileHasContent(path, content.data() + member.offset, member.size);
+}
+
+ExtractionReport extractToDirectoryDirectly(
+		std::shared_ptr<const ArchiveBuffer> archive,
+		const std::string& directoryPath, const ExtractionOptions& options) {
+	// There is no need to materialize the files. Their content is written
+	// straight from the archive. Files that do not fit into the budget are
+	// copied from the archive in chunks, and the pages of the other ones are
+	// released after writing, so the mapping does not occupy more memory than
+	// allowed. In the incremental extraction, files that are up to date are
+	// skipped.
+	const auto content = archive->getContent();
+	auto members = Extractor().scan(archive, options);
+
+	ExtractionReport report;
+	for (auto& member : members) {
+		TraceSpan span{"writeFile", member.name};
+		auto path = joinPaths(directoryPath, member.name);
+		if (options.incremental &&
+				isUpToDate(path, member, content, options)) {
+			report.unchangedFileCount++;
+		} else {
+			if (options.memoryBudget > 0 &&
+					member.size > options.memoryBudget &&
+					!archive->getPath().empty()) {
+				copyFileRange(archive->getPath(), member.offset, member.size,
+					path);
+			} else {
+				writeFile(path, content.data() + member.offset, member.size);
+				archive->release(member.offset, member.size);
+			}
+			if (options.incremental) {
+				setFileModificationTime(path,
+					static_cast<std::time_t>(member.timestamp));
+			}
+		}
+		report.fileNames.push_back(std::move(member.name));
+	}
+	return report;
+}
+
+ExtractionReport extractToDirectoryInBatches(
+		std::shared_ptr<const ArchiveBuffer> archive,
+		const std::string& directoryPath, const ExtractionOptions& options) {
+	// As in extractToDirectoryDirectly(), the content is written straight
+	// from the archive.
+	const auto content = archive->getContent();
+	auto members = Extractor().scan(archive, options);
+
+	ExtractionReport report;
+	auto writer = BatchWriter::create(options.threadCount);
+	report.ioUringUsed = writer->usesIoUring();
+	for (auto& member : members) {
+		writer->write(joinPaths(directoryPath, member.name),
+			content.data() + member.offset, member.size);
+		report.fileNames.push_back(std::move(member.name));
+	}
+	writer->flush();
+	return report;
+}
+
+} // anonymous namespace
+
+///
+/// Creates a session extracting archives with the default options.
+///
+ExtractionSession::ExtractionSession():
+	ExtractionSession(ExtractionOptions()) {}
+
+///
+/// Creates a session extracting archives with the given options.
+///
+ExtractionSession::ExtractionSession(const ExtractionOptions& options):
+	options(options), extractor(std::make_unique<Extractor>()) {}
+
+ExtractionSession::ExtractionSession(ExtractionSession&& other) noexcept =
+	default;
+
+ExtractionSession::~ExtractionSession() = default;
+
+ExtractionSession& ExtractionSession::operator=(
+	ExtractionSession&& other) noexcept = default;
+
+///
+/// Extracts the given archive and returns the files it contains.
+///
+/// Unless the options of the session let the files refer to the archive
+/// (@c shareArchiveContent or @c memoryBudget), the content of the archive is
+/// read into memory that is reused for the next archive.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when the archive cannot be read.
+///
+Files ExtractionSession::extract(std::unique_ptr<File> archive) {
+	TraceSpan span{"extract"};
+	// Let go of the previous archive first, so its buffer can be reused.
+	extractor->reset();
+	return extractor->extract(loadArchive(*archive), options);
+}
+
+///
+/// Forgets the last extracted archive.
+///
+/// The memory held by the session is kept for the next extraction.
+///
+void ExtractionSession::reset() noexcept {
+	extractor->reset();
+	archiveContent.clear();
+	if (archiveBuffer && archiveBuffer.use_count() == 1) {
+		archiveBuffer->assignView(archiveContent);
+	} else {
+		archiveBuffer.reset();
+	}
+}
+
+///
+/// Returns the options used for every extraction.
+///
+const ExtractionOptions& ExtractionSession::getOptions() const noexcept {
+	return options;
+}
+
+std::shared_ptr<const ArchiveBuffer> ExtractionSession::loadArchive(
+		File& archive) {
+	// Files that refer to the archive would be left dangling when the buffer
+	// got reused.
+	if (options.shareArchiveContent || options.memoryBudget > 0) {
+		return readArchive(archive, options.memoryBudget > 0, options.stats);
+	}
+
+	TraceSpan span{"readArchive"};
+	StatsRecorder stats{options.stats};
+	const auto phase = stats.startPhase(&ExtractionStats::readTime,
+		&ExtractionStats::readMemory);
+	if (auto file = dynamic_cast<FilesystemFile*>(&archive)) {
+		readFileInto(file->getPath(), archiveContent);
+		stats.addBytesRead(archiveContent.size());
+	} else if (auto file = dynamic_cast<StringFile*>(&archive)) {
+		archiveContent = file->takeContent();
+	} else {
+		archiveContent.assign(archive.getContentView());
+	}
+
+	// The files are copied out of the buffer, so once the previous extraction
+	// is over, nothing else refers to it.
+	if (archiveBuffer && archiveBuffer.use_count() == 1) {
+		archiveBuffer->assignView(archiveContent);
+	} else {
+		archiveBuffer = ArchiveBuffer::fromView(archiveContent);
+	}
+	return archiveBuffer;
+}
+
 ///
 /// Extracts the given archive and returns the files it contains.
 ///
 /// @throws InvalidArchiveError when the archive is invalid.
 ///
 Files extract(std::unique_ptr<File> archive) {
+	return extract(std::move(archive), ExtractionOptions());
+}
+
+///
+/// Extracts the given archive by using the given options and returns the
+/// files it contains.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+Files extract(std::unique_ptr<File> archive,
+		const ExtractionOptions& options) {
+	TraceSpan span{"extract"};
 	Extractor extractor;
-	return extractor.extract(archive->getContent());
+	return extractor.extract(
+		readArchive(*archive, options.memoryBudget > 0, options.stats),
+		options);
+}
+
+///
+/// Reads only the headers of the given archive and returns a table of its
+/// members.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+MemberTable scanMembers(std::unique_ptr<File> archive) {
+	return scanMembers(std::move(archive), ExtractionOptions());
+}
+
+///
+/// Reads only the headers of the given archive by using the given options and
+/// returns a table of its members.
+///
+/// No content is copied. The table keeps the archive alive, so it can be
+/// converted into files later (see MemberTable::toFiles()).
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+MemberTable scanMembers(std::unique_ptr<File> archive,
+		const ExtractionOptions& options) {
+	TraceSpan span{"scanMembers"};
+	Extractor extractor;
+	// Only the headers are needed (and the content of members when their
+	// checksums are computed, but every byte is touched once), so there is
+	// no point in reading the whole archive into memory.
+	return extractor.scanIntoTable(readArchive(*archive, true, options.stats),
+		options);
+}
+
+///
+/// Reads only the headers of the archive in the given source and returns a
+/// table of its members.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when the source cannot be read.
+///
+MemberTable scanMembers(std::shared_ptr<const ByteSource> archive) {
+	return scanMembers(std::move(archive), ExtractionOptions());
+}
+
+///
+/// Reads only the headers of the archive in the given source by using the
+/// given options and returns a table of its members.
+///
+/// When the bytes of the source are in memory (see ByteSource::data()), they
+/// are used without copying. Otherwise, only the headers and the filename
+/// table are read from the source by positioned reads, and the content of
+/// members is read only when it is asked for (see MemberTable::readRange()
+/// and MemberTable::toFiles()). The source is kept alive by the table. In
+/// the latter case, the headers have to have the fixed 60-byte layout, which
+/// is the case for archives produced by common tools.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when the source cannot be read.
+///
+MemberTable scanMembers(std::shared_ptr<const ByteSource> archive,
+		const ExtractionOptions& options) {
+	TraceSpan span{"scanMembers"};
+	Extractor extractor;
+	return extractor.scanIntoTable(std::move(archive), options);
+}
+
+///
+/// Extracts the given archive into the given directory.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when a file cannot be written.
+///
+ExtractionReport extractToDirectory(std::unique_ptr<File> archive,
+		const std::string& directoryPath) {
+	return extractToDirectory(std::move(archive), directoryPath,
+		ExtractionOptions());
+}
+
+///
+/// Extracts the given archive into the given directory by using the given
+/// options.
+///
+/// When a file of the same name appears several times in the archive, the
+/// last one is stored, even when the extraction is pipelined. Archives nested
+/// in the archive are stored as files, even when @c recursive is enabled.
+///
+/// @throws InvalidArchiveError when the archive is invalid. In the pipelined
+///         extraction, files preceding the invalid part of the archive may
+///         have already been written.
+/// @throws IOError when a file cannot be written.
+///
+ExtractionReport extractToDirectory(std::unique_ptr<File> archive,
+		const std::string& directoryPath, const ExtractionOptions& options) {
+	TraceSpan span{"extractToDirectory"};
+	// Within a memory budget, the archive is mapped, so it does not occupy
+	// memory that the system cannot reclaim. In the incremental extraction,
+	// the mapping ensures that only the content of written files is read.
+	const auto mapArchive = options.memoryBudget > 0 || options.incremental;
+	auto readArchiveToExtract = [&]() {
+		return readArchive(*archive, mapArchive, options.stats);
+	};
+	if (options.incremental) {
+		return extractToDirectoryDirectly(readArchiveToExtract(),
+			directoryPath, options);
+	} else if (options.pipelined) {
+		PipelinedExtractor extractor{options};
+		return extractor.extractTo(readArchiveToExtract(), directoryPath);
+	} else if (options.batchedWrites) {
+		return extractToDirectoryInBatches(readArchiveToExtract(),
+			directoryPath, options);
+	} else if (options.memoryBudget > 0) {
+		return extractToDirectoryDirectly(readArchiveToExtract(),
+			directoryPath, options);
+	}
+
+	// Nested archives are written as files. Their members would be named by
+	// paths through the nested archives, for which there are no directories.
+	auto extractionOptions = options;
+	extractionOptions.recursive = false;
+	ExtractionReport report;
+	auto files = extract(std::move(archive), extractionOptions);
+	for (auto& file : files) {
+		file->saveCopyTo(directoryPath);
+		report.fileNames.push_back(file->getName());
+	}
+	return report;
+}
+
+///
+/// Extracts the archive in the given source into the given directory.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when the source cannot be read or a file cannot be
+///         written.
+///
+ExtractionReport extractToDirectory(std::shared_ptr<const ByteSource> archive,
+		const std::string& directoryPath) {
+	return extractToDirectory(std::move(archive), directoryPath,
+		ExtractionOptions());
+}
+
+///
+/// Extracts the archive in the given source into the given directory by using
+/// the given options.
+///
+/// When the bytes of the source are in memory, the files are written straight
+/// from them. Otherwise, the extraction is always pipelined: the archive is
+/// scanned as the source is read, and @c threadCount writers read the content
+/// of the found files from the source and write them. For a source from
+/// ByteSource::fromCompressedFile(), the extraction thus takes about as long
+/// as the decompression. In this case, @c incremental, @c memoryBudget, and
+/// @c batchedWrites are ignored.
+///
+/// @throws InvalidArchiveError when the archive is invalid. Files preceding
+///         the invalid part of the archive may have already been written.
+/// @throws IOError when the source cannot be read or a file cannot be
+///         written.
+///
+ExtractionReport extractToDirectory(std::shared_ptr<const ByteSource> archive,
+		const std::string& directoryPath, const ExtractionOptions& options) {
+	TraceSpan span{"extractToDirectory"};
+	if (!archive->data() || options.pipelined) {
+		PipelinedExtractor extractor{options};
+		return extractor.extractTo(std::move(archive), directoryPath);
+	}
+
+	auto buffer = ArchiveBuffer::fromByteSource(std::move(archive));
+	if (options.batchedWrites && !options.incremental) {
+		return extractToDirectoryInBatches(std::move(buffer), directoryPath,
+			options);
+	}
+	return extractToDirectoryDirectly(std::move(buffer), directoryPath,
+		options);
 }
 
 } // namespace ar
@@ -5,6 +5,12 @@
 /// @brief     Implementation of the representation and factory for files.
 ///
 
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#include "ar/exceptions.h"
 #include "ar/file.h"
 #include "ar/internal/files/filesystem_file.h"
 #include "ar/internal/files/string_file.h"
@@ -13,6 +19,23 @@ using namespace ar::internal;
 
 namespace ar {
 
+///
+/// Copies of the name and content of a file backing the default views.
+///
+struct File::ViewCache {
+	/// Ensures that the name is obtained only once.
+	std::once_flag nameObtained;
+
+	/// Copy of the name.
+	std::string name;
+
+	/// Ensures that the content is obtained only once.
+	std::once_flag contentObtained;
+
+	/// Copy of the content.
+	std::string content;
+};
+
 File::File() = default;
 
 File::~File() = default;
@@ -29,6 +52,96 @@ File::~File() = default;
 /// Returns the content of the file.
 ///
 
+///
+/// Returns a view of the name of the file.
+///
+/// The view is valid for as long as the file exists.
+///
+/// The default implementation keeps a copy of getName() upon the first call.
+/// It may be called from several threads at once. The files created by the
+/// library override it to return a view of the name they store.
+///
+std::string_view File::getNameView() const {
+	auto& cache = getViewCache();
+	std::call_once(cache.nameObtained, [&]() { cache.name = getName(); });
+	return cache.name;
+}
+
+///
+/// Returns a view of the content of the file.
+///
+/// Contrary to getContent(), the content is not copied. When the file has to
+/// read its content (e.g. from a filesystem), it does so only upon the first
+/// call and keeps the content for subsequent calls. The view is valid for as
+/// long as the file exists.
+///
+/// The default implementation keeps the result of getContent() upon the first
+/// call. It may be called from several threads at once. The files created by
+/// the library override it to avoid the copy.
+///
+std::string_view File::getContentView() {
+	auto& cache = getViewCache();
+	std::call_once(cache.contentObtained,
+		[&]() { cache.content = getContent(); });
+	return cache.content;
+}
+
+///
+/// Returns the cache of the default views, creating it upon the first call.
+///
+File::ViewCache& File::getViewCache() const {
+	std::call_once(viewCacheCreated,
+		[this]() { viewCache = std::make_unique<ViewCache>(); });
+	return *viewCache;
+}
+
+///
+/// Calls @a callback for consecutive chunks of the content of the file.
+///
+/// Every chunk has @a chunkSize bytes, except for the last one, which may be
+/// shorter. For an empty file, @a callback is not called. A chunk is valid
+/// only during the call of @a callback.
+///
+/// Files that refer to content in memory pass views of it without copying.
+/// Files that read their content (e.g. from a filesystem) read it chunk by
+/// chunk, so memory use does not depend on the size of the content.
+///
+/// @throws Error When @a chunkSize is zero.
+///
+void File::forEachChunk(std::size_t chunkSize, const ChunkCallback& callback) {
+	if (chunkSize == 0) {
+		throw Error{"the size of a chunk cannot be zero"};
+	}
+
+	const auto content = getContentView();
+	for (std::size_t offset = 0; offset < content.size();
+			offset += chunkSize) {
+		callback(content.substr(offset, chunkSize));
+	}
+}
+
+///
+/// Copies at most @a size bytes of the content of the file, starting at
+/// @a offset, into @a buffer.
+///
+/// @return Number of copied bytes, which is less than @a size only when the
+///         content ends sooner (zero when @a offset is past its end).
+///
+/// Files that read their content (e.g. from a filesystem) read only the
+/// requested part of it.
+///
+std::size_t File::readContentAt(std::size_t offset, char* buffer,
+		std::size_t size) {
+	const auto content = getContentView();
+	if (offset >= content.size()) {
+		return 0;
+	}
+
+	const auto count = std::min(size, content.size() - offset);
+	std::memcpy(buffer, content.data() + offset, count);
+	return count;
+}
+
 /// @fn File::saveCopyTo(const std::string& directoryPath)
 ///
 /// Stores a copy of the file into the given directory.
@@ -46,9 +159,9 @@ File::~File() = default;
 /// @param[in] content Content of the file.
 /// @param[in] name Name of the file.
 ///
-std::unique_ptr<File> File::fromContentWithName(const std::string& content,
-		const std::string& name) {
-	return std::make_unique<StringFile>(content, name);
+std::unique_ptr<File> File::fromContentWithName(std::string content,
+		std::string name) {
+	return std::make_unique<StringFile>(std::move(content), std::move(name));
 }
 
 ///
@@ -125,6 +238,14 @@ auto Files::size() const noexcept -> size_type {
 	return files.size();
 }
 
+///
+/// Prepares the container for holding at least @a count files, so appending
+/// them does not reallocate the container.
+///
+void Files::reserve(size_type count) {
+	files.reserve(count);
+}
+
 ///
 /// Appends the given file to the end of the container.
 ///
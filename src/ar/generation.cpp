@@ -0,0 +1,343 @@
+///
+/// @file      ar/generation.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the generation of synthetic archives.
+///
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "ar/exceptions.h"
+#include "ar/generation.h"
+#include "ar/internal/archive_format.h"
+#include "ar/internal/boundary_discovery.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+namespace {
+
+/// Number of bytes of content generated at once (a multiple of 8).
+constexpr std::size_t ContentChunkSize = 64 * 1024;
+
+/// The largest size that fits into the size field of a header.
+constexpr std::uint64_t MaxSizeInHeader = 9999999999;
+
+/// The largest offset that fits into a 32-bit symbol table.
+constexpr std::uint64_t Max32BitOffset = 0xffffffff;
+
+/// Increment of the splitmix64 generator.
+constexpr std::uint64_t GoldenGamma = 0x9e3779b97f4a7c15;
+
+/// @name Salts
+/// Distinguish the random numbers generated for a member.
+/// @{
+constexpr std::uint64_t SizeSalt = 1;
+constexpr std::uint64_t NameSalt = 2;
+constexpr std::uint64_t ContentSalt = 3;
+/// @}
+
+///
+/// Returns the mixed bits of @a x (the finalizer of splitmix64).
+///
+/// Only the standard generators of random numbers give the same numbers on
+/// every platform, but not the standard distributions, so the numbers are
+/// derived by the arithmetic below.
+///
+std::uint64_t mix(std::uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+	return x ^ (x >> 31);
+}
+
+///
+/// Returns a random number for the member of the given index.
+///
+/// Everything about a member is derived from the seed and its index, so
+/// nothing has to be kept about the members between the passes over them.
+///
+std::uint64_t memberRandom(const GenerationOptions& options,
+		std::size_t index, std::uint64_t salt) {
+	return mix(mix(options.seed ^ salt) + (index + 1) * GoldenGamma);
+}
+
+std::uint64_t memberSize(const GenerationOptions& options,
+		std::size_t index) {
+	const auto range = options.maxMemberSize - options.minMemberSize;
+	return options.minMemberSize +
+		memberRandom(options, index, SizeSalt) % (range + 1);
+}
+
+///
+/// Is the name of the member of the given index stored in the filename
+/// table?
+///
+/// Exactly @c longNameCount members get a long name, spread evenly.
+///
+bool hasLongName(const GenerationOptions& options, std::size_t index) {
+	const std::uint64_t count = options.longNameCount;
+	return (index + 1) * count / options.memberCount >
+		index * count / options.memberCount;
+}
+
+std::string memberName(const GenerationOptions& options, std::size_t index) {
+	if (!hasLongName(options, index)) {
+		return "m" + std::to_string(index) + ".o";
+	}
+
+	auto name = "member_" + std::to_string(index) + "_";
+	auto random = memberRandom(options, index, NameSalt);
+	while (name.size() + 2 < options.longNameSize) {
+		random = mix(random + GoldenGamma);
+		name += static_cast<char>('a' + random % 26);
+	}
+	return name + ".o";
+}
+
+///
+/// Returns the index of the member defining the symbol of the given index.
+///
+std::size_t symbolMember(const GenerationOptions& options, std::size_t k) {
+	return static_cast<std::size_t>(static_cast<std::uint64_t>(k) *
+		options.memberCount / options.symbolCount);
+}
+
+std::string symbolName(std::size_t k) {
+	return "symbol_" + std::to_string(k);
+}
+
+std::uint64_t memberTotalSize(std::uint64_t size) {
+	return MemberHeaderSize + paddedSize(size);
+}
+
+///
+/// Ensures that an archive can be generated with the given options.
+///
+/// @throws Error When it cannot.
+///
+void ensureAreValidOptions(const GenerationOptions& options) {
+	if (options.minMemberSize > options.maxMemberSize) {
+		throw Error{
+			"the smallest size of a member is greater than the largest"
+		};
+	}
+	if (options.maxMemberSize > MaxSizeInHeader) {
+		throw Error{
+			"the largest size of a member does not fit into a header"
+		};
+	}
+	if (options.longNameCount > options.memberCount) {
+		throw Error{"there are more long names than members"};
+	}
+	if (options.longNameCount > 0 &&
+			options.longNameSize <= MaxShortNameSize) {
+		throw Error{"long names have to be longer than " +
+			std::to_string(MaxShortNameSize) + " characters"};
+	}
+	if (options.symbolCount > 0 && options.memberCount == 0) {
+		throw Error{"there are symbols but no members"};
+	}
+}
+
+///
+/// Writes the padding of content of the given size.
+///
+void writePadding(std::ostream& output, std::uint64_t size) {
+	if (size % 2 != 0) {
+		output << '\n';
+	}
+}
+
+///
+/// Writes the content of the member of the given index, generating it by
+/// chunks.
+///
+void writeContent(std::ostream& output, const GenerationOptions& options,
+		std::size_t index, std::uint64_t size, std::vector<char>& buffer) {
+	auto state = memberRandom(options, index, ContentSalt);
+	while (size > 0) {
+		const auto chunkSize = static_cast<std::size_t>(
+			std::min<std::uint64_t>(size, buffer.size()));
+		for (std::size_t k = 0; k < chunkSize; k += 8) {
+			state += GoldenGamma;
+			auto value = mix(state);
+			for (std::size_t b = k; b < k + 8 && b < chunkSize; ++b) {
+				buffer[b] = static_cast<char>(value & 0xff);
+				value >>= 8;
+			}
+		}
+		output.write(buffer.data(), static_cast<std::streamsize>(chunkSize));
+		size -= chunkSize;
+	}
+}
+
+///
+/// Writes the symbol table, in which the symbols refer to the headers of the
+/// members placed from @a firstMemberOffset.
+///
+void writeSymbolTable(std::ostream& output, const GenerationOptions& options,
+		std::uint64_t namesSize, std::uint64_t firstMemberOffset,
+		bool is64Bit) {
+	const std::size_t offsetSize = is64Bit ? 8 : 4;
+	const auto contentSize = (options.symbolCount + 1) * offsetSize +
+		namesSize;
+	output << formatSymbolTableHeader(contentSize, is64Bit);
+
+	char number[8];
+	writeBigEndian(options.symbolCount, number, offsetSize);
+	output.write(number, static_cast<std::streamsize>(offsetSize));
+	std::size_t member = 0;
+	auto headerOffset = firstMemberOffset;
+	for (std::size_t k = 0; k < options.symbolCount; ++k) {
+		for (const auto end = symbolMember(options, k); member < end;
+				++member) {
+			headerOffset += memberTotalSize(memberSize(options, member));
+		}
+		writeBigEndian(headerOffset, number, offsetSize);
+		output.write(number, static_cast<std::streamsize>(offsetSize));
+	}
+	for (std::size_t k = 0; k < options.symbolCount; ++k) {
+		output << symbolName(k) << '\0';
+	}
+	writePadding(output, contentSize);
+}
+
+void writeNameTable(std::ostream& output, const GenerationOptions& options,
+		std::uint64_t size) {
+	output << formatNameTableHeader(size);
+	for (std::size_t j = 0; j < options.memberCount; ++j) {
+		if (hasLongName(options, j)) {
+			output << memberName(options, j) << "/\n";
+		}
+	}
+	writePadding(output, size);
+}
+
+void writeMembers(std::ostream& output, const GenerationOptions& options) {
+	std::vector<char> buffer(ContentChunkSize);
+	std::uint64_t nameOffset = 0;
+	for (std::size_t j = 0; j < options.memberCount; ++j) {
+		const auto name = memberName(options, j);
+		std::string nameField;
+		if (hasLongName(options, j)) {
+			nameField = "/" + std::to_string(nameOffset);
+			nameOffset += name.size() + 2;
+		} else {
+			nameField = name + "/";
+		}
+		const auto size = memberSize(options, j);
+		output << formatMemberHeader(nameField, 0, 0, 0, 0644, size);
+		writeContent(output, options, j, size, buffer);
+		writePadding(output, size);
+	}
+}
+
+} // anonymous namespace
+
+///
+/// Generates a synthetic archive into @a outputPath.
+///
+/// See the description of the overload accepting a stream for more details.
+///
+/// @throws IOError When the archive cannot be written.
+/// @throws Error When an archive cannot be generated with the given options.
+///
+GenerationReport generateArchive(const std::string& outputPath,
+		const GenerationOptions& options) {
+	ensureAreValidOptions(options);
+	std::ofstream output{outputPath, std::ios::binary};
+	if (!output) {
+		throw IOError{"cannot open file \"" + outputPath + "\""};
+	}
+	auto report = generateArchive(output, options);
+	output.close();
+	if (!output) {
+		throw IOError{"cannot write file \"" + outputPath + "\""};
+	}
+	return report;
+}
+
+///
+/// Generates a synthetic archive into @a output.
+///
+/// The archive is a GNU archive with the given number of members of random
+/// sizes and content, with the given number of long names and symbols (see
+/// GenerationOptions). It is written as it is generated, so even archives
+/// with millions of members or with gigabytes of content are generated
+/// without being held in memory. The members are named @c m<index>.o (or
+/// @c member_<index>_<random letters>.o when their names are long), and the
+/// symbols @c symbol_<index>.
+///
+/// @throws IOError When the archive cannot be written.
+/// @throws Error When an archive cannot be generated with the given options.
+///
+GenerationReport generateArchive(std::ostream& output,
+		const GenerationOptions& options) {
+	ensureAreValidOptions(options);
+
+	// The first pass lays out the archive: the magic string, the symbol
+	// table, the filename table, and the members.
+	GenerationReport report;
+	report.memberCount = options.memberCount;
+	report.symbolCount = options.symbolCount;
+	std::uint64_t nameTableSize = 0;
+	std::uint64_t lastSymbolMemberOffset = 0;
+	const auto lastSymbolMember = options.symbolCount > 0
+		? symbolMember(options, options.symbolCount - 1)
+		: 0;
+	for (std::size_t j = 0; j < options.memberCount; ++j) {
+		if (j == lastSymbolMember) {
+			lastSymbolMemberOffset = report.archiveSize;
+		}
+		if (hasLongName(options, j)) {
+			nameTableSize += memberName(options, j).size() + 2;
+		}
+		const auto size = memberSize(options, j);
+		report.contentSize += size;
+		report.archiveSize += memberTotalSize(size);
+	}
+	std::uint64_t symbolNamesSize = 0;
+	for (std::size_t k = 0; k < options.symbolCount; ++k) {
+		symbolNamesSize += symbolName(k).size() + 1;
+	}
+
+	// A 64-bit symbol table is needed only when a member with a symbol
+	// starts after 4 GB.
+	report.sym64 = options.sym64;
+	auto firstMemberOffset = [&]() {
+		auto offset = static_cast<std::uint64_t>(ArchiveMagicString.size());
+		if (options.symbolCount > 0) {
+			offset += symbolTableSize(options.symbolCount, symbolNamesSize,
+				report.sym64);
+		}
+		if (nameTableSize > 0) {
+			offset += memberTotalSize(nameTableSize);
+		}
+		return offset;
+	};
+	if (options.symbolCount > 0 && !report.sym64 &&
+			firstMemberOffset() + lastSymbolMemberOffset > Max32BitOffset) {
+		report.sym64 = true;
+	}
+	report.archiveSize += firstMemberOffset();
+
+	// The second pass writes it.
+	output << ArchiveMagicString;
+	if (options.symbolCount > 0) {
+		writeSymbolTable(output, options, symbolNamesSize,
+			firstMemberOffset(), report.sym64);
+	}
+	if (nameTableSize > 0) {
+		writeNameTable(output, options, nameTableSize);
+	}
+	writeMembers(output, options);
+	if (!output) {
+		throw IOError{"cannot write the generated archive"};
+	}
+	return report;
+}
+
+} // namespace ar
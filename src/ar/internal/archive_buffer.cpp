@@ -0,0 +1,129 @@
+///
+/// @file      ar/internal/archive_buffer.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the content of an archive.
+///
+
+#include <utility>
+
+#include "ar/byte_source.h"
+#include "ar/exceptions.h"
+#include "ar/internal/archive_buffer.h"
+#include "ar/internal/utilities/mapped_file.h"
+
+namespace ar {
+namespace internal {
+
+ArchiveBuffer::ArchiveBuffer() = default;
+
+ArchiveBuffer::~ArchiveBuffer() = default;
+
+///
+/// Returns a buffer holding the given content.
+///
+std::shared_ptr<const ArchiveBuffer> ArchiveBuffer::fromContent(
+		std::string content) {
+	std::shared_ptr<ArchiveBuffer> buffer{new ArchiveBuffer()};
+	buffer->heldContent = std::move(content);
+	buffer->content = buffer->heldContent;
+	return buffer;
+}
+
+///
+/// Returns a buffer with the archive in the given path mapped into memory.
+///
+/// The archive must not be modified while the buffer exists.
+///
+/// @throws IOError When the archive cannot be opened or mapped.
+///
+std::shared_ptr<const ArchiveBuffer> ArchiveBuffer::fromFilesystem(
+		const std::string& path) {
+	std::shared_ptr<ArchiveBuffer> buffer{new ArchiveBuffer()};
+	buffer->mappedFile = std::make_unique<MappedFile>(path);
+	buffer->path = path;
+	buffer->content = {
+		buffer->mappedFile->getData(),
+		buffer->mappedFile->getSize()
+	};
+	return buffer;
+}
+
+///
+/// Returns a buffer viewing the given content, without owning it.
+///
+/// The content has to outlive the buffer and everything that refers to it.
+/// As long as nothing else refers to the buffer, its owner may point it to
+/// other content by calling assignView(), so the buffer can be reused.
+///
+std::shared_ptr<ArchiveBuffer> ArchiveBuffer::fromView(
+		std::string_view content) {
+	std::shared_ptr<ArchiveBuffer> buffer{new ArchiveBuffer()};
+	buffer->content = content;
+	return buffer;
+}
+
+///
+/// Returns a buffer with the bytes of the given source.
+///
+/// When the bytes of the source are in memory (see ByteSource::data()), they
+/// are used without copying and the buffer keeps the source alive. Otherwise,
+/// they are read into the buffer.
+///
+/// @throws IOError When the bytes cannot be read.
+///
+std::shared_ptr<const ArchiveBuffer> ArchiveBuffer::fromByteSource(
+		std::shared_ptr<const ByteSource> source) {
+	std::shared_ptr<ArchiveBuffer> buffer{new ArchiveBuffer()};
+	const auto size = static_cast<std::size_t>(source->size());
+	if (auto data = source->data()) {
+		buffer->content = {data, size};
+		buffer->source = std::move(source);
+		return buffer;
+	}
+
+	buffer->heldContent.resize(size);
+	if (source->readAt(0, &buffer->heldContent[0], size) != size) {
+		throw IOError{"cannot read the content of the archive"};
+	}
+	buffer->content = buffer->heldContent;
+	return buffer;
+}
+
+///
+/// Points a buffer created by fromView() to the given content.
+///
+void ArchiveBuffer::assignView(std::string_view content) noexcept {
+	this->content = content;
+}
+
+///
+/// Returns the content of the archive.
+///
+std::string_view ArchiveBuffer::getContent() const noexcept {
+	return content;
+}
+
+///
+/// Returns the path to the archive when the archive is mapped from a
+/// filesystem, and the empty string otherwise.
+///
+const std::string& ArchiveBuffer::getPath() const noexcept {
+	return path;
+}
+
+///
+/// Lets the system drop the given range of a mapped archive from memory.
+///
+/// The content stays accessible. For archives held in memory, this does
+/// nothing.
+///
+void ArchiveBuffer::release(std::size_t offset,
+		std::size_t size) const noexcept {
+	if (mappedFile) {
+		mappedFile->release(offset, size);
+	}
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,204 @@
+///
+/// @file      ar/internal/archive_format.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the creation of the parts of GNU archives.
+///
+
+#include <charconv>
+
+#include "ar/exceptions.h"
+#include "ar/internal/archive_format.h"
+#include "ar/internal/boundary_discovery.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+///
+/// Returns @a value left-aligned in a header field of the given @a width.
+///
+/// @throws Error When the value does not fit into the field.
+///
+std::string headerField(const std::string& value, std::size_t width,
+		std::string_view name) {
+	if (value.size() > width) {
+		throw Error{
+			std::string{name} + " " + value + " does not fit into the header"
+		};
+	}
+	return value + std::string(width - value.size(), ' ');
+}
+
+///
+/// Returns the size of an offset (and of the number of symbols) in a symbol
+/// table.
+///
+std::size_t symbolOffsetSize(bool is64Bit) {
+	return is64Bit ? 8 : 4;
+}
+
+} // anonymous namespace
+
+///
+/// Returns the size of content of the given size including its padding (the
+/// headers of members start at even offsets).
+///
+std::uint64_t paddedSize(std::uint64_t size) {
+	return size + size % 2;
+}
+
+///
+/// Returns the header of a member with the given name field (e.g. @c name/ or
+/// @c /42), attributes, and size of content.
+///
+/// @throws Error When a value does not fit into its field.
+///
+std::string formatMemberHeader(const std::string& nameField,
+		std::uint64_t timestamp, std::uint32_t ownerId, std::uint32_t groupId,
+		std::uint32_t mode, std::uint64_t size) {
+	char modeAsStr[12] = {};
+	const auto modeEnd = std::to_chars(modeAsStr,
+		modeAsStr + sizeof(modeAsStr), mode, 8).ptr;
+	return headerField(nameField, 16, "name") +
+		headerField(std::to_string(timestamp), 12, "timestamp") +
+		headerField(std::to_string(ownerId), 6, "owner ID") +
+		headerField(std::to_string(groupId), 6, "group ID") +
+		headerField(std::string(modeAsStr, modeEnd), 8, "file mode") +
+		headerField(std::to_string(size), 10, "file size") +
+		"`\n";
+}
+
+///
+/// Returns the header of the filename table (@c //) with content of the
+/// given size.
+///
+/// Only the name and size are filled, like in archives created by GNU ar.
+///
+std::string formatNameTableHeader(std::uint64_t size) {
+	return headerField("//", 48, "name") +
+		headerField(std::to_string(size), 10, "table size") + "`\n";
+}
+
+///
+/// Ensures that the given name can be stored as the name of a member.
+///
+/// @throws Error When the name is empty or contains @c / or a newline (which
+///               end names in headers and in the filename table).
+///
+void ensureIsValidMemberName(std::string_view name) {
+	if (name.empty() || name.find_first_of("/\n") != std::string_view::npos) {
+		throw Error{"invalid member name: " + std::string{name}};
+	}
+}
+
+///
+/// Is the given name field the one of a symbol table (@c / or @c /SYM64/)?
+///
+bool isSymbolTableName(std::string_view nameField) {
+	return nameField.substr(0, 7) == "/SYM64/" || (!nameField.empty() &&
+		nameField[0] == '/' &&
+		nameField.find_first_not_of(' ', 1) == std::string_view::npos);
+}
+
+///
+/// Returns the value of a big-endian number of @a size bytes.
+///
+std::uint64_t readBigEndian(const char* bytes, std::size_t size) {
+	std::uint64_t value = 0;
+	for (std::size_t k = 0; k < size; ++k) {
+		value = (value << 8) | static_cast<unsigned char>(bytes[k]);
+	}
+	return value;
+}
+
+///
+/// Stores @a value as a big-endian number of @a size bytes.
+///
+void writeBigEndian(std::uint64_t value, char* bytes, std::size_t size) {
+	for (std::size_t k = size; k > 0; --k) {
+		bytes[k - 1] = static_cast<char>(value & 0xff);
+		value >>= 8;
+	}
+}
+
+///
+/// Returns the symbols from the given content of a symbol table.
+///
+/// The table contains the number of symbols, the offsets of the headers of
+/// the members defining them (both as big-endian numbers of 4 bytes, or of
+/// 8 bytes in @c /SYM64/ tables), and the null-terminated names of the
+/// symbols.
+///
+/// @throws InvalidArchiveError When the table is invalid.
+///
+std::vector<Symbol> parseSymbolTable(std::string_view content, bool is64Bit) {
+	const auto offsetSize = symbolOffsetSize(is64Bit);
+	if (content.size() < offsetSize) {
+		throw InvalidArchiveError{"invalid symbol table"};
+	}
+	const auto count = readBigEndian(content.data(), offsetSize);
+	if (count > content.size() / offsetSize - 1) {
+		throw InvalidArchiveError{"invalid symbol table"};
+	}
+
+	std::vector<Symbol> symbols(static_cast<std::size_t>(count));
+	auto nameStart = (symbols.size() + 1) * offsetSize;
+	for (std::size_t k = 0; k < symbols.size(); ++k) {
+		const auto nameEnd = content.find('\0', nameStart);
+		if (nameEnd == std::string_view::npos) {
+			throw InvalidArchiveError{"invalid symbol table"};
+		}
+		symbols[k].name = content.substr(nameStart, nameEnd - nameStart);
+		symbols[k].headerOffset = readBigEndian(
+			content.data() + (k + 1) * offsetSize, offsetSize);
+		nameStart = nameEnd + 1;
+	}
+	return symbols;
+}
+
+///
+/// Returns the header of a symbol table with content of the given size.
+///
+std::string formatSymbolTableHeader(std::uint64_t size, bool is64Bit) {
+	return formatMemberHeader(is64Bit ? "/SYM64/" : "/", 0, 0, 0, 0, size);
+}
+
+///
+/// Returns the content of a symbol table with the given symbols.
+///
+/// @throws Error When an offset does not fit into a 32-bit table.
+///
+std::string formatSymbolTable(const std::vector<Symbol>& symbols,
+		bool is64Bit) {
+	const auto offsetSize = symbolOffsetSize(is64Bit);
+	std::string content((symbols.size() + 1) * offsetSize, '\0');
+	writeBigEndian(symbols.size(), &content[0], offsetSize);
+	for (std::size_t k = 0; k < symbols.size(); ++k) {
+		if (!is64Bit && symbols[k].headerOffset > 0xffffffff) {
+			throw Error{"archive is too large for a 32-bit symbol table"};
+		}
+		writeBigEndian(symbols[k].headerOffset,
+			&content[(k + 1) * offsetSize], offsetSize);
+	}
+	for (const auto& symbol : symbols) {
+		content += symbol.name;
+		content += '\0';
+	}
+	return content;
+}
+
+///
+/// Returns the size of a symbol table (including its header and padding)
+/// with the given number of symbols whose null-terminated names have
+/// @a namesSize bytes in total.
+///
+std::uint64_t symbolTableSize(std::size_t symbolCount,
+		std::uint64_t namesSize, bool is64Bit) {
+	return MemberHeaderSize + paddedSize(
+		(symbolCount + 1) * symbolOffsetSize(is64Bit) + namesSize);
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,200 @@
+///
+/// @file      ar/internal/boundary_discovery.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the speculative discovery of member boundaries.
+///
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+
+#include "ar/internal/boundary_discovery.h"
+#include "ar/internal/utilities/thread_pool.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+/// Offset of the "`\n" terminator in a member header.
+const std::size_t HeaderEndOffset = 58;
+
+/// Chunks of an archive smaller than this are not worth scanning separately.
+const std::size_t MinChunkSize = 64 * 1024;
+
+///
+/// Checks that the given header field contains a number, optionally surrounded
+/// by spaces, and stores the number into @a value.
+///
+bool readNumericField(const char* field, std::size_t fieldSize,
+		std::size_t& value) {
+	std::size_t j = 0;
+	while (j < fieldSize && field[j] == ' ') {
+		++j;
+	}
+
+	const auto digitsStart = j;
+	value = 0;
+	while (j < fieldSize && std::isdigit(static_cast<unsigned char>(field[j]))) {
+		const auto digit = static_cast<std::size_t>(field[j] - '0');
+		if (value > (std::numeric_limits<std::size_t>::max() - digit) / 10) {
+			return false;
+		}
+		value = value * 10 + digit;
+		++j;
+	}
+	if (j == digitsStart) {
+		return false;
+	}
+
+	while (j < fieldSize && field[j] == ' ') {
+		++j;
+	}
+	return j == fieldSize;
+}
+
+} // anonymous namespace
+
+///
+/// Checks whether there is something that looks like a member header at the
+/// given offset.
+///
+/// A candidate has to have the layout of a 60-byte header: a non-empty name
+/// field followed by numeric fields and the "`\n" terminator. When it is a
+/// candidate, the size of the member's content is stored into @a size.
+///
+bool isHeaderCandidateAt(std::string_view content, std::size_t offset,
+		std::size_t& size) {
+	if (offset > content.size() || content.size() - offset < MemberHeaderSize) {
+		return false;
+	}
+
+	const auto header = content.data() + offset;
+	if (header[HeaderEndOffset] != '`' || header[HeaderEndOffset + 1] != '\n'
+			|| header[0] == ' ') {
+		return false;
+	}
+
+	std::size_t unused;
+	return readNumericField(header + 16, 12, unused) // Timestamp.
+		&& readNumericField(header + 28, 6, unused) // Owner ID.
+		&& readNumericField(header + 34, 6, unused) // Group ID.
+		&& readNumericField(header + 40, 8, unused) // File mode.
+		&& readNumericField(header + 48, 10, size); // File size.
+}
+
+///
+/// Returns candidates for member headers that start in the given range of the
+/// archive.
+///
+/// A candidate is found by looking for the "`\n" terminator of a header. As
+/// the content of members may contain anything, some of the candidates may be
+/// false positives.
+///
+HeaderCandidates findHeaderCandidates(std::string_view content,
+		std::size_t start, std::size_t end) {
+	HeaderCandidates candidates;
+	end = std::min(end, content.size());
+	if (start >= end || content.size() < MemberHeaderSize) {
+		return candidates;
+	}
+
+	auto q = start + HeaderEndOffset;
+	const auto scanEnd = std::min(end + HeaderEndOffset, content.size() - 1);
+	while (q < scanEnd) {
+		const auto found = static_cast<const char*>(
+			std::memchr(content.data() + q, '`', scanEnd - q));
+		if (!found) {
+			break;
+		}
+
+		q = found - content.data();
+		const auto offset = q - HeaderEndOffset;
+		std::size_t size;
+		if (isHeaderCandidateAt(content, offset, size)) {
+			candidates.push_back({offset, size});
+		}
+		++q;
+	}
+	return candidates;
+}
+
+///
+/// Returns candidates for member headers that start at or after the given
+/// offset.
+///
+/// The archive is split into chunks that are scanned by the given pool. When
+/// there is no pool, the whole archive is scanned by the calling thread.
+///
+HeaderCandidates findHeaderCandidatesInParallel(std::string_view content,
+		std::size_t start, ThreadPool* pool) {
+	if (!pool || start >= content.size()) {
+		return findHeaderCandidates(content, start, content.size());
+	}
+
+	// Use more chunks than threads so that the work is balanced even when
+	// some chunks contain more candidates than others.
+	const auto regionSize = content.size() - start;
+	const auto chunkCount = std::max<std::size_t>(1, std::min(
+		4 * (pool->getThreadCount() + 1), regionSize / MinChunkSize));
+	const auto chunkSize = (regionSize + chunkCount - 1) / chunkCount;
+
+	std::vector<HeaderCandidates> chunkCandidates(chunkCount);
+	for (std::size_t k = 0; k < chunkCount; ++k) {
+		pool->submit([&content, &chunkCandidates, start, chunkSize, k]() {
+			const auto chunkStart = start + k * chunkSize;
+			chunkCandidates[k] = findHeaderCandidates(content, chunkStart,
+				chunkStart + chunkSize);
+		});
+	}
+	pool->wait();
+
+	HeaderCandidates candidates;
+	for (auto& c : chunkCandidates) {
+		candidates.insert(candidates.end(), c.begin(), c.end());
+	}
+	return candidates;
+}
+
+///
+/// Walks the chain of headers starting at @a firstHeader by using only the
+/// given candidates and stores the headers into @a chain.
+///
+/// Every header has to be followed by the content of the member (padded to an
+/// even size by '\n'), and the last member has to end exactly at the end of
+/// the archive. When this does not hold, @c false is returned.
+///
+bool stitchHeaderChain(std::string_view content, std::size_t firstHeader,
+		const HeaderCandidates& candidates, HeaderCandidates& chain) {
+	chain.clear();
+
+	std::size_t pos = firstHeader;
+	std::size_t k = 0;
+	while (pos < content.size()) {
+		while (k < candidates.size() && candidates[k].offset < pos) {
+			++k;
+		}
+		if (k == candidates.size() || candidates[k].offset != pos) {
+			return false;
+		}
+
+		const auto& candidate = candidates[k];
+		const auto contentStart = pos + MemberHeaderSize;
+		if (candidate.size > content.size() - contentStart) {
+			return false;
+		}
+		chain.push_back(candidate);
+
+		pos = contentStart + candidate.size;
+		if (candidate.size % 2 == 1 && pos < content.size()
+				&& content[pos] == '\n') {
+			++pos;
+		}
+	}
+	return true;
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,361 @@
+///
+/// @file      ar/internal/byte_sources/decompressing_byte_source.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the source of bytes decompressed from a file.
+///
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+
+#include "ar/exceptions.h"
+#include "ar/internal/byte_sources/decompressing_byte_source.h"
+
+#ifdef AR_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef AR_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+/// Magic bytes at the beginning of gzip files.
+constexpr std::string_view GzipMagic{"\x1f\x8b", 2};
+
+/// Magic bytes at the beginning of zstd frames.
+constexpr std::string_view ZstdMagic{"\x28\xb5\x2f\xfd", 4};
+
+///
+/// Returns the name of the given format to be used in messages.
+///
+std::string formatName(DecompressingByteSource::Format format) {
+	return format == DecompressingByteSource::Format::Gzip ? "gzip" : "zstd";
+}
+
+} // anonymous namespace
+
+///
+/// Constructs a source of the decompressed bytes of the file in the given path
+/// and starts decompressing it.
+///
+/// @throws IOError When the file cannot be opened.
+/// @throws Error When the file is not compressed in a supported format.
+///
+DecompressingByteSource::DecompressingByteSource(const std::string& path):
+		path(path), input(path, std::ios::in | std::ios::binary) {
+	if (!input) {
+		throw IOError{"cannot open " + path};
+	}
+
+	char prefix[ZstdMagic.size()] = {};
+	input.read(prefix, sizeof(prefix));
+	const auto detectedFormat = detectFormat(
+		std::string_view(prefix, static_cast<std::size_t>(input.gcount())));
+	if (!detectedFormat) {
+		throw Error{path + " is not compressed by gzip or zstd"};
+	} else if (!isSupported(*detectedFormat)) {
+		throw Error{
+			"reading of " + formatName(*detectedFormat) +
+			"-compressed files is not supported by this build"
+		};
+	}
+	format = *detectedFormat;
+	input.clear();
+	input.seekg(0);
+
+	decompressor = std::thread{&DecompressingByteSource::decompress, this};
+}
+
+///
+/// Stops the decompression (if it is still running).
+///
+DecompressingByteSource::~DecompressingByteSource() {
+	stopRequested = true;
+	decompressor.join();
+}
+
+std::uint64_t DecompressingByteSource::size() const {
+	waitUntilAvailable(std::numeric_limits<std::uint64_t>::max());
+	std::lock_guard<std::mutex> lock{mutex};
+	return availableSize;
+}
+
+std::size_t DecompressingByteSource::readAt(std::uint64_t offset,
+		char* buffer, std::size_t length) const {
+	const auto end = length > std::numeric_limits<std::uint64_t>::max() - offset
+		? std::numeric_limits<std::uint64_t>::max()
+		: offset + length;
+	waitUntilAvailable(end);
+
+	std::size_t count = 0;
+	while (count < length) {
+		const char* chunk = nullptr;
+		std::size_t chunkCount = 0;
+		{
+			// Only the list of chunks is guarded. The bytes in them do not
+			// change once they are available.
+			std::lock_guard<std::mutex> lock{mutex};
+			const auto position = offset + count;
+			if (position >= availableSize) {
+				break;
+			}
+			const auto offsetInChunk = position % ChunkSize;
+			chunk = chunks[position / ChunkSize].get() + offsetInChunk;
+			chunkCount = std::min<std::uint64_t>({length - count,
+				ChunkSize - offsetInChunk, availableSize - position});
+		}
+		std::memcpy(buffer + count, chunk, chunkCount);
+		count += chunkCount;
+	}
+	return count;
+}
+
+///
+/// Returns the compression format of the file.
+///
+auto DecompressingByteSource::getFormat() const noexcept -> Format {
+	return format;
+}
+
+///
+/// Returns the format of a compressed file starting with the given bytes, or
+/// nothing when the bytes do not start a compressed file.
+///
+auto DecompressingByteSource::detectFormat(std::string_view prefix)
+		-> std::optional<Format> {
+	if (prefix.substr(0, GzipMagic.size()) == GzipMagic) {
+		return Format::Gzip;
+	} else if (prefix.substr(0, ZstdMagic.size()) == ZstdMagic) {
+		return Format::Zstd;
+	}
+	return std::nullopt;
+}
+
+///
+/// Is decompression of the given format supported by this build of the
+/// library?
+///
+bool DecompressingByteSource::isSupported(Format format) noexcept {
+	switch (format) {
+		case Format::Gzip:
+#ifdef AR_HAVE_ZLIB
+			return true;
+#else
+			return false;
+#endif
+		case Format::Zstd:
+#ifdef AR_HAVE_ZSTD
+			return true;
+#else
+			return false;
+#endif
+	}
+	return false;
+}
+
+///
+/// Decompresses the file (run in the decompressing thread).
+///
+/// An error is stored, so it can be reported to readers of the source.
+///
+void DecompressingByteSource::decompress() {
+	std::string errorMessage;
+	try {
+		if (format == Format::Gzip) {
+			decompressGzip();
+		} else {
+			decompressZstd();
+		}
+	} catch (const std::exception& ex) {
+		errorMessage = ex.what();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		error = std::move(errorMessage);
+		finished = true;
+	}
+	availableChanged.notify_all();
+}
+
+void DecompressingByteSource::decompressGzip() {
+#ifdef AR_HAVE_ZLIB
+	z_stream stream{};
+	// 15 is the maximal window size, and 32 enables the detection of the
+	// gzip header.
+	if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+		throw IOError{"cannot initialize the decompression of " + path};
+	}
+	struct StreamEnd {
+		z_stream& stream;
+		~StreamEnd() { inflateEnd(&stream); }
+	} streamEnd{stream};
+
+	std::vector<char> inputChunk(InputChunkSize);
+	bool streamEnded = false;
+	bool outputFull = false;
+	while (!stopRequested) {
+		// When the output was full, zlib may hold more output even without
+		// further input.
+		if (stream.avail_in == 0 && !outputFull) {
+			const auto inputSize = readInput(inputChunk.data(),
+				inputChunk.size());
+			if (inputSize == 0) {
+				break;
+			}
+			stream.next_in = reinterpret_cast<Bytef*>(inputChunk.data());
+			stream.avail_in = static_cast<uInt>(inputSize);
+		}
+		if (streamEnded && stream.avail_in > 0) {
+			// Another gzip member follows (e.g. in files compressed by pigz
+			// or concatenated by cat).
+			inflateReset(&stream);
+			streamEnded = false;
+		}
+
+		std::size_t outputSize = 0;
+		auto output = reserveOutput(outputSize);
+		stream.next_out = reinterpret_cast<Bytef*>(output);
+		stream.avail_out = static_cast<uInt>(outputSize);
+		const auto result = inflate(&stream, Z_NO_FLUSH);
+		publishOutput(outputSize - stream.avail_out);
+		outputFull = stream.avail_out == 0;
+		if (result == Z_STREAM_END) {
+			streamEnded = true;
+		} else if (result != Z_OK && result != Z_BUF_ERROR) {
+			throw IOError{"corrupted gzip data in " + path};
+		}
+	}
+
+	if (!streamEnded && !stopRequested) {
+		throw IOError{"truncated gzip data in " + path};
+	}
+#endif
+}
+
+void DecompressingByteSource::decompressZstd() {
+#ifdef AR_HAVE_ZSTD
+	auto stream = ZSTD_createDStream();
+	if (!stream || ZSTD_isError(ZSTD_initDStream(stream))) {
+		ZSTD_freeDStream(stream);
+		throw IOError{"cannot initialize the decompression of " + path};
+	}
+	struct StreamEnd {
+		ZSTD_DStream* stream;
+		~StreamEnd() { ZSTD_freeDStream(stream); }
+	} streamEnd{stream};
+
+	std::vector<char> inputChunk(InputChunkSize);
+	ZSTD_inBuffer zstdInput{inputChunk.data(), 0, 0};
+	// Zero means that a frame has been completely decoded and flushed.
+	std::size_t result = 0;
+	bool outputFull = false;
+	while (!stopRequested) {
+		// When the output was full, zstd may hold more output even without
+		// further input.
+		if (zstdInput.pos == zstdInput.size && !outputFull) {
+			const auto inputSize = readInput(inputChunk.data(),
+				inputChunk.size());
+			if (inputSize == 0) {
+				break;
+			}
+			zstdInput = {inputChunk.data(), inputSize, 0};
+		}
+
+		std::size_t outputSize = 0;
+		auto output = reserveOutput(outputSize);
+		ZSTD_outBuffer zstdOutput{output, outputSize, 0};
+		result = ZSTD_decompressStream(stream, &zstdOutput, &zstdInput);
+		if (ZSTD_isError(result)) {
+			throw IOError{
+				"corrupted zstd data in " + path + ": " +
+				ZSTD_getErrorName(result)
+			};
+		}
+		publishOutput(zstdOutput.pos);
+		outputFull = zstdOutput.pos == zstdOutput.size;
+	}
+
+	if (result != 0 && !stopRequested) {
+		throw IOError{"truncated zstd data in " + path};
+	}
+#endif
+}
+
+///
+/// Reads at most @a size bytes of the compressed file into @a buffer.
+///
+/// @return Number of read bytes (zero at the end of the file).
+///
+std::size_t DecompressingByteSource::readInput(char* buffer,
+		std::size_t size) {
+	input.read(buffer, static_cast<std::streamsize>(size));
+	if (input.bad()) {
+		throw IOError{"cannot read " + path};
+	}
+	return static_cast<std::size_t>(input.gcount());
+}
+
+///
+/// Returns a pointer to the free space after the decompressed bytes and
+/// stores its size into @a size.
+///
+/// Only the decompressing thread changes the list of chunks, so it can access
+/// the last chunk without locking.
+///
+char* DecompressingByteSource::reserveOutput(std::size_t& size) {
+	if (availableSize == chunks.size() * ChunkSize) {
+		// The chunk is not value-initialized, as it is going to be
+		// overwritten.
+		std::unique_ptr<char[]> chunk{new char[ChunkSize]};
+		std::lock_guard<std::mutex> lock{mutex};
+		chunks.push_back(std::move(chunk));
+	}
+
+	const auto offsetInChunk = availableSize % ChunkSize;
+	size = ChunkSize - offsetInChunk;
+	return chunks.back().get() + offsetInChunk;
+}
+
+///
+/// Makes the given number of bytes written after the decompressed ones
+/// available to readers.
+///
+void DecompressingByteSource::publishOutput(std::size_t size) {
+	if (size == 0) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+		availableSize += size;
+	}
+	availableChanged.notify_all();
+}
+
+///
+/// Waits until the bytes up to @a end have been decompressed or the
+/// decompression has finished.
+///
+/// @throws IOError When the bytes are not available because the decompression
+///                 failed.
+///
+void DecompressingByteSource::waitUntilAvailable(std::uint64_t end) const {
+	std::unique_lock<std::mutex> lock{mutex};
+	availableChanged.wait(lock, [&]() {
+		return availableSize >= end || finished;
+	});
+	if (availableSize < end && !error.empty()) {
+		throw IOError{error};
+	}
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,86 @@
+///
+/// @file      ar/internal/byte_sources/file_descriptor_byte_source.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the source of bytes read from a file
+///            descriptor.
+///
+
+#include <algorithm>
+#include <cerrno>
+#include <string>
+
+#include "ar/exceptions.h"
+#include "ar/internal/byte_sources/file_descriptor_byte_source.h"
+
+#ifdef AR_OS_WINDOWS
+#include <io.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ar {
+namespace internal {
+
+///
+/// Constructs a source of the bytes of the file open as @a fd.
+///
+/// @throws IOError When the size of the file cannot be obtained.
+///
+FileDescriptorByteSource::FileDescriptorByteSource(int fd):
+		fd{fd}, fileSize{0} {
+#ifdef AR_OS_WINDOWS
+	struct _stat64 status;
+	const auto failed = _fstat64(fd, &status) != 0;
+#else
+	struct stat status;
+	const auto failed = ::fstat(fd, &status) != 0;
+#endif
+	if (failed) {
+		throw IOError{
+			"cannot get the size of file descriptor " + std::to_string(fd)
+		};
+	}
+	fileSize = static_cast<std::uint64_t>(status.st_size);
+}
+
+FileDescriptorByteSource::~FileDescriptorByteSource() = default;
+
+std::uint64_t FileDescriptorByteSource::size() const {
+	return fileSize;
+}
+
+std::size_t FileDescriptorByteSource::readAt(std::uint64_t offset,
+		char* buffer, std::size_t length) const {
+	std::size_t count = 0;
+	while (count < length && offset + count < fileSize) {
+#ifdef AR_OS_WINDOWS
+		std::lock_guard<std::mutex> lock{readMutex};
+		const auto chunkSize = static_cast<unsigned>(
+			std::min<std::size_t>(length - count, 1u << 30));
+		const auto read = _lseeki64(fd, offset + count, SEEK_SET) < 0
+			? -1
+			: _read(fd, buffer + count, chunkSize);
+#else
+		const auto read = ::pread(fd, buffer + count, length - count,
+			static_cast<off_t>(offset + count));
+#endif
+		if (read < 0 && errno == EINTR) {
+			continue;
+		} else if (read < 0) {
+			throw IOError{
+				"cannot read file descriptor " + std::to_string(fd)
+			};
+		} else if (read == 0) {
+			break;
+		}
+		count += static_cast<std::size_t>(read);
+	}
+	return count;
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,48 @@
+///
+/// @file      ar/internal/byte_sources/mapped_file_byte_source.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the source of bytes of a file mapped into
+///            memory.
+///
+
+#include <algorithm>
+#include <cstring>
+
+#include "ar/internal/byte_sources/mapped_file_byte_source.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Constructs a source of the bytes of the file in the given path.
+///
+/// @throws IOError When the file cannot be opened or mapped.
+///
+MappedFileByteSource::MappedFileByteSource(const std::string& path):
+	mappedFile{path} {}
+
+MappedFileByteSource::~MappedFileByteSource() = default;
+
+std::uint64_t MappedFileByteSource::size() const {
+	return mappedFile.getSize();
+}
+
+std::size_t MappedFileByteSource::readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const {
+	if (offset >= mappedFile.getSize()) {
+		return 0;
+	}
+
+	const auto count = std::min<std::uint64_t>(length,
+		mappedFile.getSize() - offset);
+	std::memcpy(buffer, mappedFile.getData() + offset, count);
+	return count;
+}
+
+const char* MappedFileByteSource::data() const noexcept {
+	return mappedFile.getData();
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,46 @@
+///
+/// @file      ar/internal/byte_sources/string_byte_source.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the source of bytes stored in a string.
+///
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "ar/internal/byte_sources/string_byte_source.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Constructs a source of the given bytes.
+///
+StringByteSource::StringByteSource(std::string content):
+	content{std::move(content)} {}
+
+StringByteSource::~StringByteSource() = default;
+
+std::uint64_t StringByteSource::size() const {
+	return content.size();
+}
+
+std::size_t StringByteSource::readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const {
+	if (offset >= content.size()) {
+		return 0;
+	}
+
+	const auto count = std::min<std::uint64_t>(length,
+		content.size() - offset);
+	std::memcpy(buffer, content.data() + offset, count);
+	return count;
+}
+
+const char* StringByteSource::data() const noexcept {
+	return content.data();
+}
+
+} // namespace internal
+} // namespace ar
@@ -5,12 +5,27 @@
 /// @brief     Implementation of the extractor of files from archives.
 ///
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <utility>
 
+#include "ar/byte_source.h"
 #include "ar/exceptions.h"
 #include "ar/file.h"
+#include "ar/internal/boundary_discovery.h"
 #include "ar/internal/extractor.h"
+#include "ar/internal/files/archive_member_file.h"
+#include "ar/internal/files/filesystem_range_file.h"
+#include "ar/internal/files/pmr_string_file.h"
+#include "ar/internal/files/resource_allocated_file.h"
 #include "ar/internal/files/string_file.h"
+#include "ar/internal/utilities/crc32c.h"
+#include "ar/internal/utilities/thread_pool.h"
+#include "ar/internal/utilities/tracing.h"
 
 using namespace std::literals::string_literals;
 
@@ -22,10 +37,163 @@ namespace {
 const auto MagicString = "!<arch>\n"s;
 const auto FileHeaderEnd = "`\n"s;
 
+/// Size of the field containing the name of a file in a file header.
+const std::size_t NameFieldSize = 16;
+
+/// Positions and sizes of the fields of a file header following the name.
+const std::size_t TimestampFieldOffset = 16;
+const std::size_t TimestampFieldSize = 12;
+const std::size_t OwnerIdFieldOffset = 28;
+const std::size_t OwnerIdFieldSize = 6;
+const std::size_t GroupIdFieldOffset = 34;
+const std::size_t GroupIdFieldSize = 6;
+const std::size_t ModeFieldOffset = 40;
+const std::size_t ModeFieldSize = 8;
+const std::size_t SizeFieldOffset = 48;
+const std::size_t SizeFieldSize = 10;
+
+///
+/// Parses the given number in the given base.
+///
+/// @return @c false when the number contains a digit that is invalid in the
+///         base.
+///
+bool parseNumber(std::string_view numAsStr, std::size_t base,
+		std::size_t& number) {
+	number = 0;
+	for (auto c : numAsStr) {
+		const auto digit = static_cast<std::size_t>(c - '0');
+		if (digit >= base) {
+			return false;
+		}
+		number = number * base + digit;
+	}
+	return true;
+}
+
+///
+/// Reads a number from a fixed-size header field in which the number is
+/// padded by spaces.
+///
+bool readNumberFromField(std::string_view field, std::size_t base,
+		std::size_t& number) {
+	const auto end = field.find(' ');
+	const auto digits = field.substr(0, end);
+	if (digits.empty() || (end != std::string_view::npos &&
+			field.find_first_not_of(' ', end) != std::string_view::npos)) {
+		return false;
+	}
+	return std::all_of(digits.begin(), digits.end(),
+		[](char c) { return std::isdigit(static_cast<unsigned char>(c)); }) &&
+		parseNumber(digits, base, number);
+}
+
+/// Contents larger than this are copied by several tasks in parallel.
+const std::size_t ParallelCopyChunkSize = 1024 * 1024;
+
+/// Size of the chunks in which the content of members is read from sources
+/// to compute checksums.
+const std::size_t SourceChunkSize = 1024 * 1024;
+
+///
+/// Members of an archive, together with the members of the archives nested
+/// in it.
+///
+struct ExpandedArchive {
+	/// Members of the archive.
+	Members members;
+
+	/// For every member, the expanded archive that the member contains (the
+	/// null pointer when the member is not an archive).
+	std::vector<std::unique_ptr<ExpandedArchive>> nestedArchives;
+};
+
+///
+/// Is the given member of the archive with the given content an archive?
+///
+bool isNestedArchive(std::string_view content, const Member& member) {
+	return member.size >= MagicString.size() &&
+		content.substr(member.offset, MagicString.size()) == MagicString;
+}
+
+void expandArchivesNestedIn(std::string_view content,
+	ExpandedArchive& archive, ThreadPool* pool);
+
+///
+/// Scans the archive stored in the given member of the archive with the given
+/// content into @a nested, and expands the archives nested in it.
+///
+/// The nested archive is parsed in place, as a range of the content. The
+/// offsets of its members are made relative to the content, and their names
+/// are prefixed by the name of the member.
+///
+void expandNestedArchive(std::string_view content, const Member& member,
+		ExpandedArchive& nested, ThreadPool* pool) {
+	Extractor extractor;
+	try {
+		extractor.scan(
+			ArchiveBuffer::fromView(content.substr(member.offset, member.size)),
+			[&](Member&& nestedMember) {
+				nestedMember.offset += member.offset;
+				nestedMember.name = member.name + '/' + nestedMember.name;
+				nested.members.push_back(std::move(nestedMember));
+			}
+		);
+	} catch (const InvalidArchiveError& ex) {
+		throw InvalidArchiveError{
+			"invalid nested archive " + member.name + ": " + ex.what()
+		};
+	}
+	expandArchivesNestedIn(content, nested, pool);
+}
+
+///
+/// Expands the archives nested in the given archive, whose members are
+/// relative to the given content.
+///
+/// Every nested archive is expanded by a task of its own, which expands the
+/// archives nested in it in the same way. The caller has to wait for the
+/// tasks of the pool to finish.
+///
+void expandArchivesNestedIn(std::string_view content,
+		ExpandedArchive& archive, ThreadPool* pool) {
+	archive.nestedArchives.resize(archive.members.size());
+	for (std::size_t k = 0; k < archive.members.size(); ++k) {
+		if (!isNestedArchive(content, archive.members[k])) {
+			continue;
+		}
+
+		archive.nestedArchives[k] = std::make_unique<ExpandedArchive>();
+		auto expand = [content, &member = archive.members[k],
+				&nested = *archive.nestedArchives[k], pool]() {
+			expandNestedArchive(content, member, nested, pool);
+		};
+		if (pool) {
+			pool->submit(expand);
+		} else {
+			expand();
+		}
+	}
+}
+
+///
+/// Appends the members of the given archive to @a members, replacing the
+/// members that are archives by their members.
+///
+void appendExpandedMembers(ExpandedArchive& archive, Members& members) {
+	for (std::size_t k = 0; k < archive.members.size(); ++k) {
+		if (archive.nestedArchives[k]) {
+			appendExpandedMembers(*archive.nestedArchives[k], members);
+		} else {
+			members.push_back(std::move(archive.members[k]));
+		}
+	}
+}
+
 } // anonymous namespace
 
 Extractor::Extractor():
-	content(), i(0) {}
+	content(), i(0), checksumsEnabled(false), memoryResource(nullptr) {}
 
 Extractor::~Extractor() = default;
 
@@ -34,19 +202,313 @@ Extractor::~Extractor() = default;
 ///
 /// @throws InvalidArchiveError when the archive is invalid.
 ///
-Files Extractor::extract(const std::string& archiveContent) {
-	initializeWith(archiveContent);
-	readMagicString();
-	readLookupTable();
-	readFileNameTable();
-	auto files = readFiles();
-	return files;
+Files Extractor::extract(std::string archiveContent) {
+	return extract(std::move(archiveContent), ExtractionOptions());
+}
+
+///
+/// Extracts files from the given archive content by using the given options.
+///
+/// The extraction runs in two phases. First, the headers are walked in order
+/// to obtain the members of the archive (see scan()). Then, the files are
+/// materialized, possibly in parallel.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+Files Extractor::extract(std::string archiveContent,
+		const ExtractionOptions& options) {
+	return extract(ArchiveBuffer::fromContent(std::move(archiveContent)),
+		options);
+}
+
+///
+/// Extracts files from the given archive by using the given options.
+///
+/// When the options demand sharing of the archive content, the files refer to
+/// the archive instead of holding copies of their content. Otherwise, when
+/// the options specify a memory budget and the archive is mapped from a
+/// filesystem, the files are kept in memory only as long as their total size
+/// fits into the budget. The remaining files read their content from the
+/// archive on demand.
+///
+/// When the options demand a recursive extraction, the members that are
+/// archives are replaced by their members (see expandNestedArchives()), so
+/// the files of all nested archives are materialized from the content of the
+/// outermost archive in the same way as its other files.
+///
+/// @throws InvalidArchiveError when the archive or an archive nested in it is
+///         invalid.
+///
+Files Extractor::extract(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options) {
+	auto pool = poolFor(options);
+	scanUsing(std::move(archive), options, pool, scannedMembers);
+	if (options.recursive) {
+		TraceSpan span{"expandNestedArchives"};
+		const auto phase = stats.startPhase(&ExtractionStats::expandTime,
+			&ExtractionStats::expandMemory);
+		expandNestedArchives(scannedMembers, pool);
+	}
+	memoryResource = options.memoryResource;
+	TraceSpan span{"materialize"};
+	const auto phase = stats.startPhase(&ExtractionStats::materializeTime,
+		&ExtractionStats::materializeMemory);
+	if (options.shareArchiveContent) {
+		return materializeAsArchiveMembers(scannedMembers);
+	} else if (options.memoryBudget > 0 && !this->archive->getPath().empty()) {
+		return materializeWithinBudget(scannedMembers, options.memoryBudget,
+			pool);
+	}
+	return materialize(scannedMembers, pool);
+}
+
+///
+/// Reads only the headers of the given archive and returns its members.
+///
+/// The content of the members is not copied, only its position in the archive
+/// is recorded.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+Members Extractor::scan(std::string archiveContent) {
+	return scan(std::move(archiveContent), ExtractionOptions());
+}
+
+///
+/// Reads only the headers of the given archive by using the given options and
+/// returns its members.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+Members Extractor::scan(std::string archiveContent,
+		const ExtractionOptions& options) {
+	return scan(ArchiveBuffer::fromContent(std::move(archiveContent)),
+		options);
 }
 
-void Extractor::initializeWith(const std::string& archiveContent) {
-	content = archiveContent;
+///
+/// Reads only the headers of the given archive by using the given options and
+/// returns its members.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+Members Extractor::scan(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options) {
+	Members members;
+	scanUsing(std::move(archive), options, poolFor(options), members);
+	return members;
+}
+
+///
+/// Reads the headers of the given archive and calls @a handler for every
+/// member, right after its header has been read.
+///
+/// The content of the archive is available through getArchiveContent() from
+/// the first call of the handler until the next scan or extraction.
+///
+/// @throws InvalidArchiveError when the archive is invalid. Members found
+///         before the error have already been passed to the handler.
+///
+void Extractor::scan(std::string archiveContent,
+		const MemberHandler& handler) {
+	scan(ArchiveBuffer::fromContent(std::move(archiveContent)), handler);
+}
+
+///
+/// Reads the headers of the given archive and calls @a handler for every
+/// member, right after its header has been read.
+///
+/// @throws InvalidArchiveError when the archive is invalid. Members found
+///         before the error have already been passed to the handler.
+///
+void Extractor::scan(std::shared_ptr<const ArchiveBuffer> archive,
+		const MemberHandler& handler) {
+	initializeWith(std::move(archive), ExtractionOptions());
+	readHeadersBeforeMembers();
+	readMembers(handler);
+}
+
+///
+/// Reads only the headers of the given archive by using the given options and
+/// returns its members in a table.
+///
+/// Contrary to scan(), the members are stored right into the columns of the
+/// table, without building a vector of members first (unless the headers are
+/// scanned speculatively).
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+///
+MemberTable Extractor::scanIntoTable(
+		std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options) {
+	MemberTable table;
+	if (options.speculativeHeaderScan) {
+		// The phase is measured by scanUsing().
+		scanUsing(std::move(archive), options, poolFor(options),
+			scannedMembers);
+		table.reserve(scannedMembers.size());
+		for (const auto& member : scannedMembers) {
+			appendToTable(table, member);
+		}
+	} else {
+		initializeWith(std::move(archive), options);
+		TraceSpan span{"scan"};
+		const auto phase = stats.startPhase(&ExtractionStats::scanTime,
+			&ExtractionStats::scanMemory);
+		readHeadersBeforeMembers();
+		readMembers([this, &table](Member&& member) {
+			appendToTable(table, member);
+		});
+	}
+	table.setArchive(this->archive);
+	return table;
+}
+
+///
+/// Reads only the headers of the archive in the given source by using the
+/// given options and returns its members in a table.
+///
+/// When the bytes of the source are in memory, they are scanned without
+/// copying, like an archive in a buffer. Otherwise, only the headers and the
+/// filename table are read from the source, each of them by a single
+/// positioned read, and the content of members is skipped (unless checksums
+/// are computed; otherwise, only the last byte of each member is read to
+/// check that the source is not truncated). The size of the source is not
+/// asked for, so the source may still be produced while it is scanned. The
+/// table then reads the content of members from the
+/// source on demand. In this case, the headers have to have the fixed 60-byte
+/// layout, the options concerning threads are ignored, and the content of
+/// the last scanned archive is not available through getArchiveContent().
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when the source cannot be read.
+///
+MemberTable Extractor::scanIntoTable(std::shared_ptr<const ByteSource> source,
+		const ExtractionOptions& options) {
+	if (source->data()) {
+		return scanIntoTable(ArchiveBuffer::fromByteSource(std::move(source)),
+			options);
+	}
+
+	archive.reset();
+	fileNameTable.clear();
+	checksumsEnabled = options.computeChecksums;
+	stats = StatsRecorder{options.stats};
+	TraceSpan span{"scan"};
+	const auto phase = stats.startPhase(&ExtractionStats::scanTime,
+		&ExtractionStats::scanMemory);
+	MemberTable table;
+	readSourceMembers(*source, [this, &table](Member&& member) {
+		appendToTable(table, member);
+	});
+	table.setSource(std::move(source));
+	return table;
+}
+
+///
+/// Reads the headers of the archive in the given source and calls @a handler
+/// for every member, right after its header has been read.
+///
+/// When the bytes of the source are not in memory, the offsets of members
+/// are offsets into the source, and the content of a member is in the source
+/// by the time the member is passed to the handler. The source is read as
+/// in scanIntoTable(), so reading of a source that is still being produced
+/// (e.g. decompressed) is overlapped with the handling of members.
+///
+/// @throws InvalidArchiveError when the archive is invalid. Members found
+///         before the error have already been passed to the handler.
+/// @throws IOError when the source cannot be read.
+///
+void Extractor::scan(std::shared_ptr<const ByteSource> source,
+		const MemberHandler& handler) {
+	if (source->data()) {
+		scan(ArchiveBuffer::fromByteSource(std::move(source)), handler);
+		return;
+	}
+
+	archive.reset();
+	fileNameTable.clear();
+	checksumsEnabled = false;
+	stats = StatsRecorder{};
+	readSourceMembers(*source, handler);
+}
+
+///
+/// Returns the content of the last scanned or extracted archive.
+///
+std::string_view Extractor::getArchiveContent() const noexcept {
+	return content;
+}
+
+///
+/// Forgets the last scanned or extracted archive.
+///
+/// The memory held for scanning (such as the filename table or the list of
+/// members) and the pool of threads are kept, so subsequent extractions do
+/// not need to allocate them again.
+///
+void Extractor::reset() noexcept {
+	archive.reset();
+	content = {};
+	i = 0;
+	fileNameTable.clear();
+	memoryResource = nullptr;
+	checksumsEnabled = false;
+	stats = StatsRecorder{};
+	scannedMembers.clear();
+}
+
+///
+/// Returns a pool of threads to be used for the given options.
+///
+/// The pool is created on the first use and reused as long as the number of
+/// threads stays the same. When the options demand a single thread, the null
+/// pointer is returned.
+///
+ThreadPool* Extractor::poolFor(const ExtractionOptions& options) {
+	const auto threadCount = options.threadCount == 0
+		? ThreadPool::defaultThreadCount()
+		: options.threadCount;
+	if (!pool || pool->getThreadCount() + 1 != threadCount) {
+		pool = createPoolForCaller(threadCount);
+	}
+	return pool.get();
+}
+
+void Extractor::initializeWith(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options) {
+	this->archive = std::move(archive);
+	content = this->archive->getContent();
 	i = 0;
 	fileNameTable.clear();
+	checksumsEnabled = options.computeChecksums;
+	stats = StatsRecorder{options.stats};
+}
+
+void Extractor::scanUsing(std::shared_ptr<const ArchiveBuffer> archive,
+		const ExtractionOptions& options, ThreadPool* pool, Members& members) {
+	initializeWith(std::move(archive), options);
+	TraceSpan span{"scan"};
+	const auto phase = stats.startPhase(&ExtractionStats::scanTime,
+		&ExtractionStats::scanMemory);
+	readHeadersBeforeMembers();
+
+	members.clear();
+	if (options.speculativeHeaderScan) {
+		if (readMembersSpeculatively(pool, members)) {
+			return;
+		}
+		// The speculation failed, so fall back to the serial walk, which
+		// either succeeds or reports the precise cause of the failure.
+		members.clear();
+	}
+	readMembers(members);
+}
+
+void Extractor::readHeadersBeforeMembers() {
+	readMagicString();
+	readLookupTable();
+	readFileNameTable();
 }
 
 void Extractor::readMagicString() {
@@ -58,21 +520,24 @@ void Extractor::readMagicString() {
 }
 
 void Extractor::readLookupTable() {
-	// In the GNU format, the special file name '/' denotes a lookup table.
-	// However, we need to ensure that it is just a standalone '/' because "//"
-	// denotes the start of a filename table.
+	// In the GNU format, the special file name '/' (or "/SYM64/" when the
+	// offsets in the table have 64 bits) denotes a lookup table. However, we
+	// need to ensure that it is not "//", which denotes the start of a
+	// filename table.
 	if (hasLookupTableAt(i)) {
 		// The lookup table has the same format as a file. However, as we do
 		// not need it, throw it away after reading (i.e. do not store its
 		// content).
-		++i;
+		i += NameFieldSize;
+		stats.addParsedHeaders(1);
 		readFileTimestamp();
 		readFileOwnerId();
 		readFileGroupId();
 		readFileMode();
 		auto fileSize = readFileSize();
 		readUntilEndOfFileHeader();
-		readFileContent(fileSize);
+		skipFileContent(fileSize);
+		skipFileContentPadding(fileSize);
 	}
 }
 
@@ -99,6 +564,7 @@ void Extractor::readFileNameTable() {
 	// filename table.
 	if (content.substr(i, 2) == "//") {
 		i += 2;
+		stats.addParsedHeaders(1);
 		const auto tableSize = readNumber("filename table size");
 		readUntilEndOfFileHeader();
 		const auto tableStart = i;
@@ -115,32 +581,154 @@ void Extractor::readFileNameIntoFileNameTable(std::size_t tableStart) {
 	//   module.o/
 	//
 	const auto tableIndex = i - tableStart;
-	auto fileName = readFileNameEndedWithSlash();
-	fileNameTable.emplace(tableIndex, std::move(fileName));
+	// The indexes grow, so the table stays sorted.
+	fileNameTable.emplace_back(tableIndex, readFileNameEndedWithSlash());
 
 	// Skip separators/padding.
 	skipEndsOfLines();
 }
 
-Files Extractor::readFiles() {
-	Files files;
+void Extractor::readMembers(Members& members) {
+	readMembers([&members](Member&& member) {
+		members.push_back(std::move(member));
+	});
+}
+
+void Extractor::readMembers(const MemberHandler& handler) {
 	while (i < content.size()) {
-		files.push_back(readFile());
+		handler(readMember());
 	}
-	return files;
 }
 
-std::unique_ptr<File> Extractor::readFile() {
-	auto fileName = readFileName();
-	readFileTimestamp();
-	readFileOwnerId();
-	readFileGroupId();
-	readFileMode();
-	auto fileSize = readFileSize();
-	readUntilEndOfFileHeader();
-	auto fileContent = readFileContent(fileSize);
+bool Extractor::readMembersSpeculatively(ThreadPool* pool,
+		Members& members) {
+	// The headers are chained (the position of a header is given by the sizes
+	// of the preceding members), which forces a serial walk. To avoid it, scan
+	// the archive in parallel for anything that looks like a header, and then
+	// verify that the candidates form a chain covering the whole archive. Only
+	// headers with the fixed 60-byte layout are supported this way.
+	const auto candidates = findHeaderCandidatesInParallel(content, i, pool);
+	HeaderCandidates chain;
+	if (!stitchHeaderChain(content, i, candidates, chain)) {
+		return false;
+	}
+
+	members.resize(chain.size());
+	std::atomic<bool> allNamesValid{true};
+	auto readMembersInRange = [&](std::size_t from, std::size_t to) {
+		for (auto k = from; k < to; ++k) {
+			auto& member = members[k];
+			if (!readMemberNameAt(chain[k].offset, member.name) ||
+					!readMemberMetadataAt(chain[k].offset, member)) {
+				allNamesValid = false;
+			}
+			member.offset = chain[k].offset + MemberHeaderSize;
+			member.size = chain[k].size;
+			if (checksumsEnabled) {
+				member.checksum = crc32c(
+					content.substr(member.offset, member.size));
+			}
+		}
+	};
 
-	return std::make_unique<StringFile>(fileContent, fileName);
+	const std::size_t BlockSize = 1024;
+	if (pool && chain.size() > BlockSize) {
+		for (std::size_t from = 0; from < chain.size(); from += BlockSize) {
+			const auto to = std::min(from + BlockSize, chain.size());
+			pool->submit([&readMembersInRange, from, to]() {
+				readMembersInRange(from, to);
+			});
+		}
+		pool->wait();
+	} else {
+		readMembersInRange(0, chain.size());
+	}
+
+	if (!allNamesValid) {
+		return false;
+	}
+	i = content.size();
+	stats.addParsedHeaders(chain.size());
+	if (stats.isRecording()) {
+		// The names have been read in parallel, so the lookups into the
+		// filename table are counted afterwards.
+		stats.addNameTableHits(static_cast<std::size_t>(std::count_if(
+			chain.begin(), chain.end(), [this](const auto& candidate) {
+				return hasNameSpecifiedViaIndexIntoFileNameTableAt(
+					candidate.offset);
+			})));
+	}
+	return true;
+}
+
+bool Extractor::readMemberNameAt(std::size_t offset, std::string& name) const {
+	// Contrary to the serial walk, the name has to be fully contained in the
+	// 16-byte name field of the header, followed by spaces only.
+	const auto field = content.data() + offset;
+	auto isPaddedBySpacesFrom = [field](std::size_t j) {
+		return std::all_of(field + j, field + NameFieldSize,
+			[](char c) { return c == ' '; });
+	};
+
+	if (hasNameSpecifiedViaIndexIntoFileNameTableAt(offset)) {
+		std::size_t j = 1;
+		std::size_t index = 0;
+		while (j < NameFieldSize &&
+				std::isdigit(static_cast<unsigned char>(field[j]))) {
+			index = index * 10 + static_cast<std::size_t>(field[j] - '0');
+			++j;
+		}
+		auto it = findInFileNameTable(index);
+		if (it == fileNameTable.end() || !isPaddedBySpacesFrom(j)) {
+			return false;
+		}
+		name = it->second;
+		return true;
+	}
+
+	const auto slash = std::find(field, field + NameFieldSize, '/');
+	if (slash == field || slash == field + NameFieldSize ||
+			!isPaddedBySpacesFrom(slash - field + 1)) {
+		return false;
+	}
+	name.assign(field, slash);
+	return true;
+}
+
+bool Extractor::readMemberMetadataAt(std::size_t offset,
+		Member& member) const {
+	const auto header = content.substr(offset, MemberHeaderSize);
+	return readNumberFromField(
+			header.substr(TimestampFieldOffset, TimestampFieldSize),
+			10, member.timestamp) &&
+		readNumberFromField(
+			header.substr(OwnerIdFieldOffset, OwnerIdFieldSize),
+			10, member.ownerId) &&
+		readNumberFromField(
+			header.substr(GroupIdFieldOffset, GroupIdFieldSize),
+			10, member.groupId) &&
+		readNumberFromField(
+			header.substr(ModeFieldOffset, ModeFieldSize),
+			8, member.mode);
+}
+
+Member Extractor::readMember() {
+	stats.addParsedHeaders(1);
+	Member member;
+	member.name = readFileName();
+	member.timestamp = readFileTimestamp();
+	member.ownerId = readFileOwnerId();
+	member.groupId = readFileGroupId();
+	member.mode = readFileMode();
+	member.size = readFileSize();
+	readUntilEndOfFileHeader();
+	member.offset = i;
+	skipFileContent(member.size);
+	if (checksumsEnabled) {
+		member.checksum = crc32c(content.substr(member.offset, member.size));
+	}
+	skipFileContentPadding(member.size);
+	return member;
 }
 
 std::string Extractor::readFileName() {
@@ -156,9 +744,10 @@ std::string Extractor::readFileName() {
 	if (hasNameSpecifiedViaIndexIntoFileNameTableAt(i)) {
 		++i;
 		const auto index = readNumber("index into filename table");
+		stats.addNameTableHits(1);
 		return nameFromFileNameTableOnIndex(index);
 	} else {
-		return readFileNameEndedWithSlash();
+		return std::string{readFileNameEndedWithSlash()};
 	}
 }
 
@@ -168,42 +757,61 @@ bool Extractor::hasNameSpecifiedViaIndexIntoFileNameTableAt(std::size_t j) const
 	//   /X
 	//
 	// where X is a number (the index).
-	return isValid(j + 1) && content[j] == '/' && std::isdigit(content[j + 1]);
+	return isValid(j + 1) && content[j] == '/' &&
+		std::isdigit(static_cast<unsigned char>(content[j + 1]));
 }
 
-std::string Extractor::readFileNameEndedWithSlash() {
+std::string_view Extractor::readFileNameEndedWithSlash() {
 	auto pos = content.find('/', i);
 	ensureContainsSlashOnPosition(pos);
-	auto fileName = content.substr(i, pos - i);
+	const auto fileName = content.substr(i, pos - i);
 	ensureFileNameIsNonEmpty(fileName);
 	i = pos + 1;
 	return fileName;
 }
 
 std::string Extractor::nameFromFileNameTableOnIndex(std::size_t index) const {
-	auto it = fileNameTable.find(index);
+	auto it = findInFileNameTable(index);
 	ensureIsValidFileNameTableIndex(it, index);
-	return it->second;
+	return std::string{it->second};
 }
 
-void Extractor::readFileTimestamp() {
-	// Currently unused.
-	readNumber("timestamp");
+auto Extractor::findInFileNameTable(std::size_t index) const
+		-> FileNameTable::const_iterator {
+	auto it = std::lower_bound(fileNameTable.begin(), fileNameTable.end(),
+		index, [](const FileNameTable::value_type& entry, std::size_t index) {
+			return entry.first < index;
+		});
+	return it != fileNameTable.end() && it->first == index
+		? it
+		: fileNameTable.end();
 }
 
-void Extractor::readFileOwnerId() {
-	// Currently unused.
-	readNumber("file owner ID");
+std::size_t Extractor::readFileTimestamp() {
+	return readNumber("timestamp");
 }
 
-void Extractor::readFileGroupId() {
-	// Currently unused.
-	readNumber("file group ID");
+std::size_t Extractor::readFileOwnerId() {
+	return readNumber("file owner ID");
 }
 
-void Extractor::readFileMode() {
-	// Currently unused.
+std::size_t Extractor::readFileGroupId() {
+	return readNumber("file group ID");
+}
+
+std::size_t Extractor::readFileMode() {
+	// The mode is stored in the octal notation.
+	const auto start = i;
 	readNumber("file mode");
+	const auto modeAsStr = content.substr(start, i - start);
+	std::size_t mode = 0;
+	if (!parseNumber(modeAsStr.substr(modeAsStr.find_first_not_of(' ')), 8,
+			mode)) {
+		throw InvalidArchiveError{
+			"invalid file mode: " + std::string{modeAsStr}
+		};
+	}
+	return mode;
 }
 
 std::size_t Extractor::readFileSize() {
@@ -216,11 +824,363 @@ void Extractor::readUntilEndOfFileHeader() {
 	i = pos + FileHeaderEnd.size();
 }
 
-std::string Extractor::readFileContent(std::size_t fileSize) {
-	auto fileContent = content.substr(i, fileSize);
-	ensureContentOfGivenSizeWasRead(fileContent.size(), fileSize);
+void Extractor::skipFileContent(std::size_t fileSize) {
+	const auto availableSize = content.size() - std::min(i, content.size());
+	ensureContentOfGivenSizeWasRead(std::min(fileSize, availableSize),
+		fileSize);
 	i += fileSize;
-	return fileContent;
+}
+
+void Extractor::skipFileContentPadding(std::size_t fileSize) {
+	// In the GNU format, the content of every file is padded to an even size
+	// by a '\n'.
+	if (fileSize % 2 == 1 && isValid(i) && content[i] == '\n') {
+		++i;
+	}
+}
+
+void Extractor::readSourceMembers(const ByteSource& source,
+		const MemberHandler& handler) {
+	sourceHeader.resize(MagicString.size());
+	const auto magicStringSize = source.readAt(0, &sourceHeader[0],
+		sourceHeader.size());
+	stats.addBytesRead(magicStringSize);
+	if (magicStringSize != sourceHeader.size() ||
+			sourceHeader != MagicString) {
+		throw InvalidArchiveError{"missing magic string"};
+	}
+
+	// The size of the source is not needed (it may not be known before the
+	// whole source is read, e.g. when it is being decompressed). The archive
+	// ends where no more header follows.
+	//
+	// The header that is being parsed is the content, so the functions used
+	// by the speculative scan can parse it.
+	bool memberFound = false;
+	std::uint64_t offset = MagicString.size();
+	std::size_t size = 0;
+	while (readSourceHeaderAt(source, offset, size)) {
+		const auto contentOffset = offset + MemberHeaderSize;
+		stats.addParsedHeaders(1);
+		if (offset == MagicString.size() && hasLookupTableAt(0)) {
+			// The lookup table is not needed.
+			ensureSourceContains(source, contentOffset, size);
+		} else if (!memberFound && content.substr(0, 2) == "//") {
+			readSourceFileNameTable(source, contentOffset, size);
+		} else {
+			Member member;
+			if (!readMemberNameAt(0, member.name) ||
+					!readMemberMetadataAt(0, member)) {
+				throw InvalidArchiveError{
+					"invalid header of member at offset " +
+					std::to_string(offset)
+				};
+			}
+			if (hasNameSpecifiedViaIndexIntoFileNameTableAt(0)) {
+				stats.addNameTableHits(1);
+			}
+			member.offset = contentOffset;
+			member.size = size;
+			if (checksumsEnabled) {
+				member.checksum = computeSourceChecksum(source, member);
+			} else {
+				ensureSourceContains(source, contentOffset, size);
+			}
+			memberFound = true;
+			handler(std::move(member));
+		}
+
+		// In the GNU format, the content of every file is padded to an even
+		// size by a '\n'.
+		offset = contentOffset + size;
+		char padding = '\0';
+		if (size % 2 == 1 && source.readAt(offset, &padding, 1) == 1) {
+			stats.addBytesRead(1);
+			if (padding == '\n') {
+				++offset;
+			}
+		}
+	}
+
+	content = {};
+	i = 0;
+}
+
+///
+/// Reads the header at the given offset of the source into the content and
+/// stores the size of the member from the header into @a size.
+///
+/// @return @c false when the source ends at the offset, @c true otherwise.
+///
+bool Extractor::readSourceHeaderAt(const ByteSource& source,
+		std::uint64_t offset, std::size_t& size) {
+	sourceHeader.resize(MemberHeaderSize);
+	const auto readSize = source.readAt(offset, &sourceHeader[0],
+		sourceHeader.size());
+	stats.addBytesRead(readSize);
+	if (readSize == 0) {
+		return false;
+	}
+	ensureContentOfGivenSizeWasRead(readSize, sourceHeader.size());
+	content = sourceHeader;
+	i = 0;
+	if (content.substr(MemberHeaderSize - FileHeaderEnd.size()) !=
+			FileHeaderEnd) {
+		throw InvalidArchiveError{"missing end of file header"};
+	}
+
+	const auto sizeField = content.substr(SizeFieldOffset, SizeFieldSize);
+	if (!readNumberFromField(sizeField, 10, size)) {
+		throw InvalidArchiveError{
+			"invalid file size: " + std::string{sizeField}
+		};
+	}
+	return true;
+}
+
+///
+/// Ensures that the source contains @a size bytes from the given offset.
+///
+/// Only the last of the bytes is read, so the content of the member is not
+/// read.
+///
+void Extractor::ensureSourceContains(const ByteSource& source,
+		std::uint64_t offset, std::size_t size) {
+	if (size == 0) {
+		return;
+	}
+
+	char lastByte = '\0';
+	const auto readSize = source.readAt(offset + size - 1, &lastByte, 1);
+	stats.addBytesRead(readSize);
+	if (readSize == 0) {
+		throw InvalidArchiveError{
+			"premature end of file (expected " + std::to_string(size) +
+			" bytes at offset " + std::to_string(offset) + ")"
+		};
+	}
+}
+
+void Extractor::readSourceFileNameTable(const ByteSource& source,
+		std::uint64_t offset, std::size_t tableSize) {
+	// The header is followed by the table, so the table can be read in the
+	// same way as from an archive in memory.
+	sourceFileNameTable.assign(sourceHeader);
+	sourceFileNameTable.resize(MemberHeaderSize + tableSize);
+	const auto readSize = source.readAt(offset,
+		&sourceFileNameTable[MemberHeaderSize], tableSize);
+	stats.addBytesRead(readSize);
+	ensureContentOfGivenSizeWasRead(readSize, tableSize);
+	content = sourceFileNameTable;
+	i = 0;
+	readFileNameTable();
+}
+
+std::uint32_t Extractor::computeSourceChecksum(const ByteSource& source,
+		const Member& member) {
+	std::uint32_t checksum = 0;
+	for (std::size_t read = 0; read < member.size; read += sourceChunk.size()) {
+		sourceChunk.resize(std::min(member.size - read, SourceChunkSize));
+		const auto readSize = source.readAt(member.offset + read,
+			&sourceChunk[0], sourceChunk.size());
+		stats.addBytesRead(readSize);
+		ensureContentOfGivenSizeWasRead(readSize, sourceChunk.size());
+		checksum = crc32c(sourceChunk, checksum);
+	}
+	return checksum;
+}
+
+///
+/// Returns an empty container for @a count files.
+///
+Files Extractor::createFiles(std::size_t count) const {
+	Files files;
+	files.reserve(count);
+	return files;
+}
+
+///
+/// Creates a file of the given type, allocated from the memory resource of the
+/// extraction (or from the heap when there is no resource).
+///
+template <typename FileType, typename... Args>
+std::unique_ptr<File> Extractor::createFile(Args&&... args) const {
+	if (!memoryResource) {
+		return std::make_unique<FileType>(std::forward<Args>(args)...);
+	}
+	return std::unique_ptr<File>{
+		new (memoryResource) ResourceAllocatedFile<FileType>(
+			std::forward<Args>(args)...)
+	};
+}
+
+///
+/// Replaces the scanned members that are archives (i.e. their content starts
+/// with the magic string) by their members, recursively.
+///
+/// The nested archives are parsed in place, without copying them out of the
+/// content of the archive, and in parallel when a pool is given. Names of
+/// their members are prefixed by the name of the nested archive and a slash
+/// (e.g. @c libouter.a/inner.o), and their offsets point into the content of
+/// the outermost archive. The order of the members follows the order in the
+/// archives.
+///
+/// @throws InvalidArchiveError when a nested archive is invalid.
+///
+void Extractor::expandNestedArchives(Members& members, ThreadPool* pool) {
+	ExpandedArchive expanded;
+	expanded.members = std::move(members);
+	expandArchivesNestedIn(content, expanded, pool);
+	if (pool) {
+		pool->wait();
+	}
+
+	members.clear();
+	appendExpandedMembers(expanded, members);
+}
+
+Files Extractor::materialize(Members& members, ThreadPool* pool) {
+	// Memory resources do not have to be thread-safe, so the files are
+	// allocated from them only in the calling thread.
+	if (!pool || members.empty() || memoryResource) {
+		return materializeSerially(members);
+	}
+	return materializeInParallel(members, *pool);
+}
+
+Files Extractor::materializeSerially(Members& members) {
+	auto files = createFiles(members.size());
+	for (auto& member : members) {
+		TraceSpan span{"readMember", member.name};
+		const auto memberContent = content.substr(member.offset, member.size);
+		stats.addAllocations(member.size > 0 ? 2 : 1);
+		stats.addBytesCopied(member.size);
+		if (memoryResource) {
+			files.push_back(createFile<PmrStringFile>(
+				memberContent,
+				member.name,
+				memoryResource
+			));
+		} else {
+			files.push_back(std::make_unique<StringFile>(
+				std::string{memberContent},
+				std::move(member.name)
+			));
+		}
+	}
+	return files;
+}
+
+Files Extractor::materializeAsArchiveMembers(Members& members) {
+	// No content is copied, so there is nothing to be done in parallel.
+	auto files = createFiles(members.size());
+	stats.addAllocations(members.size());
+	for (auto& member : members) {
+		files.push_back(createFile<ArchiveMemberFile>(
+			archive,
+			member.offset,
+			member.size,
+			member.name,
+			memoryResource
+				? memoryResource
+				: std::pmr::new_delete_resource()
+		));
+	}
+	return files;
+}
+
+void Extractor::appendToTable(MemberTable& table,
+		const Member& member) const {
+	table.append(
+		member.name,
+		member.offset,
+		member.size,
+		member.timestamp,
+		static_cast<std::uint32_t>(member.ownerId),
+		static_cast<std::uint32_t>(member.groupId),
+		static_cast<std::uint32_t>(member.mode)
+	);
+	if (checksumsEnabled) {
+		table.appendChecksum(member.checksum);
+	}
+}
+
+Files Extractor::materializeWithinBudget(Members& members,
+		std::size_t memoryBudget, ThreadPool* pool) {
+	// Members are copied into memory for as long as their total size fits
+	// into the budget. The remaining ones (typically the huge ones) are read
+	// from the archive only when their content is requested.
+	Members inMemoryMembers;
+	std::vector<bool> isInMemory(members.size(), false);
+	std::size_t usedMemory = 0;
+	for (std::size_t k = 0; k < members.size(); ++k) {
+		if (members[k].size <= memoryBudget - usedMemory) {
+			usedMemory += members[k].size;
+			isInMemory[k] = true;
+			inMemoryMembers.push_back(std::move(members[k]));
+		}
+	}
+
+	auto inMemoryFiles = materialize(inMemoryMembers, pool);
+	auto inMemoryFile = inMemoryFiles.begin();
+	auto files = createFiles(members.size());
+	for (std::size_t k = 0; k < members.size(); ++k) {
+		if (isInMemory[k]) {
+			files.push_back(std::move(*inMemoryFile++));
+		} else {
+			stats.addAllocations(1);
+			files.push_back(createFile<FilesystemRangeFile>(
+				archive->getPath(),
+				members[k].offset,
+				members[k].size,
+				std::move(members[k].name)
+			));
+		}
+	}
+	return files;
+}
+
+Files Extractor::materializeInParallel(Members& members, ThreadPool& pool) {
+	// Every member gets its own task. Large members split their copying into
+	// chunks that are submitted from within the task, so idle workers can
+	// steal them. In this way, a few huge members do not leave the other
+	// workers without work.
+	std::vector<std::string> contents(members.size());
+	for (std::size_t k = 0; k < members.size(); ++k) {
+		pool.submit([this, &pool, &members, &contents, k]() {
+			const auto& member = members[k];
+			TraceSpan span{"readMember", member.name};
+			auto& memberContent = contents[k];
+			if (member.size <= ParallelCopyChunkSize) {
+				memberContent.assign(content, member.offset, member.size);
+				return;
+			}
+
+			memberContent.resize(member.size);
+			for (std::size_t start = 0; start < member.size;
+					start += ParallelCopyChunkSize) {
+				const auto length = std::min(ParallelCopyChunkSize,
+					member.size - start);
+				pool.submit([this, &member, &memberContent, start, length]() {
+					std::memcpy(&memberContent[start],
+						content.data() + member.offset + start, length);
+				});
+			}
+		});
+	}
+	pool.wait();
+
+	Files files;
+	files.reserve(members.size());
+	for (std::size_t k = 0; k < members.size(); ++k) {
+		stats.addAllocations(members[k].size > 0 ? 2 : 1);
+		stats.addBytesCopied(members[k].size);
+		files.push_back(std::make_unique<StringFile>(
+			std::move(contents[k]),
+			std::move(members[k].name)
+		));
+	}
+	return files;
 }
 
 bool Extractor::isValid(std::size_t j) const noexcept {
@@ -250,16 +1210,21 @@ void Extractor::skipSuccessiveChars(char c) {
 	}
 }
 
-std::size_t Extractor::readNumber(const std::string& name) {
+std::size_t Extractor::readNumber(std::string_view name) {
 	skipSpaces();
 
-	std::string numAsStr;
-	while (isValid(i) && std::isdigit(content[i])) {
-		numAsStr += content[i];
+	const auto start = i;
+	while (isValid(i) && std::isdigit(static_cast<unsigned char>(content[i]))) {
 		++i;
 	}
+	const auto numAsStr = content.substr(start, i - start);
 	ensureNumberWasRead(numAsStr, name);
-	return std::stoull(numAsStr);
+
+	std::size_t number = 0;
+	const auto result = std::from_chars(numAsStr.data(),
+		numAsStr.data() + numAsStr.size(), number);
+	ensureNumberIsInRange(result.ec, numAsStr, name);
+	return number;
 }
 
 void Extractor::ensureIsValidFileNameTableIndex(FileNameTable::const_iterator it,
@@ -271,7 +1236,7 @@ void Extractor::ensureIsValidFileNameTableIndex(FileNameTable::const_iterator it
 	}
 }
 
-void Extractor::ensureFileNameIsNonEmpty(const std::string& fileName) const {
+void Extractor::ensureFileNameIsNonEmpty(std::string_view fileName) const {
 	if (fileName.empty()) {
 		throw InvalidArchiveError{"file has an empty name"};
 	}
@@ -304,10 +1269,20 @@ void Extractor::ensureContentOfGivenSizeWasRead(std::size_t readContentSize,
 	}
 }
 
-void Extractor::ensureNumberWasRead(const std::string& numAsStr,
-		const std::string& name) const {
+void Extractor::ensureNumberWasRead(std::string_view numAsStr,
+		std::string_view name) const {
 	if (numAsStr.empty()) {
-		throw InvalidArchiveError{"missing number (" + name + ")"};
+		throw InvalidArchiveError{"missing number (" + std::string{name} + ")"};
+	}
+}
+
+void Extractor::ensureNumberIsInRange(std::errc parseResult,
+		std::string_view numAsStr, std::string_view name) const {
+	if (parseResult != std::errc()) {
+		throw InvalidArchiveError{
+			"number out of range (" + std::string{name} + "): " +
+			std::string{numAsStr}
+		};
 	}
 }
 
@@ -0,0 +1,64 @@
+///
+/// @file      ar/internal/files/archive_member_file.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the file referring to its content in an
+///            archive.
+///
+
+#include <utility>
+
+#include "ar/internal/files/archive_member_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Constructs a file.
+///
+/// @param[in] archive The archive containing the content.
+/// @param[in] offset Offset of the content in the archive.
+/// @param[in] size Size of the content.
+/// @param[in] name Name of the file.
+/// @param[in] resource Memory resource from which the name is allocated.
+///
+ArchiveMemberFile::ArchiveMemberFile(
+		std::shared_ptr<const ArchiveBuffer> archive, std::size_t offset,
+		std::size_t size, std::string_view name,
+		std::pmr::memory_resource* resource):
+	archive{std::move(archive)},
+	content{this->archive->getContent().substr(offset, size)},
+	name{name, resource} {}
+
+ArchiveMemberFile::~ArchiveMemberFile() = default;
+
+std::string ArchiveMemberFile::getName() const {
+	return std::string{name};
+}
+
+std::string ArchiveMemberFile::getContent() {
+	return std::string{content};
+}
+
+std::string_view ArchiveMemberFile::getNameView() const {
+	return name;
+}
+
+std::string_view ArchiveMemberFile::getContentView() {
+	return content;
+}
+
+void ArchiveMemberFile::saveCopyTo(const std::string& directoryPath) {
+	saveCopyTo(directoryPath, std::string{name});
+}
+
+void ArchiveMemberFile::saveCopyTo(const std::string& directoryPath,
+		const std::string& name) {
+	TraceSpan span{"saveCopyTo", name};
+	writeFile(joinPaths(directoryPath, name), content.data(), content.size());
+}
+
+} // namespace internal
+} // namespace ar
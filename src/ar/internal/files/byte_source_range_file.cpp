@@ -0,0 +1,136 @@
+///
+/// @file      ar/internal/files/byte_source_range_file.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the file stored in a range of a source of
+///            bytes.
+///
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+#include "ar/exceptions.h"
+#include "ar/internal/files/byte_source_range_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+/// Size of the chunks in which the content is saved.
+const std::size_t SaveChunkSize = 1024 * 1024;
+
+} // anonymous namespace
+
+///
+/// Constructs a file.
+///
+/// @param[in] source Source containing the content.
+/// @param[in] offset Offset of the content in the source.
+/// @param[in] size Size of the content.
+/// @param[in] name Name of the file.
+///
+ByteSourceRangeFile::ByteSourceRangeFile(
+		std::shared_ptr<const ByteSource> source, std::uint64_t offset,
+		std::size_t size, std::string name):
+	source{std::move(source)}, offset{offset}, size{size},
+	name{std::move(name)} {}
+
+ByteSourceRangeFile::~ByteSourceRangeFile() = default;
+
+std::string ByteSourceRangeFile::getName() const {
+	return name;
+}
+
+std::string ByteSourceRangeFile::getContent() {
+	if (source->data() || readContent) {
+		return std::string{getContentView()};
+	}
+	return readRange();
+}
+
+std::string_view ByteSourceRangeFile::getNameView() const {
+	return name;
+}
+
+std::string_view ByteSourceRangeFile::getContentView() {
+	if (auto data = source->data()) {
+		return std::string_view{data + offset, size};
+	}
+
+	if (!readContent) {
+		readContent = readRange();
+	}
+	return *readContent;
+}
+
+void ByteSourceRangeFile::forEachChunk(std::size_t chunkSize,
+		const ChunkCallback& callback) {
+	if (source->data() || readContent || chunkSize == 0) {
+		File::forEachChunk(chunkSize, callback);
+		return;
+	}
+
+	std::string chunk(std::min(size, chunkSize), '\0');
+	for (std::size_t read = 0; read < size; read += chunk.size()) {
+		chunk.resize(std::min(size - read, chunkSize));
+		if (source->readAt(offset + read, &chunk[0], chunk.size()) !=
+				chunk.size()) {
+			throw IOError{"cannot read the content of file \"" + name + "\""};
+		}
+		callback(chunk);
+	}
+}
+
+std::size_t ByteSourceRangeFile::readContentAt(std::size_t offset,
+		char* buffer, std::size_t size) {
+	if (source->data() || readContent) {
+		return File::readContentAt(offset, buffer, size);
+	}
+	if (offset >= this->size) {
+		return 0;
+	}
+
+	return source->readAt(this->offset + offset, buffer,
+		std::min(size, this->size - offset));
+}
+
+void ByteSourceRangeFile::saveCopyTo(const std::string& directoryPath) {
+	saveCopyTo(directoryPath, name);
+}
+
+void ByteSourceRangeFile::saveCopyTo(const std::string& directoryPath,
+		const std::string& name) {
+	TraceSpan span{"saveCopyTo", name};
+	const auto path = joinPaths(directoryPath, name);
+	if (source->data() || readContent) {
+		const auto content = getContentView();
+		writeFile(path, content.data(), content.size());
+		return;
+	}
+
+	std::ofstream file{path, std::ios::binary};
+	if (!file) {
+		throw IOError{"cannot open file \"" + path + "\""};
+	}
+	forEachChunk(SaveChunkSize, [&](std::string_view chunk) {
+		file.write(chunk.data(), chunk.size());
+		if (!file) {
+			throw IOError{"cannot write file \"" + path + "\""};
+		}
+	});
+}
+
+std::string ByteSourceRangeFile::readRange() const {
+	std::string content(size, '\0');
+	if (source->readAt(offset, &content[0], size) != size) {
+		throw IOError{"cannot read the content of file \"" + name + "\""};
+	}
+	return content;
+}
+
+} // namespace internal
+} // namespace ar
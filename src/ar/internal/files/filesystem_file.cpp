@@ -5,8 +5,11 @@
 /// @brief     Implementation of the file stored in a filesystem.
 ///
 
+#include <limits>
+
 #include "ar/internal/files/filesystem_file.h"
 #include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
 
 namespace ar {
 namespace internal {
@@ -39,14 +42,53 @@ std::string FilesystemFile::getContent() {
 	return readFile(path);
 }
 
+std::string_view FilesystemFile::getNameView() const {
+	return name;
+}
+
+std::string_view FilesystemFile::getContentView() {
+	if (!readContent) {
+		readContent = readFile(path);
+	}
+	return *readContent;
+}
+
+void FilesystemFile::forEachChunk(std::size_t chunkSize,
+		const ChunkCallback& callback) {
+	if (readContent || chunkSize == 0) {
+		File::forEachChunk(chunkSize, callback);
+		return;
+	}
+
+	readFileRangeInChunks(path, 0, std::numeric_limits<std::size_t>::max(),
+		chunkSize, callback);
+}
+
+std::size_t FilesystemFile::readContentAt(std::size_t offset, char* buffer,
+		std::size_t size) {
+	if (readContent) {
+		return File::readContentAt(offset, buffer, size);
+	}
+
+	return readFileRangeInto(path, offset, buffer, size);
+}
+
 void FilesystemFile::saveCopyTo(const std::string& directoryPath) {
 	saveCopyTo(directoryPath, name);
 }
 
 void FilesystemFile::saveCopyTo(const std::string& directoryPath,
 		const std::string& name) {
+	TraceSpan span{"saveCopyTo", name};
 	copyFile(path, joinPaths(directoryPath, name));
 }
 
+///
+/// Returns the path to the file in a filesystem.
+///
+const std::string& FilesystemFile::getPath() const noexcept {
+	return path;
+}
+
 } // namespace internal
 } // namespace ar
@@ -0,0 +1,85 @@
+///
+/// @file      ar/internal/files/filesystem_range_file.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the file stored in a range of another file.
+///
+
+#include <algorithm>
+#include <utility>
+
+#include "ar/internal/files/filesystem_range_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Constructs a file.
+///
+/// @param[in] path Path to the file containing the content.
+/// @param[in] offset Offset of the content in the file.
+/// @param[in] size Size of the content.
+/// @param[in] name Name of the file.
+///
+FilesystemRangeFile::FilesystemRangeFile(std::string path,
+		std::size_t offset, std::size_t size, std::string name):
+	path{std::move(path)}, offset{offset}, size{size}, name{std::move(name)} {}
+
+FilesystemRangeFile::~FilesystemRangeFile() = default;
+
+std::string FilesystemRangeFile::getName() const {
+	return name;
+}
+
+std::string FilesystemRangeFile::getContent() {
+	return readFileRange(path, offset, size);
+}
+
+std::string_view FilesystemRangeFile::getNameView() const {
+	return name;
+}
+
+std::string_view FilesystemRangeFile::getContentView() {
+	if (!readContent) {
+		readContent = readFileRange(path, offset, size);
+	}
+	return *readContent;
+}
+
+void FilesystemRangeFile::forEachChunk(std::size_t chunkSize,
+		const ChunkCallback& callback) {
+	if (readContent || chunkSize == 0) {
+		File::forEachChunk(chunkSize, callback);
+		return;
+	}
+
+	readFileRangeInChunks(path, offset, size, chunkSize, callback);
+}
+
+std::size_t FilesystemRangeFile::readContentAt(std::size_t offset,
+		char* buffer, std::size_t size) {
+	if (readContent) {
+		return File::readContentAt(offset, buffer, size);
+	}
+	if (offset >= this->size) {
+		return 0;
+	}
+
+	return readFileRangeInto(path, this->offset + offset, buffer,
+		std::min(size, this->size - offset));
+}
+
+void FilesystemRangeFile::saveCopyTo(const std::string& directoryPath) {
+	saveCopyTo(directoryPath, name);
+}
+
+void FilesystemRangeFile::saveCopyTo(const std::string& directoryPath,
+		const std::string& name) {
+	TraceSpan span{"saveCopyTo", name};
+	copyFileRange(path, offset, size, joinPaths(directoryPath, name));
+}
+
+} // namespace internal
+} // namespace ar
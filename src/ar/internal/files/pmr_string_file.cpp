@@ -0,0 +1,53 @@
+///
+/// @file      ar/internal/files/pmr_string_file.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the file storing its content in a string
+///            from a memory resource.
+///
+
+#include "ar/internal/files/pmr_string_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Constructs a file with a copy of the given content and name, allocated
+/// from the given memory resource.
+///
+PmrStringFile::PmrStringFile(std::string_view content, std::string_view name,
+		std::pmr::memory_resource* resource):
+	content{content, resource}, name{name, resource} {}
+
+PmrStringFile::~PmrStringFile() = default;
+
+std::string PmrStringFile::getName() const {
+	return std::string{name};
+}
+
+std::string PmrStringFile::getContent() {
+	return std::string{content};
+}
+
+std::string_view PmrStringFile::getNameView() const {
+	return name;
+}
+
+std::string_view PmrStringFile::getContentView() {
+	return content;
+}
+
+void PmrStringFile::saveCopyTo(const std::string& directoryPath) {
+	saveCopyTo(directoryPath, std::string{name});
+}
+
+void PmrStringFile::saveCopyTo(const std::string& directoryPath,
+		const std::string& name) {
+	TraceSpan span{"saveCopyTo", name};
+	writeFile(joinPaths(directoryPath, name), content.data(), content.size());
+}
+
+} // namespace internal
+} // namespace ar
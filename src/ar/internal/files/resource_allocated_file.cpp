@@ -0,0 +1,60 @@
+///
+/// @file      ar/internal/files/resource_allocated_file.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the allocation of files from a memory
+///            resource.
+///
+
+#include <new>
+
+#include "ar/internal/files/resource_allocated_file.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+///
+/// Information stored in front of every file to be able to deallocate it.
+///
+struct alignas(alignof(std::max_align_t)) AllocationHeader {
+	/// Resource from which the file has been allocated.
+	std::pmr::memory_resource* resource;
+
+	/// Number of allocated bytes (including the header).
+	std::size_t size;
+};
+
+} // anonymous namespace
+
+///
+/// Allocates @a size bytes for a file from the given memory resource.
+///
+/// The resource is stored in front of the file, so deallocateFromResource()
+/// can return the memory to it.
+///
+void* allocateFromResource(std::size_t size,
+		std::pmr::memory_resource* resource) {
+	const auto allocationSize = sizeof(AllocationHeader) + size;
+	auto ptr = resource->allocate(allocationSize, alignof(AllocationHeader));
+	auto header = new (ptr) AllocationHeader{resource, allocationSize};
+	return header + 1;
+}
+
+///
+/// Returns the memory of a file allocated by allocateFromResource() to the
+/// resource it has been allocated from.
+///
+void deallocateFromResource(void* ptr) noexcept {
+	if (!ptr) {
+		return;
+	}
+
+	auto header = static_cast<AllocationHeader*>(ptr) - 1;
+	header->resource->deallocate(header, header->size,
+		alignof(AllocationHeader));
+}
+
+} // namespace internal
+} // namespace ar
@@ -9,6 +9,7 @@
 
 #include "ar/internal/files/string_file.h"
 #include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
 
 namespace ar {
 namespace internal {
@@ -16,14 +17,14 @@ namespace internal {
 ///
 /// Constructs a file with the given content.
 ///
-StringFile::StringFile(const std::string& content):
-	content{content} {}
+StringFile::StringFile(std::string content):
+	content{std::move(content)} {}
 
 ///
 /// Constructs a file with the given content and name.
 ///
-StringFile::StringFile(const std::string& content, const std::string& name):
-	content{content}, name{name} {}
+StringFile::StringFile(std::string content, std::string name):
+	content{std::move(content)}, name{std::move(name)} {}
 
 StringFile::~StringFile() = default;
 
@@ -35,13 +36,29 @@ std::string StringFile::getContent() {
 	return content;
 }
 
+std::string_view StringFile::getNameView() const {
+	return name;
+}
+
+std::string_view StringFile::getContentView() {
+	return content;
+}
+
 void StringFile::saveCopyTo(const std::string& directoryPath) {
 	saveCopyTo(directoryPath, name);
 }
 
 void StringFile::saveCopyTo(const std::string& directoryPath,
 		const std::string& name) {
-	writeFile(joinPaths(directoryPath, name), getContent());
+	TraceSpan span{"saveCopyTo", name};
+	writeFile(joinPaths(directoryPath, name), content);
+}
+
+///
+/// Moves the content out of the file, leaving the file empty.
+///
+std::string StringFile::takeContent() noexcept {
+	return std::move(content);
 }
 
 } // namespace internal
@@ -0,0 +1,262 @@
+///
+/// @file      ar/internal/pipelined_extractor.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the pipelined extractor.
+///
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ar/byte_source.h"
+#include "ar/exceptions.h"
+#include "ar/internal/pipelined_extractor.h"
+#include "ar/internal/utilities/backoff.h"
+#include "ar/internal/utilities/bounded_queue.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/thread_pool.h"
+#include "ar/internal/utilities/tracing.h"
+#include "ar/internal/writers/batch_writer.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+///
+/// Thrown from the parser to stop the parsing when a writer has failed.
+///
+struct PipelineAborted {};
+
+} // anonymous namespace
+
+///
+/// Creates an extractor using the given options.
+///
+PipelinedExtractor::PipelinedExtractor(const ExtractionOptions& options):
+	options(options) {}
+
+PipelinedExtractor::~PipelinedExtractor() = default;
+
+///
+/// Extracts the given archive into the given directory.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when a file cannot be written.
+///
+ExtractionReport PipelinedExtractor::extractTo(std::string archiveContent,
+		const std::string& directoryPath) {
+	return extractTo(ArchiveBuffer::fromContent(std::move(archiveContent)),
+		directoryPath);
+}
+
+///
+/// Extracts the given archive into the given directory.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when a file cannot be written.
+///
+ExtractionReport PipelinedExtractor::extractTo(
+		std::shared_ptr<const ArchiveBuffer> archive,
+		const std::string& directoryPath) {
+	const auto content = archive->getContent();
+	return extractUsing(
+		[&](Extractor& extractor, const Extractor::MemberHandler& handler) {
+			extractor.scan(std::move(archive), handler);
+		},
+		[&](const Member& member, std::string& buffer) {
+			(void)buffer;
+			return content.substr(member.offset, member.size);
+		},
+		true,
+		directoryPath
+	);
+}
+
+///
+/// Extracts the archive in the given source into the given directory.
+///
+/// When the bytes of the source are not in memory, the files are written one
+/// by one, even with batched writes.
+///
+/// @throws InvalidArchiveError when the archive is invalid.
+/// @throws IOError when the source cannot be read or a file cannot be
+///                 written.
+///
+ExtractionReport PipelinedExtractor::extractTo(
+		std::shared_ptr<const ByteSource> source,
+		const std::string& directoryPath) {
+	if (source->data()) {
+		return extractTo(ArchiveBuffer::fromByteSource(std::move(source)),
+			directoryPath);
+	}
+
+	return extractUsing(
+		[&](Extractor& extractor, const Extractor::MemberHandler& handler) {
+			extractor.scan(source, handler);
+		},
+		[&](const Member& member, std::string& buffer) {
+			buffer.resize(member.size);
+			if (source->readAt(member.offset, buffer.data(), member.size) !=
+					member.size) {
+				throw IOError{"cannot read the content of " + member.name};
+			}
+			return std::string_view{buffer};
+		},
+		false,
+		directoryPath
+	);
+}
+
+///
+/// Extracts the archive scanned by @a scan into the given directory, reading
+/// the content of members by @a readContent.
+///
+/// When the content is not in the archive (i.e. it is read into a buffer of
+/// the writer), the batched writes are not used, as they need the content to
+/// stay in place until the batch is written.
+///
+ExtractionReport PipelinedExtractor::extractUsing(const Scanner& scan,
+		const ContentReader& readContent, bool contentIsInArchive,
+		const std::string& directoryPath) {
+	Extractor extractor;
+	BoundedQueue<Member> queue{options.queueCapacity};
+	std::atomic<bool> parsingDone{false};
+	std::atomic<bool> failed{false};
+	std::atomic<std::size_t> writtenCount{0};
+	std::mutex exceptionMutex;
+	std::exception_ptr writerException;
+
+	// With batched writes, a single writer thread feeds a batch writer, which
+	// has threads of its own (if it needs them).
+	auto batchWriter = options.batchedWrites && contentIsInArchive
+		? BatchWriter::create(options.threadCount)
+		: nullptr;
+	auto writeMember = [&](const Member& member, std::string& buffer) {
+		TraceSpan span{"writeFile", member.name};
+		auto path = joinPaths(directoryPath, member.name);
+		const auto memberContent = readContent(member, buffer);
+		if (!batchWriter) {
+			writeFile(path, memberContent.data(), memberContent.size());
+			writtenCount++;
+			return;
+		}
+
+		// The batch writer flushes the batch when it is full.
+		const auto pendingBefore = batchWriter->getPendingCount();
+		batchWriter->write(std::move(path), memberContent.data(),
+			memberContent.size());
+		writtenCount += pendingBefore + 1 - batchWriter->getPendingCount();
+	};
+	auto flushBatch = [&]() {
+		if (batchWriter) {
+			const auto pending = batchWriter->getPendingCount();
+			batchWriter->flush();
+			writtenCount += pending;
+		}
+	};
+
+	auto writeFiles = [&]() {
+		Member member;
+		std::string buffer;
+		Backoff backoff;
+		while (!failed) {
+			try {
+				// Read the flag before popping. When the parsing is done and
+				// the queue is empty, no more members will ever come.
+				const bool done = parsingDone;
+				if (queue.tryPop(member)) {
+					backoff.reset();
+					writeMember(member, buffer);
+					continue;
+				}
+
+				// Do not keep a partial batch while waiting for the parser.
+				flushBatch();
+				if (done) {
+					return;
+				}
+				backoff.pause();
+			} catch (...) {
+				std::lock_guard<std::mutex> lock{exceptionMutex};
+				if (!writerException) {
+					writerException = std::current_exception();
+				}
+				failed = true;
+				return;
+			}
+		}
+	};
+
+	const auto writerCount = batchWriter ? 1
+		: options.threadCount == 0 ? ThreadPool::defaultThreadCount()
+		: options.threadCount;
+	std::vector<std::thread> writers;
+	for (std::size_t j = 0; j < writerCount; ++j) {
+		writers.emplace_back(writeFiles);
+	}
+
+	ExtractionReport report;
+	std::exception_ptr parserException;
+	try {
+		std::unordered_set<std::string> scheduledNames;
+		std::size_t pushedCount = 0;
+		Backoff backoff;
+		scan(extractor, [&](Member&& member) {
+			report.fileNames.push_back(member.name);
+
+			if (!scheduledNames.insert(member.name).second) {
+				// A file of the same name has already been scheduled. To store
+				// the last one (as the serial extraction does), wait until all
+				// scheduled files have been written.
+				while (writtenCount < pushedCount) {
+					if (failed) {
+						throw PipelineAborted{};
+					}
+					backoff.pause();
+				}
+				backoff.reset();
+			}
+
+			while (!queue.tryPush(member)) {
+				if (failed) {
+					throw PipelineAborted{};
+				}
+				backoff.pause();
+			}
+			backoff.reset();
+			pushedCount++;
+		});
+	} catch (const PipelineAborted&) {
+		// The cause has been stored by the writer that failed.
+	} catch (...) {
+		parserException = std::current_exception();
+		failed = true;
+	}
+
+	parsingDone = true;
+	for (auto& writer : writers) {
+		writer.join();
+	}
+
+	if (writerException) {
+		std::rethrow_exception(writerException);
+	}
+	if (parserException) {
+		std::rethrow_exception(parserException);
+	}
+
+	report.queueHighWaterMark = queue.getHighWaterMark();
+	report.queueCapacity = queue.getCapacity();
+	report.ioUringUsed = batchWriter && batchWriter->usesIoUring();
+	return report;
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,55 @@
+///
+/// @file      ar/internal/utilities/backoff.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the exponential backoff.
+///
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "ar/internal/utilities/backoff.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+/// Number of pauses that only yield the processor.
+const std::size_t YieldingPauseCount = 16;
+
+/// The longest sleep (in microseconds).
+const std::size_t MaxSleepMicroseconds = 1000;
+
+} // anonymous namespace
+
+Backoff::Backoff(): pauseCount(0) {}
+
+///
+/// Pauses the calling thread.
+///
+void Backoff::pause() {
+	if (pauseCount < YieldingPauseCount) {
+		std::this_thread::yield();
+	} else {
+		const auto exponent = std::min<std::size_t>(
+			pauseCount - YieldingPauseCount, 10);
+		const auto sleepTime = std::min<std::size_t>(
+			std::size_t(1) << exponent, MaxSleepMicroseconds);
+		std::this_thread::sleep_for(std::chrono::microseconds(sleepTime));
+	}
+	++pauseCount;
+}
+
+///
+/// Makes the next pause short again.
+///
+/// Call this function when the awaited event has happened.
+///
+void Backoff::reset() noexcept {
+	pauseCount = 0;
+}
+
+} // namespace internal
+} // namespace ar
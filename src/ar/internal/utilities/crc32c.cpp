@@ -0,0 +1,176 @@
+///
+/// @file      ar/internal/utilities/crc32c.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the CRC-32C checksums.
+///
+
+#include <cstddef>
+#include <cstring>
+
+#include "ar/internal/utilities/crc32c.h"
+
+// On x86-64, the checksum can be computed by the crc32 instruction from
+// SSE4.2. The code using it is compiled for SSE4.2 even when the rest of the
+// library is not, and it is used only when the running processor supports it.
+#if defined(__x86_64__) || defined(_M_X64)
+#define AR_HAVE_CRC32C_INSTRUCTION
+#include <nmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define AR_TARGET_SSE42
+#else
+#define AR_TARGET_SSE42 __attribute__((target("sse4.2")))
+#endif
+#endif
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+/// The CRC-32C (Castagnoli) polynomial, in the reversed bit order.
+constexpr std::uint32_t Polynomial = 0x82f63b78;
+
+/// Tables for computing the checksum eight bytes at a time ("slicing-by-8").
+///
+/// The k-th table gives the checksum of a byte followed by k zero bytes.
+struct SlicingTables {
+	std::uint32_t values[8][256];
+};
+
+constexpr SlicingTables createSlicingTables() {
+	SlicingTables tables{};
+	for (std::uint32_t j = 0; j < 256; ++j) {
+		auto crc = j;
+		for (int k = 0; k < 8; ++k) {
+			crc = (crc >> 1) ^ ((crc & 1) ? Polynomial : 0);
+		}
+		tables.values[0][j] = crc;
+	}
+	for (std::size_t k = 1; k < 8; ++k) {
+		for (std::size_t j = 0; j < 256; ++j) {
+			const auto crc = tables.values[k - 1][j];
+			tables.values[k][j] = (crc >> 8) ^ tables.values[0][crc & 0xff];
+		}
+	}
+	return tables;
+}
+
+constexpr SlicingTables Tables = createSlicingTables();
+
+std::uint32_t loadLittleEndian32(const unsigned char* data) {
+	return static_cast<std::uint32_t>(data[0]) |
+		static_cast<std::uint32_t>(data[1]) << 8 |
+		static_cast<std::uint32_t>(data[2]) << 16 |
+		static_cast<std::uint32_t>(data[3]) << 24;
+}
+
+std::uint32_t updateInSoftware(std::uint32_t crc, const unsigned char* data,
+		std::size_t size) {
+	const auto& t = Tables.values;
+	for (; size >= 8; data += 8, size -= 8) {
+		const auto low = crc ^ loadLittleEndian32(data);
+		const auto high = loadLittleEndian32(data + 4);
+		crc = t[7][low & 0xff] ^ t[6][(low >> 8) & 0xff] ^
+			t[5][(low >> 16) & 0xff] ^ t[4][low >> 24] ^
+			t[3][high & 0xff] ^ t[2][(high >> 8) & 0xff] ^
+			t[1][(high >> 16) & 0xff] ^ t[0][high >> 24];
+	}
+	for (; size > 0; ++data, --size) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data) & 0xff];
+	}
+	return crc;
+}
+
+#ifdef AR_HAVE_CRC32C_INSTRUCTION
+AR_TARGET_SSE42
+std::uint32_t updateInHardware(std::uint32_t crc, const unsigned char* data,
+		std::size_t size) {
+	// Process the unaligned head byte by byte, so the bulk of the data is
+	// read eight bytes at a time from aligned addresses.
+	for (; size > 0 && reinterpret_cast<std::uintptr_t>(data) % 8 != 0;
+			++data, --size) {
+		crc = _mm_crc32_u8(crc, *data);
+	}
+
+	std::uint64_t crc64 = crc;
+	for (; size >= 8; data += 8, size -= 8) {
+		std::uint64_t chunk;
+		std::memcpy(&chunk, data, sizeof(chunk));
+		crc64 = _mm_crc32_u64(crc64, chunk);
+	}
+	crc = static_cast<std::uint32_t>(crc64);
+
+	for (; size > 0; ++data, --size) {
+		crc = _mm_crc32_u8(crc, *data);
+	}
+	return crc;
+}
+
+bool processorSupportsSse42() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 20)) != 0;
+#else
+	return __builtin_cpu_supports("sse4.2");
+#endif
+}
+#endif
+
+/// Function updating a checksum by the given data.
+using UpdateFunction = std::uint32_t (*)(std::uint32_t, const unsigned char*,
+	std::size_t);
+
+UpdateFunction selectUpdateFunction() noexcept {
+#ifdef AR_HAVE_CRC32C_INSTRUCTION
+	if (processorSupportsSse42()) {
+		return updateInHardware;
+	}
+#endif
+	return updateInSoftware;
+}
+
+UpdateFunction getUpdateFunction() noexcept {
+	static const auto update = selectUpdateFunction();
+	return update;
+}
+
+} // anonymous namespace
+
+///
+/// Returns the CRC-32C (Castagnoli) checksum of the given data.
+///
+/// To compute the checksum of data split into several parts, pass the
+/// checksum of the preceding parts as @a crc.
+///
+/// The checksum is computed by the crc32 instruction when the processor
+/// supports it, and by a table-driven algorithm otherwise.
+///
+std::uint32_t crc32c(std::string_view data, std::uint32_t crc) noexcept {
+	return ~getUpdateFunction()(~crc,
+		reinterpret_cast<const unsigned char*>(data.data()), data.size());
+}
+
+///
+/// Returns the CRC-32C checksum of the given data, computed without the help
+/// of special instructions.
+///
+/// The result is the same as the one of crc32c().
+///
+std::uint32_t crc32cInSoftware(std::string_view data,
+		std::uint32_t crc) noexcept {
+	return ~updateInSoftware(~crc,
+		reinterpret_cast<const unsigned char*>(data.data()), data.size());
+}
+
+///
+/// Is crc32c() computed by a special processor instruction?
+///
+bool crc32cUsesHardware() noexcept {
+	return getUpdateFunction() != updateInSoftware;
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,117 @@
+///
+/// @file      ar/internal/utilities/mapped_file.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the file mapped into memory.
+///
+
+#include <algorithm>
+
+#include "ar/exceptions.h"
+#include "ar/internal/utilities/mapped_file.h"
+#include "ar/internal/utilities/os.h"
+
+#ifndef AR_OS_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ar {
+namespace internal {
+
+///
+/// Maps the given file into memory.
+///
+/// @throws IOError When the file cannot be opened or mapped.
+///
+MappedFile::MappedFile(const std::string& path):
+		data(nullptr), size(0) {
+#ifdef AR_OS_WINDOWS
+	readContent = readFile(path);
+	data = readContent.data();
+	size = readContent.size();
+#else
+	const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		throw IOError{"cannot open file \"" + path + "\""};
+	}
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0) {
+		::close(fd);
+		throw IOError{"cannot get the size of file \"" + path + "\""};
+	}
+
+	size = static_cast<std::size_t>(info.st_size);
+	if (size > 0) {
+		auto mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			::close(fd);
+			throw IOError{"cannot map file \"" + path + "\""};
+		}
+		data = static_cast<const char*>(mapping);
+	}
+
+	// The mapping stays valid even after the descriptor is closed.
+	::close(fd);
+#endif
+}
+
+///
+/// Unmaps the file.
+///
+MappedFile::~MappedFile() {
+#ifndef AR_OS_WINDOWS
+	if (data) {
+		::munmap(const_cast<char*>(data), size);
+	}
+#endif
+}
+
+///
+/// Returns the content of the file.
+///
+/// When the file is empty, the null pointer may be returned.
+///
+const char* MappedFile::getData() const noexcept {
+	return data;
+}
+
+///
+/// Returns the size of the file.
+///
+std::size_t MappedFile::getSize() const noexcept {
+	return size;
+}
+
+///
+/// Tells the system that the given range of the file will not be needed soon,
+/// so its pages can be dropped from memory.
+///
+/// The content stays accessible; dropped pages are loaded again when they are
+/// accessed.
+///
+void MappedFile::release(std::size_t offset, std::size_t size) const noexcept {
+#ifdef AR_OS_WINDOWS
+	(void)offset;
+	(void)size;
+#else
+	if (!data || offset >= this->size) {
+		return;
+	}
+
+	// Only whole pages can be released.
+	static const auto PageSize =
+		static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+	const auto start = (offset + PageSize - 1) / PageSize * PageSize;
+	const auto end = std::min(offset + size, this->size) / PageSize * PageSize;
+	if (start < end) {
+		::madvise(const_cast<char*>(data) + start, end - start, MADV_DONTNEED);
+	}
+#endif
+}
+
+} // namespace internal
+} // namespace ar
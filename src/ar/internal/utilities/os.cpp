@@ -6,17 +6,146 @@
 ///
 
 #include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <regex>
 
 #include "ar/exceptions.h"
 #include "ar/internal/utilities/os.h"
 
+#ifdef AR_OS_WINDOWS
+#include <direct.h>
+#include <fcntl.h>
+#include <io.h>
+#include <share.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/utime.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+#endif
+
 namespace ar {
 namespace internal {
 
 namespace {
 
+/// Size of the chunks in which files are copied or compared.
+const std::size_t FileChunkSize = 1024 * 1024;
+
+std::ifstream openFileForReadingAt(const std::string& path,
+		std::size_t offset) {
+	std::ifstream file{path, std::ios::binary};
+	if (!file) {
+		throw IOError{"cannot open file \"" + path + "\""};
+	}
+
+	file.seekg(offset);
+	if (!file) {
+		throw IOError{"cannot seek in file \"" + path + "\""};
+	}
+	return file;
+}
+
+void readFileChunk(std::ifstream& file, const std::string& path, char* chunk,
+		std::size_t size) {
+	file.read(chunk, size);
+	if (static_cast<std::size_t>(file.gcount()) != size) {
+		throw IOError{"cannot read file \"" + path + "\" (premature end)"};
+	}
+}
+
+std::fstream openFileForUpdating(const std::string& path) {
+	std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+	if (!file) {
+		throw IOError{"cannot open file \"" + path + "\""};
+	}
+	return file;
+}
+
+#ifdef __linux__
+///
+/// Moves the range of an open file by @c copy_file_range, which lets the
+/// kernel copy the bytes (or share their blocks) without passing them through
+/// the user space.
+///
+/// Ranges in the same file must not overlap, so the range is moved in chunks
+/// no larger than the distance of the move, starting from the side the range
+/// moves to.
+///
+/// @return Number of bytes that were moved, counted from the side the range
+///         moves to. It is less than @a size when the kernel or filesystem
+///         does not support the call.
+///
+std::size_t moveFileRangeInKernel(int fd, std::size_t srcOffset,
+		std::size_t dstOffset, std::size_t size) {
+	const auto distance = srcOffset > dstOffset
+		? srcOffset - dstOffset
+		: dstOffset - srcOffset;
+	const auto towardsStart = dstOffset < srcOffset;
+	std::size_t moved = 0;
+	while (moved < size) {
+		const auto chunkSize = std::min(size - moved, distance);
+		const auto chunkOffset = towardsStart
+			? moved
+			: size - moved - chunkSize;
+		auto src = static_cast<loff_t>(srcOffset + chunkOffset);
+		auto dst = static_cast<loff_t>(dstOffset + chunkOffset);
+		std::size_t copied = 0;
+		while (copied < chunkSize) {
+			const auto result = ::copy_file_range(fd, &src, fd, &dst,
+				chunkSize - copied, 0);
+			if (result <= 0) {
+				// A partially moved chunk is moved again by the caller.
+				return moved;
+			}
+			copied += static_cast<std::size_t>(result);
+		}
+		moved += chunkSize;
+	}
+	return moved;
+}
+
+///
+/// Copies the given ranges from the open file @a srcFd into the open file
+/// @a dstFd by @c copy_file_range, so the bytes do not pass through the user
+/// space (and filesystems supporting reflinks may even share them).
+///
+/// @return Number of ranges that were copied. It is less than the number of
+///         the ranges when the kernel or filesystem does not support the
+///         call (e.g. when the files lie on different filesystems).
+///
+std::size_t copyFileRangesInKernel(int srcFd, int dstFd,
+		const std::vector<FileRangeCopy>& ranges) {
+	for (std::size_t k = 0; k < ranges.size(); ++k) {
+		const auto& range = ranges[k];
+		auto src = static_cast<loff_t>(range.srcOffset);
+		auto dst = static_cast<loff_t>(range.dstOffset);
+		std::size_t copied = 0;
+		while (copied < range.size) {
+			const auto result = ::copy_file_range(srcFd, &src, dstFd, &dst,
+				range.size - copied, 0);
+			if (result <= 0) {
+				// A partially copied range is copied again by the caller.
+				return k;
+			}
+			copied += static_cast<std::size_t>(result);
+		}
+	}
+	return ranges.size();
+}
+#endif
+
 bool isPathFromRoot(const std::string& path) {
 #ifdef AR_OS_WINDOWS
 	return std::regex_match(path, std::regex{R"([a-zA-Z]:(/|\\).*)"}) ||
@@ -103,13 +232,32 @@ std::string joinPaths(const std::string& path1, const std::string& path2) {
 /// during the reading.
 ///
 std::string readFile(const std::string& path) {
-	std::ifstream file{path, std::ios::binary};
+	std::string content;
+	readFileInto(path, content);
+	return content;
+}
+
+///
+/// Reads the content of the given file into @a content.
+///
+/// @param[in] path Path to the file.
+/// @param[out] content Content of the file. Its capacity is reused, so reading
+///                     files of similar sizes into the same string does not
+///                     allocate memory.
+///
+/// @throws IOError When the file cannot be opened or read.
+///
+void readFileInto(const std::string& path, std::string& content) {
+	// The file is read at once, so the stream does not need a buffer of its
+	// own (which would be allocated for every file).
+	std::ifstream file;
+	file.rdbuf()->pubsetbuf(nullptr, 0);
+	file.open(path, std::ios::binary);
 	if (!file) {
 		throw IOError{"cannot open file \"" + path + "\""};
 	}
 
 	file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	std::string content;
 	try {
 		// The following method gets the file size, resizes the string holding
 		// the content, and reads the file afterwards. The obtained file size
@@ -122,9 +270,91 @@ std::string readFile(const std::string& path) {
 	} catch (const std::ifstream::failure& ex) {
 		throw IOError{"cannot read file \"" + path + "\" (" + ex.what() + ")"};
 	}
+}
+
+///
+/// Returns @a size bytes of the given file, starting at @a offset.
+///
+/// @throws IOError When the file cannot be opened or when it does not contain
+///                 the whole range.
+///
+std::string readFileRange(const std::string& path, std::size_t offset,
+		std::size_t size) {
+	auto file = openFileForReadingAt(path, offset);
+	std::string content(size, '\0');
+	readFileChunk(file, path, &content[0], size);
 	return content;
 }
 
+///
+/// Reads at most @a size bytes of the given file, starting at @a offset, into
+/// @a buffer.
+///
+/// @return Number of read bytes, which is less than @a size only when the
+///         file ends sooner.
+///
+/// @throws IOError When the file cannot be opened or read.
+///
+std::size_t readFileRangeInto(const std::string& path, std::size_t offset,
+		char* buffer, std::size_t size) {
+	// Only a single read is performed, so the stream does not need a buffer
+	// of its own.
+	std::ifstream file;
+	file.rdbuf()->pubsetbuf(nullptr, 0);
+	file.open(path, std::ios::binary);
+	if (!file) {
+		throw IOError{"cannot open file \"" + path + "\""};
+	}
+
+	file.seekg(0, std::ios::end);
+	const auto fileSize = static_cast<std::size_t>(file.tellg());
+	if (!file) {
+		throw IOError{"cannot seek in file \"" + path + "\""};
+	}
+	if (offset >= fileSize) {
+		return 0;
+	}
+
+	const auto count = std::min(size, fileSize - offset);
+	file.seekg(offset);
+	file.read(buffer, count);
+	if (!file) {
+		throw IOError{"cannot read file \"" + path + "\""};
+	}
+	return count;
+}
+
+///
+/// Reads at most @a size bytes of the given file, starting at @a offset, in
+/// chunks of @a chunkSize bytes and calls @a callback for each of them.
+///
+/// Only a single chunk is held in memory at a time. The last chunk may be
+/// shorter, and the reading stops sooner when the file ends. The view passed
+/// to @a callback is valid only during the call.
+///
+/// @throws IOError When the file cannot be opened or read.
+///
+void readFileRangeInChunks(const std::string& path, std::size_t offset,
+		std::size_t size, std::size_t chunkSize,
+		const std::function<void (std::string_view)>& callback) {
+	auto file = openFileForReadingAt(path, offset);
+	std::string chunk(std::min(size, chunkSize), '\0');
+	for (std::size_t read = 0; read < size; read += chunk.size()) {
+		chunk.resize(std::min(size - read, chunkSize));
+		file.read(&chunk[0], chunk.size());
+		const auto count = static_cast<std::size_t>(file.gcount());
+		if (file.bad()) {
+			throw IOError{"cannot read file \"" + path + "\""};
+		}
+		if (count > 0) {
+			callback(std::string_view{chunk.data(), count});
+		}
+		if (count < chunk.size()) {
+			return;
+		}
+	}
+}
+
 ///
 /// Stores a file with the given @a content into the given @a path.
 ///
@@ -134,12 +364,25 @@ std::string readFile(const std::string& path) {
 /// during writing.
 ///
 void writeFile(const std::string& path, const std::string& content) {
+	writeFile(path, content.data(), content.size());
+}
+
+///
+/// Stores a file with the given @a content of the given @a size into the given
+/// @a path.
+///
+/// @throws IOError When the file cannot be opened or written.
+///
+/// The file is opened in the binary mode, so no conversions are performed
+/// during writing.
+///
+void writeFile(const std::string& path, const char* content, std::size_t size) {
 	std::ofstream file{path, std::ios::binary};
 	if (!file) {
 		throw IOError{"cannot open file \"" + path + "\""};
 	}
 
-	file << content;
+	file.write(content, size);
 	if (!file) {
 		throw IOError{"cannot write file \"" + path + "\""};
 	}
@@ -155,5 +398,358 @@ void copyFile(const std::string& srcPath, const std::string& dstPath) {
 	writeFile(dstPath, content);
 }
 
+///
+/// Copies @a size bytes of the file in @a srcPath, starting at @a offset, to a
+/// file in @a dstPath.
+///
+/// The range is copied in chunks, so it does not have to fit into memory.
+///
+/// @throws IOError When a file cannot be opened, read, or written, or when the
+///                 source file does not contain the whole range.
+///
+void copyFileRange(const std::string& srcPath, std::size_t offset,
+		std::size_t size, const std::string& dstPath) {
+	auto srcFile = openFileForReadingAt(srcPath, offset);
+	std::ofstream dstFile{dstPath, std::ios::binary};
+	if (!dstFile) {
+		throw IOError{"cannot open file \"" + dstPath + "\""};
+	}
+
+	std::string chunk(std::min(size, FileChunkSize), '\0');
+	for (std::size_t copied = 0; copied < size; copied += chunk.size()) {
+		chunk.resize(std::min(size - copied, FileChunkSize));
+		readFileChunk(srcFile, srcPath, &chunk[0], chunk.size());
+		dstFile.write(chunk.data(), chunk.size());
+		if (!dstFile) {
+			throw IOError{"cannot write file \"" + dstPath + "\""};
+		}
+	}
+}
+
+///
+/// Copies the given ranges of the file in @a srcPath into the existing file
+/// in @a dstPath.
+///
+/// The rest of the destination file is left intact, and the file is extended
+/// when a range ends after its end. On Linux, the ranges are copied by
+/// @c copy_file_range, so their bytes are not read into memory. Otherwise (or
+/// when the filesystems do not support it), they are copied in chunks through
+/// memory.
+///
+/// @throws IOError When a file cannot be opened, read, or written, or when the
+///                 source file does not contain a whole range.
+///
+void copyFileRanges(const std::string& srcPath, const std::string& dstPath,
+		const std::vector<FileRangeCopy>& ranges) {
+	std::size_t copiedRanges = 0;
+#ifdef __linux__
+	const auto srcFd = ::open(srcPath.c_str(), O_RDONLY | O_CLOEXEC);
+	if (srcFd < 0) {
+		throw IOError{"cannot open file \"" + srcPath + "\""};
+	}
+	const auto dstFd = ::open(dstPath.c_str(), O_WRONLY | O_CLOEXEC);
+	if (dstFd < 0) {
+		::close(srcFd);
+		throw IOError{"cannot open file \"" + dstPath + "\""};
+	}
+	copiedRanges = copyFileRangesInKernel(srcFd, dstFd, ranges);
+	::close(dstFd);
+	::close(srcFd);
+	if (copiedRanges == ranges.size()) {
+		return;
+	}
+#endif
+
+	std::ifstream srcFile{srcPath, std::ios::binary};
+	if (!srcFile) {
+		throw IOError{"cannot open file \"" + srcPath + "\""};
+	}
+	auto dstFile = openFileForUpdating(dstPath);
+	std::string chunk;
+	for (auto k = copiedRanges; k < ranges.size(); ++k) {
+		const auto& range = ranges[k];
+		srcFile.seekg(range.srcOffset);
+		dstFile.seekp(range.dstOffset);
+		for (std::size_t copied = 0; copied < range.size;
+				copied += chunk.size()) {
+			chunk.resize(std::min(range.size - copied, FileChunkSize));
+			readFileChunk(srcFile, srcPath, &chunk[0], chunk.size());
+			dstFile.write(chunk.data(), chunk.size());
+			if (!dstFile) {
+				throw IOError{"cannot write file \"" + dstPath + "\""};
+			}
+		}
+	}
+	dstFile.flush();
+	if (!dstFile) {
+		throw IOError{"cannot write file \"" + dstPath + "\""};
+	}
+}
+
+///
+/// Writes @a size bytes of the given @a content into the existing file in
+/// @a path, starting at @a offset.
+///
+/// Unlike writeFile(), the rest of the file is left intact. When @a offset is
+/// the size of the file, the content is appended to it.
+///
+/// @throws IOError When the file cannot be opened or written.
+///
+void writeFileAt(const std::string& path, std::size_t offset,
+		const char* content, std::size_t size) {
+	auto file = openFileForUpdating(path);
+	file.seekp(offset);
+	file.write(content, size);
+	file.flush();
+	if (!file) {
+		throw IOError{"cannot write file \"" + path + "\""};
+	}
+}
+
+///
+/// Moves @a size bytes of the given file from @a srcOffset to @a dstOffset.
+///
+/// The ranges may overlap. The bytes outside of the destination range are
+/// left intact, so when the range moves towards the start of the file, its
+/// last bytes stay also in their original place (see resizeFile()). On Linux,
+/// the bytes are moved by @c copy_file_range when the distance of the move is
+/// at least a megabyte, so large parts of archives are moved without reading
+/// them. Otherwise, they are moved in chunks through memory.
+///
+/// @throws IOError When the file cannot be opened, read, or written, or when
+///                 it does not contain the whole source range.
+///
+void moveFileRange(const std::string& path, std::size_t srcOffset,
+		std::size_t dstOffset, std::size_t size) {
+	if (srcOffset == dstOffset || size == 0) {
+		return;
+	}
+
+	const auto towardsStart = dstOffset < srcOffset;
+	std::size_t moved = 0;
+#ifdef __linux__
+	const auto distance = towardsStart
+		? srcOffset - dstOffset
+		: dstOffset - srcOffset;
+	if (distance >= FileChunkSize) {
+		const auto fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+		if (fd < 0) {
+			throw IOError{"cannot open file \"" + path + "\""};
+		}
+		moved = moveFileRangeInKernel(fd, srcOffset, dstOffset, size);
+		::close(fd);
+	}
+#endif
+
+	auto file = openFileForUpdating(path);
+	std::string chunk(std::min(size - moved, FileChunkSize), '\0');
+	while (moved < size) {
+		chunk.resize(std::min(size - moved, FileChunkSize));
+		// Every chunk is read whole before it is written, so the chunks are
+		// moved in the order in which they do not overwrite unread bytes.
+		const auto chunkOffset = towardsStart
+			? moved
+			: size - moved - chunk.size();
+		file.seekg(srcOffset + chunkOffset);
+		file.read(&chunk[0], chunk.size());
+		if (static_cast<std::size_t>(file.gcount()) != chunk.size()) {
+			throw IOError{"cannot read file \"" + path + "\" (premature end)"};
+		}
+		file.seekp(dstOffset + chunkOffset);
+		file.write(chunk.data(), chunk.size());
+		if (!file) {
+			throw IOError{"cannot write file \"" + path + "\""};
+		}
+		moved += chunk.size();
+	}
+	file.flush();
+	if (!file) {
+		throw IOError{"cannot write file \"" + path + "\""};
+	}
+}
+
+///
+/// Truncates or extends the given file to the given size.
+///
+/// @throws IOError When the size cannot be changed.
+///
+void resizeFile(const std::string& path, std::size_t size) {
+#ifdef AR_OS_WINDOWS
+	int fd = -1;
+	auto failed = _sopen_s(&fd, path.c_str(), _O_RDWR | _O_BINARY,
+		_SH_DENYNO, 0) != 0;
+	if (!failed) {
+		failed = _chsize_s(fd, static_cast<__int64>(size)) != 0;
+		_close(fd);
+	}
+#else
+	const auto failed = ::truncate(path.c_str(),
+		static_cast<off_t>(size)) != 0;
+#endif
+	if (failed) {
+		throw IOError{"cannot resize file \"" + path + "\""};
+	}
+}
+
+///
+/// Obtains the size and the modification time (in seconds since the epoch) of
+/// the given file.
+///
+/// @return @c false when there is no regular file in the given path.
+///
+bool getFileSizeAndModificationTime(const std::string& path, std::size_t& size,
+		std::time_t& modificationTime) {
+#ifdef AR_OS_WINDOWS
+	struct _stat64 status;
+	if (_stat64(path.c_str(), &status) != 0 ||
+			(status.st_mode & _S_IFMT) != _S_IFREG) {
+		return false;
+	}
+#else
+	struct stat status;
+	if (::stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode)) {
+		return false;
+	}
+#endif
+	size = static_cast<std::size_t>(status.st_size);
+	modificationTime = static_cast<std::time_t>(status.st_mtime);
+	return true;
+}
+
+///
+/// Sets the modification (and access) time of the given file.
+///
+/// @param[in] path Path to the file.
+/// @param[in] time Time in seconds since the epoch.
+///
+/// @throws IOError When the time cannot be set.
+///
+void setFileModificationTime(const std::string& path, std::time_t time) {
+#ifdef AR_OS_WINDOWS
+	struct __utimbuf64 times;
+	times.actime = time;
+	times.modtime = time;
+	const auto failed = _utime64(path.c_str(), &times) != 0;
+#else
+	struct utimbuf times;
+	times.actime = time;
+	times.modtime = time;
+	const auto failed = ::utime(path.c_str(), &times) != 0;
+#endif
+	if (failed) {
+		throw IOError{
+			"cannot set the modification time of file \"" + path + "\""
+		};
+	}
+}
+
+///
+/// Does the given file have exactly the given @a content of the given
+/// @a size?
+///
+/// The file is compared in chunks, so it is not read whole into memory. When
+/// the file cannot be opened, @c false is returned.
+///
+bool fileHasContent(const std::string& path, const char* content,
+		std::size_t size) {
+	std::ifstream file{path, std::ios::binary};
+	if (!file) {
+		return false;
+	}
+
+	std::string chunk(std::min(size, FileChunkSize), '\0');
+	for (std::size_t compared = 0; compared < size; compared += chunk.size()) {
+		chunk.resize(std::min(size - compared, FileChunkSize));
+		file.read(&chunk[0], chunk.size());
+		if (static_cast<std::size_t>(file.gcount()) != chunk.size() ||
+				std::memcmp(chunk.data(), content + compared,
+					chunk.size()) != 0) {
+			return false;
+		}
+	}
+	return file.peek() == std::ifstream::traits_type::eof();
+}
+
+///
+/// Creates the given directory.
+///
+/// @throws IOError When the directory cannot be created. An already existing
+///                 directory is not an error.
+///
+void createDirectory(const std::string& path) {
+#ifdef AR_OS_WINDOWS
+	const auto failed = _mkdir(path.c_str()) != 0 && errno != EEXIST;
+#else
+	const auto failed = ::mkdir(path.c_str(), 0777) != 0 && errno != EEXIST;
+#endif
+	if (failed) {
+		throw IOError{"cannot create directory \"" + path + "\""};
+	}
+}
+
+///
+/// Removes the given file (if it exists).
+///
+/// Unlike overwriting, removing a file that is a hard link to other files
+/// leaves the other files intact.
+///
+void removeFile(const std::string& path) {
+	std::remove(path.c_str());
+}
+
+///
+/// Creates a hard link in @a dstPath to the file in @a srcPath.
+///
+/// @return @c false when the link cannot be created (for example, because the
+///         paths lie on different filesystems or a file already exists in
+///         @a dstPath).
+///
+bool createHardLink(const std::string& srcPath, const std::string& dstPath) {
+#ifdef AR_OS_WINDOWS
+	return CreateHardLinkA(dstPath.c_str(), srcPath.c_str(), nullptr) != 0;
+#else
+	return ::link(srcPath.c_str(), dstPath.c_str()) == 0;
+#endif
+}
+
+///
+/// Creates a file in @a dstPath that shares its content with the file in
+/// @a srcPath (a reflink).
+///
+/// No content is copied. The new file is otherwise independent of the
+/// original one, so a later modification of either of them does not affect
+/// the other one.
+///
+/// @return @c false when the clone cannot be created (for example, because
+///         the filesystem does not support cloning or a file already exists
+///         in @a dstPath).
+///
+bool cloneFile(const std::string& srcPath, const std::string& dstPath) {
+#ifdef FICLONE
+	const auto srcFd = ::open(srcPath.c_str(), O_RDONLY | O_CLOEXEC);
+	if (srcFd < 0) {
+		return false;
+	}
+	const auto dstFd = ::open(dstPath.c_str(),
+		O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+	if (dstFd < 0) {
+		::close(srcFd);
+		return false;
+	}
+
+	const auto cloned = ::ioctl(dstFd, FICLONE, srcFd) == 0;
+	::close(dstFd);
+	::close(srcFd);
+	if (!cloned) {
+		::unlink(dstPath.c_str());
+	}
+	return cloned;
+#else
+	(void)srcPath;
+	(void)dstPath;
+	return false;
+#endif
+}
+
 } // namespace internal
 } // namespace ar
@@ -0,0 +1,231 @@
+///
+/// @file      ar/internal/utilities/thread_pool.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the work-stealing thread pool.
+///
+
+#include <utility>
+
+#include "ar/internal/utilities/thread_pool.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+/// Pool whose worker is running on the current thread (if any).
+thread_local const ThreadPool* currentPool = nullptr;
+
+/// Index of the worker running on the current thread.
+thread_local std::size_t currentWorkerIndex = 0;
+
+} // anonymous namespace
+
+///
+/// Creates a pool with the given number of worker threads.
+///
+/// When @a threadCount is zero, defaultThreadCount() workers are created.
+///
+ThreadPool::ThreadPool(std::size_t threadCount):
+		pendingTasks(0), queuedTasks(0), nextQueue(0), stopping(false) {
+	if (threadCount == 0) {
+		threadCount = defaultThreadCount();
+	}
+
+	for (std::size_t j = 0; j < threadCount; ++j) {
+		queues.push_back(std::make_unique<WorkerQueue>());
+	}
+	for (std::size_t j = 0; j < threadCount; ++j) {
+		workers.emplace_back([this, j]() { workerLoop(j); });
+	}
+}
+
+///
+/// Finishes all pending tasks and stops the workers.
+///
+ThreadPool::~ThreadPool() {
+	try {
+		wait();
+	} catch (...) {
+		// Exceptions cannot be propagated from a destructor.
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{sleepMutex};
+		stopping = true;
+	}
+	workAvailable.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+///
+/// Schedules the given task to be run by the pool.
+///
+/// When called from a worker of this pool, the task is placed into the queue
+/// of that worker. Otherwise, the queues are filled in a round-robin fashion.
+///
+void ThreadPool::submit(Task task) {
+	const auto queueIndex = currentPool == this
+		? currentWorkerIndex
+		: nextQueue++ % queues.size();
+
+	pendingTasks++;
+	{
+		auto& queue = *queues[queueIndex];
+		std::lock_guard<std::mutex> lock{queue.mutex};
+		queue.tasks.push_back(std::move(task));
+		queuedTasks++;
+	}
+	{
+		// Lock the mutex so that a thread that is about to sleep cannot miss
+		// the notification.
+		std::lock_guard<std::mutex> lock{sleepMutex};
+	}
+	workAvailable.notify_one();
+	allTasksDone.notify_all();
+}
+
+///
+/// Waits until all submitted tasks have finished.
+///
+/// The calling thread helps with running the tasks while waiting. If any of
+/// the tasks has thrown an exception, the first such exception is rethrown.
+///
+/// This function must not be called from a task run by the pool.
+///
+void ThreadPool::wait() {
+	while (pendingTasks > 0) {
+		if (tryRunTask(0)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock{sleepMutex};
+		allTasksDone.wait(lock, [this]() {
+			return pendingTasks == 0 || queuedTasks > 0;
+		});
+	}
+
+	std::exception_ptr exception;
+	{
+		std::lock_guard<std::mutex> lock{sleepMutex};
+		std::swap(exception, firstException);
+	}
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+///
+/// Returns the number of worker threads in the pool.
+///
+std::size_t ThreadPool::getThreadCount() const noexcept {
+	return workers.size();
+}
+
+///
+/// Returns the number of threads that the hardware can run concurrently.
+///
+std::size_t ThreadPool::defaultThreadCount() noexcept {
+	const auto count = std::thread::hardware_concurrency();
+	return count > 0 ? count : 1;
+}
+
+void ThreadPool::workerLoop(std::size_t workerIndex) {
+	currentPool = this;
+	currentWorkerIndex = workerIndex;
+
+	for (;;) {
+		if (tryRunTask(workerIndex)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock{sleepMutex};
+		workAvailable.wait(lock, [this]() {
+			return stopping || queuedTasks > 0;
+		});
+		if (stopping) {
+			return;
+		}
+	}
+}
+
+bool ThreadPool::tryRunTask(std::size_t preferredQueue) {
+	Task task;
+
+	// Own tasks are taken from the back (the most recently submitted ones are
+	// hot in the cache), stolen tasks from the front (the oldest ones tend to
+	// be the largest ones when tasks split themselves).
+	auto found = tryPopTask(preferredQueue, task, currentPool == this);
+	for (std::size_t j = 1; !found && j < queues.size(); ++j) {
+		found = tryPopTask((preferredQueue + j) % queues.size(), task, false);
+	}
+	if (!found) {
+		return false;
+	}
+
+	runTask(task);
+	return true;
+}
+
+bool ThreadPool::tryPopTask(std::size_t queueIndex, Task& task,
+		bool fromBack) {
+	auto& queue = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock{queue.mutex};
+	if (queue.tasks.empty()) {
+		return false;
+	}
+
+	if (fromBack) {
+		task = std::move(queue.tasks.back());
+		queue.tasks.pop_back();
+	} else {
+		task = std::move(queue.tasks.front());
+		queue.tasks.pop_front();
+	}
+	queuedTasks--;
+	return true;
+}
+
+void ThreadPool::runTask(Task& task) {
+	try {
+		task();
+	} catch (...) {
+		std::lock_guard<std::mutex> lock{sleepMutex};
+		if (!firstException) {
+			firstException = std::current_exception();
+		}
+	}
+
+	if (--pendingTasks == 0) {
+		{
+			std::lock_guard<std::mutex> lock{sleepMutex};
+		}
+		allTasksDone.notify_all();
+	}
+}
+
+///
+/// Creates a pool for running tasks by @a threadCount threads, one of which
+/// is the calling thread.
+///
+/// The calling thread helps the pool while waiting (see ThreadPool::wait()),
+/// so the pool has one worker less than @a threadCount. When @a threadCount
+/// is zero, ThreadPool::defaultThreadCount() threads are used. When only a
+/// single thread is to be used, the null pointer is returned, and the tasks
+/// should be run directly in the calling thread.
+///
+std::unique_ptr<ThreadPool> createPoolForCaller(std::size_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = ThreadPool::defaultThreadCount();
+	}
+	if (threadCount <= 1) {
+		return nullptr;
+	}
+	return std::make_unique<ThreadPool>(threadCount - 1);
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,205 @@
+///
+/// @file      ar/internal/utilities/tracing.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the spans of traced operations.
+///
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include "ar/exceptions.h"
+#include "ar/internal/utilities/tracing.h"
+
+namespace ar {
+namespace internal {
+
+std::atomic<bool> tracingEnabled{false};
+
+namespace {
+
+///
+/// The trace being written.
+///
+struct Trace {
+	/// Guards the trace.
+	std::mutex mutex;
+
+	/// File into which the trace is written.
+	std::ofstream file;
+
+	/// Start of the trace (see traceClockNow()).
+	std::uint64_t start = 0;
+
+	/// Has an event been written into the trace?
+	bool hasEvents = false;
+};
+
+Trace& currentTrace() {
+	static Trace trace;
+	return trace;
+}
+
+///
+/// Returns the ID of the calling thread in traces.
+///
+/// Threads are numbered from 1 in the order in which they trace their first
+/// span, which keeps the IDs small and stable within a trace.
+///
+std::uint32_t traceThreadId() {
+	static std::atomic<std::uint32_t> lastThreadId{0};
+	thread_local const auto threadId = ++lastThreadId;
+	return threadId;
+}
+
+///
+/// Appends the given time (in nanoseconds) in microseconds, the unit of the
+/// trace-event format.
+///
+void appendMicroseconds(std::string& json, std::uint64_t nanoseconds) {
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "%llu.%03u",
+		static_cast<unsigned long long>(nanoseconds / 1000),
+		static_cast<unsigned>(nanoseconds % 1000));
+	json += buffer;
+}
+
+///
+/// Appends the given string as a JSON string.
+///
+void appendJsonString(std::string& json, std::string_view str) {
+	json += '"';
+	for (auto c : str) {
+		if (c == '"' || c == '\\') {
+			json += '\\';
+			json += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			char buffer[8];
+			std::snprintf(buffer, sizeof(buffer), "\\u%04x",
+				static_cast<unsigned>(c));
+			json += buffer;
+		} else {
+			json += c;
+		}
+	}
+	json += '"';
+}
+
+///
+/// Writes a trace into the file named by the @c AR_TRACE environment
+/// variable (when it is set) from the start of the program until its end.
+///
+class EnvironmentTrace {
+public:
+	EnvironmentTrace() {
+		// Construct the trace before this object, so it is destroyed after
+		// the destructor below has closed it.
+		currentTrace();
+
+		const auto path = std::getenv("AR_TRACE");
+		if (path && *path) {
+			try {
+				openTrace(path);
+			} catch (const IOError&) {
+				// The program should not fail because of a misconfigured
+				// trace.
+			}
+		}
+	}
+
+	~EnvironmentTrace() {
+		closeTrace();
+	}
+};
+
+const EnvironmentTrace environmentTrace;
+
+} // anonymous namespace
+
+///
+/// Returns the current time of the clock of traces (in nanoseconds).
+///
+std::uint64_t traceClockNow() noexcept {
+	return static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()
+		).count()
+	);
+}
+
+///
+/// Starts writing a trace into the given file, finishing the current trace
+/// (if any).
+///
+/// @throws IOError When the file cannot be opened.
+///
+void openTrace(const std::string& path) {
+	closeTrace();
+
+	auto& trace = currentTrace();
+	std::lock_guard<std::mutex> lock{trace.mutex};
+	trace.file.open(path, std::ios::binary);
+	if (!trace.file) {
+		throw IOError{"cannot open file \"" + path + "\""};
+	}
+	trace.file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	trace.start = traceClockNow();
+	trace.hasEvents = false;
+	tracingEnabled = true;
+}
+
+///
+/// Finishes the current trace (if any).
+///
+/// Spans that end after the trace has been finished are not recorded.
+///
+void closeTrace() {
+	auto& trace = currentTrace();
+	std::lock_guard<std::mutex> lock{trace.mutex};
+	tracingEnabled = false;
+	if (trace.file.is_open()) {
+		trace.file << "\n]}\n";
+		trace.file.close();
+	}
+}
+
+///
+/// Records a span of the operation of the given name that lasted from
+/// @a start to @a end into the current trace.
+///
+/// The span is written as a complete event (@c "ph":"X") of the calling
+/// thread, with the detail (if any) in its arguments.
+///
+void recordTraceSpan(const char* name, std::string_view detail,
+		std::uint64_t start, std::uint64_t end) {
+	auto& trace = currentTrace();
+	std::lock_guard<std::mutex> lock{trace.mutex};
+	if (!trace.file.is_open()) {
+		return;
+	}
+
+	std::string event{"{\"name\":"};
+	appendJsonString(event, name);
+	event += ",\"cat\":\"ar\",\"ph\":\"X\",\"ts\":";
+	// A span started before the trace is clamped to the start of the trace.
+	appendMicroseconds(event, start > trace.start ? start - trace.start : 0);
+	event += ",\"dur\":";
+	appendMicroseconds(event, end > start ? end - start : 0);
+	event += ",\"pid\":1,\"tid\":";
+	event += std::to_string(traceThreadId());
+	if (!detail.empty()) {
+		event += ",\"args\":{\"detail\":";
+		appendJsonString(event, detail);
+		event += '}';
+	}
+	event += '}';
+	trace.file << (trace.hasEvents ? ",\n" : "\n") << event;
+	trace.hasEvents = true;
+}
+
+} // namespace internal
+} // namespace ar
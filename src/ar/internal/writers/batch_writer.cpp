@@ -0,0 +1,94 @@
+///
+/// @file      ar/internal/writers/batch_writer.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the base class and factory for writers of
+///            files in batches.
+///
+
+#include <utility>
+
+#include "ar/internal/writers/batch_writer.h"
+#include "ar/internal/writers/io_uring_batch_writer.h"
+#include "ar/internal/writers/thread_pool_batch_writer.h"
+
+namespace ar {
+namespace internal {
+
+///
+/// Constructs a writer that writes files in batches of the given size.
+///
+BatchWriter::BatchWriter(std::size_t batchSize):
+	batchSize(batchSize) {}
+
+BatchWriter::~BatchWriter() = default;
+
+///
+/// Schedules a file with the given content to be written into the given path.
+///
+/// The content is not copied, so it has to stay valid until the next flush.
+/// When the batch is full, it is flushed. When a file with the same path is
+/// already waiting, the batch is flushed first, so the file written last is
+/// the one that is kept.
+///
+/// @throws IOError When a file in a flushed batch cannot be written.
+///
+void BatchWriter::write(std::string path, const char* content,
+		std::size_t size) {
+	if (pendingPaths.count(path) > 0) {
+		flush();
+	}
+
+	pendingPaths.insert(path);
+	pendingWrites.push_back({std::move(path), content, size});
+	if (pendingWrites.size() >= batchSize) {
+		flush();
+	}
+}
+
+///
+/// Writes all scheduled files.
+///
+/// @throws IOError When a file cannot be written. All the other files are
+///         still written.
+///
+void BatchWriter::flush() {
+	if (pendingWrites.empty()) {
+		return;
+	}
+
+	PendingWrites writes;
+	writes.swap(pendingWrites);
+	pendingPaths.clear();
+	writeBatch(writes);
+}
+
+///
+/// Returns the number of files waiting to be written.
+///
+std::size_t BatchWriter::getPendingCount() const noexcept {
+	return pendingWrites.size();
+}
+
+///
+/// Are the files written through io_uring?
+///
+bool BatchWriter::usesIoUring() const noexcept {
+	return false;
+}
+
+///
+/// Creates the best writer available on the current system.
+///
+/// When the kernel supports io_uring, a writer using it is returned.
+/// Otherwise, a writer using a pool of @a threadCount threads is returned.
+///
+std::unique_ptr<BatchWriter> BatchWriter::create(std::size_t threadCount) {
+	if (IoUringBatchWriter::isSupported()) {
+		return std::make_unique<IoUringBatchWriter>();
+	}
+	return std::make_unique<ThreadPoolBatchWriter>(threadCount);
+}
+
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,510 @@
+///
+/// @file      ar/internal/writers/io_uring_batch_writer.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the writer of files in batches by using
+///            io_uring.
+///
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef AR_HAVE_IO_URING
+// The header uses flexible array members, which are not part of ISO C++.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <linux/io_uring.h>
+#pragma GCC diagnostic pop
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "ar/exceptions.h"
+#include "ar/internal/writers/io_uring_batch_writer.h"
+
+namespace ar {
+namespace internal {
+
+#ifdef AR_HAVE_IO_URING
+
+namespace {
+
+/// Number of entries in the submission queue.
+const unsigned RingEntries = 256;
+
+/// The largest number of bytes that Linux writes by a single request.
+const std::size_t MaxWriteSize = 0x7ffff000;
+
+std::string errorMessage(int errorNumber) {
+	return std::strerror(errorNumber);
+}
+
+///
+/// Descriptors of the files opened in a group of writes.
+///
+/// The descriptors that have not been released are closed on destruction, so
+/// they do not leak when the writing fails with an exception.
+///
+class OpenedFiles {
+public:
+	explicit OpenedFiles(std::size_t count): fds(count, -1) {}
+
+	~OpenedFiles() {
+		for (const auto fd : fds) {
+			if (fd >= 0) {
+				::close(fd);
+			}
+		}
+	}
+
+	/// Stores the descriptor of the k-th file (ignored when negative).
+	void set(std::size_t k, int fd) noexcept {
+		if (fd >= 0) {
+			fds[k] = fd;
+		}
+	}
+
+	/// Forgets the descriptor of the k-th file after it has been closed.
+	void release(std::size_t k) noexcept {
+		fds[k] = -1;
+	}
+
+	bool isOpen(std::size_t k) const noexcept {
+		return fds[k] >= 0;
+	}
+
+	int operator[](std::size_t k) const noexcept {
+		return fds[k];
+	}
+
+	/// @name Disabled
+	/// @{
+	OpenedFiles(const OpenedFiles&) = delete;
+	OpenedFiles(OpenedFiles&&) = delete;
+	OpenedFiles& operator=(const OpenedFiles&) = delete;
+	OpenedFiles& operator=(OpenedFiles&&) = delete;
+	/// @}
+
+private:
+	/// Descriptors of the files (-1 when a file is not open).
+	std::vector<int> fds;
+};
+
+} // anonymous namespace
+
+///
+/// The submission and completion queues of io_uring.
+///
+class IoUringBatchWriter::Ring {
+public:
+	explicit Ring(unsigned entries);
+	~Ring();
+
+	unsigned getCapacity() const noexcept;
+	bool supportsOperation(unsigned operation) const;
+
+	io_uring_sqe& prepareSqe();
+	void submitAndWait(std::vector<io_uring_cqe>& completions);
+
+	/// @name Disabled
+	/// @{
+	Ring(const Ring&) = delete;
+	Ring(Ring&&) = delete;
+	Ring& operator=(const Ring&) = delete;
+	Ring& operator=(Ring&&) = delete;
+	/// @}
+
+private:
+	void release() noexcept;
+	void reapCompletions(std::vector<io_uring_cqe>& completions);
+
+	template <typename T>
+	T* at(void* ring, unsigned offset) const noexcept {
+		return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+	}
+
+private:
+	/// File descriptor of the ring.
+	int fd = -1;
+
+	/// Mapped submission queue ring.
+	void* sqRing = MAP_FAILED;
+	std::size_t sqRingSize = 0;
+
+	/// Mapped completion queue ring (may be the same as @c sqRing).
+	void* cqRing = MAP_FAILED;
+	std::size_t cqRingSize = 0;
+
+	/// Mapped submission queue entries.
+	io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+	std::size_t sqesSize = 0;
+
+	/// @name Pointers into the mapped rings
+	/// @{
+	unsigned* sqTail = nullptr;
+	unsigned* sqMask = nullptr;
+	unsigned* sqArray = nullptr;
+	unsigned* cqHead = nullptr;
+	unsigned* cqTail = nullptr;
+	unsigned* cqMask = nullptr;
+	io_uring_cqe* cqes = nullptr;
+	/// @}
+
+	/// Number of entries in the submission queue.
+	unsigned sqEntries = 0;
+
+	/// Tail of the submission queue including prepared (unsubmitted) entries.
+	unsigned preparedTail = 0;
+
+	/// Number of submitted requests whose completions have not been reaped.
+	unsigned inFlight = 0;
+};
+
+IoUringBatchWriter::Ring::Ring(unsigned entries) {
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+	fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+	if (fd < 0) {
+		throw IOError{"cannot set up io_uring (" + errorMessage(errno) + ")"};
+	}
+
+	sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (singleMmap) {
+		sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+	}
+	sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+	sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	cqRing = singleMmap ? sqRing : mmap(nullptr, cqRingSize,
+		PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+		IORING_OFF_CQ_RING);
+	sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqesSize,
+		PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+		IORING_OFF_SQES));
+	if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqes == MAP_FAILED) {
+		const auto errorNumber = errno;
+		release();
+		throw IOError{"cannot map io_uring (" + errorMessage(errorNumber) + ")"};
+	}
+
+	sqTail = at<unsigned>(sqRing, params.sq_off.tail);
+	sqMask = at<unsigned>(sqRing, params.sq_off.ring_mask);
+	sqArray = at<unsigned>(sqRing, params.sq_off.array);
+	cqHead = at<unsigned>(cqRing, params.cq_off.head);
+	cqTail = at<unsigned>(cqRing, params.cq_off.tail);
+	cqMask = at<unsigned>(cqRing, params.cq_off.ring_mask);
+	cqes = at<io_uring_cqe>(cqRing, params.cq_off.cqes);
+	sqEntries = params.sq_entries;
+	preparedTail = *sqTail;
+}
+
+IoUringBatchWriter::Ring::~Ring() {
+	release();
+}
+
+///
+/// Returns the number of requests that can be prepared before a submission.
+///
+unsigned IoUringBatchWriter::Ring::getCapacity() const noexcept {
+	return sqEntries;
+}
+
+///
+/// Does the kernel support the given operation (@c IORING_OP_*)?
+///
+bool IoUringBatchWriter::Ring::supportsOperation(unsigned operation) const {
+	const std::size_t OpCount = 256;
+	std::vector<char> buffer(
+		sizeof(io_uring_probe) + OpCount * sizeof(io_uring_probe_op));
+	auto probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+	if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe,
+			OpCount) < 0) {
+		return false;
+	}
+	return operation <= probe->last_op &&
+		(probe->ops[operation].flags & IO_URING_OP_SUPPORTED);
+}
+
+///
+/// Returns a cleared submission queue entry to be filled by the caller.
+///
+/// At most getCapacity() entries can be prepared before submitAndWait().
+///
+io_uring_sqe& IoUringBatchWriter::Ring::prepareSqe() {
+	const auto index = preparedTail & *sqMask;
+	auto& sqe = sqes[index];
+	std::memset(&sqe, 0, sizeof(sqe));
+	sqArray[index] = index;
+	++preparedTail;
+	return sqe;
+}
+
+///
+/// Submits all prepared entries and waits until all of them complete.
+///
+/// The completions are appended to @a completions.
+///
+/// @throws IOError When the entries cannot be submitted.
+///
+void IoUringBatchWriter::Ring::submitAndWait(
+		std::vector<io_uring_cqe>& completions) {
+	auto toSubmit = preparedTail - __atomic_load_n(sqTail, __ATOMIC_RELAXED);
+	__atomic_store_n(sqTail, preparedTail, __ATOMIC_RELEASE);
+
+	while (toSubmit > 0 || inFlight > 0) {
+		// Submit first and wait only after everything has been submitted.
+		// Otherwise, the kernel could wait for requests it has not accepted.
+		const auto waitFor = toSubmit > 0 ? 0 : inFlight;
+		const auto result = syscall(__NR_io_uring_enter, fd, toSubmit,
+			waitFor, waitFor > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+		if (result < 0) {
+			if (errno == EINTR || errno == EAGAIN) {
+				continue;
+			}
+			throw IOError{"cannot submit io_uring requests (" +
+				errorMessage(errno) + ")"};
+		}
+
+		toSubmit -= static_cast<unsigned>(result);
+		inFlight += static_cast<unsigned>(result);
+		reapCompletions(completions);
+	}
+}
+
+void IoUringBatchWriter::Ring::reapCompletions(
+		std::vector<io_uring_cqe>& completions) {
+	auto head = *cqHead;
+	const auto tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+	while (head != tail) {
+		completions.push_back(cqes[head & *cqMask]);
+		++head;
+		--inFlight;
+	}
+	__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+}
+
+void IoUringBatchWriter::Ring::release() noexcept {
+	if (sqes != MAP_FAILED) {
+		munmap(sqes, sqesSize);
+	}
+	if (cqRing != MAP_FAILED && cqRing != sqRing) {
+		munmap(cqRing, cqRingSize);
+	}
+	if (sqRing != MAP_FAILED) {
+		munmap(sqRing, sqRingSize);
+	}
+	if (fd >= 0) {
+		::close(fd);
+	}
+	sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+	cqRing = sqRing = MAP_FAILED;
+	fd = -1;
+}
+
+///
+/// Constructs a writer.
+///
+/// @throws IOError When io_uring cannot be set up. Check isSupported() before
+///         creating the writer.
+///
+IoUringBatchWriter::IoUringBatchWriter():
+	BatchWriter(RingEntries), ring(std::make_unique<Ring>(RingEntries)) {}
+
+IoUringBatchWriter::~IoUringBatchWriter() = default;
+
+bool IoUringBatchWriter::usesIoUring() const noexcept {
+	return true;
+}
+
+///
+/// Does the running kernel support everything the writer needs?
+///
+bool IoUringBatchWriter::isSupported() {
+	static const bool supported = []() {
+		try {
+			Ring ring{8};
+			return ring.supportsOperation(IORING_OP_OPENAT) &&
+				ring.supportsOperation(IORING_OP_WRITE) &&
+				ring.supportsOperation(IORING_OP_CLOSE);
+		} catch (const IOError&) {
+			return false;
+		}
+	}();
+	return supported;
+}
+
+void IoUringBatchWriter::writeBatch(const PendingWrites& writes) {
+	const std::size_t GroupSize = ring->getCapacity();
+
+	std::string firstError;
+	auto recordError = [&firstError](const std::string& what,
+			const std::string& path, int errorNumber) {
+		if (firstError.empty()) {
+			firstError = "cannot " + what + " file \"" + path + "\" (" +
+				errorMessage(errorNumber) + ")";
+		}
+	};
+
+	std::vector<io_uring_cqe> completions;
+	for (std::size_t start = 0; start < writes.size(); start += GroupSize) {
+		const auto count = std::min(GroupSize, writes.size() - start);
+
+		// Phase 1: open all the files in the group.
+		for (std::size_t k = 0; k < count; ++k) {
+			auto& sqe = ring->prepareSqe();
+			sqe.opcode = IORING_OP_OPENAT;
+			sqe.fd = AT_FDCWD;
+			sqe.addr = reinterpret_cast<std::uintptr_t>(
+				writes[start + k].path.c_str());
+			sqe.len = 0666;
+			sqe.open_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+			sqe.user_data = k;
+		}
+		OpenedFiles files{count};
+		completions.clear();
+		try {
+			ring->submitAndWait(completions);
+		} catch (...) {
+			// Do not leak the files that have been opened before the failure.
+			for (const auto& cqe : completions) {
+				files.set(cqe.user_data, cqe.res);
+			}
+			throw;
+		}
+		for (const auto& cqe : completions) {
+			if (cqe.res < 0) {
+				recordError("open", writes[start + cqe.user_data].path,
+					-cqe.res);
+			} else {
+				files.set(cqe.user_data, cqe.res);
+			}
+		}
+
+		// Phase 2: write the opened files.
+		for (std::size_t k = 0; k < count; ++k) {
+			if (!files.isOpen(k)) {
+				continue;
+			}
+
+			const auto& write = writes[start + k];
+			auto& sqe = ring->prepareSqe();
+			sqe.opcode = IORING_OP_WRITE;
+			sqe.fd = files[k];
+			sqe.addr = reinterpret_cast<std::uintptr_t>(write.content);
+			sqe.len = static_cast<std::uint32_t>(
+				std::min(write.size, MaxWriteSize));
+			sqe.off = 0;
+			sqe.user_data = k;
+		}
+		completions.clear();
+		ring->submitAndWait(completions);
+
+		std::vector<std::size_t> written(count, 0);
+		std::vector<bool> writeFailed(count, false);
+		for (const auto& cqe : completions) {
+			if (cqe.res < 0) {
+				writeFailed[cqe.user_data] = true;
+				recordError("write", writes[start + cqe.user_data].path,
+					-cqe.res);
+			} else {
+				written[cqe.user_data] = static_cast<std::size_t>(cqe.res);
+			}
+		}
+
+		// Phase 3: finish short writes synchronously. The files are still
+		// open because their close is submitted only after that.
+		for (std::size_t k = 0; k < count; ++k) {
+			if (!files.isOpen(k)) {
+				continue;
+			}
+
+			const auto& write = writes[start + k];
+			while (!writeFailed[k] && written[k] < write.size) {
+				const auto result = pwrite(files[k],
+					write.content + written[k],
+					std::min(write.size - written[k], MaxWriteSize),
+					static_cast<off_t>(written[k]));
+				if (result > 0) {
+					written[k] += static_cast<std::size_t>(result);
+				} else if (result == 0 || errno != EINTR) {
+					writeFailed[k] = true;
+					recordError("write", write.path,
+						result == 0 ? ENOSPC : errno);
+				}
+			}
+		}
+
+		// Phase 4: close the opened files.
+		for (std::size_t k = 0; k < count; ++k) {
+			if (!files.isOpen(k)) {
+				continue;
+			}
+
+			auto& sqe = ring->prepareSqe();
+			sqe.opcode = IORING_OP_CLOSE;
+			sqe.fd = files[k];
+			sqe.user_data = k;
+		}
+		completions.clear();
+		try {
+			ring->submitAndWait(completions);
+		} catch (...) {
+			// Files whose close has completed must not be closed again.
+			for (const auto& cqe : completions) {
+				files.release(cqe.user_data);
+			}
+			throw;
+		}
+		for (const auto& cqe : completions) {
+			// The descriptor is released even when the close fails.
+			files.release(cqe.user_data);
+			if (cqe.res < 0) {
+				recordError("close", writes[start + cqe.user_data].path,
+					-cqe.res);
+			}
+		}
+	}
+
+	if (!firstError.empty()) {
+		throw IOError{firstError};
+	}
+}
+
+#else
+
+///
+/// The submission and completion queues of io_uring (unsupported).
+///
+class IoUringBatchWriter::Ring {};
+
+IoUringBatchWriter::IoUringBatchWriter(): BatchWriter(1) {
+	throw IOError{"io_uring is not supported on this system"};
+}
+
+IoUringBatchWriter::~IoUringBatchWriter() = default;
+
+bool IoUringBatchWriter::usesIoUring() const noexcept {
+	return false;
+}
+
+bool IoUringBatchWriter::isSupported() {
+	return false;
+}
+
+void IoUringBatchWriter::writeBatch(const PendingWrites&) {
+	throw IOError{"io_uring is not supported on this system"};
+}
+
+#endif
+
+} // namespace internal
+} // namespace ar
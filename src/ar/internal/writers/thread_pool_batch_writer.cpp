@@ -0,0 +1,55 @@
+///
+/// @file      ar/internal/writers/thread_pool_batch_writer.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the writer of files in batches by using a pool
+///            of threads.
+///
+
+#include <utility>
+
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
+#include "ar/internal/writers/thread_pool_batch_writer.h"
+
+namespace ar {
+namespace internal {
+
+namespace {
+
+/// Number of files written at once.
+const std::size_t BatchSize = 256;
+
+} // anonymous namespace
+
+///
+/// Constructs a writer using the given number of threads.
+///
+/// The thread calling flush() is one of them, so when @a threadCount is one,
+/// the files are written only in that thread. When @a threadCount is zero, as
+/// many threads as the hardware can run concurrently are used.
+///
+ThreadPoolBatchWriter::ThreadPoolBatchWriter(std::size_t threadCount):
+		BatchWriter(BatchSize), pool(createPoolForCaller(threadCount)) {}
+
+ThreadPoolBatchWriter::~ThreadPoolBatchWriter() = default;
+
+void ThreadPoolBatchWriter::writeBatch(const PendingWrites& writes) {
+	for (const auto& write : writes) {
+		auto task = [&write]() {
+			TraceSpan span{"writeFile", write.path};
+			writeFile(write.path, write.content, write.size);
+		};
+		if (pool) {
+			pool->submit(std::move(task));
+		} else {
+			task();
+		}
+	}
+	if (pool) {
+		pool->wait();
+	}
+}
+
+} // namespace internal
+} // namespace ar
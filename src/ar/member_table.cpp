@@ -0,0 +1,434 @@
+///
+/// @file      ar/member_table.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the table of members of an archive.
+///
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "ar/byte_source.h"
+#include "ar/exceptions.h"
+#include "ar/file.h"
+#include "ar/internal/archive_buffer.h"
+#include "ar/internal/files/archive_member_file.h"
+#include "ar/internal/files/byte_source_range_file.h"
+#include "ar/member_table.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+namespace {
+
+///
+/// Returns the values of the given column in the given order.
+///
+template <typename T>
+std::vector<T> permute(const std::vector<T>& column,
+		const std::vector<std::size_t>& order) {
+	std::vector<T> permuted;
+	permuted.reserve(column.size());
+	for (auto index : order) {
+		permuted.push_back(column[index]);
+	}
+	return permuted;
+}
+
+} // anonymous namespace
+
+///
+/// Constructs an empty table.
+///
+MemberTable::MemberTable() = default;
+
+MemberTable::MemberTable(const MemberTable& other) = default;
+
+MemberTable::MemberTable(MemberTable&& other) noexcept = default;
+
+MemberTable::~MemberTable() = default;
+
+MemberTable& MemberTable::operator=(const MemberTable& other) = default;
+
+MemberTable& MemberTable::operator=(MemberTable&& other) noexcept = default;
+
+///
+/// Is the table empty?
+///
+bool MemberTable::empty() const noexcept {
+	return nameEnds.empty();
+}
+
+///
+/// Returns the number of members in the table.
+///
+auto MemberTable::size() const noexcept -> size_type {
+	return nameEnds.size();
+}
+
+///
+/// Returns the name of the member on the given index.
+///
+/// The returned view is valid until the table is modified or destroyed.
+///
+/// @throws std::out_of_range When the index is out of range.
+///
+std::string_view MemberTable::getName(size_type index) const {
+	const auto end = nameEnds.at(index);
+	const auto start = index > 0 ? nameEnds[index - 1] : 0;
+	return std::string_view{names}.substr(start, end - start);
+}
+
+///
+/// Returns the offset of the content of the member on the given index from
+/// the start of the archive.
+///
+/// @throws std::out_of_range When the index is out of range.
+///
+std::uint64_t MemberTable::getOffset(size_type index) const {
+	return offsets.at(index);
+}
+
+///
+/// Returns the size of the content of the member on the given index.
+///
+/// @throws std::out_of_range When the index is out of range.
+///
+std::uint64_t MemberTable::getSize(size_type index) const {
+	return sizes.at(index);
+}
+
+///
+/// Returns the modification time of the member on the given index (in seconds
+/// since the epoch).
+///
+/// @throws std::out_of_range When the index is out of range.
+///
+std::uint64_t MemberTable::getTimestamp(size_type index) const {
+	return timestamps.at(index);
+}
+
+///
+/// Returns the ID of the owner of the member on the given index.
+///
+/// @throws std::out_of_range When the index is out of range.
+///
+std::uint32_t MemberTable::getOwnerId(size_type index) const {
+	return ownerIds.at(index);
+}
+
+///
+/// Returns the ID of the group of the member on the given index.
+///
+/// @throws std::out_of_range When the index is out of range.
+///
+std::uint32_t MemberTable::getGroupId(size_type index) const {
+	return groupIds.at(index);
+}
+
+///
+/// Returns the file mode of the member on the given index.
+///
+/// @throws std::out_of_range When the index is out of range.
+///
+std::uint32_t MemberTable::getMode(size_type index) const {
+	return modes.at(index);
+}
+
+///
+/// Returns the CRC-32C checksum of the content of the member on the given
+/// index.
+///
+/// @throws std::out_of_range When the index is out of range or when the
+///                           checksums have not been computed (see
+///                           hasChecksums()).
+///
+std::uint32_t MemberTable::getChecksum(size_type index) const {
+	return checksums.at(index);
+}
+
+///
+/// Returns a view of the content of the member on the given index.
+///
+/// No content is copied. The view is valid for as long as the table (or any
+/// copy of it) exists.
+///
+/// @throws std::out_of_range When the index is out of range.
+/// @throws Error When the content of the archive is not in memory (see
+///               isContentInMemory()).
+///
+std::string_view MemberTable::getContentView(size_type index) const {
+	return readRange(index, 0, getSize(index));
+}
+
+///
+/// Returns a view of @a length bytes of the content of the member on the
+/// given index, starting at @a offset in the content.
+///
+/// Only the requested range is accessed. For an archive mapped into memory
+/// (see scanMembers()), only the pages of the archive that contain the range
+/// are read from the disk, so reading, e.g., the header of a large object
+/// file does not load the whole file. The view is valid for as long as the
+/// table (or any copy of it) exists.
+///
+/// @throws std::out_of_range When the index is out of range or when the
+///                           range does not lie within the content of the
+///                           member (as given by its header).
+/// @throws Error When the content of the archive is not in memory (see
+///               isContentInMemory()).
+///
+std::string_view MemberTable::readRange(size_type index, std::uint64_t offset,
+		std::uint64_t length) const {
+	ensureIsValidRange(index, offset, length);
+	if (!archive) {
+		throw Error{
+			"the content of the archive is not in memory, so it cannot be "
+			"viewed"
+		};
+	}
+
+	return archive->getContent().substr(offsets[index] + offset, length);
+}
+
+///
+/// Copies @a length bytes of the content of the member on the given index,
+/// starting at @a offset in the content, into @a buffer.
+///
+/// Contrary to the overload returning a view, this works also when the
+/// content of the archive is not in memory, in which case only the range is
+/// read from the source of the archive.
+///
+/// @throws std::out_of_range When the index is out of range or when the
+///                           range does not lie within the content of the
+///                           member (as given by its header).
+/// @throws IOError When the range cannot be read from the source.
+///
+void MemberTable::readRange(size_type index, std::uint64_t offset,
+		std::uint64_t length, char* buffer) const {
+	ensureIsValidRange(index, offset, length);
+	if (archive) {
+		const auto range = archive->getContent().substr(
+			offsets[index] + offset, length);
+		std::copy(range.begin(), range.end(), buffer);
+		return;
+	}
+
+	const auto count = static_cast<std::size_t>(length);
+	if (source->readAt(offsets[index] + offset, buffer, count) != count) {
+		throw IOError{
+			"cannot read the content of member \"" +
+			std::string{getName(index)} + "\""
+		};
+	}
+}
+
+///
+/// Is the content of the archive containing the members in memory?
+///
+/// It is not only when the archive has been scanned from a ByteSource whose
+/// bytes are not in memory. Views of the content of members cannot be
+/// obtained then.
+///
+bool MemberTable::isContentInMemory() const noexcept {
+	return !source;
+}
+
+///
+/// Returns the offsets of the content of all members.
+///
+const std::vector<std::uint64_t>& MemberTable::getOffsets() const noexcept {
+	return offsets;
+}
+
+///
+/// Returns the sizes of the content of all members.
+///
+const std::vector<std::uint64_t>& MemberTable::getSizes() const noexcept {
+	return sizes;
+}
+
+///
+/// Returns the modification times of all members.
+///
+const std::vector<std::uint64_t>& MemberTable::getTimestamps() const noexcept {
+	return timestamps;
+}
+
+///
+/// Returns the IDs of the owners of all members.
+///
+const std::vector<std::uint32_t>& MemberTable::getOwnerIds() const noexcept {
+	return ownerIds;
+}
+
+///
+/// Returns the IDs of the groups of all members.
+///
+const std::vector<std::uint32_t>& MemberTable::getGroupIds() const noexcept {
+	return groupIds;
+}
+
+///
+/// Returns the file modes of all members.
+///
+const std::vector<std::uint32_t>& MemberTable::getModes() const noexcept {
+	return modes;
+}
+
+///
+/// Returns the CRC-32C checksums of the content of all members.
+///
+/// The returned vector is empty when the checksums have not been computed.
+///
+const std::vector<std::uint32_t>& MemberTable::getChecksums() const noexcept {
+	return checksums;
+}
+
+///
+/// Have the checksums of the content of members been computed?
+///
+/// They are computed when the table is obtained from scanMembers() with
+/// ExtractionOptions::computeChecksums.
+///
+bool MemberTable::hasChecksums() const noexcept {
+	return !checksums.empty() && checksums.size() == size();
+}
+
+///
+/// Returns the index of the first member of the given name, or @c npos when
+/// there is no such member.
+///
+auto MemberTable::find(std::string_view name) const noexcept -> size_type {
+	std::size_t start = 0;
+	for (size_type index = 0; index < nameEnds.size(); ++index) {
+		const auto end = nameEnds[index];
+		if (end - start == name.size() &&
+				names.compare(start, end - start, name) == 0) {
+			return index;
+		}
+		start = end;
+	}
+	return npos;
+}
+
+///
+/// Sorts the members by their names.
+///
+/// The sort is stable, so members of the same name keep their order.
+///
+void MemberTable::sortByName() {
+	std::vector<std::size_t> order(size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+		[this](std::size_t a, std::size_t b) {
+			return getName(a) < getName(b);
+		});
+
+	std::string sortedNames;
+	sortedNames.reserve(names.size());
+	std::vector<std::size_t> sortedNameEnds;
+	sortedNameEnds.reserve(nameEnds.size());
+	for (auto index : order) {
+		sortedNames += getName(index);
+		sortedNameEnds.push_back(sortedNames.size());
+	}
+
+	names = std::move(sortedNames);
+	nameEnds = std::move(sortedNameEnds);
+	offsets = permute(offsets, order);
+	sizes = permute(sizes, order);
+	timestamps = permute(timestamps, order);
+	ownerIds = permute(ownerIds, order);
+	groupIds = permute(groupIds, order);
+	modes = permute(modes, order);
+	if (!checksums.empty()) {
+		checksums = permute(checksums, order);
+	}
+}
+
+///
+/// Returns the members as files.
+///
+/// The files refer to the content of the archive, which stays alive for as
+/// long as any of the files exists. When the content of the archive is not in
+/// memory, the files read their content from the source of the archive on
+/// demand.
+///
+Files MemberTable::toFiles() const {
+	Files files;
+	files.reserve(size());
+	for (size_type index = 0; index < size(); ++index) {
+		if (source) {
+			files.push_back(std::make_unique<ByteSourceRangeFile>(
+				source,
+				offsets[index],
+				sizes[index],
+				std::string{getName(index)}
+			));
+			continue;
+		}
+
+		files.push_back(std::make_unique<ArchiveMemberFile>(
+			archive,
+			offsets[index],
+			sizes[index],
+			getName(index)
+		));
+	}
+	return files;
+}
+
+void MemberTable::reserve(size_type count) {
+	nameEnds.reserve(count);
+	offsets.reserve(count);
+	sizes.reserve(count);
+	timestamps.reserve(count);
+	ownerIds.reserve(count);
+	groupIds.reserve(count);
+	modes.reserve(count);
+}
+
+void MemberTable::append(std::string_view name, std::uint64_t offset,
+		std::uint64_t size, std::uint64_t timestamp, std::uint32_t ownerId,
+		std::uint32_t groupId, std::uint32_t mode) {
+	names += name;
+	nameEnds.push_back(names.size());
+	offsets.push_back(offset);
+	sizes.push_back(size);
+	timestamps.push_back(timestamp);
+	ownerIds.push_back(ownerId);
+	groupIds.push_back(groupId);
+	modes.push_back(mode);
+}
+
+void MemberTable::appendChecksum(std::uint32_t checksum) {
+	checksums.push_back(checksum);
+}
+
+void MemberTable::setArchive(
+		std::shared_ptr<const internal::ArchiveBuffer> archive) {
+	this->archive = std::move(archive);
+}
+
+void MemberTable::setSource(std::shared_ptr<const ByteSource> source) {
+	this->source = std::move(source);
+}
+
+void MemberTable::ensureIsValidRange(size_type index, std::uint64_t offset,
+		std::uint64_t length) const {
+	const auto size = getSize(index);
+	if (offset > size || length > size - offset) {
+		throw std::out_of_range{
+			"range <" + std::to_string(offset) + ", " +
+			std::to_string(offset + length) + ") is out of member \"" +
+			std::string{getName(index)} + "\" of size " +
+			std::to_string(size)
+		};
+	}
+}
+
+} // namespace ar
@@ -0,0 +1,161 @@
+///
+/// @file      ar/memory_accounting.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the accounting of allocated memory.
+///
+
+#include "ar/memory_accounting.h"
+
+namespace ar {
+
+namespace {
+
+/// The counter registered by setMemoryCounter().
+std::atomic<MemoryCounter*> registeredCounter{nullptr};
+
+} // anonymous namespace
+
+///
+/// Counts an allocation of the given number of bytes.
+///
+void MemoryCounter::recordAllocation(std::size_t size) noexcept {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	const auto held = heldBytes.fetch_add(size,
+		std::memory_order_relaxed) + size;
+	raisePeak(held);
+}
+
+///
+/// Counts a deallocation of the given number of bytes.
+///
+/// The size has to be the one with which the memory has been counted as
+/// allocated.
+///
+void MemoryCounter::recordDeallocation(std::size_t size) noexcept {
+	heldBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+///
+/// Returns the counted usage of memory.
+///
+/// When memory is being allocated by other threads, the returned counts do
+/// not have to form a consistent snapshot.
+///
+MemoryUsage MemoryCounter::getUsage() const noexcept {
+	MemoryUsage usage;
+	usage.allocations = allocations.load(std::memory_order_relaxed);
+	usage.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+	usage.heldBytes = heldBytes.load(std::memory_order_relaxed);
+	usage.peakHeldBytes = peakHeldBytes.load(std::memory_order_relaxed);
+	return usage;
+}
+
+///
+/// Sets the peak to the number of bytes that are currently held and returns
+/// the previous peak.
+///
+/// Together with raisePeak(), it allows to measure the peak of a part of a
+/// program without losing the overall peak:
+/// @code
+/// auto previousPeak = counter.resetPeak();
+/// // ...
+/// auto partPeak = counter.getUsage().peakHeldBytes;
+/// counter.raisePeak(previousPeak);
+/// @endcode
+///
+std::uint64_t MemoryCounter::resetPeak() noexcept {
+	return peakHeldBytes.exchange(heldBytes.load(std::memory_order_relaxed),
+		std::memory_order_relaxed);
+}
+
+///
+/// Raises the peak to the given number of bytes (when it is lower).
+///
+void MemoryCounter::raisePeak(std::uint64_t bytes) noexcept {
+	auto peak = peakHeldBytes.load(std::memory_order_relaxed);
+	while (peak < bytes && !peakHeldBytes.compare_exchange_weak(
+			peak, bytes, std::memory_order_relaxed)) {}
+}
+
+///
+/// Creates a resource that counts the memory allocated by
+/// @c std::pmr::new_delete_resource().
+///
+CountingMemoryResource::CountingMemoryResource() noexcept:
+	CountingMemoryResource(std::pmr::new_delete_resource()) {}
+
+///
+/// Creates a resource that counts the memory allocated from @a upstream.
+///
+CountingMemoryResource::CountingMemoryResource(
+		std::pmr::memory_resource* upstream) noexcept:
+	upstream(upstream) {}
+
+///
+/// Returns the resource from which the memory is allocated.
+///
+std::pmr::memory_resource* CountingMemoryResource::getUpstream()
+		const noexcept {
+	return upstream;
+}
+
+///
+/// Returns the counter of the allocated memory (e.g. to register it by
+/// setMemoryCounter()).
+///
+MemoryCounter& CountingMemoryResource::getCounter() noexcept {
+	return counter;
+}
+
+///
+/// Returns the usage of memory allocated from the resource.
+///
+MemoryUsage CountingMemoryResource::getUsage() const noexcept {
+	return counter.getUsage();
+}
+
+void* CountingMemoryResource::do_allocate(std::size_t bytes,
+		std::size_t alignment) {
+	auto p = upstream->allocate(bytes, alignment);
+	counter.recordAllocation(bytes);
+	return p;
+}
+
+void CountingMemoryResource::do_deallocate(void* p, std::size_t bytes,
+		std::size_t alignment) {
+	upstream->deallocate(p, bytes, alignment);
+	counter.recordDeallocation(bytes);
+}
+
+bool CountingMemoryResource::do_is_equal(
+		const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+///
+/// Registers the counter whose usage is recorded in the statistics of
+/// extractions (the null pointer unregisters it).
+///
+/// For every phase of an extraction that collects statistics (see
+/// ExtractionOptions::stats), the number of allocations and allocated
+/// bytes counted during the phase, the peak of the held bytes, and the held
+/// bytes at its end are recorded. The peaks are measured by resetting the
+/// peak of the counter at the start of every phase (see
+/// MemoryCounter::resetPeak()), so when several extractions run at the same
+/// time, the peaks of their phases are mixed.
+///
+void setMemoryCounter(MemoryCounter* counter) noexcept {
+	registeredCounter.store(counter, std::memory_order_release);
+}
+
+///
+/// Returns the counter registered by setMemoryCounter() (the null pointer
+/// when there is none).
+///
+MemoryCounter* getMemoryCounter() noexcept {
+	return registeredCounter.load(std::memory_order_acquire);
+}
+
+} // namespace ar
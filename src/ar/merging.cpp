@@ -0,0 +1,318 @@
+///
+/// @file      ar/merging.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the merging of archives.
+///
+
+#include <charconv>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+
+#include "ar/byte_source.h"
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/internal/archive_format.h"
+#include "ar/internal/boundary_discovery.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/member_table.h"
+#include "ar/merging.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+namespace {
+
+///
+/// An archive to be merged.
+///
+struct SourceArchive {
+	/// Path to the archive.
+	std::string path;
+
+	/// Members of the archive (only their headers have been read).
+	MemberTable members;
+
+	/// Symbols from the symbol table of the archive.
+	std::vector<Symbol> symbols;
+};
+
+///
+/// A member of the merged archive.
+///
+struct PlannedMember {
+	/// Index of the archive containing the member.
+	std::size_t archiveIndex;
+
+	/// Index of the member in the archive.
+	MemberTable::size_type memberIndex;
+
+	/// The name field of the header of the member in the merged archive.
+	std::string nameField;
+
+	/// Offset of the header of the member in the merged archive.
+	std::uint64_t headerOffset = 0;
+};
+
+///
+/// Returns the symbols from the symbol table of the given archive (or nothing
+/// when it has no symbol table).
+///
+/// The symbol table is the first member of GNU archives, so only it is read.
+///
+std::vector<Symbol> readSymbols(const ByteSource& source) {
+	const auto tableOffset = ArchiveMagicString.size();
+	std::string header(MemberHeaderSize, '\0');
+	if (source.readAt(tableOffset, &header[0], header.size()) !=
+			header.size() ||
+			!isSymbolTableName(std::string_view{header}.substr(0, 16))) {
+		return {};
+	}
+
+	auto sizeField = std::string_view{header}.substr(48, 10);
+	sizeField = sizeField.substr(0, sizeField.find(' '));
+	std::size_t size = 0;
+	const auto result = std::from_chars(sizeField.data(),
+		sizeField.data() + sizeField.size(), size);
+	if (result.ec != std::errc() ||
+			result.ptr != sizeField.data() + sizeField.size()) {
+		throw InvalidArchiveError{
+			"invalid symbol table size: " + std::string{sizeField}
+		};
+	}
+	std::string content(size, '\0');
+	if (source.readAt(tableOffset + MemberHeaderSize, &content[0], size) !=
+			size) {
+		throw InvalidArchiveError{"premature end of symbol table"};
+	}
+	return parseSymbolTable(content, header[1] == 'S');
+}
+
+///
+/// Reads the headers (and the symbol table) of the given archive.
+///
+SourceArchive readSourceArchive(const std::string& path,
+		const MergeOptions& options) {
+	// The archive is mapped into memory, so only the pages with the headers
+	// are read.
+	auto source = ByteSource::fromFilesystem(path);
+	SourceArchive archive{path, scanMembers(source), {}};
+	if (options.symbolTable) {
+		archive.symbols = readSymbols(*source);
+	}
+	return archive;
+}
+
+///
+/// Plans the names of the members of the merged archive and returns the
+/// content of the filename table of the merged archive.
+///
+std::string planNames(const std::vector<SourceArchive>& archives,
+		std::vector<PlannedMember>& members) {
+	std::string nameTable;
+	std::unordered_map<std::string_view, std::size_t> nameIndexes;
+	for (std::size_t i = 0; i < archives.size(); ++i) {
+		const auto& table = archives[i].members;
+		for (MemberTable::size_type j = 0; j < table.size(); ++j) {
+			const auto name = table.getName(j);
+			ensureIsValidMemberName(name);
+			PlannedMember member{i, j, {}};
+			if (name.size() <= MaxShortNameSize) {
+				member.nameField = std::string{name} + "/";
+			} else {
+				// Every long name is stored only once.
+				const auto [it, inserted] = nameIndexes.emplace(name,
+					nameTable.size());
+				if (inserted) {
+					nameTable.append(name);
+					nameTable.append("/\n");
+				}
+				member.nameField = "/" + std::to_string(it->second);
+			}
+			members.push_back(std::move(member));
+		}
+	}
+	return nameTable;
+}
+
+///
+/// Returns the symbol table of the merged archive, in which the symbols
+/// refer to the headers of the given members.
+///
+/// @throws InvalidArchiveError When a symbol does not refer to a member.
+///
+std::vector<Symbol> planSymbols(const std::vector<SourceArchive>& archives,
+		const std::vector<PlannedMember>& members) {
+	std::vector<Symbol> symbols;
+	std::size_t firstMember = 0;
+	for (const auto& archive : archives) {
+		const auto& table = archive.members;
+		std::unordered_map<std::uint64_t, std::uint64_t> headerOffsets;
+		for (MemberTable::size_type j = 0; j < table.size(); ++j) {
+			headerOffsets.emplace(table.getOffset(j) - MemberHeaderSize,
+				members[firstMember + j].headerOffset);
+		}
+		for (const auto& symbol : archive.symbols) {
+			const auto it = headerOffsets.find(symbol.headerOffset);
+			if (it == headerOffsets.end()) {
+				throw InvalidArchiveError{
+					"symbol " + symbol.name + " in " + archive.path +
+					" does not refer to a member"
+				};
+			}
+			symbols.push_back(Symbol{symbol.name, it->second});
+		}
+		firstMember += table.size();
+	}
+	return symbols;
+}
+
+///
+/// Places the members after the given offset and returns the size of the
+/// merged archive.
+///
+std::uint64_t placeMembers(const std::vector<SourceArchive>& archives,
+		std::vector<PlannedMember>& members, std::uint64_t offset) {
+	for (auto& member : members) {
+		member.headerOffset = offset;
+		offset += MemberHeaderSize + paddedSize(
+			archives[member.archiveIndex].members.getSize(member.memberIndex));
+	}
+	return offset;
+}
+
+} // anonymous namespace
+
+///
+/// Merges the given archives into a single archive in @a outputPath.
+///
+/// See the description of the overload accepting options for more details.
+///
+MergeReport mergeArchives(const std::vector<std::string>& archivePaths,
+		const std::string& outputPath) {
+	return mergeArchives(archivePaths, outputPath, MergeOptions());
+}
+
+///
+/// Merges the given archives into a single archive in @a outputPath.
+///
+/// The merged archive contains the members of all the archives, in the order
+/// of the archives and of the members in them (members of the same name are
+/// all kept, like by <tt>ar q</tt>). Its filename table and symbol table are
+/// built from the headers and the symbol tables of the archives, so the
+/// archives are planned without reading the content of their members. The
+/// content is then copied from the archives into the merged archive by
+/// @c copy_file_range on Linux, so it does not pass through memory.
+///
+/// Only GNU archives (and archives without long names) are supported.
+///
+/// @throws IOError When an archive cannot be read or the merged archive cannot
+///                 be written.
+/// @throws InvalidArchiveError When an archive is invalid.
+/// @throws Error When the merged archive is also one of the merged archives.
+///
+MergeReport mergeArchives(const std::vector<std::string>& archivePaths,
+		const std::string& outputPath, const MergeOptions& options) {
+	std::vector<SourceArchive> archives;
+	archives.reserve(archivePaths.size());
+	for (const auto& path : archivePaths) {
+		if (path == outputPath) {
+			throw Error{"cannot merge archive " + path + " into itself"};
+		}
+		archives.push_back(readSourceArchive(path, options));
+	}
+
+	std::vector<PlannedMember> members;
+	const auto nameTable = planNames(archives, members);
+	std::uint64_t namesSize = 0;
+	std::size_t symbolCount = 0;
+	for (const auto& archive : archives) {
+		for (const auto& symbol : archive.symbols) {
+			namesSize += symbol.name.size() + 1;
+		}
+		symbolCount += archive.symbols.size();
+	}
+
+	// The layout is: the magic string, the symbol table, the filename table,
+	// and the members. A 64-bit symbol table is needed only when a member
+	// starts after 4 GB.
+	bool is64Bit = false;
+	auto layOut = [&]() {
+		auto offset = static_cast<std::uint64_t>(ArchiveMagicString.size());
+		if (symbolCount > 0) {
+			offset += symbolTableSize(symbolCount, namesSize, is64Bit);
+		}
+		if (!nameTable.empty()) {
+			offset += MemberHeaderSize + paddedSize(nameTable.size());
+		}
+		return placeMembers(archives, members, offset);
+	};
+	auto archiveSize = layOut();
+	if (!members.empty() && members.back().headerOffset > 0xffffffff) {
+		is64Bit = true;
+		archiveSize = layOut();
+	}
+
+	// Write everything except the content of the members, which is then
+	// copied into the gaps between the headers.
+	std::ofstream output{outputPath, std::ios::binary};
+	if (!output) {
+		throw IOError{"cannot open file \"" + outputPath + "\""};
+	}
+	output << ArchiveMagicString;
+	if (symbolCount > 0) {
+		const auto symbolTable = formatSymbolTable(
+			planSymbols(archives, members), is64Bit);
+		output << formatSymbolTableHeader(symbolTable.size(), is64Bit)
+			<< symbolTable;
+		if (symbolTable.size() % 2 != 0) {
+			output << '\n';
+		}
+	}
+	if (!nameTable.empty()) {
+		output << formatNameTableHeader(nameTable.size()) << nameTable;
+		if (nameTable.size() % 2 != 0) {
+			output << '\n';
+		}
+	}
+	MergeReport report;
+	for (const auto& member : members) {
+		const auto& table = archives[member.archiveIndex].members;
+		const auto i = member.memberIndex;
+		const auto size = table.getSize(i);
+		output.seekp(member.headerOffset);
+		output << formatMemberHeader(member.nameField, table.getTimestamp(i),
+			table.getOwnerId(i), table.getGroupId(i), table.getMode(i), size);
+		if (size % 2 != 0) {
+			output.seekp(member.headerOffset + MemberHeaderSize + size);
+			output << '\n';
+		}
+		report.contentSize += size;
+	}
+	output.close();
+	if (!output) {
+		throw IOError{"cannot write file \"" + outputPath + "\""};
+	}
+
+	auto member = members.begin();
+	for (const auto& archive : archives) {
+		std::vector<FileRangeCopy> ranges;
+		ranges.reserve(archive.members.size());
+		for (MemberTable::size_type j = 0; j < archive.members.size();
+				++j, ++member) {
+			ranges.push_back(FileRangeCopy{archive.members.getOffset(j),
+				member->headerOffset + MemberHeaderSize,
+				archive.members.getSize(j)});
+		}
+		copyFileRanges(archive.path, outputPath, ranges);
+	}
+
+	report.memberCount = members.size();
+	report.symbolCount = symbolCount;
+	report.archiveSize = archiveSize;
+	return report;
+}
+
+} // namespace ar
@@ -0,0 +1,54 @@
+///
+/// @file      ar/tracing.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the tracing of operations of the library.
+///
+
+#include "ar/internal/utilities/tracing.h"
+#include "ar/tracing.h"
+
+using namespace ar::internal;
+
+namespace ar {
+
+///
+/// Starts writing a trace of the operations of the library into the given
+/// file.
+///
+/// The trace is in the Chrome trace-event format (JSON), so it can be opened
+/// in Perfetto (https://ui.perfetto.dev) or in @c chrome://tracing. It
+/// contains spans of extractions and their phases, of reading of every
+/// member, and of writing of every file (including File::saveCopyTo()), in
+/// the threads that performed them. The trace is complete once stopTracing()
+/// is called. A trace that is already being written is finished first.
+///
+/// Tracing can also be enabled without changing the program: when the
+/// @c AR_TRACE environment variable is set, the trace is written into the
+/// file it names from the start of the program until its end.
+///
+/// When no trace is being written, the traced operations only check a flag.
+///
+/// @throws IOError When the file cannot be opened.
+///
+void startTracing(const std::string& tracePath) {
+	openTrace(tracePath);
+}
+
+///
+/// Finishes the trace that is being written (if any).
+///
+/// Operations that are still running are not included in the trace.
+///
+void stopTracing() {
+	closeTrace();
+}
+
+///
+/// Is a trace being written?
+///
+bool isTracing() noexcept {
+	return tracingEnabled;
+}
+
+} // namespace ar
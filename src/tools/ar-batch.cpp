@@ -0,0 +1,124 @@
+///
+/// @file      tools/ar-batch.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     A sample application that uses the library to process many
+///            archives at once.
+///
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ar/ar.h"
+
+using namespace ar;
+
+namespace {
+
+void printUsage(const char* program) {
+	std::cerr << "usage: " << program << " [OPTIONS] ARCHIVE|@LISTFILE...\n"
+		<< "\n"
+		<< "Processes all the given archives and prints a summary. @LISTFILE\n"
+		<< "stands for the archives listed in LISTFILE, one per line.\n"
+		<< "\n"
+		<< "options:\n"
+		<< "  -j N    use N threads (0 = all cores, default)\n"
+		<< "  --list  print the files of the archives\n";
+}
+
+bool parseNumber(const char* arg, std::size_t& number) {
+	char* end = nullptr;
+	number = std::strtoull(arg, &end, 10);
+	return *arg != '\0' && *end == '\0';
+}
+
+bool readListFile(const std::string& path, std::vector<std::string>& paths) {
+	std::ifstream file{path};
+	if (!file) {
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line)) {
+		if (!line.empty()) {
+			paths.push_back(line);
+		}
+	}
+	return true;
+}
+
+void printSummary(const BatchReport& report) {
+	const auto seconds = report.elapsedSeconds > 0.0
+		? report.elapsedSeconds
+		: 1e-9;
+	std::cout << "archives:   " << report.archives.size()
+			<< " (" << report.failedArchiveCount << " failed)\n"
+		<< "files:      " << report.fileCount << "\n"
+		<< "bytes:      " << report.contentSize << "\n"
+		<< "time:       " << report.elapsedSeconds << " s\n"
+		<< "throughput: "
+			<< report.archives.size() / seconds << " archives/s, "
+			<< report.fileCount / seconds << " files/s, "
+			<< report.contentSize / seconds / (1024 * 1024) << " MiB/s\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+	BatchOptions options;
+	bool listFiles = false;
+	std::vector<std::string> archivePaths;
+	for (int j = 1; j < argc; ++j) {
+		const std::string arg{argv[j]};
+		if (arg == "-j" && j + 1 < argc) {
+			if (!parseNumber(argv[++j], options.threadCount)) {
+				printUsage(argv[0]);
+				return 1;
+			}
+		} else if (arg == "--list") {
+			listFiles = true;
+		} else if (arg[0] == '@' && arg.size() > 1) {
+			if (!readListFile(arg.substr(1), archivePaths)) {
+				std::cerr << "error: cannot read \"" << arg.substr(1) << "\"\n";
+				return 1;
+			}
+		} else if (!arg.empty() && arg[0] != '-') {
+			archivePaths.push_back(arg);
+		} else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (archivePaths.empty()) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	std::mutex outputMutex;
+	BatchFileHandler handler;
+	if (listFiles) {
+		handler = [&outputMutex](const std::string& archivePath, File& file) {
+			std::lock_guard<std::mutex> lock{outputMutex};
+			std::cout << archivePath << ": " << file.getNameView() << "\n";
+		};
+	}
+
+	try {
+		auto report = processArchives(archivePaths, handler, options);
+		for (auto& result : report.archives) {
+			if (!result.error.empty()) {
+				std::cerr << "error: " << result.path << ": " << result.error
+					<< "\n";
+			}
+		}
+		printSummary(report);
+		return report.failedArchiveCount == 0 ? 0 : 1;
+	} catch (const Error& ex) {
+		std::cerr << "error: " << ex.what() << "\n";
+		return 1;
+	}
+}
@@ -0,0 +1,146 @@
+///
+/// @file      tools/ar-dedup.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     A sample application that uses the library to find identical
+///            members of archives and to extract archives without duplicates.
+///
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ar/ar.h"
+
+using namespace ar;
+
+namespace {
+
+void printUsage(const char* program) {
+	std::cerr << "usage: " << program << " [OPTIONS] ARCHIVE|@LISTFILE...\n"
+		<< "\n"
+		<< "Lists members with identical content in the given archives.\n"
+		<< "@LISTFILE stands for the archives listed in LISTFILE, one per\n"
+		<< "line.\n"
+		<< "\n"
+		<< "options:\n"
+		<< "  -j N           use N threads (0 = all cores, default)\n"
+		<< "  --extract DIR  extract every archive into DIR/ARCHIVE-NAME,\n"
+		<< "                 writing identical files only once and cloning\n"
+		<< "                 them (reflinks) for the other copies\n"
+		<< "  --hardlink     with --extract, create hard links instead of\n"
+		<< "                 clones\n";
+}
+
+bool parseNumber(const char* arg, std::size_t& number) {
+	char* end = nullptr;
+	number = std::strtoull(arg, &end, 10);
+	return *arg != '\0' && *end == '\0';
+}
+
+bool readListFile(const std::string& path, std::vector<std::string>& paths) {
+	std::ifstream file{path};
+	if (!file) {
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line)) {
+		if (!line.empty()) {
+			paths.push_back(line);
+		}
+	}
+	return true;
+}
+
+void printErrors(const std::vector<BatchArchiveResult>& archives) {
+	for (auto& result : archives) {
+		if (!result.error.empty()) {
+			std::cerr << "error: " << result.path << ": " << result.error
+				<< "\n";
+		}
+	}
+}
+
+void printReport(const DeduplicationReport& report) {
+	for (auto& group : report.duplicateGroups) {
+		char checksum[9];
+		std::snprintf(checksum, sizeof(checksum), "%08x", group.checksum);
+		std::cout << group.members.size() << " copies of " << group.size
+			<< " bytes (" << checksum << "):\n";
+		for (auto& member : group.members) {
+			std::cout << "  " << report.archives[member.archiveIndex].path
+				<< ": " << member.name << "\n";
+		}
+	}
+	std::cout << "members:         " << report.memberCount
+			<< " (" << report.uniqueMemberCount << " unique)\n"
+		<< "bytes:           " << report.contentSize
+			<< " (" << report.uniqueContentSize << " unique)\n"
+		<< "duplicate bytes: "
+			<< report.contentSize - report.uniqueContentSize << "\n";
+}
+
+void printReport(const DeduplicatedExtractionReport& report) {
+	std::cout << "written files:     " << report.writtenFileCount
+			<< " (" << report.writtenSize << " bytes)\n"
+		<< "reflinked files:   " << report.reflinkedFileCount << "\n"
+		<< "hard-linked files: " << report.hardLinkedFileCount << "\n"
+		<< "saved bytes:       " << report.savedSize << "\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+	DeduplicationOptions options;
+	std::string extractionPath;
+	std::vector<std::string> archivePaths;
+	for (int j = 1; j < argc; ++j) {
+		const std::string arg{argv[j]};
+		if (arg == "-j" && j + 1 < argc) {
+			if (!parseNumber(argv[++j], options.threadCount)) {
+				printUsage(argv[0]);
+				return 1;
+			}
+		} else if (arg == "--extract" && j + 1 < argc) {
+			extractionPath = argv[++j];
+		} else if (arg == "--hardlink") {
+			options.linking = DuplicateLinking::HardLink;
+		} else if (arg[0] == '@' && arg.size() > 1) {
+			if (!readListFile(arg.substr(1), archivePaths)) {
+				std::cerr << "error: cannot read \"" << arg.substr(1) << "\"\n";
+				return 1;
+			}
+		} else if (!arg.empty() && arg[0] != '-') {
+			archivePaths.push_back(arg);
+		} else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (archivePaths.empty()) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	try {
+		if (!extractionPath.empty()) {
+			auto report = extractDeduplicated(archivePaths, extractionPath,
+				options);
+			printErrors(report.archives);
+			printReport(report);
+			return report.failedArchiveCount == 0 ? 0 : 1;
+		}
+
+		auto report = findDuplicateMembers(archivePaths, options);
+		printErrors(report.archives);
+		printReport(report);
+		return report.failedArchiveCount == 0 ? 0 : 1;
+	} catch (const Error& ex) {
+		std::cerr << "error: " << ex.what() << "\n";
+		return 1;
+	}
+}
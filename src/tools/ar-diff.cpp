@@ -0,0 +1,92 @@
+///
+/// @file      tools/ar-diff.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     A sample application that uses the library to compare two
+///            archives.
+///
+
+#include <iostream>
+#include <string>
+
+#include "ar/ar.h"
+
+using namespace ar;
+
+namespace {
+
+void printUsage(const char* program) {
+	std::cerr << "usage: " << program << " [OPTIONS] OLD NEW\n"
+		<< "\n"
+		<< "Compares the archives OLD and NEW and prints their added (+),\n"
+		<< "removed (-), and modified (M) members. Only the content of\n"
+		<< "members of the same name and size is compared. Exits with 0 when\n"
+		<< "the archives are the same, 1 when they differ, and 2 on errors.\n"
+		<< "\n"
+		<< "options:\n"
+		<< "  -q       print nothing, only set the exit status\n"
+		<< "  --stats  print also how much content had to be compared\n";
+}
+
+char changeMark(MemberChange change) {
+	switch (change) {
+		case MemberChange::Added:
+			return '+';
+		case MemberChange::Removed:
+			return '-';
+		case MemberChange::Modified:
+			return 'M';
+	}
+	return '?';
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+	bool quiet = false;
+	bool stats = false;
+	std::string paths[2];
+	int pathCount = 0;
+	for (int j = 1; j < argc; ++j) {
+		const std::string arg{argv[j]};
+		if (arg == "-q") {
+			quiet = true;
+		} else if (arg == "--stats") {
+			stats = true;
+		} else if (!arg.empty() && arg[0] != '-' && pathCount < 2) {
+			paths[pathCount++] = arg;
+		} else {
+			printUsage(argv[0]);
+			return 2;
+		}
+	}
+	if (pathCount != 2) {
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	try {
+		const auto result = diff(paths[0], paths[1]);
+		if (!quiet) {
+			for (const auto& difference : result.differences) {
+				std::cout << changeMark(difference.change) << " "
+					<< difference.name;
+				if (difference.change == MemberChange::Modified &&
+						difference.oldSize != difference.newSize) {
+					std::cout << " (" << difference.oldSize << " -> "
+						<< difference.newSize << " bytes)";
+				}
+				std::cout << "\n";
+			}
+			if (stats) {
+				std::cout << "unchanged: " << result.unchangedCount << "\n"
+					<< "compared:  " << result.comparedCount << " members ("
+					<< result.comparedSize << " bytes)\n";
+			}
+		}
+		return result.empty() ? 0 : 1;
+	} catch (const Error& ex) {
+		std::cerr << "error: " << ex.what() << "\n";
+		return 2;
+	}
+}
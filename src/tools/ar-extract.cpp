@@ -5,23 +5,116 @@
 /// @brief     A sample application that uses the library to extract archives.
 ///
 
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
 #include "ar/ar.h"
 
 using namespace ar;
 
+namespace {
+
+void printUsage(const char* program) {
+	std::cerr << "usage: " << program << " [OPTIONS] ARCHIVE\n"
+		<< "\n"
+		<< "Archives ending with .gz or .zst are decompressed while they are\n"
+		<< "extracted.\n"
+		<< "\n"
+		<< "options:\n"
+		<< "  -j N            use N threads (0 = all cores)\n"
+		<< "  --pipeline      overlap parsing of the archive with writing\n"
+		<< "  --queue-size N  size of the queue of the pipeline\n"
+		<< "  --report-queue  print the high-water mark of the queue\n"
+		<< "  --batched       write the files in batches (io_uring if available)\n"
+		<< "  --memory-budget N\n"
+		<< "                  hold at most N bytes of the files in memory\n"
+		<< "  --incremental   write only files that are not up to date\n"
+		<< "  --compare-content\n"
+		<< "                  with --incremental, compare also the content\n";
+}
+
+bool endsWith(const std::string& str, const std::string& suffix) {
+	return str.size() >= suffix.size() &&
+		str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool isCompressed(const std::string& archivePath) {
+	return endsWith(archivePath, ".gz") || endsWith(archivePath, ".zst");
+}
+
+bool parseNumber(const char* arg, std::size_t& number) {
+	char* end = nullptr;
+	number = std::strtoull(arg, &end, 10);
+	return *arg != '\0' && *end == '\0';
+}
+
+} // anonymous namespace
+
 int main(int argc, char** argv) {
-	if (argc != 2) {
-		std::cerr << "usage: " << argv[0] << " ARCHIVE\n";
+	ExtractionOptions options;
+	bool reportQueue = false;
+	std::string archivePath;
+	for (int j = 1; j < argc; ++j) {
+		const std::string arg{argv[j]};
+		if (arg == "-j" && j + 1 < argc) {
+			if (!parseNumber(argv[++j], options.threadCount)) {
+				printUsage(argv[0]);
+				return 1;
+			}
+		} else if (arg == "--pipeline") {
+			options.pipelined = true;
+		} else if (arg == "--queue-size" && j + 1 < argc) {
+			if (!parseNumber(argv[++j], options.queueCapacity)) {
+				printUsage(argv[0]);
+				return 1;
+			}
+		} else if (arg == "--report-queue") {
+			reportQueue = true;
+		} else if (arg == "--batched") {
+			options.batchedWrites = true;
+		} else if (arg == "--memory-budget" && j + 1 < argc) {
+			if (!parseNumber(argv[++j], options.memoryBudget)) {
+				printUsage(argv[0]);
+				return 1;
+			}
+		} else if (arg == "--incremental") {
+			options.incremental = true;
+		} else if (arg == "--compare-content") {
+			options.compareContent = true;
+		} else if (archivePath.empty() && arg[0] != '-') {
+			archivePath = arg;
+		} else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (archivePath.empty()) {
+		printUsage(argv[0]);
 		return 1;
 	}
 
 	try {
-		auto files = extract(File::fromFilesystem(argv[1]));
-		for (auto& file : files) {
-			std::cout << file->getName() << "\n";
-			file->saveCopyTo(".");
+		auto report = isCompressed(archivePath)
+			? extractToDirectory(ByteSource::fromCompressedFile(archivePath),
+				".", options)
+			: extractToDirectory(File::fromFilesystem(archivePath),
+				".", options);
+		for (auto& fileName : report.fileNames) {
+			std::cout << fileName << "\n";
+		}
+		if (options.incremental) {
+			std::cerr << "unchanged files: " << report.unchangedFileCount
+				<< "/" << report.fileNames.size() << "\n";
+		}
+		if (reportQueue) {
+			std::cerr << "queue high-water mark: "
+				<< report.queueHighWaterMark << "/"
+				<< report.queueCapacity << "\n";
+			if (options.batchedWrites) {
+				std::cerr << "io_uring used: "
+					<< (report.ioUringUsed ? "yes" : "no") << "\n";
+			}
 		}
 		return 0;
 	} catch (const Error& ex) {
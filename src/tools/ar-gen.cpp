@@ -0,0 +1,99 @@
+///
+/// @file      tools/ar-gen.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     A sample application that uses the library to generate
+///            synthetic archives for stress and scale testing.
+///
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "ar/ar.h"
+
+using namespace ar;
+
+namespace {
+
+void printUsage(const char* program) {
+	std::cerr << "usage: " << program << " [OPTIONS] -o OUTPUT\n"
+		<< "\n"
+		<< "Generates a synthetic archive into OUTPUT. The same options (and\n"
+		<< "seed) always generate the same archive. The archive is written\n"
+		<< "as it is generated, so it is not held in memory.\n"
+		<< "\n"
+		<< "options:\n"
+		<< "  -o OUTPUT           write the archive into OUTPUT\n"
+		<< "  --seed N            seed of the generator (default: 0)\n"
+		<< "  --members N         number of members (default: 100)\n"
+		<< "  --min-size N        smallest size of a member (default: 0)\n"
+		<< "  --max-size N        largest size of a member (default: 4096)\n"
+		<< "  --long-names N      number of members with names stored in\n"
+		<< "                      the filename table (default: 0)\n"
+		<< "  --long-name-size N  size of the long names (default: 100)\n"
+		<< "  --symbols N         number of symbols (default: 0)\n"
+		<< "  --sym64             store the symbol table as /SYM64/\n";
+}
+
+template <typename Number>
+bool parseNumber(const char* arg, Number& number) {
+	char* end = nullptr;
+	const auto value = std::strtoull(arg, &end, 10);
+	number = static_cast<Number>(value);
+	return *arg != '\0' && *end == '\0' && number == value;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+	GenerationOptions options;
+	std::string outputPath;
+	for (int j = 1; j < argc; ++j) {
+		const std::string arg{argv[j]};
+		bool valid = true;
+		if (arg == "-o" && j + 1 < argc) {
+			outputPath = argv[++j];
+		} else if (arg == "--seed" && j + 1 < argc) {
+			valid = parseNumber(argv[++j], options.seed);
+		} else if (arg == "--members" && j + 1 < argc) {
+			valid = parseNumber(argv[++j], options.memberCount);
+		} else if (arg == "--min-size" && j + 1 < argc) {
+			valid = parseNumber(argv[++j], options.minMemberSize);
+		} else if (arg == "--max-size" && j + 1 < argc) {
+			valid = parseNumber(argv[++j], options.maxMemberSize);
+		} else if (arg == "--long-names" && j + 1 < argc) {
+			valid = parseNumber(argv[++j], options.longNameCount);
+		} else if (arg == "--long-name-size" && j + 1 < argc) {
+			valid = parseNumber(argv[++j], options.longNameSize);
+		} else if (arg == "--symbols" && j + 1 < argc) {
+			valid = parseNumber(argv[++j], options.symbolCount);
+		} else if (arg == "--sym64") {
+			options.sym64 = true;
+		} else {
+			valid = false;
+		}
+		if (!valid) {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (outputPath.empty()) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	try {
+		auto report = generateArchive(outputPath, options);
+		std::cout << "members:  " << report.memberCount << "\n"
+			<< "symbols:  " << report.symbolCount
+				<< (report.sym64 ? " (/SYM64/)" : "") << "\n"
+			<< "content:  " << report.contentSize << " bytes\n"
+			<< "size:     " << report.archiveSize << " bytes\n";
+		return 0;
+	} catch (const Error& ex) {
+		std::cerr << "error: " << ex.what() << "\n";
+		return 1;
+	}
+}
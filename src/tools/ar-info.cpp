@@ -6,22 +6,287 @@
 ///            of archives.
 ///
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
+#include <new>
+#include <string>
 
 #include "ar/ar.h"
 
 using namespace ar;
 
+namespace {
+
+/// Counter of the memory allocated by the program (see operator new below).
+MemoryCounter heapCounter;
+
+/// Is the memory allocated by the program being counted (see --mem)?
+bool countHeap = false;
+
+///
+/// Information stored in front of every block allocated by operator new.
+///
+struct alignas(alignof(std::max_align_t)) BlockHeader {
+	/// Start of the memory allocated by malloc() (before the header when the
+	/// block is over-aligned).
+	void* start;
+
+	/// Number of bytes requested for the block.
+	std::size_t size;
+
+	/// Has the allocation of the block been counted?
+	bool counted;
+};
+
+///
+/// Allocates the given number of bytes aligned to @a alignment, counting
+/// them when the memory allocated by the program is being counted.
+///
+/// All the memory allocated by operator new (e.g. by strings, vectors, and
+/// files) is counted, not only the memory allocated through memory resources.
+/// The size of the block is stored in front of it, so the same size is
+/// counted when the block is freed, and only blocks whose allocation has been
+/// counted are counted when they are freed.
+///
+void* allocate(std::size_t size, std::size_t alignment) {
+	alignment = std::max(alignment, alignof(BlockHeader));
+	const auto padding = alignment > alignof(BlockHeader) ? alignment : 0;
+	auto start = std::malloc(sizeof(BlockHeader) + padding + size);
+	if (!start) {
+		throw std::bad_alloc();
+	}
+
+	const auto address = reinterpret_cast<std::uintptr_t>(start) +
+		sizeof(BlockHeader);
+	const auto block = reinterpret_cast<void*>(
+		(address + alignment - 1) / alignment * alignment);
+	const bool counted = countHeap;
+	new (static_cast<BlockHeader*>(block) - 1) BlockHeader{
+		start, size, counted
+	};
+	if (counted) {
+		heapCounter.recordAllocation(size);
+	}
+	return block;
+}
+
+void* allocateNoThrow(std::size_t size, std::size_t alignment) noexcept {
+	try {
+		return allocate(size, alignment);
+	} catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+void deallocate(void* p) noexcept {
+	if (!p) {
+		return;
+	}
+
+	const auto header = static_cast<BlockHeader*>(p) - 1;
+	if (header->counted) {
+		heapCounter.recordDeallocation(header->size);
+	}
+	std::free(header->start);
+}
+
+void printUsage(const char* program) {
+	std::cerr << "usage: " << program << " [OPTIONS] ARCHIVE\n"
+		<< "\n"
+		<< "options:\n"
+		<< "  --hash   print also the CRC-32C checksums of the files\n"
+		<< "  --stats  extract the files in memory and print statistics about\n"
+		<< "           the extraction in JSON (instead of the names)\n"
+		<< "  --mem    like --stats, but print also the memory allocated by\n"
+		<< "           the extraction (overall and in every phase)\n";
+}
+
+void printMemoryUsage(const char* name, const MemoryUsage& usage,
+		const char* indent, const char* separator) {
+	std::cout << indent << "\"" << name << "\": {"
+		<< "\"allocations\": " << usage.allocations << ", "
+		<< "\"allocated_bytes\": " << usage.allocatedBytes << ", "
+		<< "\"held_bytes\": " << usage.heldBytes << ", "
+		<< "\"peak_held_bytes\": " << usage.peakHeldBytes << "}"
+		<< separator << "\n";
+}
+
+void printStats(const ExtractionStats& stats, std::size_t fileCount,
+		const MemoryUsage* memory) {
+	std::cout << "{\n"
+		<< "  \"collected\": " << (stats.collected ? "true" : "false") << ",\n"
+		<< "  \"files\": " << fileCount << ",\n"
+		<< "  \"bytes_read\": " << stats.bytesRead << ",\n"
+		<< "  \"headers_parsed\": " << stats.headersParsed << ",\n"
+		<< "  \"name_table_hits\": " << stats.nameTableHits << ",\n"
+		<< "  \"allocations\": " << stats.allocations << ",\n"
+		<< "  \"bytes_copied\": " << stats.bytesCopied << ",\n"
+		<< "  \"phases_ns\": {\n"
+		<< "    \"read\": " << stats.readTime.count() << ",\n"
+		<< "    \"scan\": " << stats.scanTime.count() << ",\n"
+		<< "    \"expand\": " << stats.expandTime.count() << ",\n"
+		<< "    \"materialize\": " << stats.materializeTime.count() << "\n"
+		<< "  }" << (memory ? "," : "") << "\n";
+	if (memory) {
+		std::cout << "  \"memory\": {\n";
+		printMemoryUsage("total", *memory, "    ", ",");
+		std::cout << "    \"phases\": {\n";
+		printMemoryUsage("read", stats.readMemory, "      ", ",");
+		printMemoryUsage("scan", stats.scanMemory, "      ", ",");
+		printMemoryUsage("expand", stats.expandMemory, "      ", ",");
+		printMemoryUsage("materialize", stats.materializeMemory, "      ", "");
+		std::cout << "    }\n"
+			<< "  }\n";
+	}
+	std::cout << "}\n";
+}
+
+} // anonymous namespace
+
+// All the replaceable forms of the global operator new and delete are
+// replaced, so no block allocated by one of them is freed by a default form
+// (e.g. the aligned forms used by std::pmr::new_delete_resource()).
+void* operator new(std::size_t size) {
+	return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+	return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return allocateNoThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return allocateNoThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+		const std::nothrow_t&) noexcept {
+	return allocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+		const std::nothrow_t&) noexcept {
+	return allocateNoThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept {
+	deallocate(p);
+}
+
+void operator delete[](void* p) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+	deallocate(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+	deallocate(p);
+}
+
+void operator delete(void* p, std::align_val_t,
+		const std::nothrow_t&) noexcept {
+	deallocate(p);
+}
+
+void operator delete[](void* p, std::align_val_t,
+		const std::nothrow_t&) noexcept {
+	deallocate(p);
+}
+
 int main(int argc, char** argv) {
-	if (argc != 2) {
-		std::cerr << "usage: " << argv[0] << " ARCHIVE\n";
+	bool printChecksums = false;
+	bool printStatistics = false;
+	bool printMemory = false;
+	std::string archivePath;
+	for (int j = 1; j < argc; ++j) {
+		const std::string arg{argv[j]};
+		if (arg == "--hash") {
+			printChecksums = true;
+		} else if (arg == "--stats") {
+			printStatistics = true;
+		} else if (arg == "--mem") {
+			printStatistics = true;
+			printMemory = true;
+		} else if (archivePath.empty() && !arg.empty() && arg[0] != '-') {
+			archivePath = arg;
+		} else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (archivePath.empty()) {
+		printUsage(argv[0]);
 		return 1;
 	}
 
 	try {
-		auto files = extract(File::fromFilesystem(argv[1]));
-		for (auto& file : files) {
-			std::cout << file->getName() << "\n";
+		if (printStatistics) {
+			if (printMemory) {
+				countHeap = true;
+				setMemoryCounter(&heapCounter);
+			}
+			ExtractionStats stats;
+			ExtractionOptions options;
+			options.stats = &stats;
+			auto files = extract(File::fromFilesystem(archivePath), options);
+			// The usage is taken while the extracted files are still held.
+			const auto memory = heapCounter.getUsage();
+			printStats(stats, files.size(), printMemory ? &memory : nullptr);
+			return 0;
+		}
+
+		// Only the headers are read (and the content of the files when their
+		// checksums are computed, in the same pass).
+		ExtractionOptions options;
+		options.computeChecksums = printChecksums;
+		auto table = scanMembers(File::fromFilesystem(archivePath), options);
+		for (std::size_t j = 0; j < table.size(); ++j) {
+			if (printChecksums) {
+				std::cout << std::hex << std::setw(8) << std::setfill('0')
+					<< table.getChecksum(j) << std::dec << "  ";
+			}
+			std::cout << table.getName(j) << "\n";
 		}
 		return 0;
 	} catch (const Error& ex) {
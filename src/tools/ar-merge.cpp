@@ -0,0 +1,91 @@
+///
+/// @file      tools/ar-merge.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     A sample application that uses the library to merge archives
+///            into a single archive.
+///
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ar/ar.h"
+
+using namespace ar;
+
+namespace {
+
+void printUsage(const char* program) {
+	std::cerr << "usage: " << program
+			<< " [OPTIONS] -o OUTPUT ARCHIVE|@LISTFILE...\n"
+		<< "\n"
+		<< "Merges the given archives into OUTPUT, keeping all their members\n"
+		<< "and combining their filename and symbol tables. The content of\n"
+		<< "the members is copied by the kernel (copy_file_range on Linux).\n"
+		<< "@LISTFILE stands for the archives listed in LISTFILE, one per\n"
+		<< "line.\n"
+		<< "\n"
+		<< "options:\n"
+		<< "  -o OUTPUT     write the merged archive into OUTPUT\n"
+		<< "  --no-symbols  do not store a symbol table in OUTPUT\n";
+}
+
+bool readListFile(const std::string& path, std::vector<std::string>& paths) {
+	std::ifstream file{path};
+	if (!file) {
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(file, line)) {
+		if (!line.empty()) {
+			paths.push_back(line);
+		}
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+	MergeOptions options;
+	std::string outputPath;
+	std::vector<std::string> archivePaths;
+	for (int j = 1; j < argc; ++j) {
+		const std::string arg{argv[j]};
+		if (arg == "-o" && j + 1 < argc) {
+			outputPath = argv[++j];
+		} else if (arg == "--no-symbols") {
+			options.symbolTable = false;
+		} else if (arg[0] == '@' && arg.size() > 1) {
+			if (!readListFile(arg.substr(1), archivePaths)) {
+				std::cerr << "error: cannot read \"" << arg.substr(1) << "\"\n";
+				return 1;
+			}
+		} else if (!arg.empty() && arg[0] != '-') {
+			archivePaths.push_back(arg);
+		} else {
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+	if (outputPath.empty() || archivePaths.empty()) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	try {
+		auto report = mergeArchives(archivePaths, outputPath, options);
+		std::cout << "archives: " << archivePaths.size() << "\n"
+			<< "members:  " << report.memberCount << "\n"
+			<< "symbols:  " << report.symbolCount << "\n"
+			<< "content:  " << report.contentSize << " bytes\n"
+			<< "size:     " << report.archiveSize << " bytes\n";
+		return 0;
+	} catch (const Error& ex) {
+		std::cerr << "error: " << ex.what() << "\n";
+		return 1;
+	}
+}
@@ -0,0 +1,338 @@
+///
+/// @file      ar/archive_editor_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c archive_editor module.
+///
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/archive_editor.h"
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/member_table.h"
+#include "ar/test_utilities/built_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::internal;
+
+namespace ar {
+namespace tests {
+
+///
+/// Tests for ArchiveEditor.
+///
+class ArchiveEditorTests: public testing::Test {};
+
+TEST_F(ArchiveEditorTests,
+CreateCreatesEmptyArchive) {
+	auto tmpFile = TmpFile::createWithContent("not an archive");
+
+	auto editor = ArchiveEditor::create(tmpFile->getPath());
+
+	ASSERT_TRUE(editor.getMemberNames().empty());
+	ASSERT_EQ("!<arch>\n", readFile(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+ConstructorReadsNamesOfMembers) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "aaa"}, {"b.o", "bb"}
+	}));
+
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	ASSERT_EQ(std::vector<std::string>({"a.o", "b.o"}),
+		editor.getMemberNames());
+	ASSERT_TRUE(editor.hasMember("b.o"));
+	ASSERT_FALSE(editor.hasMember("c.o"));
+}
+
+TEST_F(ArchiveEditorTests,
+ConstructorThrowsInvalidArchiveErrorWhenFileIsNotArchive) {
+	auto tmpFile = TmpFile::createWithContent("not an archive");
+
+	ASSERT_THROW(ArchiveEditor{tmpFile->getPath()}, InvalidArchiveError);
+}
+
+TEST_F(ArchiveEditorTests,
+ConstructorThrowsIOErrorWhenFileDoesNotExist) {
+	ASSERT_THROW(ArchiveEditor{"ar-cpp-nonexisting-archive.a"}, IOError);
+}
+
+TEST_F(ArchiveEditorTests,
+AppendWritesMemberAfterEndOfArchiveWithoutChangingRest) {
+	const auto original = archiveWithMembers({{"a.o", "aaa"}});
+	auto tmpFile = TmpFile::createWithContent(original);
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.append("b.o", "bbb");
+
+	const auto archive = readFile(tmpFile->getPath());
+	ASSERT_EQ(original, archive.substr(0, original.size()));
+	ASSERT_EQ(archiveWithMembers({{"a.o", "aaa"}, {"b.o", "bbb"}}), archive);
+	ASSERT_EQ(archive.size(), editor.getArchiveSize());
+}
+
+TEST_F(ArchiveEditorTests,
+AppendStoresGivenAttributes) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	ArchiveEditor editor{tmpFile->getPath()};
+	MemberAttributes attributes;
+	attributes.timestamp = 1500000000;
+	attributes.ownerId = 1000;
+	attributes.groupId = 100;
+	attributes.mode = 0755;
+
+	editor.append("a.o", "aaa", attributes);
+
+	auto table = scanMembers(File::fromFilesystem(tmpFile->getPath()));
+	ASSERT_EQ(1, table.size());
+	ASSERT_EQ(1500000000, table.getTimestamp(0));
+	ASSERT_EQ(1000, table.getOwnerId(0));
+	ASSERT_EQ(100, table.getGroupId(0));
+	ASSERT_EQ(0755, table.getMode(0));
+}
+
+TEST_F(ArchiveEditorTests,
+AppendAddsMissingPaddingOfLastMember) {
+	auto original = archiveWithMembers({{"a.o", "aaa"}});
+	original.pop_back();
+	auto tmpFile = TmpFile::createWithContent(original);
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.append("b.o", "b");
+
+	ASSERT_EQ(Members({{"a.o", "aaa"}, {"b.o", "b"}}),
+		membersOf(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+AppendStoresLongNameInNewFilenameTable) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "aaa"}
+	}));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.append("very-long-name-of-member.o", "content");
+
+	ASSERT_EQ(Members({
+			{"a.o", "aaa"}, {"very-long-name-of-member.o", "content"}
+		}),
+		membersOf(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+AppendReusesLongNameStoredInFilenameTable) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	ArchiveEditor editor{tmpFile->getPath()};
+	editor.append("very-long-name-of-member.o", "first");
+	const auto sizeBeforeAppend = editor.getArchiveSize();
+
+	editor.append("very-long-name-of-member.o", "second");
+
+	ASSERT_EQ(sizeBeforeAppend + 60 + 6, editor.getArchiveSize());
+	ASSERT_EQ(Members({
+			{"very-long-name-of-member.o", "first"},
+			{"very-long-name-of-member.o", "second"}
+		}),
+		membersOf(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+AppendThrowsErrorWhenNameContainsSlash) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	ASSERT_THROW(editor.append("dir/a.o", "aaa"), Error);
+}
+
+TEST_F(ArchiveEditorTests,
+ReplaceRewritesMemberAndMovesSubsequentMembers) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "aaa"}, {"b.o", "bbb"}, {"c.o", "ccc"}
+	}));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.replace("b.o", "longer content of b.o");
+
+	ASSERT_EQ(
+		archiveWithMembers({
+			{"a.o", "aaa"}, {"b.o", "longer content of b.o"}, {"c.o", "ccc"}
+		}),
+		readFile(tmpFile->getPath())
+	);
+}
+
+TEST_F(ArchiveEditorTests,
+ReplaceWithShorterContentTruncatesArchive) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "long content of a.o"}, {"b.o", "bbb"}
+	}));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.replace("a.o", "a");
+
+	ASSERT_EQ(archiveWithMembers({{"a.o", "a"}, {"b.o", "bbb"}}),
+		readFile(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+ReplaceKeepsAttributesOfMember) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	ArchiveEditor editor{tmpFile->getPath()};
+	MemberAttributes attributes;
+	attributes.mode = 0755;
+	editor.append("a.o", "aaa", attributes);
+
+	editor.replace("a.o", "new");
+
+	auto table = scanMembers(File::fromFilesystem(tmpFile->getPath()));
+	ASSERT_EQ(0755, table.getMode(0));
+	ASSERT_EQ("new", table.getContentView(0));
+}
+
+TEST_F(ArchiveEditorTests,
+ReplaceMovesLargeMembers) {
+	std::string large(3 * 1024 * 1024 + 1, 'x');
+	large.back() = 'y';
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "aaa"}, {"large.o", large}, {"c.o", "ccc"}
+	}));
+	ArchiveEditor editor{tmpFile->getPath()};
+	const std::string grownContent(2 * 1024 * 1024, 'a');
+
+	editor.replace("a.o", grownContent);
+	ASSERT_EQ(Members({{"a.o", grownContent}, {"large.o", large},
+		{"c.o", "ccc"}}), membersOf(tmpFile->getPath()));
+
+	editor.replace("a.o", "a");
+	ASSERT_EQ(Members({{"a.o", "a"}, {"large.o", large}, {"c.o", "ccc"}}),
+		membersOf(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+ReplaceThrowsErrorWhenThereIsNoSuchMember) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "aaa"}
+	}));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	ASSERT_THROW(editor.replace("b.o", "bbb"), Error);
+}
+
+TEST_F(ArchiveEditorTests,
+RemoveRemovesMemberAndTruncatesArchive) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "aaa"}, {"b.o", "bbb"}, {"c.o", "ccc"}
+	}));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.remove("b.o");
+
+	ASSERT_EQ(archiveWithMembers({{"a.o", "aaa"}, {"c.o", "ccc"}}),
+		readFile(tmpFile->getPath()));
+	ASSERT_EQ(std::vector<std::string>({"a.o", "c.o"}),
+		editor.getMemberNames());
+}
+
+TEST_F(ArchiveEditorTests,
+RemoveKeepsMembersWithLongNames) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	ArchiveEditor editor{tmpFile->getPath()};
+	editor.append("first-long-name-of-member.o", "first");
+	editor.append("a.o", "aaa");
+	editor.append("second-long-name-of-member.o", "second");
+
+	editor.remove("a.o");
+
+	ASSERT_EQ(Members({
+			{"first-long-name-of-member.o", "first"},
+			{"second-long-name-of-member.o", "second"}
+		}),
+		membersOf(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+ReplacePatchesOffsetsInSymbolTable) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers(
+		{{"a.o", "aaa"}, {"b.o", "bbb"}},
+		{{"funcA", 0}, {"funcB", 1}}
+	));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.replace("a.o", "longer content of a.o");
+
+	ASSERT_EQ(
+		archiveWithMembers(
+			{{"a.o", "longer content of a.o"}, {"b.o", "bbb"}},
+			{{"funcA", 0}, {"funcB", 1}}
+		),
+		readFile(tmpFile->getPath())
+	);
+}
+
+TEST_F(ArchiveEditorTests,
+RemoveRemovesSymbolsOfMemberFromSymbolTable) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers(
+		{{"a.o", "aaa"}, {"b.o", "bbb"}, {"c.o", "ccc"}},
+		{{"funcA", 0}, {"funcB", 1}, {"funcC", 2}, {"otherB", 1}}
+	));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.remove("b.o");
+
+	ASSERT_EQ((std::vector<std::pair<std::string, std::string>>{
+			{"funcA", "a.o"}, {"funcC", "c.o"}
+		}),
+		symbolsOf(tmpFile->getPath()));
+	ASSERT_EQ(Members({{"a.o", "aaa"}, {"c.o", "ccc"}}),
+		membersOf(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+AppendOfLongNamePatchesOffsetsInSymbolTable) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers(
+		{{"a.o", "aaa"}, {"b.o", "bbb"}},
+		{{"funcA", 0}, {"funcB", 1}}
+	));
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	editor.append("very-long-name-of-member.o", "content");
+
+	ASSERT_EQ((std::vector<std::pair<std::string, std::string>>{
+			{"funcA", "a.o"}, {"funcB", "b.o"}
+		}),
+		symbolsOf(tmpFile->getPath()));
+	ASSERT_EQ(Members({
+			{"a.o", "aaa"}, {"b.o", "bbb"},
+			{"very-long-name-of-member.o", "content"}
+		}),
+		membersOf(tmpFile->getPath()));
+}
+
+TEST_F(ArchiveEditorTests,
+ReopenedArchiveContainsModifiedMembers) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	{
+		ArchiveEditor editor{tmpFile->getPath()};
+		editor.append("a.o", "aaa");
+		editor.append("very-long-name-of-member.o", "bbb");
+		editor.append("c.o", "ccc");
+		editor.remove("a.o");
+	}
+
+	ArchiveEditor editor{tmpFile->getPath()};
+
+	ASSERT_EQ(std::vector<std::string>({"very-long-name-of-member.o", "c.o"}),
+		editor.getMemberNames());
+}
+
+} // namespace tests
+} // namespace ar
@@ -0,0 +1,127 @@
+///
+/// @file      ar/batch_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c batch module.
+///
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/batch.h"
+#include "ar/file.h"
+#include "ar/test_utilities/built_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+
+namespace ar {
+namespace tests {
+
+namespace {
+
+///
+/// Returns the content of an archive with @a fileCount files named
+/// @a prefix followed by their index, each with content "x".
+///
+std::string archiveWithFiles(const std::string& prefix,
+		std::size_t fileCount) {
+	Members members;
+	for (std::size_t j = 0; j < fileCount; ++j) {
+		members.emplace_back(prefix + std::to_string(j), "x");
+	}
+	return archiveWithMembers(members);
+}
+
+} // anonymous namespace
+
+///
+/// Tests for processArchives().
+///
+class ProcessArchivesTests: public testing::Test {};
+
+TEST_F(ProcessArchivesTests,
+ReportIsEmptyForNoArchives) {
+	auto report = processArchives({}, nullptr);
+
+	ASSERT_TRUE(report.archives.empty());
+	ASSERT_EQ(0, report.fileCount);
+	ASSERT_EQ(0, report.failedArchiveCount);
+}
+
+TEST_F(ProcessArchivesTests,
+HandlerIsCalledForEveryFileOfEveryArchive) {
+	// The second archive is split into several ranges of files.
+	auto tmpFile1 = TmpFile::createWithContent(archiveWithFiles("a", 3));
+	auto tmpFile2 = TmpFile::createWithContent(archiveWithFiles("b", 1000));
+	std::mutex mutex;
+	std::multiset<std::string> names;
+	BatchOptions options;
+	options.threadCount = 4;
+
+	auto report = processArchives(
+		{tmpFile1->getPath(), tmpFile2->getPath()},
+		[&](const std::string&, File& file) {
+			ASSERT_EQ("x", file.getContentView());
+			std::lock_guard<std::mutex> lock{mutex};
+			names.insert(file.getName());
+		},
+		options
+	);
+
+	ASSERT_EQ(1003, names.size());
+	ASSERT_EQ(1, names.count("a2"));
+	ASSERT_EQ(1, names.count("b999"));
+	ASSERT_EQ(2, report.archives.size());
+	ASSERT_EQ(tmpFile1->getPath(), report.archives[0].path);
+	ASSERT_EQ(3, report.archives[0].fileCount);
+	ASSERT_EQ(1000, report.archives[1].fileCount);
+	ASSERT_EQ(1003, report.fileCount);
+	ASSERT_EQ(1003, report.contentSize);
+}
+
+TEST_F(ProcessArchivesTests,
+InvalidArchiveIsReportedAndOtherArchivesAreProcessed) {
+	auto tmpFile1 = TmpFile::createWithContent("invalid");
+	auto tmpFile2 = TmpFile::createWithContent(archiveWithFiles("a", 2));
+	std::atomic<std::size_t> fileCount{0};
+	BatchOptions options;
+	options.threadCount = 1;
+
+	auto report = processArchives(
+		{tmpFile1->getPath(), "nonexisting-archive.a", tmpFile2->getPath()},
+		[&](const std::string&, File&) { fileCount++; },
+		options
+	);
+
+	ASSERT_EQ(2, fileCount);
+	ASSERT_EQ(2, report.failedArchiveCount);
+	ASSERT_FALSE(report.archives[0].error.empty());
+	ASSERT_FALSE(report.archives[1].error.empty());
+	ASSERT_TRUE(report.archives[2].error.empty());
+	ASSERT_EQ(2, report.fileCount);
+}
+
+TEST_F(ProcessArchivesTests,
+ExceptionThrownByHandlerIsPropagated) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithFiles("a", 2));
+	BatchOptions options;
+	options.threadCount = 2;
+
+	ASSERT_THROW(
+		processArchives(
+			{tmpFile->getPath()},
+			[](const std::string&, File&) {
+				throw std::runtime_error("error");
+			},
+			options
+		),
+		std::runtime_error
+	);
+}
+
+} // namespace tests
+} // namespace ar
@@ -0,0 +1,61 @@
+///
+/// @file      ar/byte_source_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c byte_source module.
+///
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/byte_source.h"
+#include "ar/exceptions.h"
+#include "ar/test_utilities/tmp_file.h"
+
+namespace ar {
+namespace tests {
+
+///
+/// Tests for ByteSource.
+///
+class ByteSourceTests: public testing::Test {};
+
+TEST_F(ByteSourceTests,
+SourceFromStringProvidesItsBytesInMemory) {
+	auto source = ByteSource::fromString("content");
+
+	ASSERT_EQ(7, source->size());
+	ASSERT_EQ("content", std::string(source->data(), source->size()));
+}
+
+TEST_F(ByteSourceTests,
+SourceFromFilesystemProvidesBytesOfFileInMemory) {
+	auto tmpFile = TmpFile::createWithContent("content");
+
+	auto source = ByteSource::fromFilesystem(tmpFile->getPath());
+
+	ASSERT_EQ(7, source->size());
+	ASSERT_EQ("content", std::string(source->data(), source->size()));
+}
+
+TEST_F(ByteSourceTests,
+SourceFromFilesystemThrowsIOErrorWhenFileDoesNotExist) {
+	ASSERT_THROW(
+		ByteSource::fromFilesystem("/nonexisting/path/archive.a"),
+		IOError
+	);
+}
+
+TEST_F(ByteSourceTests,
+ReadAtReadsOnlyBytesUpToEndOfSource) {
+	auto source = ByteSource::fromString("content");
+	char buffer[5] = {};
+
+	ASSERT_EQ(3, source->readAt(4, buffer, 5));
+	ASSERT_EQ("ent", std::string(buffer, 3));
+	ASSERT_EQ(0, source->readAt(7, buffer, 5));
+}
+
+} // namespace tests
+} // namespace ar
@@ -0,0 +1,188 @@
+///
+/// @file      ar/comparison_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c comparison module.
+///
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/byte_source.h"
+#include "ar/comparison.h"
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/member_table.h"
+#include "ar/test_utilities/built_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+#include "ar/test_utilities/unmapped_byte_source.h"
+
+namespace ar {
+namespace tests {
+
+namespace {
+
+///
+/// Returns the differences (pairs of marks and names of members) in the given
+/// result of a comparison.
+///
+std::vector<std::pair<char, std::string>> differencesIn(
+		const ArchiveDiff& result) {
+	std::vector<std::pair<char, std::string>> differences;
+	for (const auto& difference : result.differences) {
+		const auto mark = difference.change == MemberChange::Added ? '+' :
+			difference.change == MemberChange::Removed ? '-' : 'M';
+		differences.emplace_back(mark, difference.name);
+	}
+	return differences;
+}
+
+} // anonymous namespace
+
+///
+/// Tests for diff().
+///
+class DiffTests: public testing::Test {
+protected:
+	using Differences = std::vector<std::pair<char, std::string>>;
+
+	/// Compares the archives with the given members, held in memory.
+	ArchiveDiff diffMembers(const Members& oldMembers,
+			const Members& newMembers) {
+		return diff(
+			scanMembers(ByteSource::fromString(archiveWithMembers(oldMembers))),
+			scanMembers(ByteSource::fromString(archiveWithMembers(newMembers)))
+		);
+	}
+};
+
+TEST_F(DiffTests,
+SameArchivesHaveNoDifferences) {
+	const Members members{{"a.o", "aaa"}, {"b.o", "bb"}};
+
+	auto result = diffMembers(members, members);
+
+	ASSERT_TRUE(result.empty());
+	ASSERT_EQ(2, result.unchangedCount);
+	ASSERT_EQ(2, result.comparedCount);
+	ASSERT_EQ(5, result.comparedSize);
+}
+
+TEST_F(DiffTests,
+ReportsRemovedModifiedAndAddedMembersInOrder) {
+	auto result = diffMembers(
+		{{"a.o", "aaa"}, {"b.o", "bb"}, {"c.o", "c"}},
+		{{"d.o", "d"}, {"c.o", "x"}, {"a.o", "aaa"}}
+	);
+
+	ASSERT_EQ(Differences({{'-', "b.o"}, {'M', "c.o"}, {'+', "d.o"}}),
+		differencesIn(result));
+	ASSERT_EQ(1, result.unchangedCount);
+}
+
+TEST_F(DiffTests,
+ReportsSizesOfMembers) {
+	auto result = diffMembers({{"a.o", "aaa"}, {"b.o", "bb"}},
+		{{"a.o", "aaaa"}, {"c.o", "c"}});
+
+	ASSERT_EQ(3, result.differences.size());
+	ASSERT_EQ(3, result.differences[0].oldSize);
+	ASSERT_EQ(4, result.differences[0].newSize);
+	ASSERT_EQ(2, result.differences[1].oldSize);
+	ASSERT_EQ(0, result.differences[1].newSize);
+	ASSERT_EQ(0, result.differences[2].oldSize);
+	ASSERT_EQ(1, result.differences[2].newSize);
+}
+
+TEST_F(DiffTests,
+MembersOfDifferentSizesAreModifiedWithoutComparingTheirContent) {
+	auto oldSource = UnmappedByteSource::createWithContent(
+		archiveWithMembers({{"a.o", "aaa"}}));
+	auto newSource = UnmappedByteSource::createWithContent(
+		archiveWithMembers({{"a.o", "aaaa"}}));
+	auto oldMembers = scanMembers(oldSource);
+	auto newMembers = scanMembers(newSource);
+	const auto oldReadByteCount = oldSource->getReadByteCount();
+	const auto newReadByteCount = newSource->getReadByteCount();
+
+	auto result = diff(oldMembers, newMembers);
+
+	ASSERT_EQ(Differences({{'M', "a.o"}}), differencesIn(result));
+	ASSERT_EQ(0, result.comparedCount);
+	ASSERT_EQ(oldReadByteCount, oldSource->getReadByteCount());
+	ASSERT_EQ(newReadByteCount, newSource->getReadByteCount());
+}
+
+TEST_F(DiffTests,
+ComparesContentOfArchivesThatAreNotInMemory) {
+	std::string large(200 * 1024, 'x');
+	auto modified = large;
+	modified.back() = 'y';
+	auto oldMembers = scanMembers(UnmappedByteSource::createWithContent(
+		archiveWithMembers({{"a.o", "aaa"}, {"large.o", large}})));
+	auto newMembers = scanMembers(UnmappedByteSource::createWithContent(
+		archiveWithMembers({{"a.o", "aaa"}, {"large.o", modified}})));
+
+	auto result = diff(oldMembers, newMembers);
+
+	ASSERT_EQ(Differences({{'M', "large.o"}}), differencesIn(result));
+	ASSERT_EQ(1, result.unchangedCount);
+}
+
+TEST_F(DiffTests,
+MembersWithDifferentChecksumsAreModifiedWithoutComparingTheirContent) {
+	auto oldSource = UnmappedByteSource::createWithContent(
+		archiveWithMembers({{"a.o", "aaa"}}));
+	auto newSource = UnmappedByteSource::createWithContent(
+		archiveWithMembers({{"a.o", "bbb"}}));
+	ExtractionOptions options;
+	options.computeChecksums = true;
+	auto oldMembers = scanMembers(oldSource, options);
+	auto newMembers = scanMembers(newSource, options);
+	const auto oldReadByteCount = oldSource->getReadByteCount();
+
+	auto result = diff(oldMembers, newMembers);
+
+	ASSERT_EQ(Differences({{'M', "a.o"}}), differencesIn(result));
+	ASSERT_EQ(oldReadByteCount, oldSource->getReadByteCount());
+}
+
+TEST_F(DiffTests,
+MembersOfSameNameAreMatchedInOrder) {
+	auto result = diffMembers(
+		{{"a.o", "first"}, {"a.o", "second"}, {"a.o", "third"}},
+		{{"a.o", "first"}, {"a.o", "SECOND"}}
+	);
+
+	ASSERT_EQ(Differences({{'M', "a.o"}, {'-', "a.o"}}),
+		differencesIn(result));
+	ASSERT_EQ(1, result.unchangedCount);
+}
+
+TEST_F(DiffTests,
+ComparesArchivesInFilesystem) {
+	auto oldFile = TmpFile::createWithContent(
+		archiveWithMembers({{"a.o", "aaa"}, {"b.o", "bb"}}));
+	auto newFile = TmpFile::createWithContent(
+		archiveWithMembers({{"a.o", "aab"}, {"b.o", "bb"}}));
+
+	auto result = diff(oldFile->getPath(), newFile->getPath());
+
+	ASSERT_EQ(Differences({{'M', "a.o"}}), differencesIn(result));
+	ASSERT_TRUE(diff(oldFile->getPath(), oldFile->getPath()).empty());
+}
+
+TEST_F(DiffTests,
+ThrowsInvalidArchiveErrorWhenArchiveIsInvalid) {
+	auto validFile = TmpFile::createWithContent("!<arch>\n");
+	auto invalidFile = TmpFile::createWithContent("not an archive");
+
+	ASSERT_THROW(diff(validFile->getPath(), invalidFile->getPath()),
+		InvalidArchiveError);
+}
+
+} // namespace tests
+} // namespace ar
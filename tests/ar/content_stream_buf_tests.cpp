@@ -0,0 +1,94 @@
+///
+/// @file      ar/content_stream_buf_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c content_stream_buf module.
+///
+
+#include <istream>
+#include <iterator>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/content_stream_buf.h"
+#include "ar/file.h"
+#include "ar/internal/files/filesystem_range_file.h"
+#include "ar/test_utilities/tmp_file.h"
+
+namespace ar {
+namespace tests {
+
+///
+/// Tests for ContentStreamBuf.
+///
+class ContentStreamBufTests: public testing::Test {};
+
+TEST_F(ContentStreamBufTests,
+StreamReadsWholeContentThroughSmallBuffer) {
+	auto file = File::fromContentWithName("0123456789", "file.txt");
+	ContentStreamBuf streamBuf{*file, 3};
+	std::istream stream{&streamBuf};
+
+	std::string content{std::istreambuf_iterator<char>(stream),
+		std::istreambuf_iterator<char>()};
+
+	ASSERT_EQ("0123456789", content);
+}
+
+TEST_F(ContentStreamBufTests,
+StreamReadsOnlyContentOfRangeOfArchive) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	internal::FilesystemRangeFile file{tmpFile->getPath(), 2, 5, "file.txt"};
+	ContentStreamBuf streamBuf{file, 2};
+	std::istream stream{&streamBuf};
+
+	std::string content{std::istreambuf_iterator<char>(stream),
+		std::istreambuf_iterator<char>()};
+
+	ASSERT_EQ("23456", content);
+}
+
+TEST_F(ContentStreamBufTests,
+StreamCanSeekFromBeginningAndFromCurrentPosition) {
+	auto file = File::fromContentWithName("0123456789", "file.txt");
+	ContentStreamBuf streamBuf{*file, 4};
+	std::istream stream{&streamBuf};
+	char buffer[3] = {};
+
+	stream.seekg(6);
+	stream.read(buffer, 2);
+	ASSERT_EQ("67", std::string(buffer, 2));
+	ASSERT_EQ(8, stream.tellg());
+
+	stream.seekg(-7, std::ios_base::cur);
+	stream.read(buffer, 3);
+	ASSERT_EQ("123", std::string(buffer, 3));
+}
+
+TEST_F(ContentStreamBufTests,
+StreamSignalsEndOfFileAfterContent) {
+	auto file = File::fromContentWithName("01", "file.txt");
+	ContentStreamBuf streamBuf{*file};
+	std::istream stream{&streamBuf};
+	char buffer[3];
+
+	stream.read(buffer, 3);
+
+	ASSERT_EQ(2, stream.gcount());
+	ASSERT_TRUE(stream.eof());
+}
+
+TEST_F(ContentStreamBufTests,
+SeekingFromEndFails) {
+	auto file = File::fromContentWithName("0123456789", "file.txt");
+	ContentStreamBuf streamBuf{*file};
+	std::istream stream{&streamBuf};
+
+	stream.seekg(-2, std::ios_base::end);
+
+	ASSERT_TRUE(stream.fail());
+}
+
+} // namespace tests
+} // namespace ar
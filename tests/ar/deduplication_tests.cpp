@@ -0,0 +1,194 @@
+///
+/// @file      ar/deduplication_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c deduplication module.
+///
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/deduplication.h"
+#include "ar/exceptions.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/built_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+
+#ifndef AR_OS_WINDOWS
+#include <sys/stat.h>
+#endif
+
+namespace ar {
+namespace tests {
+
+///
+/// Tests for findDuplicateMembers().
+///
+class FindDuplicateMembersTests: public testing::Test {};
+
+TEST_F(FindDuplicateMembersTests,
+ReportIsEmptyForNoArchives) {
+	auto report = findDuplicateMembers({});
+
+	ASSERT_TRUE(report.archives.empty());
+	ASSERT_TRUE(report.duplicateGroups.empty());
+	ASSERT_EQ(0, report.memberCount);
+}
+
+TEST_F(FindDuplicateMembersTests,
+FindsMembersWithIdenticalContentAcrossArchives) {
+	auto tmpFile1 = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "same"}, {"b.o", "first"}, {"c.o", "same"}
+	}));
+	auto tmpFile2 = TmpFile::createWithContent(archiveWithMembers({
+		{"d.o", "other"}, {"e.o", "same"}
+	}));
+	DeduplicationOptions options;
+	options.threadCount = 2;
+
+	auto report = findDuplicateMembers(
+		{tmpFile1->getPath(), tmpFile2->getPath()}, options);
+
+	ASSERT_EQ(1, report.duplicateGroups.size());
+	const auto& group = report.duplicateGroups[0];
+	ASSERT_EQ(4, group.size);
+	ASSERT_EQ(3, group.members.size());
+	ASSERT_EQ(0, group.members[0].archiveIndex);
+	ASSERT_EQ("a.o", group.members[0].name);
+	ASSERT_EQ("c.o", group.members[1].name);
+	ASSERT_EQ(1, group.members[2].archiveIndex);
+	ASSERT_EQ("e.o", group.members[2].name);
+	ASSERT_EQ(5, report.memberCount);
+	ASSERT_EQ(3, report.uniqueMemberCount);
+	ASSERT_EQ(22, report.contentSize);
+	ASSERT_EQ(14, report.uniqueContentSize);
+}
+
+TEST_F(FindDuplicateMembersTests,
+MembersOfSameSizeWithDifferentContentAreNotReported) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "content1"}, {"b.o", "content2"}
+	}));
+
+	auto report = findDuplicateMembers({tmpFile->getPath()});
+
+	ASSERT_TRUE(report.duplicateGroups.empty());
+	ASSERT_EQ(2, report.uniqueMemberCount);
+}
+
+TEST_F(FindDuplicateMembersTests,
+ArchivesThatCannotBeReadAreReportedAndSkipped) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "same"}, {"b.o", "same"}
+	}));
+
+	auto report = findDuplicateMembers(
+		{"nonexisting-file", tmpFile->getPath()});
+
+	ASSERT_EQ(1, report.failedArchiveCount);
+	ASSERT_FALSE(report.archives[0].error.empty());
+	ASSERT_EQ(2, report.archives[1].fileCount);
+	ASSERT_EQ(1, report.duplicateGroups.size());
+	ASSERT_EQ(1, report.duplicateGroups[0].members[0].archiveIndex);
+}
+
+///
+/// Tests for extractDeduplicated().
+///
+class ExtractDeduplicatedTests: public testing::Test {};
+
+TEST_F(ExtractDeduplicatedTests,
+WritesIdenticalFilesOnlyOnceAndHardLinksOtherCopies) {
+	const std::string DirPath{"ar-dedup-tst"};
+	auto tmpFile1 = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "same"}, {"b.o", "first"}
+	}));
+	auto tmpFile2 = TmpFile::createWithContent(archiveWithMembers({
+		{"c.o", "same"}
+	}));
+	const auto dir1Path = internal::joinPaths(DirPath, tmpFile1->getPath());
+	const auto dir2Path = internal::joinPaths(DirPath, tmpFile2->getPath());
+	RemoveFileOnDestruction dirRemover{DirPath};
+	RemoveFileOnDestruction dir1Remover{dir1Path};
+	RemoveFileOnDestruction dir2Remover{dir2Path};
+	RemoveFileOnDestruction aRemover{internal::joinPaths(dir1Path, "a.o")};
+	RemoveFileOnDestruction bRemover{internal::joinPaths(dir1Path, "b.o")};
+	RemoveFileOnDestruction cRemover{internal::joinPaths(dir2Path, "c.o")};
+	DeduplicationOptions options;
+	options.linking = DuplicateLinking::HardLink;
+
+	auto report = extractDeduplicated(
+		{tmpFile1->getPath(), tmpFile2->getPath()}, DirPath, options);
+
+	ASSERT_EQ(2, report.writtenFileCount);
+	ASSERT_EQ(9, report.writtenSize);
+	ASSERT_EQ(1, report.hardLinkedFileCount);
+	ASSERT_EQ(4, report.savedSize);
+	ASSERT_EQ("same", internal::readFile(internal::joinPaths(dir1Path, "a.o")));
+	ASSERT_EQ("first", internal::readFile(internal::joinPaths(dir1Path, "b.o")));
+	ASSERT_EQ("same", internal::readFile(internal::joinPaths(dir2Path, "c.o")));
+#ifndef AR_OS_WINDOWS
+	struct stat status1;
+	struct stat status2;
+	ASSERT_EQ(0, ::stat(internal::joinPaths(dir1Path, "a.o").c_str(),
+		&status1));
+	ASSERT_EQ(0, ::stat(internal::joinPaths(dir2Path, "c.o").c_str(),
+		&status2));
+	ASSERT_EQ(status1.st_ino, status2.st_ino);
+#endif
+}
+
+TEST_F(ExtractDeduplicatedTests,
+ClonesOrWritesOtherCopiesWhenReflinksAreRequested) {
+	const std::string DirPath{"ar-dedup-tst"};
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "same"}, {"b.o", "same"}
+	}));
+	const auto dir1Path = internal::joinPaths(DirPath, tmpFile->getPath());
+	RemoveFileOnDestruction dirRemover{DirPath};
+	RemoveFileOnDestruction dir1Remover{dir1Path};
+	RemoveFileOnDestruction aRemover{internal::joinPaths(dir1Path, "a.o")};
+	RemoveFileOnDestruction bRemover{internal::joinPaths(dir1Path, "b.o")};
+
+	auto report = extractDeduplicated({tmpFile->getPath()}, DirPath);
+
+	// Whether the filesystem supports clones depends on where the tests run.
+	ASSERT_EQ(2, report.writtenFileCount + report.reflinkedFileCount);
+	ASSERT_EQ(0, report.hardLinkedFileCount);
+	ASSERT_EQ("same", internal::readFile(internal::joinPaths(dir1Path, "a.o")));
+	ASSERT_EQ("same", internal::readFile(internal::joinPaths(dir1Path, "b.o")));
+}
+
+TEST_F(ExtractDeduplicatedTests,
+FileReplacedByMemberOfSameNameIsNotUsedAsCopy) {
+	const std::string DirPath{"ar-dedup-tst"};
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers({
+		{"a.o", "same"}, {"a.o", "other"}, {"b.o", "same"}
+	}));
+	const auto dir1Path = internal::joinPaths(DirPath, tmpFile->getPath());
+	RemoveFileOnDestruction dirRemover{DirPath};
+	RemoveFileOnDestruction dir1Remover{dir1Path};
+	RemoveFileOnDestruction aRemover{internal::joinPaths(dir1Path, "a.o")};
+	RemoveFileOnDestruction bRemover{internal::joinPaths(dir1Path, "b.o")};
+	DeduplicationOptions options;
+	options.linking = DuplicateLinking::HardLink;
+
+	auto report = extractDeduplicated({tmpFile->getPath()}, DirPath, options);
+
+	ASSERT_EQ(3, report.writtenFileCount);
+	ASSERT_EQ("other",
+		internal::readFile(internal::joinPaths(dir1Path, "a.o")));
+	ASSERT_EQ("same", internal::readFile(internal::joinPaths(dir1Path, "b.o")));
+}
+
+TEST_F(ExtractDeduplicatedTests,
+ThrowsErrorForArchivesWithSameName) {
+	ASSERT_THROW(
+		extractDeduplicated({"dir1/lib.a", "dir2/lib.a"}, "ar-dedup-tst"),
+		Error
+	);
+}
+
+} // namespace tests
+} // namespace ar
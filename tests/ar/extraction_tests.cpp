@@ -5,11 +5,23 @@
 /// @brief     Tests for the @c extraction module.
 ///
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "ar/byte_source.h"
 #include "ar/exceptions.h"
 #include "ar/extraction.h"
 #include "ar/file.h"
+#include "ar/generation.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/memory_accounting.h"
+#include "ar/member_table.h"
+#include "ar/test_utilities/compression.h"
+#include "ar/test_utilities/generated_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+#include "ar/test_utilities/unmapped_byte_source.h"
 
 namespace ar {
 namespace tests {
@@ -46,6 +58,194 @@ ExtractReturnsSingletonContainerForArchiveWithSingleFile) {
 	ASSERT_EQ("contents of test.txt", file->getContent());
 }
 
+TEST_F(ExtractTests,
+ExtractWithMoreThreadsReturnsFilesInOrderOfArchive) {
+	ExtractionOptions options;
+	options.threadCount = 2;
+
+	auto files = extract(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"a.txt/          0           0     0     644     1         `\n"
+			"a"
+			"b.txt/          0           0     0     644     1         `\n"
+			"b"
+		,
+			"archive.a"
+		),
+		options
+	);
+
+	ASSERT_EQ(2, files.size());
+	ASSERT_EQ("a.txt", files.front()->getName());
+	ASSERT_EQ("b.txt", files.back()->getName());
+}
+
+TEST_F(ExtractTests,
+ExtractWithMemoryBudgetReturnsCorrectContentOfArchiveFromFilesystem) {
+	auto tmpFile = TmpFile::createWithContent(
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     3         `\n"
+		"aaa\n"
+		"b.txt/          0           0     0     644     1         `\n"
+		"b"
+	);
+	ExtractionOptions options;
+	options.memoryBudget = 2;
+
+	auto files = extract(File::fromFilesystem(tmpFile->getPath()), options);
+
+	ASSERT_EQ(2, files.size());
+	ASSERT_EQ("aaa", files.front()->getContent());
+	ASSERT_EQ("b", files.back()->getContent());
+}
+
+TEST_F(ExtractTests,
+ExtractWithStatsRecordsWhatExtractionDid) {
+	const std::string archive{
+		"!<arch>\n"
+		"//                                              14        `\n"
+		"long_name.txt/\n"
+		"/0              0           0     0     644     3         `\n"
+		"aaa\n"
+		"b.txt/          0           0     0     644     2         `\n"
+		"bb"
+	};
+	auto tmpFile = TmpFile::createWithContent(archive);
+	ExtractionStats stats;
+	ExtractionOptions options;
+	options.stats = &stats;
+
+	auto files = extract(File::fromFilesystem(tmpFile->getPath()), options);
+
+	if (!stats.collected) {
+		GTEST_SKIP() << "statistics are not supported by this build";
+	}
+	ASSERT_EQ(2, files.size());
+	ASSERT_EQ(archive.size(), stats.bytesRead);
+	ASSERT_EQ(3, stats.headersParsed);
+	ASSERT_EQ(1, stats.nameTableHits);
+	ASSERT_EQ(4, stats.allocations);
+	ASSERT_EQ(5, stats.bytesCopied);
+}
+
+TEST_F(ExtractTests,
+ExtractWithStatsAddsToStatsOfPreviousExtractions) {
+	const std::string archive{
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     1         `\n"
+		"a"
+	};
+	ExtractionStats stats;
+	ExtractionOptions options;
+	options.stats = &stats;
+	options.shareArchiveContent = true;
+
+	extract(File::fromContentWithName(archive, "archive.a"), options);
+	extract(File::fromContentWithName(archive, "archive.a"), options);
+
+	if (!stats.collected) {
+		GTEST_SKIP() << "statistics are not supported by this build";
+	}
+	ASSERT_EQ(2, stats.headersParsed);
+	ASSERT_EQ(2, stats.allocations);
+	ASSERT_EQ(0, stats.bytesCopied);
+}
+
+TEST_F(ExtractTests,
+ExtractWithStatsRecordsMemoryUsedInPhasesWhenCounterIsRegistered) {
+	const std::string archive{
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     1         `\n"
+		"a\n"
+		"b.txt/          0           0     0     644     2         `\n"
+		"bb"
+	};
+	CountingMemoryResource resource;
+	setMemoryCounter(&resource.getCounter());
+	ExtractionStats stats;
+	ExtractionOptions options;
+	options.stats = &stats;
+	options.memoryResource = &resource;
+
+	auto files = extract(File::fromContentWithName(archive, "archive.a"),
+		options);
+	setMemoryCounter(nullptr);
+
+	if (!stats.collected) {
+		GTEST_SKIP() << "statistics are not supported by this build";
+	}
+	// Only the files are allocated from the resource.
+	const auto usage = resource.getUsage();
+	ASSERT_EQ(0, stats.scanMemory.allocations);
+	ASSERT_EQ(usage.allocations, stats.materializeMemory.allocations);
+	ASSERT_EQ(usage.allocatedBytes, stats.materializeMemory.allocatedBytes);
+	ASSERT_EQ(usage.heldBytes, stats.materializeMemory.heldBytes);
+	ASSERT_EQ(usage.peakHeldBytes, stats.materializeMemory.peakHeldBytes);
+	ASSERT_LT(0, stats.materializeMemory.heldBytes);
+}
+
+TEST_F(ExtractTests,
+ExtractWithStatsCountsAllocationsOfFilesInMaterializeMemory) {
+	// The names and content are short, so the strings holding them do not
+	// allocate and only the files themselves are allocated.
+	const std::string archive{
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     1         `\n"
+		"a\n"
+		"b.txt/          0           0     0     644     2         `\n"
+		"bb"
+	};
+	CountingMemoryResource resource;
+	setMemoryCounter(&resource.getCounter());
+	ExtractionStats stats;
+	ExtractionOptions options;
+	options.stats = &stats;
+	options.memoryResource = &resource;
+
+	auto files = extract(File::fromContentWithName(archive, "archive.a"),
+		options);
+	setMemoryCounter(nullptr);
+
+	if (!stats.collected) {
+		GTEST_SKIP() << "statistics are not supported by this build";
+	}
+	ASSERT_EQ(files.size(), stats.materializeMemory.allocations);
+	ASSERT_LE(files.size() * sizeof(File),
+		stats.materializeMemory.allocatedBytes);
+}
+
+TEST_F(ExtractTests,
+ExtractGivesSameFilesOfGeneratedArchiveWithAllOptions) {
+	GenerationOptions generation;
+	generation.memberCount = 2000;
+	generation.maxMemberSize = 300;
+	generation.longNameCount = 200;
+	generation.symbolCount = 3000;
+	generation.sym64 = true;
+	auto tmpFile = generateArchiveFile(generation);
+	auto expectedFiles = extract(File::fromFilesystem(tmpFile->getPath()));
+	std::vector<ExtractionOptions> allOptions(4);
+	allOptions[0].threadCount = 4;
+	allOptions[1].speculativeHeaderScan = true;
+	allOptions[2].shareArchiveContent = true;
+	allOptions[2].memoryBudget = 1024;
+	allOptions[3].recursive = true;
+
+	for (const auto& options : allOptions) {
+		auto files = extract(File::fromFilesystem(tmpFile->getPath()),
+			options);
+
+		ASSERT_EQ(generation.memberCount, files.size());
+		auto expectedFile = expectedFiles.begin();
+		for (const auto& file : files) {
+			ASSERT_EQ((*expectedFile)->getName(), file->getName());
+			ASSERT_EQ((*expectedFile)->getContent(), file->getContent());
+			++expectedFile;
+		}
+	}
+}
+
 TEST_F(ExtractTests,
 ExtractThrowsInvalidArchiveErrorWhenMagicStringIsNotPresent) {
 	ASSERT_THROW(
@@ -54,5 +254,510 @@ ExtractThrowsInvalidArchiveErrorWhenMagicStringIsNotPresent) {
 	);
 }
 
+///
+/// Tests for ExtractionSession.
+///
+class ExtractionSessionTests: public testing::Test {};
+
+TEST_F(ExtractionSessionTests,
+ExtractReturnsFilesOfEveryArchive) {
+	ExtractionSession session;
+
+	auto files1 = session.extract(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"a.txt/          0           0     0     644     3         `\n"
+			"aaa\n"
+		,
+			"archive1.a"
+		)
+	);
+	auto files2 = session.extract(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"b.txt/          0           0     0     644     2         `\n"
+			"bb"
+		,
+			"archive2.a"
+		)
+	);
+
+	ASSERT_EQ(1, files1.size());
+	ASSERT_EQ("a.txt", files1.front()->getName());
+	ASSERT_EQ("aaa", files1.front()->getContent());
+	ASSERT_EQ(1, files2.size());
+	ASSERT_EQ("b.txt", files2.front()->getName());
+	ASSERT_EQ("bb", files2.front()->getContent());
+}
+
+TEST_F(ExtractionSessionTests,
+ExtractReturnsCorrectFilesOfArchivesFromFilesystem) {
+	auto tmpFile1 = TmpFile::createWithContent(
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     3         `\n"
+		"aaa\n"
+	);
+	auto tmpFile2 = TmpFile::createWithContent(
+		"!<arch>\n"
+		"b.txt/          0           0     0     644     1         `\n"
+		"b\n"
+	);
+	ExtractionOptions options;
+	options.threadCount = 2;
+	ExtractionSession session{options};
+
+	auto files1 = session.extract(File::fromFilesystem(tmpFile1->getPath()));
+	auto files2 = session.extract(File::fromFilesystem(tmpFile2->getPath()));
+
+	ASSERT_EQ("aaa", files1.front()->getContent());
+	ASSERT_EQ("b", files2.front()->getContent());
+}
+
+TEST_F(ExtractionSessionTests,
+FilesSharingArchiveContentStayValidAfterNextExtraction) {
+	ExtractionOptions options;
+	options.shareArchiveContent = true;
+	ExtractionSession session{options};
+
+	auto files1 = session.extract(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"a.txt/          0           0     0     644     3         `\n"
+			"aaa\n"
+		,
+			"archive1.a"
+		)
+	);
+	auto files2 = session.extract(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"b.txt/          0           0     0     644     3         `\n"
+			"bbb\n"
+		,
+			"archive2.a"
+		)
+	);
+
+	ASSERT_EQ("aaa", files1.front()->getContent());
+	ASSERT_EQ("bbb", files2.front()->getContent());
+}
+
+TEST_F(ExtractionSessionTests,
+ExtractWorksAfterInvalidArchiveAndAfterReset) {
+	ExtractionSession session;
+	ASSERT_THROW(
+		session.extract(File::fromContentWithName("invalid", "archive.a")),
+		InvalidArchiveError
+	);
+	session.reset();
+
+	auto files = session.extract(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"a.txt/          0           0     0     644     1         `\n"
+			"a\n"
+		,
+			"archive.a"
+		)
+	);
+
+	ASSERT_EQ(1, files.size());
+	ASSERT_EQ("a", files.front()->getContent());
+}
+
+///
+/// Tests for scanMembers().
+///
+class ScanMembersTests: public testing::Test {};
+
+TEST_F(ScanMembersTests,
+ScanMembersReturnsTableWithMembersOfArchive) {
+	auto table = scanMembers(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"a.txt/          0           0     0     644     1         `\n"
+			"a\n"
+			"b.txt/          0           0     0     644     2         `\n"
+			"bb"
+		,
+			"archive.a"
+		)
+	);
+
+	ASSERT_EQ(2, table.size());
+	ASSERT_EQ("a.txt", table.getName(0));
+	ASSERT_EQ(1, table.getSize(0));
+	ASSERT_EQ("b.txt", table.getName(1));
+	ASSERT_EQ(2, table.getSize(1));
+}
+
+TEST_F(ScanMembersTests,
+ScanMembersWithStatsRecordsBytesReadFromSource) {
+	auto source = UnmappedByteSource::createWithContent(
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     1         `\n"
+		"a\n"
+		"b.txt/          0           0     0     644     2         `\n"
+		"bb"
+	);
+	ExtractionStats stats;
+	ExtractionOptions options;
+	options.stats = &stats;
+
+	scanMembers(source, options);
+
+	if (!stats.collected) {
+		GTEST_SKIP() << "statistics are not supported by this build";
+	}
+	ASSERT_EQ(source->getReadByteCount(), stats.bytesRead);
+	ASSERT_EQ(2, stats.headersParsed);
+	ASSERT_EQ(0, stats.allocations);
+}
+
+TEST_F(ScanMembersTests,
+ScanMembersFindsSameMembersOfGeneratedArchiveInSourceAsInMemory) {
+	GenerationOptions generation;
+	generation.memberCount = 500;
+	generation.longNameCount = 50;
+	generation.symbolCount = 500;
+	const auto archive = generateArchiveContent(generation);
+
+	auto expectedTable = scanMembers(
+		File::fromContentWithName(archive, "archive.a"));
+	auto table = scanMembers(UnmappedByteSource::createWithContent(archive));
+
+	ASSERT_EQ(generation.memberCount, table.size());
+	for (MemberTable::size_type j = 0; j < table.size(); ++j) {
+		ASSERT_EQ(expectedTable.getName(j), table.getName(j));
+		ASSERT_EQ(expectedTable.getOffset(j), table.getOffset(j));
+		ASSERT_EQ(expectedTable.getSize(j), table.getSize(j));
+	}
+}
+
+TEST_F(ScanMembersTests,
+ScanMembersThrowsInvalidArchiveErrorForInvalidArchive) {
+	ASSERT_THROW(
+		scanMembers(File::fromContentWithName("invalid", "archive.a")),
+		InvalidArchiveError
+	);
+}
+
+///
+/// Tests for extractToDirectory().
+///
+class ExtractToDirectoryTests: public testing::Test {};
+
+TEST_F(ExtractToDirectoryTests,
+ExtractToDirectoryWritesFilesAndReportsTheirNames) {
+	const std::string Name{"ar-extract-to-directory-test.txt"};
+	RemoveFileOnDestruction remover{Name};
+
+	auto report = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"ar-extract-to-directory-test.txt/"
+			"0           0     0     644     7         `\n"
+			"content"
+		,
+			"archive.a"
+		),
+		"."
+	);
+
+	ASSERT_EQ(1, report.fileNames.size());
+	ASSERT_EQ(Name, report.fileNames[0]);
+	ASSERT_EQ("content", internal::readFile(Name));
+	ASSERT_EQ(0, report.queueHighWaterMark);
+}
+
+TEST_F(ExtractToDirectoryTests,
+ExtractToDirectoryWritesNestedArchiveAsFileEvenWhenRecursive) {
+	const std::string Name{"ar-extract-to-directory-nested-test.a"};
+	RemoveFileOnDestruction remover{Name};
+	const std::string Nested{
+		"!<arch>\n"
+		"inner.o/        0           0     0     644     5         `\n"
+		"inner\n"
+	};
+	ExtractionOptions options;
+	options.recursive = true;
+
+	auto report = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              39        `\n"
+			"ar-extract-to-directory-nested-test.a/\n\n"
+			"/0              0           0     0     644     74        `\n" +
+			Nested
+		,
+			"archive.a"
+		),
+		".",
+		options
+	);
+
+	ASSERT_EQ(1, report.fileNames.size());
+	ASSERT_EQ(Name, report.fileNames[0]);
+	ASSERT_EQ(Nested, internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+PipelinedExtractToDirectoryWritesFilesAndReportsQueue) {
+	const std::string Name{"ar-extract-to-directory-pipelined-test.txt"};
+	RemoveFileOnDestruction remover{Name};
+	ExtractionOptions options;
+	options.pipelined = true;
+	options.queueCapacity = 4;
+
+	auto report = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              44        `\n"
+			"ar-extract-to-directory-pipelined-test.txt/\n"
+			"/0              0           0     0     644     7         `\n"
+			"content\n"
+		,
+			"archive.a"
+		),
+		".",
+		options
+	);
+
+	ASSERT_EQ(1, report.fileNames.size());
+	ASSERT_EQ("content", internal::readFile(Name));
+	ASSERT_EQ(4, report.queueCapacity);
+	ASSERT_EQ(1, report.queueHighWaterMark);
+}
+
+TEST_F(ExtractToDirectoryTests,
+ExtractToDirectoryWithBatchedWritesWritesFiles) {
+	const std::string Name{"ar-extract-to-directory-batched-test.txt"};
+	RemoveFileOnDestruction remover{Name};
+	ExtractionOptions options;
+	options.batchedWrites = true;
+
+	auto report = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              39        `\n"
+			"ar-extract-to-directory-batched-test.txt/\n"
+			"/0              0           0     0     644     7         `\n"
+			"content\n"
+		,
+			"archive.a"
+		),
+		".",
+		options
+	);
+
+	ASSERT_EQ(1, report.fileNames.size());
+	ASSERT_EQ("content", internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+PipelinedExtractToDirectoryWithBatchedWritesWritesFiles) {
+	const std::string Name{"ar-extract-to-directory-batched-test.txt"};
+	RemoveFileOnDestruction remover{Name};
+	ExtractionOptions options;
+	options.pipelined = true;
+	options.batchedWrites = true;
+
+	auto report = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              39        `\n"
+			"ar-extract-to-directory-batched-test.txt/\n"
+			"/0              0           0     0     644     7         `\n"
+			"content\n"
+			"/0              0           0     0     644     8         `\n"
+			"content2"
+		,
+			"archive.a"
+		),
+		".",
+		options
+	);
+
+	ASSERT_EQ(2, report.fileNames.size());
+	ASSERT_EQ("content2", internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+ExtractToDirectoryWithMemoryBudgetWritesFilesStraightFromArchive) {
+	const std::string Name{"ar-extract-to-directory-budget-test.txt"};
+	RemoveFileOnDestruction remover{Name};
+	auto tmpFile = TmpFile::createWithContent(
+		"!<arch>\n"
+		"//                                              39        `\n"
+		"ar-extract-to-directory-budget-test.txt/\n"
+		"/0              0           0     0     644     7         `\n"
+		"content\n"
+	);
+	ExtractionOptions options;
+	options.memoryBudget = 1;
+
+	auto report = extractToDirectory(File::fromFilesystem(tmpFile->getPath()),
+		".", options);
+
+	ASSERT_EQ(1, report.fileNames.size());
+	ASSERT_EQ("content", internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+IncrementalExtractionWritesOnlyFilesThatAreNotUpToDate) {
+	const std::string Name{"ar-incremental-tst.txt"};
+	RemoveFileOnDestruction remover{Name};
+	auto tmpFile = TmpFile::createWithContent(
+		"!<arch>\n"
+		"//                                              24        `\n"
+		"ar-incremental-tst.txt/\n"
+		"/0              1445412357  0     0     644     7         `\n"
+		"content\n"
+	);
+	ExtractionOptions options;
+	options.incremental = true;
+
+	auto report1 = extractToDirectory(File::fromFilesystem(tmpFile->getPath()),
+		".", options);
+	auto report2 = extractToDirectory(File::fromFilesystem(tmpFile->getPath()),
+		".", options);
+	internal::writeFile(Name, "CONTENT");
+	internal::setFileModificationTime(Name, 1445412357);
+	auto report3 = extractToDirectory(File::fromFilesystem(tmpFile->getPath()),
+		".", options);
+
+	ASSERT_EQ(1, report1.fileNames.size());
+	ASSERT_EQ(0, report1.unchangedFileCount);
+	ASSERT_EQ(1, report2.fileNames.size());
+	ASSERT_EQ(1, report2.unchangedFileCount);
+	ASSERT_EQ(1, report3.unchangedFileCount);
+	ASSERT_EQ("CONTENT", internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+IncrementalExtractionComparingContentRewritesChangedFiles) {
+	const std::string Name{"ar-incremental-tst.txt"};
+	RemoveFileOnDestruction remover{Name};
+	internal::writeFile(Name, "CONTENT");
+	internal::setFileModificationTime(Name, 1445412357);
+	ExtractionOptions options;
+	options.incremental = true;
+	options.compareContent = true;
+
+	auto report = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              24        `\n"
+			"ar-incremental-tst.txt/\n"
+			"/0              1445412357  0     0     644     7         `\n"
+			"content\n"
+		,
+			"archive.a"
+		),
+		".",
+		options
+	);
+
+	ASSERT_EQ(0, report.unchangedFileCount);
+	ASSERT_EQ("content", internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+IncrementalExtractionComparesContentOfMembersWithZeroTimestamp) {
+	const std::string Name{"ar-incremental-tst.txt"};
+	RemoveFileOnDestruction remover{Name};
+	ExtractionOptions options;
+	options.incremental = true;
+
+	auto report1 = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              24        `\n"
+			"ar-incremental-tst.txt/\n"
+			"/0              0           0     0     644     4         `\n"
+			"AAAA"
+		,
+			"archive1.a"
+		),
+		".",
+		options
+	);
+	auto report2 = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              24        `\n"
+			"ar-incremental-tst.txt/\n"
+			"/0              0           0     0     644     4         `\n"
+			"BBBB"
+		,
+			"archive2.a"
+		),
+		".",
+		options
+	);
+	auto report3 = extractToDirectory(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"//                                              24        `\n"
+			"ar-incremental-tst.txt/\n"
+			"/0              0           0     0     644     4         `\n"
+			"BBBB"
+		,
+			"archive2.a"
+		),
+		".",
+		options
+	);
+
+	ASSERT_EQ(0, report1.unchangedFileCount);
+	ASSERT_EQ(0, report2.unchangedFileCount);
+	ASSERT_EQ(1, report3.unchangedFileCount);
+	ASSERT_EQ("BBBB", internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+ExtractToDirectoryFromSourceInMemoryWritesFiles) {
+	const std::string Name{"ar-extract-to-directory-src-test.txt"};
+	RemoveFileOnDestruction remover{Name};
+
+	auto report = extractToDirectory(
+		ByteSource::fromString(
+			"!<arch>\n"
+			"//                                              38        `\n"
+			"ar-extract-to-directory-src-test.txt/\n"
+			"/0              0           0     0     644     7         `\n"
+			"content\n"
+		),
+		"."
+	);
+
+	ASSERT_EQ(1, report.fileNames.size());
+	ASSERT_EQ("content", internal::readFile(Name));
+}
+
+TEST_F(ExtractToDirectoryTests,
+ExtractToDirectoryFromCompressedFileWritesFiles) {
+	if (!canCompressByGzip()) {
+		GTEST_SKIP() << "gzip is not supported by this build";
+	}
+	const std::string Name{"ar-extract-to-directory-gzip-tests.txt"};
+	RemoveFileOnDestruction remover{Name};
+	auto tmpFile = TmpFile::createWithContent(compressByGzip(
+		"!<arch>\n"
+		"//                                              39        `\n"
+		"ar-extract-to-directory-gzip-tests.txt/\n"
+		"/0              0           0     0     644     7         `\n"
+		"content\n"
+	));
+
+	auto report = extractToDirectory(
+		ByteSource::fromCompressedFile(tmpFile->getPath()),
+		"."
+	);
+
+	ASSERT_EQ(1, report.fileNames.size());
+	ASSERT_EQ("content", internal::readFile(Name));
+}
+
 } // namespace tests
 } // namespace ar
@@ -5,14 +5,47 @@
 /// @brief     Tests for the @c file module.
 ///
 
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "ar/exceptions.h"
 #include "ar/file.h"
 #include "ar/internal/utilities/os.h"
 
 namespace ar {
 namespace tests {
 
+namespace {
+
+///
+/// File implementing only the functions that every file has to implement.
+///
+class MinimalFile: public File {
+public:
+	/// Number of calls of getContent().
+	std::size_t contentCalls = 0;
+
+public:
+	virtual std::string getName() const override {
+		return "file.txt";
+	}
+
+	virtual std::string getContent() override {
+		++contentCalls;
+		return "content";
+	}
+
+	virtual void saveCopyTo(const std::string&) override {}
+
+	virtual void saveCopyTo(const std::string&, const std::string&) override {}
+};
+
+} // anonymous namespace
+
 ///
 /// Tests for File.
 ///
@@ -26,6 +59,68 @@ FromContentWithNameReturnsFileWithCorrectContentAndName) {
 	ASSERT_EQ("file.txt", file->getName());
 }
 
+TEST_F(FileTests,
+FromContentWithNameReturnsFileWithCorrectContentAndNameViews) {
+	auto file = File::fromContentWithName("content", "file.txt");
+
+	ASSERT_EQ("content", file->getContentView());
+	ASSERT_EQ("file.txt", file->getNameView());
+}
+
+TEST_F(FileTests,
+DefaultViewsReturnNameAndContentOfFile) {
+	MinimalFile file;
+
+	ASSERT_EQ("file.txt", file.getNameView());
+	ASSERT_EQ("content", file.getContentView());
+}
+
+TEST_F(FileTests,
+DefaultContentViewGetsContentOnlyOnce) {
+	MinimalFile file;
+
+	const auto view = file.getContentView();
+
+	ASSERT_EQ(view.data(), file.getContentView().data());
+	ASSERT_EQ(1, file.contentCalls);
+}
+
+TEST_F(FileTests,
+DefaultViewsCanBeObtainedFromMultipleThreadsAtOnce) {
+	const std::size_t ThreadCount = 4;
+	MinimalFile file;
+	const File& constFile = file;
+	std::vector<const char*> names(ThreadCount);
+	std::vector<const char*> contents(ThreadCount);
+
+	std::vector<std::thread> threads;
+	for (std::size_t j = 0; j < ThreadCount; ++j) {
+		threads.emplace_back([&, j]() {
+			names[j] = constFile.getNameView().data();
+			contents[j] = file.getContentView().data();
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	for (std::size_t j = 0; j < ThreadCount; ++j) {
+		ASSERT_EQ(names[0], names[j]);
+		ASSERT_EQ(contents[0], contents[j]);
+	}
+	ASSERT_EQ(1, file.contentCalls);
+}
+
+TEST_F(FileTests,
+FromContentWithNameTakesOverMovedContent) {
+	std::string content(1024, 'x');
+	const auto data = content.data();
+
+	auto file = File::fromContentWithName(std::move(content), "file.txt");
+
+	ASSERT_EQ(data, file->getContentView().data());
+}
+
 TEST_F(FileTests,
 FromFilesystemReturnsFileWithCorrectName) {
 #ifdef AR_OS_WINDOWS
@@ -50,6 +145,48 @@ FromFilesystemWithOtherNameReturnsFileWithCorrectName) {
 	ASSERT_EQ("other.txt", file->getName());
 }
 
+TEST_F(FileTests,
+ForEachChunkPassesViewsOfContentInChunksOfGivenSize) {
+	auto file = File::fromContentWithName("0123456789", "file.txt");
+	std::vector<std::string> chunks;
+
+	file->forEachChunk(4, [&](std::string_view chunk) {
+		ASSERT_GE(chunk.data(), file->getContentView().data());
+		chunks.emplace_back(chunk);
+	});
+
+	ASSERT_EQ(std::vector<std::string>({"0123", "4567", "89"}), chunks);
+}
+
+TEST_F(FileTests,
+ForEachChunkDoesNotCallCallbackForEmptyFile) {
+	auto file = File::fromContentWithName("", "file.txt");
+	auto called = false;
+
+	file->forEachChunk(4, [&](std::string_view) { called = true; });
+
+	ASSERT_FALSE(called);
+}
+
+TEST_F(FileTests,
+ForEachChunkThrowsErrorForZeroChunkSize) {
+	auto file = File::fromContentWithName("content", "file.txt");
+
+	ASSERT_THROW(file->forEachChunk(0, [](std::string_view) {}), Error);
+}
+
+TEST_F(FileTests,
+ReadContentAtCopiesRequestedPartOfContent) {
+	auto file = File::fromContentWithName("0123456789", "file.txt");
+	char buffer[4];
+
+	ASSERT_EQ(4, file->readContentAt(2, buffer, 4));
+	ASSERT_EQ("2345", std::string(buffer, 4));
+	ASSERT_EQ(2, file->readContentAt(8, buffer, 4));
+	ASSERT_EQ("89", std::string(buffer, 2));
+	ASSERT_EQ(0, file->readContentAt(10, buffer, 4));
+}
+
 ///
 /// Tests for Files.
 ///
@@ -100,6 +237,15 @@ ContainerIsNoLongerEmptyAfterAppendingFileIntoEmptyContainer) {
 	ASSERT_FALSE(files.empty());
 }
 
+TEST_F(FilesTests,
+ReserveDoesNotChangeSize) {
+	Files files;
+
+	files.reserve(10);
+
+	ASSERT_TRUE(files.empty());
+}
+
 TEST_F(FilesTests,
 FrontReturnsReferenceToFirstFile) {
 	Files files;
@@ -0,0 +1,249 @@
+///
+/// @file      ar/generation_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c generation module.
+///
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/file.h"
+#include "ar/generation.h"
+#include "ar/internal/archive_format.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/member_table.h"
+#include "ar/test_utilities/generated_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::internal;
+
+namespace ar {
+namespace tests {
+
+namespace {
+
+///
+/// Returns the members of the given content of an archive.
+///
+MemberTable membersOf(const std::string& archive) {
+	return scanMembers(File::fromContentWithName(archive, "archive.a"));
+}
+
+} // anonymous namespace
+
+///
+/// Tests for generateArchive().
+///
+class GenerateArchiveTests: public testing::Test {};
+
+TEST_F(GenerateArchiveTests,
+GeneratedArchiveHasRequestedNumberOfMembersOfSizesInRange) {
+	GenerationOptions options;
+	options.memberCount = 500;
+	options.minMemberSize = 10;
+	options.maxMemberSize = 20;
+
+	std::ostringstream output;
+	const auto report = generateArchive(output, options);
+
+	const auto archive = output.str();
+	auto files = extract(File::fromContentWithName(archive, "archive.a"));
+	ASSERT_EQ(500, files.size());
+	std::set<std::string> names;
+	std::uint64_t contentSize = 0;
+	for (const auto& file : files) {
+		ASSERT_LE(10, file->getContent().size());
+		ASSERT_GE(20, file->getContent().size());
+		names.insert(file->getName());
+		contentSize += file->getContent().size();
+	}
+	ASSERT_EQ(500, names.size());
+	ASSERT_EQ(500, report.memberCount);
+	ASSERT_EQ(contentSize, report.contentSize);
+	ASSERT_EQ(archive.size(), report.archiveSize);
+}
+
+TEST_F(GenerateArchiveTests,
+GeneratedArchiveHasMembersOfOddSizesThatArePadded) {
+	GenerationOptions options;
+	options.memberCount = 100;
+
+	const auto members = membersOf(generateArchiveContent(options));
+
+	std::size_t oddSizeCount = 0;
+	for (MemberTable::size_type j = 0; j < members.size(); ++j) {
+		oddSizeCount += members.getSize(j) % 2;
+	}
+	ASSERT_LT(0, oddSizeCount);
+	ASSERT_GT(members.size(), oddSizeCount);
+}
+
+TEST_F(GenerateArchiveTests,
+SameSeedAndOptionsGiveSameArchive) {
+	GenerationOptions options;
+	options.seed = 42;
+	options.longNameCount = 10;
+	options.symbolCount = 20;
+
+	ASSERT_EQ(generateArchiveContent(options),
+		generateArchiveContent(options));
+}
+
+TEST_F(GenerateArchiveTests,
+DifferentSeedsGiveDifferentArchives) {
+	GenerationOptions options1;
+	options1.seed = 1;
+	GenerationOptions options2;
+	options2.seed = 2;
+
+	ASSERT_NE(generateArchiveContent(options1),
+		generateArchiveContent(options2));
+}
+
+TEST_F(GenerateArchiveTests,
+GeneratedArchiveHasRequestedNumberOfLongNamesOfRequestedSize) {
+	GenerationOptions options;
+	options.memberCount = 100;
+	options.longNameCount = 30;
+	options.longNameSize = 40;
+
+	const auto archive = generateArchiveContent(options);
+
+	const auto members = membersOf(archive);
+	std::size_t longNameCount = 0;
+	for (MemberTable::size_type j = 0; j < members.size(); ++j) {
+		if (members.getName(j).size() > MaxShortNameSize) {
+			ASSERT_EQ(40, members.getName(j).size());
+			++longNameCount;
+		}
+	}
+	ASSERT_EQ(30, longNameCount);
+	ASSERT_EQ("//", archive.substr(ArchiveMagicString.size(), 2));
+}
+
+TEST_F(GenerateArchiveTests,
+SymbolsInSymbolTableReferToHeadersOfMembersSpreadEvenly) {
+	GenerationOptions options;
+	options.memberCount = 10;
+	options.longNameCount = 3;
+	options.symbolCount = 25;
+
+	const auto archive = generateArchiveContent(options);
+
+	const auto members = membersOf(archive);
+	ASSERT_EQ("/ ", archive.substr(ArchiveMagicString.size(), 2));
+	const auto symbols = parseSymbolTable(
+		std::string_view{archive}.substr(ArchiveMagicString.size() + 60),
+		false);
+	ASSERT_EQ(25, symbols.size());
+	for (std::size_t k = 0; k < symbols.size(); ++k) {
+		ASSERT_EQ("symbol_" + std::to_string(k), symbols[k].name);
+		ASSERT_EQ(members.getOffset(k * 10 / 25) - 60,
+			symbols[k].headerOffset);
+	}
+}
+
+TEST_F(GenerateArchiveTests,
+GeneratedArchiveHas64BitSymbolTableWhenRequested) {
+	GenerationOptions options;
+	options.memberCount = 10;
+	options.symbolCount = 5;
+	options.sym64 = true;
+
+	std::ostringstream output;
+	const auto report = generateArchive(output, options);
+
+	const auto archive = output.str();
+	ASSERT_TRUE(report.sym64);
+	ASSERT_EQ("/SYM64/", archive.substr(ArchiveMagicString.size(), 7));
+	const auto symbols = parseSymbolTable(
+		std::string_view{archive}.substr(ArchiveMagicString.size() + 60),
+		true);
+	const auto members = membersOf(archive);
+	ASSERT_EQ(5, symbols.size());
+	ASSERT_EQ(members.getOffset(8) - 60, symbols[4].headerOffset);
+}
+
+TEST_F(GenerateArchiveTests,
+GeneratedArchiveHasNoSymbolTableWhenThereAreNoSymbols) {
+	GenerationOptions options;
+	options.memberCount = 3;
+
+	const auto archive = generateArchiveContent(options);
+
+	ASSERT_EQ("m0.o/", archive.substr(ArchiveMagicString.size(), 5));
+}
+
+TEST_F(GenerateArchiveTests,
+GenerateArchiveIntoFileWritesSameArchiveAsIntoStream) {
+	GenerationOptions options;
+	options.longNameCount = 5;
+	options.symbolCount = 5;
+
+	auto tmpFile = generateArchiveFile(options);
+
+	ASSERT_EQ(generateArchiveContent(options),
+		readFile(tmpFile->getPath()));
+}
+
+TEST_F(GenerateArchiveTests,
+GenerateArchiveGeneratesEmptyArchiveWhenThereAreNoMembers) {
+	GenerationOptions options;
+	options.memberCount = 0;
+
+	ASSERT_EQ("!<arch>\n", generateArchiveContent(options));
+}
+
+TEST_F(GenerateArchiveTests,
+GenerateArchiveThrowsErrorWhenSmallestSizeIsGreaterThanLargestSize) {
+	GenerationOptions options;
+	options.minMemberSize = 2;
+	options.maxMemberSize = 1;
+
+	ASSERT_THROW(generateArchiveContent(options), Error);
+}
+
+TEST_F(GenerateArchiveTests,
+GenerateArchiveThrowsErrorWhenLargestSizeDoesNotFitIntoHeader) {
+	GenerationOptions options;
+	options.maxMemberSize = 10000000000;
+
+	ASSERT_THROW(generateArchiveContent(options), Error);
+}
+
+TEST_F(GenerateArchiveTests,
+GenerateArchiveThrowsErrorWhenLongNamesAreNotLong) {
+	GenerationOptions options;
+	options.longNameCount = 1;
+	options.longNameSize = 15;
+
+	ASSERT_THROW(generateArchiveContent(options), Error);
+}
+
+TEST_F(GenerateArchiveTests,
+GenerateArchiveThrowsErrorWhenThereAreMoreLongNamesThanMembers) {
+	GenerationOptions options;
+	options.memberCount = 1;
+	options.longNameCount = 2;
+
+	ASSERT_THROW(generateArchiveContent(options), Error);
+}
+
+TEST_F(GenerateArchiveTests,
+GenerateArchiveThrowsIOErrorWhenFileCannotBeOpened) {
+	ASSERT_THROW(
+		generateArchive("/nonexistent-directory/archive.a",
+			GenerationOptions()),
+		IOError
+	);
+}
+
+} // namespace tests
+} // namespace ar
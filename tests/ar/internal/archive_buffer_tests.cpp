@@ -0,0 +1,89 @@
+///
+/// @file      ar/internal/archive_buffer_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c archive_buffer module.
+///
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/byte_source.h"
+#include "ar/internal/archive_buffer.h"
+#include "ar/test_utilities/tmp_file.h"
+#include "ar/test_utilities/unmapped_byte_source.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for ArchiveBuffer.
+///
+class ArchiveBufferTests: public testing::Test {};
+
+TEST_F(ArchiveBufferTests,
+BufferFromContentProvidesContentAndHasNoPath) {
+	auto buffer = ArchiveBuffer::fromContent("content");
+
+	ASSERT_EQ("content", buffer->getContent());
+	ASSERT_EQ("", buffer->getPath());
+}
+
+TEST_F(ArchiveBufferTests,
+BufferFromFilesystemProvidesContentAndPath) {
+	auto tmpFile = TmpFile::createWithContent("content");
+
+	auto buffer = ArchiveBuffer::fromFilesystem(tmpFile->getPath());
+
+	ASSERT_EQ("content", buffer->getContent());
+	ASSERT_EQ(tmpFile->getPath(), buffer->getPath());
+}
+
+TEST_F(ArchiveBufferTests,
+BufferFromViewProvidesViewedContentWithoutCopyingIt) {
+	const std::string content{"content"};
+
+	auto buffer = ArchiveBuffer::fromView(content);
+
+	ASSERT_EQ(content.data(), buffer->getContent().data());
+	ASSERT_EQ("content", buffer->getContent());
+	ASSERT_EQ("", buffer->getPath());
+}
+
+TEST_F(ArchiveBufferTests,
+AssignViewPointsBufferToOtherContent) {
+	const std::string content1{"content1"};
+	const std::string content2{"content2"};
+	auto buffer = ArchiveBuffer::fromView(content1);
+
+	buffer->assignView(content2);
+
+	ASSERT_EQ(content2.data(), buffer->getContent().data());
+}
+
+TEST_F(ArchiveBufferTests,
+BufferFromByteSourceInMemoryViewsBytesOfSourceWithoutCopyingThem) {
+	auto source = ByteSource::fromString("content");
+
+	auto buffer = ArchiveBuffer::fromByteSource(source);
+
+	ASSERT_EQ(source->data(), buffer->getContent().data());
+	ASSERT_EQ("content", buffer->getContent());
+}
+
+TEST_F(ArchiveBufferTests,
+BufferFromByteSourceNotInMemoryHoldsReadBytes) {
+	auto buffer = ArchiveBuffer::fromByteSource(
+		UnmappedByteSource::createWithContent("content")
+	);
+
+	ASSERT_EQ("content", buffer->getContent());
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,115 @@
+///
+/// @file      ar/internal/archive_format_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c archive_format module.
+///
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/internal/archive_format.h"
+
+using namespace std::literals::string_literals;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for the formatting of headers.
+///
+class HeaderFormattingTests: public testing::Test {};
+
+TEST_F(HeaderFormattingTests,
+FormatMemberHeaderReturnsHeaderWithGivenFields) {
+	ASSERT_EQ(
+		"test.txt/       1500000000  1000  100   100755  20        `\n",
+		formatMemberHeader("test.txt/", 1500000000, 1000, 100, 0100755, 20)
+	);
+}
+
+TEST_F(HeaderFormattingTests,
+FormatMemberHeaderThrowsErrorWhenValueDoesNotFitIntoField) {
+	ASSERT_THROW(formatMemberHeader("test.txt/", 0, 1234567, 0, 0644, 20),
+		Error);
+}
+
+TEST_F(HeaderFormattingTests,
+FormatNameTableHeaderReturnsHeaderWithOnlyNameAndSize) {
+	ASSERT_EQ(
+		"//                                              42        `\n",
+		formatNameTableHeader(42)
+	);
+}
+
+TEST_F(HeaderFormattingTests,
+EnsureIsValidMemberNameThrowsErrorForInvalidNames) {
+	ASSERT_NO_THROW(ensureIsValidMemberName("file.o"));
+	ASSERT_THROW(ensureIsValidMemberName(""), Error);
+	ASSERT_THROW(ensureIsValidMemberName("dir/file.o"), Error);
+	ASSERT_THROW(ensureIsValidMemberName("file\n.o"), Error);
+}
+
+///
+/// Tests for symbol tables.
+///
+class SymbolTableTests: public testing::Test {};
+
+TEST_F(SymbolTableTests,
+IsSymbolTableNameReturnsTrueOnlyForNamesOfSymbolTables) {
+	ASSERT_TRUE(isSymbolTableName("/               "));
+	ASSERT_TRUE(isSymbolTableName("/SYM64/         "));
+	ASSERT_FALSE(isSymbolTableName("//              "));
+	ASSERT_FALSE(isSymbolTableName("/42             "));
+	ASSERT_FALSE(isSymbolTableName("file.o/         "));
+}
+
+TEST_F(SymbolTableTests,
+FormatSymbolTableReturnsBigEndianOffsetsFollowedByNames) {
+	const auto content = formatSymbolTable({{"f", 0x102}, {"gh", 0x304}},
+		false);
+
+	ASSERT_EQ("\0\0\0\x02\0\0\x01\x02\0\0\x03\x04" "f\0gh\0"s, content);
+}
+
+TEST_F(SymbolTableTests,
+ParseSymbolTableReturnsSymbolsOfFormattedTable) {
+	for (bool is64Bit : {false, true}) {
+		const auto symbols = parseSymbolTable(
+			formatSymbolTable({{"f", 68}, {"gh", 1234567}}, is64Bit), is64Bit);
+
+		ASSERT_EQ(2, symbols.size());
+		ASSERT_EQ("f", symbols[0].name);
+		ASSERT_EQ(68, symbols[0].headerOffset);
+		ASSERT_EQ("gh", symbols[1].name);
+		ASSERT_EQ(1234567, symbols[1].headerOffset);
+	}
+}
+
+TEST_F(SymbolTableTests,
+ParseSymbolTableThrowsInvalidArchiveErrorWhenNamesAreMissing) {
+	ASSERT_THROW(parseSymbolTable("\0\0\0\x01\0\0\0\x44"s, false),
+		InvalidArchiveError);
+}
+
+TEST_F(SymbolTableTests,
+FormatSymbolTableThrowsErrorWhenOffsetDoesNotFitIntoThirtyTwoBits) {
+	ASSERT_THROW(formatSymbolTable({{"f", 0x100000000}}, false), Error);
+	ASSERT_NO_THROW(formatSymbolTable({{"f", 0x100000000}}, true));
+}
+
+TEST_F(SymbolTableTests,
+SymbolTableSizeIncludesHeaderAndPadding) {
+	// 60 + 4 * 3 + 5, padded to an even size.
+	ASSERT_EQ(78, symbolTableSize(2, 5, false));
+	ASSERT_EQ(78,
+		60 + formatSymbolTable({{"f", 0}, {"gh", 0}}, false).size() + 1);
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,159 @@
+///
+/// @file      ar/internal/boundary_discovery_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c boundary_discovery module.
+///
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/boundary_discovery.h"
+#include "ar/internal/utilities/thread_pool.h"
+
+using namespace std::literals::string_literals;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+namespace {
+
+const auto HeaderOfA =
+	"a.txt/          0           0     0     644     3         `\n"s;
+const auto HeaderOfB =
+	"b.txt/          0           0     0     644     2         `\n"s;
+
+} // anonymous namespace
+
+///
+/// Tests for isHeaderCandidateAt().
+///
+class IsHeaderCandidateAtTests: public testing::Test {};
+
+TEST_F(IsHeaderCandidateAtTests,
+ReturnsTrueAndSizeForValidHeader) {
+	std::size_t size = 0;
+
+	ASSERT_TRUE(isHeaderCandidateAt(HeaderOfA, 0, size));
+	ASSERT_EQ(3, size);
+}
+
+TEST_F(IsHeaderCandidateAtTests,
+ReturnsFalseWhenTerminatorIsMissing) {
+	auto header = HeaderOfA;
+	header[58] = ' ';
+	std::size_t size;
+
+	ASSERT_FALSE(isHeaderCandidateAt(header, 0, size));
+}
+
+TEST_F(IsHeaderCandidateAtTests,
+ReturnsFalseWhenSizeIsNotNumber) {
+	auto header = HeaderOfA;
+	header[48] = 'x';
+	std::size_t size;
+
+	ASSERT_FALSE(isHeaderCandidateAt(header, 0, size));
+}
+
+TEST_F(IsHeaderCandidateAtTests,
+ReturnsFalseWhenThereIsNotEnoughData) {
+	std::size_t size;
+
+	ASSERT_FALSE(isHeaderCandidateAt(HeaderOfA.substr(0, 59), 0, size));
+}
+
+///
+/// Tests for findHeaderCandidates().
+///
+class FindHeaderCandidatesTests: public testing::Test {};
+
+TEST_F(FindHeaderCandidatesTests,
+FindsAllHeadersInGivenRange) {
+	const auto content = HeaderOfA + "aaa\n"s + HeaderOfB + "bb"s;
+
+	auto candidates = findHeaderCandidates(content, 0, content.size());
+
+	ASSERT_EQ(2, candidates.size());
+	ASSERT_EQ(0, candidates[0].offset);
+	ASSERT_EQ(3, candidates[0].size);
+	ASSERT_EQ(64, candidates[1].offset);
+	ASSERT_EQ(2, candidates[1].size);
+}
+
+TEST_F(FindHeaderCandidatesTests,
+IgnoresHeadersStartingOutsideOfGivenRange) {
+	const auto content = HeaderOfA + "aaa\n"s + HeaderOfB + "bb"s;
+
+	auto candidates = findHeaderCandidates(content, 1, 64);
+
+	ASSERT_TRUE(candidates.empty());
+}
+
+TEST_F(FindHeaderCandidatesTests,
+ParallelScanFindsSameCandidatesAsSerialScan) {
+	std::string content;
+	for (int j = 0; j < 5000; ++j) {
+		content += HeaderOfA + "aaa\n"s;
+	}
+	ThreadPool pool{3};
+
+	auto candidates = findHeaderCandidatesInParallel(content, 0, &pool);
+
+	ASSERT_EQ(5000, candidates.size());
+	for (std::size_t j = 0; j < candidates.size(); ++j) {
+		ASSERT_EQ(j * 64, candidates[j].offset);
+	}
+}
+
+///
+/// Tests for stitchHeaderChain().
+///
+class StitchHeaderChainTests: public testing::Test {};
+
+TEST_F(StitchHeaderChainTests,
+ReturnsTrueAndChainWhenCandidatesCoverWholeArchive) {
+	const auto content = HeaderOfA + "aaa\n"s + HeaderOfB + "bb"s;
+	const auto candidates = findHeaderCandidates(content, 0, content.size());
+	HeaderCandidates chain;
+
+	ASSERT_TRUE(stitchHeaderChain(content, 0, candidates, chain));
+	ASSERT_EQ(2, chain.size());
+}
+
+TEST_F(StitchHeaderChainTests,
+SkipsFalsePositivesInContentOfMembers) {
+	// The content of the first member looks like a header.
+	const auto fakeHeader = HeaderOfB;
+	const auto content =
+		"a.txt/          0           0     0     644     60        `\n"s +
+		fakeHeader + HeaderOfB + "bb"s;
+	const auto candidates = findHeaderCandidates(content, 0, content.size());
+	HeaderCandidates chain;
+
+	ASSERT_TRUE(stitchHeaderChain(content, 0, candidates, chain));
+	ASSERT_EQ(2, chain.size());
+	ASSERT_EQ(120, chain[1].offset);
+}
+
+TEST_F(StitchHeaderChainTests,
+ReturnsFalseWhenChainIsBroken) {
+	const auto content = HeaderOfA + "aaaa"s + HeaderOfB + "bb"s;
+	const auto candidates = findHeaderCandidates(content, 0, content.size());
+	HeaderCandidates chain;
+
+	ASSERT_FALSE(stitchHeaderChain(content, 0, candidates, chain));
+}
+
+TEST_F(StitchHeaderChainTests,
+ReturnsFalseWhenLastMemberEndsPrematurely) {
+	const auto content = HeaderOfA + "aa"s;
+	const auto candidates = findHeaderCandidates(content, 0, content.size());
+	HeaderCandidates chain;
+
+	ASSERT_FALSE(stitchHeaderChain(content, 0, candidates, chain));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,144 @@
+///
+/// @file      ar/internal/byte_sources/decompressing_byte_source_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c decompressing_byte_source module.
+///
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/internal/byte_sources/decompressing_byte_source.h"
+#include "ar/test_utilities/compression.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for DecompressingByteSource.
+///
+class DecompressingByteSourceTests: public testing::Test {};
+
+TEST_F(DecompressingByteSourceTests,
+DetectFormatRecognizesMagicBytesOfGzipAndZstd) {
+	ASSERT_EQ(DecompressingByteSource::Format::Gzip,
+		DecompressingByteSource::detectFormat("\x1f\x8b\x08\x00"));
+	ASSERT_EQ(DecompressingByteSource::Format::Zstd,
+		DecompressingByteSource::detectFormat("\x28\xb5\x2f\xfd"));
+}
+
+TEST_F(DecompressingByteSourceTests,
+DetectFormatReturnsNothingForUncompressedContent) {
+	ASSERT_FALSE(DecompressingByteSource::detectFormat("!<arch>\n"));
+	ASSERT_FALSE(DecompressingByteSource::detectFormat(""));
+}
+
+TEST_F(DecompressingByteSourceTests,
+ConstructorThrowsErrorForUncompressedFile) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+
+	ASSERT_THROW(DecompressingByteSource{tmpFile->getPath()}, Error);
+}
+
+TEST_F(DecompressingByteSourceTests,
+ConstructorThrowsIOErrorWhenFileDoesNotExist) {
+	ASSERT_THROW(
+		DecompressingByteSource{"/nonexisting/path/archive.a.gz"},
+		IOError
+	);
+}
+
+///
+/// Tests for DecompressingByteSource reading gzip-compressed files.
+///
+class GzipDecompressingByteSourceTests: public testing::Test {
+protected:
+	virtual void SetUp() override;
+};
+
+void GzipDecompressingByteSourceTests::SetUp() {
+	if (!DecompressingByteSource::isSupported(
+			DecompressingByteSource::Format::Gzip) || !canCompressByGzip()) {
+		GTEST_SKIP() << "gzip is not supported by this build";
+	}
+}
+
+TEST_F(GzipDecompressingByteSourceTests,
+SourceProvidesDecompressedBytes) {
+	auto tmpFile = TmpFile::createWithContent(compressByGzip("0123456789"));
+
+	DecompressingByteSource source{tmpFile->getPath()};
+	char buffer[4] = {};
+
+	ASSERT_EQ(DecompressingByteSource::Format::Gzip, source.getFormat());
+	ASSERT_EQ(10, source.size());
+	ASSERT_EQ(nullptr, source.data());
+	ASSERT_EQ(3, source.readAt(2, buffer, 3));
+	ASSERT_EQ("234", std::string(buffer, 3));
+	ASSERT_EQ(2, source.readAt(8, buffer, 4));
+	ASSERT_EQ(0, source.readAt(10, buffer, 4));
+}
+
+TEST_F(GzipDecompressingByteSourceTests,
+ReadAtReadsBytesAcrossChunks) {
+	std::string content;
+	for (std::size_t j = 0; content.size() < 3 *
+			DecompressingByteSource::ChunkSize; ++j) {
+		content += std::to_string(j);
+	}
+	auto tmpFile = TmpFile::createWithContent(compressByGzip(content));
+	DecompressingByteSource source{tmpFile->getPath()};
+	const auto offset = DecompressingByteSource::ChunkSize - 5;
+	std::vector<char> buffer(DecompressingByteSource::ChunkSize + 10);
+
+	ASSERT_EQ(buffer.size(), source.readAt(offset, buffer.data(),
+		buffer.size()));
+	ASSERT_EQ(content.substr(offset, buffer.size()),
+		std::string(buffer.data(), buffer.size()));
+	ASSERT_EQ(content.size(), source.size());
+}
+
+TEST_F(GzipDecompressingByteSourceTests,
+SourceDecompressesConcatenatedMembers) {
+	auto tmpFile = TmpFile::createWithContent(
+		compressByGzip("01234") + compressByGzip("56789"));
+
+	DecompressingByteSource source{tmpFile->getPath()};
+	char buffer[10] = {};
+
+	ASSERT_EQ(10, source.readAt(0, buffer, 10));
+	ASSERT_EQ("0123456789", std::string(buffer, 10));
+}
+
+TEST_F(GzipDecompressingByteSourceTests,
+SizeThrowsIOErrorForTruncatedFile) {
+	const auto compressed = compressByGzip(std::string(1000, 'x'));
+	auto tmpFile = TmpFile::createWithContent(
+		compressed.substr(0, compressed.size() - 4));
+
+	DecompressingByteSource source{tmpFile->getPath()};
+
+	ASSERT_THROW(source.size(), IOError);
+}
+
+TEST_F(GzipDecompressingByteSourceTests,
+SourceCanBeDestroyedBeforeDecompressionFinishes) {
+	auto tmpFile = TmpFile::createWithContent(
+		compressByGzip(std::string(64 * 1024 * 1024, 'x')));
+
+	DecompressingByteSource source{tmpFile->getPath()};
+	char buffer[1] = {};
+
+	ASSERT_EQ(1, source.readAt(0, buffer, 1));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
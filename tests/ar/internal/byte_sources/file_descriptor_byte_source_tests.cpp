@@ -0,0 +1,89 @@
+///
+/// @file      ar/internal/byte_sources/file_descriptor_byte_source_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c file_descriptor_byte_source module.
+///
+
+#include <string>
+
+#include <fcntl.h>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/internal/byte_sources/file_descriptor_byte_source.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/tmp_file.h"
+
+#ifdef AR_OS_WINDOWS
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for FileDescriptorByteSource.
+///
+class FileDescriptorByteSourceTests: public testing::Test {
+protected:
+	virtual void TearDown() override;
+
+	int openFile(const std::string& path);
+
+private:
+	/// Descriptor opened by openFile().
+	int fd = -1;
+};
+
+void FileDescriptorByteSourceTests::TearDown() {
+	if (fd >= 0) {
+		close(fd);
+	}
+}
+
+///
+/// Opens the given file for reading and closes it at the end of the test.
+///
+int FileDescriptorByteSourceTests::openFile(const std::string& path) {
+	fd = open(path.c_str(), O_RDONLY);
+	return fd;
+}
+
+TEST_F(FileDescriptorByteSourceTests,
+SourceProvidesSizeOfFileButNoBytesInMemory) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	FileDescriptorByteSource source{openFile(tmpFile->getPath())};
+
+	ASSERT_EQ(10, source.size());
+	ASSERT_EQ(nullptr, source.data());
+}
+
+TEST_F(FileDescriptorByteSourceTests,
+ReadAtReadsOnlyBytesUpToEndOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	FileDescriptorByteSource source{openFile(tmpFile->getPath())};
+	char buffer[4] = {};
+
+	ASSERT_EQ(3, source.readAt(1, buffer, 3));
+	ASSERT_EQ("123", std::string(buffer, 3));
+	ASSERT_EQ(2, source.readAt(8, buffer, 4));
+	ASSERT_EQ("89", std::string(buffer, 2));
+	ASSERT_EQ(0, source.readAt(10, buffer, 4));
+}
+
+TEST_F(FileDescriptorByteSourceTests,
+ConstructorThrowsIOErrorForInvalidDescriptor) {
+	ASSERT_THROW(FileDescriptorByteSource{-1}, IOError);
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,57 @@
+///
+/// @file      ar/internal/byte_sources/mapped_file_byte_source_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c mapped_file_byte_source module.
+///
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/byte_sources/mapped_file_byte_source.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for MappedFileByteSource.
+///
+class MappedFileByteSourceTests: public testing::Test {};
+
+TEST_F(MappedFileByteSourceTests,
+SourceProvidesSizeAndBytesOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	MappedFileByteSource source{tmpFile->getPath()};
+
+	ASSERT_EQ(10, source.size());
+	ASSERT_EQ("0123456789", std::string(source.data(), source.size()));
+}
+
+TEST_F(MappedFileByteSourceTests,
+ReadAtReadsOnlyBytesUpToEndOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	MappedFileByteSource source{tmpFile->getPath()};
+	char buffer[4] = {};
+
+	ASSERT_EQ(2, source.readAt(8, buffer, 4));
+	ASSERT_EQ("89", std::string(buffer, 2));
+}
+
+TEST_F(MappedFileByteSourceTests,
+SourceOfEmptyFileIsEmpty) {
+	auto tmpFile = TmpFile::createWithContent("");
+
+	MappedFileByteSource source{tmpFile->getPath()};
+
+	ASSERT_EQ(0, source.size());
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,56 @@
+///
+/// @file      ar/internal/byte_sources/string_byte_source_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c string_byte_source module.
+///
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/byte_sources/string_byte_source.h"
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for StringByteSource.
+///
+class StringByteSourceTests: public testing::Test {};
+
+TEST_F(StringByteSourceTests,
+SizeReturnsNumberOfBytes) {
+	StringByteSource source{"content"};
+
+	ASSERT_EQ(7, source.size());
+}
+
+TEST_F(StringByteSourceTests,
+ReadAtReadsRequestedBytes) {
+	StringByteSource source{"0123456789"};
+	char buffer[3] = {};
+
+	ASSERT_EQ(3, source.readAt(2, buffer, 3));
+	ASSERT_EQ("234", std::string(buffer, 3));
+}
+
+TEST_F(StringByteSourceTests,
+ReadAtReturnsZeroWhenOffsetIsPastEnd) {
+	StringByteSource source{"0123456789"};
+	char buffer[3] = {};
+
+	ASSERT_EQ(0, source.readAt(11, buffer, 3));
+}
+
+TEST_F(StringByteSourceTests,
+DataReturnsPointerToBytes) {
+	StringByteSource source{"content"};
+
+	ASSERT_EQ("content", std::string(source.data(), source.size()));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -5,12 +5,25 @@
 /// @brief     Tests for the @c extractor module.
 ///
 
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "ar/byte_source.h"
 #include "ar/exceptions.h"
 #include "ar/extraction.h"
 #include "ar/file.h"
 #include "ar/internal/extractor.h"
+#include "ar/internal/files/filesystem_range_file.h"
+#include "ar/internal/files/string_file.h"
+#include "ar/test_utilities/built_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+#include "ar/test_utilities/unmapped_byte_source.h"
+
+using namespace ar::tests;
 
 using namespace std::literals::string_literals;
 
@@ -25,6 +38,8 @@ class BaseExtractorTests: public testing::Test {
 protected:
 	static Files extractArchiveWithContent(
 		const std::string& content);
+	static Files extractArchiveWithContentInParallel(
+		const std::string& content);
 };
 
 ///
@@ -36,6 +51,17 @@ Files BaseExtractorTests::extractArchiveWithContent(
 	return extractor.extract(content);
 }
 
+///
+/// A helper method to extract the archive by using several threads.
+///
+Files BaseExtractorTests::extractArchiveWithContentInParallel(
+		const std::string& content) {
+	ExtractionOptions options;
+	options.threadCount = 4;
+	Extractor extractor;
+	return extractor.extract(content, options);
+}
+
 ///
 /// Common extraction tests for all formats.
 ///
@@ -58,6 +84,465 @@ ExtractThrowsInvalidArchiveErrorWhenMagicStringIsNotPresent) {
 	);
 }
 
+TEST_F(CommonExtractionTests,
+ScanReturnsMembersWithCorrectNamesOffsetsAndSizes) {
+	Extractor extractor;
+
+	auto members = extractor.scan(
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     2         `\n"s +
+		"aa"s +
+		"b.txt/          0           0     0     644     3         `\n"s +
+		"bbb"s
+	);
+
+	ASSERT_EQ(2, members.size());
+	ASSERT_EQ("a.txt", members[0].name);
+	ASSERT_EQ(68, members[0].offset);
+	ASSERT_EQ(2, members[0].size);
+	ASSERT_EQ("b.txt", members[1].name);
+	ASSERT_EQ(130, members[1].offset);
+	ASSERT_EQ(3, members[1].size);
+}
+
+TEST_F(CommonExtractionTests,
+ScanReturnsMembersWithCorrectMetadata) {
+	Extractor extractor;
+
+	auto members = extractor.scan(
+		"!<arch>\n"s +
+		"a.txt/          1445412357  1000  100   100755  2         `\n"s +
+		"aa"s
+	);
+
+	ASSERT_EQ(1, members.size());
+	ASSERT_EQ(1445412357, members[0].timestamp);
+	ASSERT_EQ(1000, members[0].ownerId);
+	ASSERT_EQ(100, members[0].groupId);
+	ASSERT_EQ(0100755, members[0].mode);
+}
+
+TEST_F(CommonExtractionTests,
+ScanThrowsInvalidArchiveErrorWhenFileModeIsNotOctal) {
+	ASSERT_THROW(
+		Extractor().scan(
+			"!<arch>\n"s +
+			"a.txt/          0           0     0     689     2         `\n"s +
+			"aa"s
+		),
+		InvalidArchiveError
+	);
+}
+
+TEST_F(CommonExtractionTests,
+ScanComputesChecksumsOfMembersOnlyWhenRequested) {
+	const auto content =
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     9         `\n"s +
+		"123456789\n"s +
+		"b.txt/          0           0     0     644     0         `\n"s;
+	ExtractionOptions options;
+	options.computeChecksums = true;
+
+	auto members = Extractor().scan(content, options);
+	auto membersWithoutChecksums = Extractor().scan(content);
+
+	ASSERT_EQ(2, members.size());
+	ASSERT_EQ(0xe3069283, members[0].checksum);
+	ASSERT_EQ(0, members[1].checksum);
+	ASSERT_EQ(0, membersWithoutChecksums[0].checksum);
+}
+
+TEST_F(CommonExtractionTests,
+SpeculativeScanComputesSameChecksumsAsSerialScan) {
+	const auto content =
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     9         `\n"s +
+		"123456789\n"s +
+		"b.txt/          0           0     0     644     2         `\n"s +
+		"bb"s;
+	ExtractionOptions options;
+	options.computeChecksums = true;
+	auto speculativeOptions = options;
+	speculativeOptions.threadCount = 2;
+	speculativeOptions.speculativeHeaderScan = true;
+
+	auto members = Extractor().scan(content, options);
+	auto speculativeMembers = Extractor().scan(content, speculativeOptions);
+
+	ASSERT_EQ(members[0].checksum, speculativeMembers[0].checksum);
+	ASSERT_EQ(members[1].checksum, speculativeMembers[1].checksum);
+}
+
+TEST_F(CommonExtractionTests,
+ScanIntoTableReturnsSameMembersAsScan) {
+	const auto content =
+		"!<arch>\n"s +
+		"a.txt/          1           2     3     644     2         `\n"s +
+		"aa"s +
+		"b.txt/          4           5     6     600     3         `\n"s +
+		"bbb\n"s;
+
+	auto members = Extractor().scan(content);
+	auto table = Extractor().scanIntoTable(
+		ArchiveBuffer::fromContent(content), ExtractionOptions());
+
+	ASSERT_EQ(members.size(), table.size());
+	for (std::size_t j = 0; j < members.size(); ++j) {
+		ASSERT_EQ(members[j].name, table.getName(j));
+		ASSERT_EQ(members[j].offset, table.getOffset(j));
+		ASSERT_EQ(members[j].size, table.getSize(j));
+		ASSERT_EQ(members[j].timestamp, table.getTimestamp(j));
+		ASSERT_EQ(members[j].ownerId, table.getOwnerId(j));
+		ASSERT_EQ(members[j].groupId, table.getGroupId(j));
+		ASSERT_EQ(members[j].mode, table.getMode(j));
+	}
+}
+
+TEST_F(CommonExtractionTests,
+ScanIntoTableFromSourceNotInMemoryDoesNotReadContentOfMembers) {
+	const auto memberContent = std::string(1000, 'x');
+	auto source = UnmappedByteSource::createWithContent(
+		"!<arch>\n"s +
+		"a.txt/          1           2     3     644     1000      `\n"s +
+		memberContent +
+		"b.txt/          4           5     6     600     3         `\n"s +
+		"bbb\n"s
+	);
+
+	auto table = Extractor().scanIntoTable(source, ExtractionOptions());
+
+	ASSERT_EQ(2, table.size());
+	ASSERT_FALSE(table.isContentInMemory());
+	ASSERT_EQ("a.txt", table.getName(0));
+	ASSERT_EQ(68, table.getOffset(0));
+	ASSERT_EQ(1000, table.getSize(0));
+	ASSERT_EQ(1, table.getTimestamp(0));
+	ASSERT_EQ(0644, table.getMode(0));
+	ASSERT_EQ("b.txt", table.getName(1));
+	ASSERT_EQ(1128, table.getOffset(1));
+	ASSERT_EQ(3, table.getSize(1));
+	// The magic string, two headers, the last bytes of the members (to check
+	// that the archive is not truncated), and the padding after the odd-sized
+	// member.
+	ASSERT_EQ(8 + 2 * 60 + 2 + 1, source->getReadByteCount());
+}
+
+TEST_F(CommonExtractionTests,
+ScanIntoTableFromSourceNotInMemoryComputesSameChecksumsAsScan) {
+	const auto content =
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     2         `\n"s +
+		"aa"s +
+		"b.txt/          0           0     0     644     3         `\n"s +
+		"bbb\n"s;
+	ExtractionOptions options;
+	options.computeChecksums = true;
+
+	auto members = Extractor().scan(content, options);
+	auto table = Extractor().scanIntoTable(
+		UnmappedByteSource::createWithContent(content), options);
+
+	ASSERT_EQ(members[0].checksum, table.getChecksum(0));
+	ASSERT_EQ(members[1].checksum, table.getChecksum(1));
+}
+
+TEST_F(CommonExtractionTests,
+ScanIntoTableFromSourceNotInMemoryThrowsInvalidArchiveErrorForInvalidHeader) {
+	auto source = UnmappedByteSource::createWithContent(
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     648     2         `\n"s +
+		"aa"s
+	);
+
+	ASSERT_THROW(
+		Extractor().scanIntoTable(source, ExtractionOptions()),
+		InvalidArchiveError
+	);
+}
+
+TEST_F(CommonExtractionTests,
+ScanIntoTableFromSourceNotInMemoryThrowsInvalidArchiveErrorForTruncatedMember) {
+	auto source = UnmappedByteSource::createWithContent(
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     20        `\n"s +
+		"aa"s
+	);
+
+	ASSERT_THROW(
+		Extractor().scanIntoTable(source, ExtractionOptions()),
+		InvalidArchiveError
+	);
+}
+
+TEST_F(CommonExtractionTests,
+ScanOfSourceNotInMemoryPassesMembersWithOffsetsIntoSourceToHandler) {
+	auto source = UnmappedByteSource::createWithContent(
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     1         `\n"s +
+		"a\n"s +
+		"b.txt/          0           0     0     644     2         `\n"s +
+		"bb"s
+	);
+	Members members;
+
+	Extractor().scan(source, [&](Member&& member) {
+		members.push_back(std::move(member));
+	});
+
+	ASSERT_EQ(2, members.size());
+	ASSERT_EQ("a.txt", members[0].name);
+	ASSERT_EQ(68, members[0].offset);
+	ASSERT_EQ("b.txt", members[1].name);
+	ASSERT_EQ(130, members[1].offset);
+	ASSERT_EQ(2, members[1].size);
+}
+
+TEST_F(CommonExtractionTests,
+ScanIntoTableFromSourceInMemoryViewsBytesOfSource) {
+	auto source = ByteSource::fromString(
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     2         `\n"s +
+		"aa"s
+	);
+
+	auto table = Extractor().scanIntoTable(source, ExtractionOptions());
+
+	ASSERT_TRUE(table.isContentInMemory());
+	ASSERT_EQ(source->data() + 68, table.getContentView(0).data());
+}
+
+TEST_F(CommonExtractionTests,
+ParallelExtractionReturnsSameFilesAsSerialExtraction) {
+	// Mix a large file (copied in chunks by several tasks) with small ones.
+	const auto largeContent = std::string(3 * 1024 * 1024 + 7, 'x');
+	const auto content =
+		"!<arch>\n"s +
+		"small1.txt/     0           0     0     644     6         `\n"s +
+		"small1"s +
+		"large.bin/      0           0     0     644     "s +
+			std::to_string(largeContent.size()) + "   `\n"s +
+		largeContent +
+		"small2.txt/     0           0     0     644     6         `\n"s +
+		"small2"s;
+
+	auto files = extractArchiveWithContentInParallel(content);
+
+	ASSERT_EQ(3, files.size());
+	auto it = files.begin();
+	ASSERT_EQ("small1.txt", (*it)->getName());
+	ASSERT_EQ("small1", (*it)->getContent());
+	++it;
+	ASSERT_EQ("large.bin", (*it)->getName());
+	ASSERT_EQ(largeContent, (*it)->getContent());
+	++it;
+	ASSERT_EQ("small2.txt", (*it)->getName());
+	ASSERT_EQ("small2", (*it)->getContent());
+}
+
+TEST_F(CommonExtractionTests,
+ParallelExtractionThrowsInvalidArchiveErrorForInvalidArchive) {
+	ASSERT_THROW(
+		extractArchiveWithContentInParallel(
+			"!<arch>\n"s +
+			"test.txt/       0           0     0     644     9999  `\n"s +
+			"..."s
+		),
+		InvalidArchiveError
+	);
+}
+
+TEST_F(CommonExtractionTests,
+SpeculativeScanReturnsSameMembersAsSerialScan) {
+	const auto content =
+		"!<arch>\n"s +
+		"//                                              42        `\n"s +
+		"very_long_name_of_a_module_in_archive.o/\n"s +
+		"\n"
+		"/0              0           0     0     644     3         `\n"s +
+		"abc\n"s +
+		"short.o/        0           0     0     644     2         `\n"s +
+		"de"s;
+	ExtractionOptions options;
+	options.threadCount = 3;
+	options.speculativeHeaderScan = true;
+
+	auto serialMembers = Extractor().scan(content);
+	auto speculativeMembers = Extractor().scan(content, options);
+
+	ASSERT_EQ(2, speculativeMembers.size());
+	for (std::size_t j = 0; j < serialMembers.size(); ++j) {
+		ASSERT_EQ(serialMembers[j].name, speculativeMembers[j].name);
+		ASSERT_EQ(serialMembers[j].offset, speculativeMembers[j].offset);
+		ASSERT_EQ(serialMembers[j].size, speculativeMembers[j].size);
+		ASSERT_EQ(serialMembers[j].mode, speculativeMembers[j].mode);
+	}
+}
+
+TEST_F(CommonExtractionTests,
+SpeculativeScanFallsBackToSerialWalkForNonStandardHeaders) {
+	ExtractionOptions options;
+	options.speculativeHeaderScan = true;
+
+	// The header is shorter than 60 bytes.
+	auto members = Extractor().scan(
+		"!<arch>\n"s +
+		"a.txt/ 0 0 0 644 2 `\n"s +
+		"aa"s,
+		options
+	);
+
+	ASSERT_EQ(1, members.size());
+	ASSERT_EQ("a.txt", members[0].name);
+	ASSERT_EQ(2, members[0].size);
+}
+
+TEST_F(CommonExtractionTests,
+SpeculativeScanThrowsInvalidArchiveErrorForInvalidArchive) {
+	ExtractionOptions options;
+	options.speculativeHeaderScan = true;
+
+	ASSERT_THROW(
+		Extractor().scan(
+			"!<arch>\n"s +
+			"test.txt/       0           0     0     644     9999      `\n"s +
+			"..."s,
+			options
+		),
+		InvalidArchiveError
+	);
+}
+
+TEST_F(CommonExtractionTests,
+ExtractWithMemoryBudgetKeepsInMemoryOnlyFilesFittingIntoBudget) {
+	auto tmpFile = TmpFile::createWithContent(
+		"!<arch>\n"
+		"big.txt/        0           0     0     644     10        `\n"
+		"0123456789"
+		"small.txt/      0           0     0     644     4         `\n"
+		"abcd"
+	);
+	ExtractionOptions options;
+	options.memoryBudget = 8;
+
+	auto files = Extractor().extract(
+		ArchiveBuffer::fromFilesystem(tmpFile->getPath()), options);
+
+	ASSERT_EQ(2, files.size());
+	auto& bigFile = files.front();
+	ASSERT_NE(nullptr, dynamic_cast<FilesystemRangeFile*>(bigFile.get()));
+	ASSERT_EQ("big.txt", bigFile->getName());
+	ASSERT_EQ("0123456789", bigFile->getContent());
+	auto& smallFile = files.back();
+	ASSERT_NE(nullptr, dynamic_cast<StringFile*>(smallFile.get()));
+	ASSERT_EQ("small.txt", smallFile->getName());
+	ASSERT_EQ("abcd", smallFile->getContent());
+}
+
+TEST_F(CommonExtractionTests,
+ExtractSharingArchiveContentReturnsFilesReferringToArchive) {
+	auto archive = ArchiveBuffer::fromContent(
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     1         `\n"
+		"a\n"
+		"b.txt/          0           0     0     644     2         `\n"
+		"bb"
+	);
+	ExtractionOptions options;
+	options.shareArchiveContent = true;
+
+	auto files = Extractor().extract(archive, options);
+
+	ASSERT_EQ(2, files.size());
+	ASSERT_EQ("a.txt", files.front()->getNameView());
+	ASSERT_EQ("a", files.front()->getContentView());
+	ASSERT_EQ("bb", files.back()->getContentView());
+	ASSERT_EQ(archive->getContent().data() + archive->getContent().size() - 2,
+		files.back()->getContentView().data());
+}
+
+TEST_F(CommonExtractionTests,
+ExtractWithMemoryResourceAllocatesFilesFromIt) {
+	std::pmr::monotonic_buffer_resource resource;
+	struct DefaultResourceGuard {
+		DefaultResourceGuard() {
+			std::pmr::set_default_resource(std::pmr::null_memory_resource());
+		}
+		~DefaultResourceGuard() {
+			std::pmr::set_default_resource(nullptr);
+		}
+	};
+	auto guard = std::make_unique<DefaultResourceGuard>();
+	ExtractionOptions options;
+	options.memoryResource = &resource;
+	options.threadCount = 4;
+
+	// The extraction itself may allocate from the heap, the resulting files
+	// may not (the null resource throws upon allocation).
+	auto files = Extractor().extract(
+		"!<arch>\n"
+		"a_file_with_long_name.txt/0           0     0     644     1         `\n"
+		"a\n"
+		"b.txt/          0           0     0     644     2         `\n"
+		"bb",
+		options
+	);
+	auto sharedFiles = [&]() {
+		options.shareArchiveContent = true;
+		return Extractor().extract(
+			"!<arch>\n"
+			"b.txt/          0           0     0     644     2         `\n"
+			"bb",
+			options
+		);
+	}();
+	guard.reset();
+
+	ASSERT_EQ(2, files.size());
+	ASSERT_EQ("a_file_with_long_name.txt", files.front()->getNameView());
+	ASSERT_EQ("a", files.front()->getContentView());
+	ASSERT_EQ("bb", files.back()->getContentView());
+	ASSERT_EQ(1, sharedFiles.size());
+	ASSERT_EQ("bb", sharedFiles.front()->getContentView());
+}
+
+TEST_F(CommonExtractionTests,
+ExtractWithoutMemoryResourceDoesNotAllocateFilesFromDefaultResource) {
+	struct DefaultResourceGuard {
+		DefaultResourceGuard() {
+			std::pmr::set_default_resource(std::pmr::null_memory_resource());
+		}
+		~DefaultResourceGuard() {
+			std::pmr::set_default_resource(nullptr);
+		}
+	};
+	auto guard = std::make_unique<DefaultResourceGuard>();
+	ExtractionOptions options;
+
+	// The null resource throws upon allocation.
+	auto files = Extractor().extract(
+		"!<arch>\n"
+		"a_file_with_long_name.txt/0           0     0     644     1         `\n"
+		"a\n",
+		options
+	);
+	auto sharedFiles = [&]() {
+		options.shareArchiveContent = true;
+		return Extractor().extract(
+			"!<arch>\n"
+			"b.txt/          0           0     0     644     2         `\n"
+			"bb",
+			options
+		);
+	}();
+	guard.reset();
+
+	ASSERT_EQ(1, files.size());
+	ASSERT_EQ("a", files.front()->getContentView());
+	ASSERT_EQ(1, sharedFiles.size());
+	ASSERT_EQ("b.txt", sharedFiles.front()->getNameView());
+}
+
 ///
 /// Tests for extraction of GNU archives.
 ///
@@ -93,6 +578,43 @@ ExtractReturnsSingletonContainerForArchiveWithLookupTableAndSingleFile) {
 	ASSERT_EQ("contents of mod1.o", file->getContent());
 }
 
+TEST_F(GNUArchiveTests,
+ExtractSkipsWholeNameOf64BitLookupTable) {
+	auto files = extractArchiveWithContent(
+		"!<arch>\n"s +
+		"/SYM64/         0           0     0     0       22        `\n"s +
+		"\x00\x00\x00\x00\x00\x00\x00\x01"
+			"\x00\x00\x00\x00\x00\x00\x00\x5a""func1\x00"s +
+		"mod1.o/         0           0     0     644     18        `\n"s +
+		"contents of mod1.o"s
+	);
+
+	ASSERT_EQ(1, files.size());
+	auto& file = files.front();
+	ASSERT_EQ("mod1.o", file->getName());
+	ASSERT_EQ("contents of mod1.o", file->getContent());
+}
+
+TEST_F(GNUArchiveTests,
+ExtractSkipsPaddingAfterLookupTableWithOddSize) {
+	auto files = extractArchiveWithContent(
+		"!<arch>\n"s +
+		"/               0           0     0     0       13        `\n"s +
+		"\x00\x00\x00\x01\x00\x00\x00\xb8""func\x00"s +
+		"\n"s +
+		"//                                              42        `\n"s +
+		"very_long_name_of_a_module_in_archive.o/\n"s +
+		"\n"
+		"/0              0           0     0     644     22        `\n"s +
+		"contents of the module"s
+	);
+
+	ASSERT_EQ(1, files.size());
+	auto& file = files.front();
+	ASSERT_EQ("very_long_name_of_a_module_in_archive.o", file->getName());
+	ASSERT_EQ("contents of the module", file->getContent());
+}
+
 TEST_F(GNUArchiveTests,
 ExtractReturnsSingletonContainerForArchiveWithFileNameTableAndSingleFile) {
 	auto files = extractArchiveWithContent(
@@ -110,6 +632,22 @@ ExtractReturnsSingletonContainerForArchiveWithFileNameTableAndSingleFile) {
 	ASSERT_EQ("contents of the module", file->getContent());
 }
 
+TEST_F(GNUArchiveTests,
+ExtractSkipsPaddingAfterFilesWithOddSize) {
+	auto files = extractArchiveWithContent(
+		"!<arch>\n"s +
+		"a.txt/          0           0     0     644     1         `\n"s +
+		"a\n"s +
+		"b.txt/          0           0     0     644     1         `\n"s +
+		"b\n"s
+	);
+
+	ASSERT_EQ(2, files.size());
+	ASSERT_EQ("a", files.front()->getContent());
+	ASSERT_EQ("b.txt", files.back()->getName());
+	ASSERT_EQ("b", files.back()->getContent());
+}
+
 TEST_F(GNUArchiveTests,
 ExtractThrowsInvalidArchiveErrorWhenFileNameIsNotEndedWithSlash) {
 	ASSERT_THROW(
@@ -257,6 +795,137 @@ ExtractThrowsInvalidArchiveErrorWhenIndexIntoFileNameTableIsInvalid) {
 	);
 }
 
+TEST_F(GNUArchiveTests,
+ScanIntoTableFromSourceNotInMemoryReadsNamesFromFileNameTable) {
+	auto source = UnmappedByteSource::createWithContent(
+		"!<arch>\n"s +
+		"/               0           0     0     0       14        `\n"s +
+		"\x00\x00\x00\x10\x00\x00\x00\x52""func1\x00"s +
+		"//                                              42        `\n"s +
+		"very_long_name_of_a_module_in_archive.o/\n"s +
+		"\n"
+		"/0              0           0     0     644     22        `\n"s +
+		"contents of the module"s
+	);
+
+	auto table = Extractor().scanIntoTable(source, ExtractionOptions());
+
+	ASSERT_EQ(1, table.size());
+	ASSERT_EQ("very_long_name_of_a_module_in_archive.o", table.getName(0));
+	ASSERT_EQ("contents of the module",
+		table.toFiles().front()->getContent());
+}
+
+///
+/// Tests for the recursive extraction of nested archives.
+///
+class RecursiveExtractionTests: public BaseExtractorTests {
+protected:
+	static ExtractionOptions recursiveOptions(std::size_t threadCount);
+};
+
+ExtractionOptions RecursiveExtractionTests::recursiveOptions(
+		std::size_t threadCount) {
+	ExtractionOptions options;
+	options.recursive = true;
+	options.threadCount = threadCount;
+	return options;
+}
+
+TEST_F(RecursiveExtractionTests,
+ExtractReturnsFilesOfNestedArchivesInPlaceOfThem) {
+	const auto content = archiveWithMembers({
+		{"first.txt", "1"},
+		{"outer.a", archiveWithMembers({
+			{"a.txt", "aa"},
+			{"inner.a", archiveWithMembers({{"b.txt", "bbb"}})},
+		})},
+		{"last.txt", "2"},
+	});
+
+	auto files = Extractor().extract(content, recursiveOptions(1));
+
+	ASSERT_EQ(4, files.size());
+	auto it = files.begin();
+	ASSERT_EQ("first.txt", (*it)->getName());
+	++it;
+	ASSERT_EQ("outer.a/a.txt", (*it)->getName());
+	ASSERT_EQ("aa", (*it)->getContent());
+	++it;
+	ASSERT_EQ("outer.a/inner.a/b.txt", (*it)->getName());
+	ASSERT_EQ("bbb", (*it)->getContent());
+	++it;
+	ASSERT_EQ("last.txt", (*it)->getName());
+}
+
+TEST_F(RecursiveExtractionTests,
+ExtractWithoutRecursionReturnsNestedArchivesAsFiles) {
+	const auto nested = archiveWithMembers({{"a.txt", "aa"}});
+	const auto content = archiveWithMembers({{"nested.a", nested}});
+
+	auto files = Extractor().extract(content);
+
+	ASSERT_EQ(1, files.size());
+	ASSERT_EQ("nested.a", files.front()->getName());
+	ASSERT_EQ(nested, files.front()->getContent());
+}
+
+TEST_F(RecursiveExtractionTests,
+ExtractWithSharedContentViewsContentOfOutermostArchive) {
+	const auto content = archiveWithMembers({
+		{"outer.a", archiveWithMembers({
+			{"inner.a", archiveWithMembers({{"b.txt", "bbb"}})},
+		})},
+	});
+	auto options = recursiveOptions(1);
+	options.shareArchiveContent = true;
+
+	auto files = Extractor().extract(ArchiveBuffer::fromView(content),
+		options);
+
+	ASSERT_EQ(1, files.size());
+	const auto view = files.front()->getContentView();
+	ASSERT_EQ("bbb", view);
+	ASSERT_EQ(content.data() + content.find("bbb"), view.data());
+}
+
+TEST_F(RecursiveExtractionTests,
+ParallelExtractReturnsSameFilesAsSerialExtract) {
+	std::vector<std::pair<std::string, std::string>> members;
+	for (int j = 0; j < 20; ++j) {
+		const auto name = std::to_string(j);
+		members.emplace_back(name + ".a", archiveWithMembers({
+			{name + ".txt", name},
+			{name + ".b", archiveWithMembers({{name + ".o", name + name}})},
+		}));
+	}
+	const auto content = archiveWithMembers(members);
+
+	auto files = Extractor().extract(content, recursiveOptions(1));
+	auto parallelFiles = Extractor().extract(content, recursiveOptions(4));
+
+	ASSERT_EQ(40, files.size());
+	ASSERT_EQ(files.size(), parallelFiles.size());
+	auto it = files.begin();
+	auto parallelIt = parallelFiles.begin();
+	for (; it != files.end(); ++it, ++parallelIt) {
+		ASSERT_EQ((*it)->getName(), (*parallelIt)->getName());
+		ASSERT_EQ((*it)->getContent(), (*parallelIt)->getContent());
+	}
+}
+
+TEST_F(RecursiveExtractionTests,
+ExtractThrowsInvalidArchiveErrorForInvalidNestedArchive) {
+	const auto content = archiveWithMembers({
+		{"nested.a", "!<arch>\nnot a header"},
+	});
+
+	ASSERT_THROW(
+		Extractor().extract(content, recursiveOptions(2)),
+		InvalidArchiveError
+	);
+}
+
 } // namespace tests
 } // namespace internal
 } // namespace ar
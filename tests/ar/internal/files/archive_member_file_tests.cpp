@@ -0,0 +1,65 @@
+///
+/// @file      ar/internal/files/archive_member_file_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c archive_member_file module.
+///
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/files/archive_member_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for ArchiveMemberFile.
+///
+class ArchiveMemberFileTests: public testing::Test {};
+
+TEST_F(ArchiveMemberFileTests,
+FileHasCorrectNameAndContent) {
+	ArchiveMemberFile file{ArchiveBuffer::fromContent("0123456789"), 2, 3,
+		"file.txt"};
+
+	ASSERT_EQ("file.txt", file.getName());
+	ASSERT_EQ("file.txt", file.getNameView());
+	ASSERT_EQ("234", file.getContent());
+}
+
+TEST_F(ArchiveMemberFileTests,
+GetContentViewReturnsViewIntoArchive) {
+	auto archive = ArchiveBuffer::fromContent("0123456789");
+	ArchiveMemberFile file{archive, 2, 3, "file.txt"};
+
+	ASSERT_EQ(archive->getContent().data() + 2, file.getContentView().data());
+}
+
+TEST_F(ArchiveMemberFileTests,
+FileKeepsArchiveAlive) {
+	ArchiveMemberFile file{ArchiveBuffer::fromContent(std::string(100, 'x')),
+		10, 5, "file.txt"};
+
+	ASSERT_EQ("xxxxx", file.getContentView());
+}
+
+TEST_F(ArchiveMemberFileTests,
+SaveCopyToSavesCopyOfFileToGivenDirectory) {
+	const std::string Name{"ar-archive-member-file-save-copy-to-test.txt"};
+	ArchiveMemberFile file{ArchiveBuffer::fromContent("0123456789"), 2, 3,
+		Name};
+
+	file.saveCopyTo(".");
+
+	RemoveFileOnDestruction remover{Name};
+	ASSERT_EQ("234", readFile(Name));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
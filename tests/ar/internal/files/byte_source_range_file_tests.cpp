@@ -0,0 +1,110 @@
+///
+/// @file      ar/internal/files/byte_source_range_file_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c byte_source_range_file module.
+///
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/byte_source.h"
+#include "ar/exceptions.h"
+#include "ar/internal/files/byte_source_range_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/tmp_file.h"
+#include "ar/test_utilities/unmapped_byte_source.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for ByteSourceRangeFile.
+///
+class ByteSourceRangeFileTests: public testing::Test {};
+
+TEST_F(ByteSourceRangeFileTests,
+GetNameReturnsCorrectValue) {
+	ByteSourceRangeFile file{ByteSource::fromString(""), 0, 0, "file.txt"};
+
+	ASSERT_EQ("file.txt", file.getName());
+}
+
+TEST_F(ByteSourceRangeFileTests,
+GetContentViewOfSourceInMemoryViewsBytesOfSource) {
+	auto source = ByteSource::fromString("0123456789");
+	ByteSourceRangeFile file{source, 2, 3, "file.txt"};
+
+	auto content = file.getContentView();
+
+	ASSERT_EQ("234", content);
+	ASSERT_EQ(source->data() + 2, content.data());
+}
+
+TEST_F(ByteSourceRangeFileTests,
+GetContentViewOfSourceNotInMemoryReadsRangeOnlyOnce) {
+	auto source = UnmappedByteSource::createWithContent("0123456789");
+	ByteSourceRangeFile file{source, 2, 3, "file.txt"};
+
+	auto content = file.getContentView();
+
+	ASSERT_EQ("234", content);
+	ASSERT_EQ(content.data(), file.getContentView().data());
+	ASSERT_EQ(3, source->getReadByteCount());
+}
+
+TEST_F(ByteSourceRangeFileTests,
+ForEachChunkReadsOnlyContentOfRangeInChunks) {
+	auto source = UnmappedByteSource::createWithContent("0123456789");
+	ByteSourceRangeFile file{source, 2, 5, "file.txt"};
+	std::vector<std::string> chunks;
+
+	file.forEachChunk(2, [&](std::string_view chunk) {
+		chunks.emplace_back(chunk);
+	});
+
+	ASSERT_EQ(std::vector<std::string>({"23", "45", "6"}), chunks);
+	ASSERT_EQ(5, source->getReadByteCount());
+}
+
+TEST_F(ByteSourceRangeFileTests,
+ReadContentAtDoesNotReadPastEndOfRange) {
+	auto source = UnmappedByteSource::createWithContent("0123456789");
+	ByteSourceRangeFile file{source, 2, 5, "file.txt"};
+	char buffer[4];
+
+	ASSERT_EQ(2, file.readContentAt(3, buffer, 4));
+	ASSERT_EQ("56", std::string(buffer, 2));
+	ASSERT_EQ(0, file.readContentAt(5, buffer, 4));
+}
+
+TEST_F(ByteSourceRangeFileTests,
+GetContentThrowsIOErrorWhenSourceEndsBeforeEndOfRange) {
+	ByteSourceRangeFile file{
+		UnmappedByteSource::createWithContent("0123"), 2, 5, "file.txt"
+	};
+
+	ASSERT_THROW(file.getContent(), IOError);
+}
+
+TEST_F(ByteSourceRangeFileTests,
+SaveCopyToSavesContentOfRangeToGivenDirectory) {
+	const std::string Name{"ar-byte-source-range-file-save-copy-to-test.txt"};
+	ByteSourceRangeFile file{
+		UnmappedByteSource::createWithContent("0123456789"), 2, 3, Name
+	};
+
+	file.saveCopyTo(".");
+
+	RemoveFileOnDestruction remover{Name};
+	ASSERT_EQ("234", readFile(Name));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
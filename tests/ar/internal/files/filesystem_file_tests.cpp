@@ -5,6 +5,9 @@
 /// @brief     Tests for the @c filesystem_file module.
 ///
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "ar/internal/files/filesystem_file.h"
@@ -48,6 +51,40 @@ GetContentReturnsCorrectContent) {
 	ASSERT_EQ("content", file.getContent());
 }
 
+TEST_F(FilesystemFileTests,
+GetContentViewReadsContentOnlyOnce) {
+	auto tmpFile = TmpFile::createWithContent("content");
+	FilesystemFile file{tmpFile->getPath()};
+
+	auto content = file.getContentView();
+
+	ASSERT_EQ("content", content);
+	ASSERT_EQ(content.data(), file.getContentView().data());
+}
+
+TEST_F(FilesystemFileTests,
+ForEachChunkReadsFileInChunks) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	FilesystemFile file{tmpFile->getPath()};
+	std::vector<std::string> chunks;
+
+	file.forEachChunk(4, [&](std::string_view chunk) {
+		chunks.emplace_back(chunk);
+	});
+
+	ASSERT_EQ(std::vector<std::string>({"0123", "4567", "89"}), chunks);
+}
+
+TEST_F(FilesystemFileTests,
+ReadContentAtReadsRequestedPartOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	FilesystemFile file{tmpFile->getPath()};
+	char buffer[4];
+
+	ASSERT_EQ(3, file.readContentAt(7, buffer, 4));
+	ASSERT_EQ("789", std::string(buffer, 3));
+}
+
 TEST_F(FilesystemFileTests,
 SaveCopyToSavesCopyOfFileToGivenDirectory) {
 	const std::string Content{"content"};
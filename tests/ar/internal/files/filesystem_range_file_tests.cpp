@@ -0,0 +1,92 @@
+///
+/// @file      ar/internal/files/filesystem_range_file_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c filesystem_range_file module.
+///
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/files/filesystem_range_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for FilesystemRangeFile.
+///
+class FilesystemRangeFileTests: public testing::Test {};
+
+TEST_F(FilesystemRangeFileTests,
+GetNameReturnsCorrectValue) {
+	FilesystemRangeFile file{"/path/to/archive.a", 0, 0, "file.txt"};
+
+	ASSERT_EQ("file.txt", file.getName());
+}
+
+TEST_F(FilesystemRangeFileTests,
+GetContentReturnsContentOfRange) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	FilesystemRangeFile file{tmpFile->getPath(), 2, 3, "file.txt"};
+
+	ASSERT_EQ("234", file.getContent());
+}
+
+TEST_F(FilesystemRangeFileTests,
+GetContentViewReadsContentOfRangeOnlyOnce) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	FilesystemRangeFile file{tmpFile->getPath(), 2, 3, "file.txt"};
+
+	auto content = file.getContentView();
+
+	ASSERT_EQ("234", content);
+	ASSERT_EQ(content.data(), file.getContentView().data());
+}
+
+TEST_F(FilesystemRangeFileTests,
+ForEachChunkReadsOnlyContentOfRangeInChunks) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	FilesystemRangeFile file{tmpFile->getPath(), 2, 5, "file.txt"};
+	std::vector<std::string> chunks;
+
+	file.forEachChunk(2, [&](std::string_view chunk) {
+		chunks.emplace_back(chunk);
+	});
+
+	ASSERT_EQ(std::vector<std::string>({"23", "45", "6"}), chunks);
+}
+
+TEST_F(FilesystemRangeFileTests,
+ReadContentAtDoesNotReadPastEndOfRange) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	FilesystemRangeFile file{tmpFile->getPath(), 2, 5, "file.txt"};
+	char buffer[4];
+
+	ASSERT_EQ(2, file.readContentAt(3, buffer, 4));
+	ASSERT_EQ("56", std::string(buffer, 2));
+	ASSERT_EQ(0, file.readContentAt(5, buffer, 4));
+}
+
+TEST_F(FilesystemRangeFileTests,
+SaveCopyToSavesContentOfRangeToGivenDirectory) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	const std::string Name{"ar-filesystem-range-file-save-copy-to-test.txt"};
+	FilesystemRangeFile file{tmpFile->getPath(), 2, 3, Name};
+
+	file.saveCopyTo(".");
+
+	RemoveFileOnDestruction remover{Name};
+	ASSERT_EQ("234", readFile(Name));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
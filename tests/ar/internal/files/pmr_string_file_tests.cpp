@@ -0,0 +1,53 @@
+///
+/// @file      ar/internal/files/pmr_string_file_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c pmr_string_file module.
+///
+
+#include <memory_resource>
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/files/pmr_string_file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for PmrStringFile.
+///
+class PmrStringFileTests: public testing::Test {
+protected:
+	std::pmr::monotonic_buffer_resource resource;
+};
+
+TEST_F(PmrStringFileTests,
+FileHasCorrectContentAndName) {
+	PmrStringFile file{"content", "file.txt", &resource};
+
+	ASSERT_EQ("content", file.getContent());
+	ASSERT_EQ("content", file.getContentView());
+	ASSERT_EQ("file.txt", file.getName());
+	ASSERT_EQ("file.txt", file.getNameView());
+}
+
+TEST_F(PmrStringFileTests,
+SaveCopyToSavesCopyOfFileToGivenDirectory) {
+	const std::string Name{"ar-pmr-string-file-save-copy-to-test.txt"};
+	PmrStringFile file{"content", Name, &resource};
+
+	file.saveCopyTo(".");
+
+	RemoveFileOnDestruction remover{Name};
+	ASSERT_EQ("content", readFile(Name));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
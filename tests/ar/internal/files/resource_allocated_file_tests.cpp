@@ -0,0 +1,90 @@
+///
+/// @file      ar/internal/files/resource_allocated_file_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c resource_allocated_file module.
+///
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+#include <gtest/gtest.h>
+
+#include "ar/file.h"
+#include "ar/internal/files/pmr_string_file.h"
+#include "ar/internal/files/resource_allocated_file.h"
+#include "ar/internal/files/string_file.h"
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+namespace {
+
+///
+/// Memory resource counting the bytes that are currently allocated.
+///
+class CountingResource: public std::pmr::memory_resource {
+public:
+	std::size_t allocatedBytes = 0;
+
+private:
+	virtual void* do_allocate(std::size_t bytes,
+			std::size_t alignment) override {
+		allocatedBytes += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	virtual void do_deallocate(void* ptr, std::size_t bytes,
+			std::size_t alignment) override {
+		allocatedBytes -= bytes;
+		std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+	}
+
+	virtual bool do_is_equal(
+			const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+};
+
+} // anonymous namespace
+
+///
+/// Tests for ResourceAllocatedFile.
+///
+class ResourceAllocatedFileTests: public testing::Test {};
+
+TEST_F(ResourceAllocatedFileTests,
+FileIsAllocatedFromResourceAndReturnedToItUponDeletion) {
+	CountingResource resource;
+	std::unique_ptr<File> file{
+		new (&resource) ResourceAllocatedFile<PmrStringFile>(
+			"content", "file.txt", &resource)
+	};
+	ASSERT_GT(resource.allocatedBytes, sizeof(PmrStringFile));
+	ASSERT_EQ("content", file->getContentView());
+
+	file.reset();
+
+	ASSERT_EQ(0, resource.allocatedBytes);
+}
+
+TEST_F(ResourceAllocatedFileTests,
+FileOfTypeThatDoesNotUseResourceIsAllocatedFromIt) {
+	CountingResource resource;
+	std::unique_ptr<File> file{
+		new (&resource) ResourceAllocatedFile<StringFile>("content",
+			"file.txt")
+	};
+	ASSERT_GE(resource.allocatedBytes, sizeof(StringFile));
+	ASSERT_EQ("file.txt", file->getNameView());
+
+	file.reset();
+
+	ASSERT_EQ(0, resource.allocatedBytes);
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
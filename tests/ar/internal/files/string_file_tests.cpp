@@ -43,6 +43,25 @@ GetNameReturnsEmptyStringWhenFileHasNoName) {
 	ASSERT_EQ("", file.getName());
 }
 
+TEST_F(StringFileTests,
+GetContentViewReturnsViewOfContentWithoutCopying) {
+	StringFile file{"content", "file.txt"};
+
+	auto content = file.getContentView();
+
+	ASSERT_EQ("content", content);
+	ASSERT_EQ(content.data(), file.getContentView().data());
+	ASSERT_EQ("file.txt", file.getNameView());
+}
+
+TEST_F(StringFileTests,
+TakeContentMovesContentOutOfFile) {
+	StringFile file{"content"};
+
+	ASSERT_EQ("content", file.takeContent());
+	ASSERT_EQ("", file.getContent());
+}
+
 TEST_F(StringFileTests,
 SaveCopyToSavesCopyOfFileToGivenDirectory) {
 	const std::string Content{"content"};
@@ -0,0 +1,148 @@
+///
+/// @file      ar/internal/pipelined_extractor_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c pipelined_extractor module.
+///
+
+#include <gtest/gtest.h>
+
+#include "ar/byte_source.h"
+#include "ar/exceptions.h"
+#include "ar/internal/pipelined_extractor.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/tmp_file.h"
+#include "ar/test_utilities/unmapped_byte_source.h"
+
+using namespace std::literals::string_literals;
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for PipelinedExtractor.
+///
+class PipelinedExtractorTests: public testing::Test {
+protected:
+	static ExtractionOptions optionsWithThreads(std::size_t threadCount);
+};
+
+ExtractionOptions PipelinedExtractorTests::optionsWithThreads(
+		std::size_t threadCount) {
+	ExtractionOptions options;
+	options.pipelined = true;
+	options.threadCount = threadCount;
+	options.queueCapacity = 2;
+	return options;
+}
+
+TEST_F(PipelinedExtractorTests,
+ExtractToWritesAllFilesIntoDirectory) {
+	const std::string NameA{"ar-pipelined-extractor-test-a.txt"};
+	const std::string NameB{"ar-pipelined-extractor-test-b.txt"};
+	RemoveFileOnDestruction removerA{NameA};
+	RemoveFileOnDestruction removerB{NameB};
+	PipelinedExtractor extractor{optionsWithThreads(2)};
+
+	auto report = extractor.extractTo(
+		"!<arch>\n"s +
+		"//                                              70        `\n"s +
+		"ar-pipelined-extractor-test-a.txt/\n"s +
+		"ar-pipelined-extractor-test-b.txt/\n"s +
+		"/0              0           0     0     644     1         `\n"s +
+		"a\n"s +
+		"/35             0           0     0     644     2         `\n"s +
+		"bb"s,
+		"."
+	);
+
+	ASSERT_EQ(2, report.fileNames.size());
+	ASSERT_EQ(NameA, report.fileNames[0]);
+	ASSERT_EQ(NameB, report.fileNames[1]);
+	ASSERT_EQ("a", readFile(NameA));
+	ASSERT_EQ("bb", readFile(NameB));
+	ASSERT_EQ(2, report.queueCapacity);
+	ASSERT_LE(report.queueHighWaterMark, report.queueCapacity);
+}
+
+TEST_F(PipelinedExtractorTests,
+ExtractToStoresLastFileWhenNameAppearsSeveralTimes) {
+	const std::string Name{"ar-pipelined-extractor-test-dup.txt"};
+	RemoveFileOnDestruction remover{Name};
+	std::string content{"!<arch>\n"};
+	content += "//                                              36        `\n"s +
+		"ar-pipelined-extractor-test-dup.txt/\n"s;
+	for (int j = 0; j < 20; ++j) {
+		content += "/0              0           0     0     644     2         `\n"s +
+			std::to_string(j % 10) + "\n"s;
+	}
+	PipelinedExtractor extractor{optionsWithThreads(4)};
+
+	extractor.extractTo(content, ".");
+
+	ASSERT_EQ("9\n", readFile(Name));
+}
+
+TEST_F(PipelinedExtractorTests,
+ExtractToWritesAllFilesFromSourceNotInMemory) {
+	const std::string NameA{"ar-pipelined-extractor-source-test-a.txt"};
+	const std::string NameB{"ar-pipelined-extractor-source-test-b.txt"};
+	RemoveFileOnDestruction removerA{NameA};
+	RemoveFileOnDestruction removerB{NameB};
+	auto options = optionsWithThreads(2);
+	// The batched writes are not used for sources not in memory.
+	options.batchedWrites = true;
+	PipelinedExtractor extractor{options};
+
+	auto report = extractor.extractTo(
+		std::shared_ptr<const ByteSource>(
+			UnmappedByteSource::createWithContent(
+				"!<arch>\n"s +
+				"//                                              84        `\n"s +
+				"ar-pipelined-extractor-source-test-a.txt/\n"s +
+				"ar-pipelined-extractor-source-test-b.txt/\n"s +
+				"/0              0           0     0     644     1         `\n"s +
+				"a\n"s +
+				"/42             0           0     0     644     2         `\n"s +
+				"bb"s
+			)
+		),
+		"."
+	);
+
+	ASSERT_EQ(2, report.fileNames.size());
+	ASSERT_EQ("a", readFile(NameA));
+	ASSERT_EQ("bb", readFile(NameB));
+	ASSERT_FALSE(report.ioUringUsed);
+}
+
+TEST_F(PipelinedExtractorTests,
+ExtractToThrowsInvalidArchiveErrorForInvalidArchive) {
+	PipelinedExtractor extractor{optionsWithThreads(2)};
+
+	ASSERT_THROW(
+		extractor.extractTo("!<arch>\ntest.txt"s, "."),
+		InvalidArchiveError
+	);
+}
+
+TEST_F(PipelinedExtractorTests,
+ExtractToThrowsIOErrorWhenFileCannotBeWritten) {
+	PipelinedExtractor extractor{optionsWithThreads(2)};
+
+	ASSERT_THROW(
+		extractor.extractTo(
+			"!<arch>\n"s +
+			"a.txt/          0           0     0     644     1         `\n"s +
+			"a\n"s,
+			"/nonexisting-directory"
+		),
+		IOError
+	);
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,120 @@
+///
+/// @file      ar/internal/utilities/bounded_queue_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c bounded_queue module.
+///
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/utilities/bounded_queue.h"
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for BoundedQueue.
+///
+class BoundedQueueTests: public testing::Test {};
+
+TEST_F(BoundedQueueTests,
+CapacityIsRoundedUpToPowerOfTwo) {
+	BoundedQueue<int> queue{5};
+
+	ASSERT_EQ(8, queue.getCapacity());
+}
+
+TEST_F(BoundedQueueTests,
+PopFromEmptyQueueFails) {
+	BoundedQueue<int> queue{4};
+	int value;
+
+	ASSERT_FALSE(queue.tryPop(value));
+}
+
+TEST_F(BoundedQueueTests,
+ValuesArePoppedInOrderInWhichTheyWerePushed) {
+	BoundedQueue<int> queue{4};
+	int value = 1;
+	queue.tryPush(value);
+	value = 2;
+	queue.tryPush(value);
+
+	ASSERT_TRUE(queue.tryPop(value));
+	ASSERT_EQ(1, value);
+	ASSERT_TRUE(queue.tryPop(value));
+	ASSERT_EQ(2, value);
+}
+
+TEST_F(BoundedQueueTests,
+PushIntoFullQueueFailsAndLeavesValueUntouched) {
+	BoundedQueue<std::string> queue{2};
+	std::string value{"a"};
+	queue.tryPush(value);
+	value = "b";
+	queue.tryPush(value);
+
+	value = "c";
+	ASSERT_FALSE(queue.tryPush(value));
+	ASSERT_EQ("c", value);
+}
+
+TEST_F(BoundedQueueTests,
+HighWaterMarkIsLargestNumberOfValuesInQueue) {
+	BoundedQueue<int> queue{8};
+	int value = 0;
+	queue.tryPush(value);
+	queue.tryPush(value);
+	queue.tryPush(value);
+	queue.tryPop(value);
+	queue.tryPop(value);
+	queue.tryPush(value);
+
+	ASSERT_EQ(3, queue.getHighWaterMark());
+}
+
+TEST_F(BoundedQueueTests,
+AllValuesPushedByProducersArePoppedByConsumers) {
+	const int ValueCount = 10000;
+	BoundedQueue<int> queue{16};
+	std::atomic<long long> sum{0};
+	std::atomic<int> poppedCount{0};
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 2; ++t) {
+		threads.emplace_back([&queue, t]() {
+			for (int j = t; j < ValueCount; j += 2) {
+				int value = j;
+				while (!queue.tryPush(value)) {
+					std::this_thread::yield();
+				}
+			}
+		});
+		threads.emplace_back([&queue, &sum, &poppedCount]() {
+			int value;
+			while (poppedCount < ValueCount) {
+				if (queue.tryPop(value)) {
+					sum += value;
+					poppedCount++;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	ASSERT_EQ(ValueCount, poppedCount);
+	ASSERT_EQ(static_cast<long long>(ValueCount) * (ValueCount - 1) / 2, sum);
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
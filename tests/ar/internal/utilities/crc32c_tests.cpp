@@ -0,0 +1,70 @@
+///
+/// @file      ar/internal/utilities/crc32c_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c crc32c module.
+///
+
+#include <cstddef>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/utilities/crc32c.h"
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for crc32c().
+///
+class Crc32cTests: public testing::Test {};
+
+TEST_F(Crc32cTests,
+ReturnsZeroForEmptyData) {
+	ASSERT_EQ(0, crc32c(""));
+	ASSERT_EQ(0, crc32cInSoftware(""));
+}
+
+TEST_F(Crc32cTests,
+ReturnsCorrectChecksumForCheckString) {
+	ASSERT_EQ(0xe3069283, crc32c("123456789"));
+	ASSERT_EQ(0xe3069283, crc32cInSoftware("123456789"));
+}
+
+TEST_F(Crc32cTests,
+ReturnsCorrectChecksumForThirtyTwoZeroBytes) {
+	// A test vector from RFC 3720 (iSCSI).
+	const std::string data(32, '\0');
+
+	ASSERT_EQ(0x8a9136aa, crc32c(data));
+}
+
+TEST_F(Crc32cTests,
+ChecksumOfPartsEqualsChecksumOfWhole) {
+	const std::string data{"The quick brown fox jumps over the lazy dog"};
+
+	ASSERT_EQ(crc32c(data),
+		crc32c(data.substr(10), crc32c(data.substr(0, 10))));
+}
+
+TEST_F(Crc32cTests,
+HardwareAndSoftwareChecksumsAreSameForAllSizesAndAlignments) {
+	std::string data(100, '\0');
+	for (std::size_t j = 0; j < data.size(); ++j) {
+		data[j] = static_cast<char>(j * 37 + 11);
+	}
+
+	for (std::size_t offset = 0; offset < 8; ++offset) {
+		for (std::size_t size = 0; offset + size <= data.size(); ++size) {
+			const auto part = std::string_view{data}.substr(offset, size);
+			ASSERT_EQ(crc32cInSoftware(part), crc32c(part))
+				<< "offset " << offset << ", size " << size;
+		}
+	}
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,63 @@
+///
+/// @file      ar/internal/utilities/mapped_file_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c mapped_file module.
+///
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/internal/utilities/mapped_file.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for MappedFile.
+///
+class MappedFileTests: public testing::Test {};
+
+TEST_F(MappedFileTests,
+MappedFileProvidesContentOfFile) {
+	auto tmpFile = TmpFile::createWithContent("content");
+
+	MappedFile file{tmpFile->getPath()};
+
+	ASSERT_EQ("content", std::string(file.getData(), file.getSize()));
+}
+
+TEST_F(MappedFileTests,
+MappedEmptyFileHasZeroSize) {
+	auto tmpFile = TmpFile::createWithContent("");
+
+	MappedFile file{tmpFile->getPath()};
+
+	ASSERT_EQ(0, file.getSize());
+}
+
+TEST_F(MappedFileTests,
+ContentIsAccessibleAfterRelease) {
+	const std::string Content(3 * 4096, 'x');
+	auto tmpFile = TmpFile::createWithContent(Content);
+	MappedFile file{tmpFile->getPath()};
+
+	file.release(0, file.getSize());
+
+	ASSERT_EQ(Content, std::string(file.getData(), file.getSize()));
+}
+
+TEST_F(MappedFileTests,
+ConstructorThrowsIOErrorWhenFileDoesNotExist) {
+	ASSERT_THROW(MappedFile{"nonexisting-file"}, IOError);
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -106,6 +106,106 @@ ThrowsIOErrorWhenFileDoesNotExist) {
 	ASSERT_THROW(readFile("nonexisting-file"), IOError);
 }
 
+///
+/// Tests for readFileInto().
+///
+class ReadFileIntoTests: public testing::Test {};
+
+TEST_F(ReadFileIntoTests,
+ReplacesContentOfStringAndKeepsItsCapacity) {
+	auto tmpFile = TmpFile::createWithContent("content");
+	std::string content(100, 'x');
+	const auto capacity = content.capacity();
+
+	readFileInto(tmpFile->getPath(), content);
+
+	ASSERT_EQ("content", content);
+	ASSERT_EQ(capacity, content.capacity());
+}
+
+TEST_F(ReadFileIntoTests,
+ThrowsIOErrorWhenFileDoesNotExist) {
+	std::string content;
+
+	ASSERT_THROW(readFileInto("nonexisting-file", content), IOError);
+}
+
+///
+/// Tests for readFileRange().
+///
+class ReadFileRangeTests: public testing::Test {};
+
+TEST_F(ReadFileRangeTests,
+ReturnsCorrectContentOfRange) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	ASSERT_EQ("3456", readFileRange(tmpFile->getPath(), 3, 4));
+}
+
+TEST_F(ReadFileRangeTests,
+ThrowsIOErrorWhenFileDoesNotContainWholeRange) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	ASSERT_THROW(readFileRange(tmpFile->getPath(), 8, 4), IOError);
+}
+
+///
+/// Tests for readFileRangeInto().
+///
+class ReadFileRangeIntoTests: public testing::Test {};
+
+TEST_F(ReadFileRangeIntoTests,
+ReadsAtMostUntilEndOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	char buffer[4];
+
+	ASSERT_EQ(4, readFileRangeInto(tmpFile->getPath(), 3, buffer, 4));
+	ASSERT_EQ("3456", std::string(buffer, 4));
+	ASSERT_EQ(2, readFileRangeInto(tmpFile->getPath(), 8, buffer, 4));
+	ASSERT_EQ(0, readFileRangeInto(tmpFile->getPath(), 12, buffer, 4));
+}
+
+TEST_F(ReadFileRangeIntoTests,
+ThrowsIOErrorWhenFileDoesNotExist) {
+	char buffer[4];
+
+	ASSERT_THROW(readFileRangeInto("nonexisting-file", 0, buffer, 4),
+		IOError);
+}
+
+///
+/// Tests for readFileRangeInChunks().
+///
+class ReadFileRangeInChunksTests: public testing::Test {};
+
+TEST_F(ReadFileRangeInChunksTests,
+CallsCallbackForChunksOfRange) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	std::string chunks;
+
+	readFileRangeInChunks(tmpFile->getPath(), 1, 7, 3,
+		[&](std::string_view chunk) {
+			chunks += std::string(chunk) + "|";
+		}
+	);
+
+	ASSERT_EQ("123|456|7|", chunks);
+}
+
+TEST_F(ReadFileRangeInChunksTests,
+StopsAtEndOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+	std::string chunks;
+
+	readFileRangeInChunks(tmpFile->getPath(), 5, 100, 3,
+		[&](std::string_view chunk) {
+			chunks += std::string(chunk) + "|";
+		}
+	);
+
+	ASSERT_EQ("567|89|", chunks);
+}
+
 ///
 /// Tests for writeFile().
 ///
@@ -147,6 +247,218 @@ ThrowsIOErrorWhenSourceFileDoesNotExist) {
 	ASSERT_THROW(copyFile("nonexisting-file", "any-file"), IOError);
 }
 
+///
+/// Tests for copyFileRange().
+///
+class CopyFileRangeTests: public testing::Test {};
+
+TEST_F(CopyFileRangeTests,
+WritesCorrectContentToFile) {
+	auto tmpInFile = TmpFile::createWithContent("0123456789");
+	auto tmpOutFile = TmpFile::createWithContent("");
+
+	copyFileRange(tmpInFile->getPath(), 2, 5, tmpOutFile->getPath());
+
+	ASSERT_EQ("23456", readFile(tmpOutFile->getPath()));
+}
+
+TEST_F(CopyFileRangeTests,
+WritesCorrectContentToFileWhenRangeIsLargerThanChunk) {
+	std::string content(3 * 1024 * 1024 + 5, 'a');
+	content.back() = 'b';
+	auto tmpInFile = TmpFile::createWithContent("x" + content);
+	auto tmpOutFile = TmpFile::createWithContent("");
+
+	copyFileRange(tmpInFile->getPath(), 1, content.size(),
+		tmpOutFile->getPath());
+
+	ASSERT_EQ(content, readFile(tmpOutFile->getPath()));
+}
+
+TEST_F(CopyFileRangeTests,
+ThrowsIOErrorWhenSourceFileDoesNotContainWholeRange) {
+	auto tmpInFile = TmpFile::createWithContent("0123456789");
+	auto tmpOutFile = TmpFile::createWithContent("");
+
+	ASSERT_THROW(
+		copyFileRange(tmpInFile->getPath(), 5, 10, tmpOutFile->getPath()),
+		IOError
+	);
+}
+
+///
+/// Tests for copyFileRanges().
+///
+class CopyFileRangesTests: public testing::Test {};
+
+TEST_F(CopyFileRangesTests,
+CopiesRangesIntoGivenPlacesOfFile) {
+	auto tmpInFile = TmpFile::createWithContent("0123456789");
+	auto tmpOutFile = TmpFile::createWithContent("abcdefgh");
+
+	copyFileRanges(tmpInFile->getPath(), tmpOutFile->getPath(),
+		{{2, 1, 3}, {8, 7, 2}});
+
+	ASSERT_EQ("a234efg89", readFile(tmpOutFile->getPath()));
+}
+
+TEST_F(CopyFileRangesTests,
+CopiesRangeLargerThanChunk) {
+	std::string content(3 * 1024 * 1024 + 5, 'a');
+	content.back() = 'b';
+	auto tmpInFile = TmpFile::createWithContent("x" + content);
+	auto tmpOutFile = TmpFile::createWithContent("y");
+
+	copyFileRanges(tmpInFile->getPath(), tmpOutFile->getPath(),
+		{{1, 1, content.size()}});
+
+	ASSERT_EQ("y" + content, readFile(tmpOutFile->getPath()));
+}
+
+TEST_F(CopyFileRangesTests,
+ThrowsIOErrorWhenSourceFileDoesNotContainWholeRange) {
+	auto tmpInFile = TmpFile::createWithContent("0123456789");
+	auto tmpOutFile = TmpFile::createWithContent("");
+
+	ASSERT_THROW(
+		copyFileRanges(tmpInFile->getPath(), tmpOutFile->getPath(),
+			{{5, 0, 10}}),
+		IOError
+	);
+}
+
+///
+/// Tests for writeFileAt().
+///
+class WriteFileAtTests: public testing::Test {};
+
+TEST_F(WriteFileAtTests,
+OverwritesRangeOfFileAndKeepsRest) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	writeFileAt(tmpFile->getPath(), 2, "abc", 3);
+
+	ASSERT_EQ("01abc56789", readFile(tmpFile->getPath()));
+}
+
+TEST_F(WriteFileAtTests,
+AppendsContentWhenOffsetIsSizeOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123");
+
+	writeFileAt(tmpFile->getPath(), 4, "45", 2);
+
+	ASSERT_EQ("012345", readFile(tmpFile->getPath()));
+}
+
+///
+/// Tests for moveFileRange() and resizeFile().
+///
+class MoveFileRangeTests: public testing::Test {};
+
+TEST_F(MoveFileRangeTests,
+MovesOverlappingRangeTowardsStartOfFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	moveFileRange(tmpFile->getPath(), 3, 1, 7);
+
+	ASSERT_EQ("0345678989", readFile(tmpFile->getPath()));
+}
+
+TEST_F(MoveFileRangeTests,
+MovesOverlappingRangeTowardsEndOfFileAndExtendsIt) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	moveFileRange(tmpFile->getPath(), 6, 8, 4);
+
+	ASSERT_EQ("012345676789", readFile(tmpFile->getPath()));
+}
+
+TEST_F(MoveFileRangeTests,
+MovesRangeLargerThanChunkByLargeDistanceInBothDirections) {
+	std::string content(3 * 1024 * 1024 + 5, 'a');
+	content.back() = 'b';
+	const std::string prefix(2 * 1024 * 1024, 'p');
+	auto tmpFile = TmpFile::createWithContent(prefix + content);
+
+	moveFileRange(tmpFile->getPath(), prefix.size(), 1, content.size());
+	resizeFile(tmpFile->getPath(), content.size() + 1);
+	ASSERT_EQ("p" + content, readFile(tmpFile->getPath()));
+
+	moveFileRange(tmpFile->getPath(), 1, prefix.size(), content.size());
+	const auto moved = readFile(tmpFile->getPath());
+	ASSERT_EQ(prefix.size() + content.size(), moved.size());
+	ASSERT_EQ(content, moved.substr(prefix.size()));
+}
+
+TEST_F(MoveFileRangeTests,
+ThrowsIOErrorWhenFileDoesNotContainWholeRange) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	ASSERT_THROW(moveFileRange(tmpFile->getPath(), 5, 0, 10), IOError);
+}
+
+TEST_F(MoveFileRangeTests,
+ResizeFileTruncatesFile) {
+	auto tmpFile = TmpFile::createWithContent("0123456789");
+
+	resizeFile(tmpFile->getPath(), 4);
+
+	ASSERT_EQ("0123", readFile(tmpFile->getPath()));
+}
+
+///
+/// Tests for getFileSizeAndModificationTime() and setFileModificationTime().
+///
+class FileModificationTimeTests: public testing::Test {};
+
+TEST_F(FileModificationTimeTests,
+GetReturnsSizeAndTimeSetBySet) {
+	auto tmpFile = TmpFile::createWithContent("content");
+	setFileModificationTime(tmpFile->getPath(), 1445412357);
+
+	std::size_t size = 0;
+	std::time_t modificationTime = 0;
+	ASSERT_TRUE(getFileSizeAndModificationTime(tmpFile->getPath(), size,
+		modificationTime));
+
+	ASSERT_EQ(7, size);
+	ASSERT_EQ(1445412357, modificationTime);
+}
+
+TEST_F(FileModificationTimeTests,
+GetReturnsFalseWhenFileDoesNotExist) {
+	std::size_t size = 0;
+	std::time_t modificationTime = 0;
+
+	ASSERT_FALSE(getFileSizeAndModificationTime("nonexisting-file", size,
+		modificationTime));
+}
+
+TEST_F(FileModificationTimeTests,
+SetThrowsIOErrorWhenFileDoesNotExist) {
+	ASSERT_THROW(setFileModificationTime("nonexisting-file", 0), IOError);
+}
+
+///
+/// Tests for fileHasContent().
+///
+class FileHasContentTests: public testing::Test {};
+
+TEST_F(FileHasContentTests,
+ReturnsTrueOnlyForExactlySameContent) {
+	auto tmpFile = TmpFile::createWithContent("content");
+
+	ASSERT_TRUE(fileHasContent(tmpFile->getPath(), "content", 7));
+	ASSERT_FALSE(fileHasContent(tmpFile->getPath(), "contenT", 7));
+	ASSERT_FALSE(fileHasContent(tmpFile->getPath(), "content", 6));
+	ASSERT_FALSE(fileHasContent(tmpFile->getPath(), "content!", 8));
+}
+
+TEST_F(FileHasContentTests,
+ReturnsFalseWhenFileDoesNotExist) {
+	ASSERT_FALSE(fileHasContent("nonexisting-file", "", 0));
+}
+
 } // namespace tests
 } // namespace internal
 } // namespace ar
@@ -0,0 +1,124 @@
+///
+/// @file      ar/internal/utilities/stats_recorder_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c stats_recorder module.
+///
+
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "ar/extraction.h"
+#include "ar/internal/utilities/stats_recorder.h"
+#include "ar/memory_accounting.h"
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for BasicStatsRecorder.
+///
+class StatsRecorderTests: public testing::Test {};
+
+TEST_F(StatsRecorderTests,
+EnabledRecorderAddsRecordedValuesToStats) {
+	ExtractionStats stats;
+	stats.bytesRead = 10;
+	BasicStatsRecorder<true> recorder{&stats};
+
+	recorder.addBytesRead(5);
+	recorder.addParsedHeaders(2);
+	recorder.addNameTableHits(1);
+	recorder.addAllocations(3);
+	recorder.addBytesCopied(7);
+
+	ASSERT_TRUE(recorder.isRecording());
+	ASSERT_TRUE(stats.collected);
+	ASSERT_EQ(15, stats.bytesRead);
+	ASSERT_EQ(2, stats.headersParsed);
+	ASSERT_EQ(1, stats.nameTableHits);
+	ASSERT_EQ(3, stats.allocations);
+	ASSERT_EQ(7, stats.bytesCopied);
+}
+
+TEST_F(StatsRecorderTests,
+EnabledRecorderAddsDurationOfPhaseWhenPhaseEnds) {
+	ExtractionStats stats;
+	BasicStatsRecorder<true> recorder{&stats};
+
+	{
+		const auto phase = recorder.startPhase(&ExtractionStats::scanTime,
+			&ExtractionStats::scanMemory);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_GE(stats.scanTime, std::chrono::milliseconds(1));
+	ASSERT_EQ(0, stats.readTime.count());
+}
+
+TEST_F(StatsRecorderTests,
+EnabledRecorderRecordsMemoryUsedInPhaseWhenCounterIsRegistered) {
+	ExtractionStats stats;
+	BasicStatsRecorder<true> recorder{&stats};
+	MemoryCounter counter;
+	counter.recordAllocation(100);
+	counter.recordDeallocation(100);
+	counter.recordAllocation(10);
+	setMemoryCounter(&counter);
+
+	{
+		const auto phase = recorder.startPhase(&ExtractionStats::scanTime,
+			&ExtractionStats::scanMemory);
+		counter.recordAllocation(20);
+		counter.recordAllocation(30);
+		counter.recordDeallocation(30);
+	}
+	setMemoryCounter(nullptr);
+
+	ASSERT_EQ(2, stats.scanMemory.allocations);
+	ASSERT_EQ(50, stats.scanMemory.allocatedBytes);
+	ASSERT_EQ(30, stats.scanMemory.heldBytes);
+	ASSERT_EQ(60, stats.scanMemory.peakHeldBytes);
+	ASSERT_EQ(0, stats.readMemory.allocations);
+	// The overall peak of the counter is kept.
+	ASSERT_EQ(100, counter.getUsage().peakHeldBytes);
+}
+
+TEST_F(StatsRecorderTests,
+EnabledRecorderWithoutStatsRecordsNothing) {
+	BasicStatsRecorder<true> recorder;
+
+	recorder.addBytesRead(5);
+	const auto phase = recorder.startPhase(&ExtractionStats::scanTime,
+		&ExtractionStats::scanMemory);
+
+	ASSERT_FALSE(recorder.isRecording());
+}
+
+TEST_F(StatsRecorderTests,
+DisabledRecorderIsEmptyAndRecordsNothing) {
+	ExtractionStats stats;
+	BasicStatsRecorder<false> recorder{&stats};
+
+	recorder.addBytesRead(5);
+	recorder.addParsedHeaders(2);
+	{
+		const auto phase = recorder.startPhase(&ExtractionStats::scanTime,
+			&ExtractionStats::scanMemory);
+	}
+
+	ASSERT_TRUE(std::is_empty_v<BasicStatsRecorder<false>>);
+	ASSERT_FALSE(recorder.isRecording());
+	ASSERT_FALSE(stats.collected);
+	ASSERT_EQ(0, stats.bytesRead);
+	ASSERT_EQ(0, stats.headersParsed);
+	ASSERT_EQ(0, stats.scanTime.count());
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
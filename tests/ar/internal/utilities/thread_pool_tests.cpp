@@ -0,0 +1,122 @@
+///
+/// @file      ar/internal/utilities/thread_pool_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c thread_pool module.
+///
+
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include "ar/internal/utilities/thread_pool.h"
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for ThreadPool.
+///
+class ThreadPoolTests: public testing::Test {};
+
+TEST_F(ThreadPoolTests,
+PoolHasGivenNumberOfThreads) {
+	ThreadPool pool{3};
+
+	ASSERT_EQ(3, pool.getThreadCount());
+}
+
+TEST_F(ThreadPoolTests,
+PoolHasDefaultNumberOfThreadsWhenZeroIsGiven) {
+	ThreadPool pool{0};
+
+	ASSERT_EQ(ThreadPool::defaultThreadCount(), pool.getThreadCount());
+}
+
+TEST_F(ThreadPoolTests,
+WaitReturnsAfterAllSubmittedTasksHaveFinished) {
+	ThreadPool pool{4};
+	std::atomic<int> counter{0};
+
+	for (int j = 0; j < 1000; ++j) {
+		pool.submit([&counter]() { counter++; });
+	}
+	pool.wait();
+
+	ASSERT_EQ(1000, counter);
+}
+
+TEST_F(ThreadPoolTests,
+TasksSubmittedFromTasksAreAlsoWaitedFor) {
+	ThreadPool pool{4};
+	std::atomic<int> counter{0};
+
+	for (int j = 0; j < 10; ++j) {
+		pool.submit([&pool, &counter]() {
+			for (int k = 0; k < 10; ++k) {
+				pool.submit([&counter]() { counter++; });
+			}
+		});
+	}
+	pool.wait();
+
+	ASSERT_EQ(100, counter);
+}
+
+TEST_F(ThreadPoolTests,
+WaitRethrowsExceptionThrownByTask) {
+	ThreadPool pool{2};
+
+	pool.submit([]() { throw std::runtime_error{"error"}; });
+
+	ASSERT_THROW(pool.wait(), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTests,
+PoolCanBeReusedAfterWait) {
+	ThreadPool pool{2};
+	std::atomic<int> counter{0};
+	pool.submit([&counter]() { counter++; });
+	pool.wait();
+
+	pool.submit([&counter]() { counter++; });
+	pool.wait();
+
+	ASSERT_EQ(2, counter);
+}
+
+///
+/// Tests for createPoolForCaller().
+///
+class CreatePoolForCallerTests: public testing::Test {};
+
+TEST_F(CreatePoolForCallerTests,
+PoolHasOneThreadLessThanGivenNumberOfThreads) {
+	auto pool = createPoolForCaller(4);
+
+	ASSERT_NE(nullptr, pool);
+	ASSERT_EQ(3, pool->getThreadCount());
+}
+
+TEST_F(CreatePoolForCallerTests,
+NoPoolIsCreatedForSingleThread) {
+	ASSERT_EQ(nullptr, createPoolForCaller(1));
+}
+
+TEST_F(CreatePoolForCallerTests,
+PoolForZeroThreadsIsCreatedForDefaultNumberOfThreads) {
+	auto pool = createPoolForCaller(0);
+
+	if (ThreadPool::defaultThreadCount() == 1) {
+		ASSERT_EQ(nullptr, pool);
+	} else {
+		ASSERT_EQ(ThreadPool::defaultThreadCount() - 1,
+			pool->getThreadCount());
+	}
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,63 @@
+///
+/// @file      ar/internal/writers/batch_writer_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c batch_writer module.
+///
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/writers/batch_writer.h"
+#include "ar/internal/writers/io_uring_batch_writer.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for BatchWriter.
+///
+class BatchWriterTests: public testing::Test {};
+
+TEST_F(BatchWriterTests,
+CreateReturnsIoUringWriterWhenIoUringIsSupported) {
+	auto writer = BatchWriter::create(2);
+
+	ASSERT_EQ(IoUringBatchWriter::isSupported(), writer->usesIoUring());
+}
+
+TEST_F(BatchWriterTests,
+FilesAreWrittenOnlyAfterFlush) {
+	const std::string Path{"ar-batch-writer-test-flush.txt"};
+	RemoveFileOnDestruction remover{Path};
+	auto writer = BatchWriter::create(2);
+
+	writer->write(Path, "content", 7);
+
+	ASSERT_EQ(1, writer->getPendingCount());
+	writer->flush();
+	ASSERT_EQ(0, writer->getPendingCount());
+	ASSERT_EQ("content", readFile(Path));
+}
+
+TEST_F(BatchWriterTests,
+FileWrittenLastIsKeptWhenSamePathIsWrittenTwice) {
+	const std::string Path{"ar-batch-writer-test-same-path.txt"};
+	RemoveFileOnDestruction remover{Path};
+	auto writer = BatchWriter::create(2);
+
+	writer->write(Path, "first", 5);
+	writer->write(Path, "second", 6);
+	writer->flush();
+
+	ASSERT_EQ("second", readFile(Path));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
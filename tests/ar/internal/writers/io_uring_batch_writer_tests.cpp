@@ -0,0 +1,89 @@
+///
+/// @file      ar/internal/writers/io_uring_batch_writer_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c io_uring_batch_writer module.
+///
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/writers/io_uring_batch_writer.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for IoUringBatchWriter.
+///
+class IoUringBatchWriterTests: public testing::Test {
+protected:
+	virtual void SetUp() override;
+};
+
+void IoUringBatchWriterTests::SetUp() {
+	if (!IoUringBatchWriter::isSupported()) {
+		GTEST_SKIP() << "io_uring is not supported on this system";
+	}
+}
+
+TEST_F(IoUringBatchWriterTests,
+FlushWritesAllFilesEvenWhenThereAreMoreFilesThanFitIntoRing) {
+	std::vector<std::string> paths;
+	std::vector<std::unique_ptr<RemoveFileOnDestruction>> removers;
+	for (int j = 0; j < 300; ++j) {
+		paths.push_back("ar-io-uring-batch-writer-test-" +
+			std::to_string(j) + ".txt");
+		removers.push_back(
+			std::make_unique<RemoveFileOnDestruction>(paths.back()));
+	}
+	IoUringBatchWriter writer;
+
+	for (const auto& path : paths) {
+		writer.write(path, path.data(), path.size());
+	}
+	writer.flush();
+
+	ASSERT_TRUE(writer.usesIoUring());
+	for (const auto& path : paths) {
+		ASSERT_EQ(path, readFile(path));
+	}
+}
+
+TEST_F(IoUringBatchWriterTests,
+FlushWritesEmptyFiles) {
+	const std::string Path{"ar-io-uring-batch-writer-test-empty.txt"};
+	RemoveFileOnDestruction remover{Path};
+	writeFile(Path, "previous content");
+	IoUringBatchWriter writer;
+
+	writer.write(Path, "", 0);
+	writer.flush();
+
+	ASSERT_EQ("", readFile(Path));
+}
+
+TEST_F(IoUringBatchWriterTests,
+FlushThrowsIOErrorWhenFileCannotBeOpenedButWritesOtherFiles) {
+	const std::string Path{"ar-io-uring-batch-writer-test-other.txt"};
+	RemoveFileOnDestruction remover{Path};
+	IoUringBatchWriter writer;
+
+	writer.write("/nonexisting-directory/file.txt", "a", 1);
+	writer.write(Path, "b", 1);
+
+	ASSERT_THROW(writer.flush(), IOError);
+	ASSERT_EQ("b", readFile(Path));
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
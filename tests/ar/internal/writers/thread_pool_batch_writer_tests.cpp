@@ -0,0 +1,79 @@
+///
+/// @file      ar/internal/writers/thread_pool_batch_writer_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c thread_pool_batch_writer module.
+///
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/writers/thread_pool_batch_writer.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::tests;
+
+namespace ar {
+namespace internal {
+namespace tests {
+
+///
+/// Tests for ThreadPoolBatchWriter.
+///
+class ThreadPoolBatchWriterTests: public testing::Test {};
+
+TEST_F(ThreadPoolBatchWriterTests,
+FlushWritesAllFiles) {
+	const std::string PathA{"ar-thread-pool-batch-writer-test-a.txt"};
+	const std::string PathB{"ar-thread-pool-batch-writer-test-b.txt"};
+	RemoveFileOnDestruction removerA{PathA};
+	RemoveFileOnDestruction removerB{PathB};
+	ThreadPoolBatchWriter writer{2};
+
+	writer.write(PathA, "a", 1);
+	writer.write(PathB, "bb", 2);
+	writer.flush();
+
+	ASSERT_FALSE(writer.usesIoUring());
+	ASSERT_EQ("a", readFile(PathA));
+	ASSERT_EQ("bb", readFile(PathB));
+}
+
+TEST_F(ThreadPoolBatchWriterTests,
+FlushWritesAllFilesWhenThereIsSingleThread) {
+	const std::string PathA{"ar-thread-pool-batch-writer-test-a.txt"};
+	const std::string PathB{"ar-thread-pool-batch-writer-test-b.txt"};
+	RemoveFileOnDestruction removerA{PathA};
+	RemoveFileOnDestruction removerB{PathB};
+	ThreadPoolBatchWriter writer{1};
+
+	writer.write(PathA, "a", 1);
+	writer.write(PathB, "bb", 2);
+	writer.flush();
+
+	ASSERT_EQ("a", readFile(PathA));
+	ASSERT_EQ("bb", readFile(PathB));
+}
+
+TEST_F(ThreadPoolBatchWriterTests,
+FlushThrowsIOErrorWhenFileCannotBeWrittenInSingleThread) {
+	ThreadPoolBatchWriter writer{1};
+
+	writer.write("/nonexisting-directory/file.txt", "a", 1);
+
+	ASSERT_THROW(writer.flush(), IOError);
+}
+
+TEST_F(ThreadPoolBatchWriterTests,
+FlushThrowsIOErrorWhenFileCannotBeWritten) {
+	ThreadPoolBatchWriter writer{2};
+
+	writer.write("/nonexisting-directory/file.txt", "a", 1);
+
+	ASSERT_THROW(writer.flush(), IOError);
+}
+
+} // namespace tests
+} // namespace internal
+} // namespace ar
@@ -0,0 +1,242 @@
+///
+/// @file      ar/member_table_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c member_table module.
+///
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/file.h"
+#include "ar/member_table.h"
+#include "ar/test_utilities/unmapped_byte_source.h"
+
+namespace ar {
+namespace tests {
+
+namespace {
+
+const std::string ArchiveWithThreeMembers =
+	"!<arch>\n"
+	"c.txt/          3           0     0     644     1         `\n"
+	"c\n"
+	"a.txt/          1           0     0     600     2         `\n"
+	"aa"
+	"b.txt/          2           0     0     755     3         `\n"
+	"bbb\n";
+
+MemberTable scanArchiveWithThreeMembers() {
+	return scanMembers(
+		File::fromContentWithName(ArchiveWithThreeMembers, "archive.a")
+	);
+}
+
+} // anonymous namespace
+
+///
+/// Tests for MemberTable.
+///
+class MemberTableTests: public testing::Test {};
+
+TEST_F(MemberTableTests,
+DefaultConstructedTableIsEmpty) {
+	MemberTable table;
+
+	ASSERT_TRUE(table.empty());
+	ASSERT_EQ(0, table.size());
+	ASSERT_TRUE(table.toFiles().empty());
+}
+
+TEST_F(MemberTableTests,
+TableHasColumnsInOrderOfArchive) {
+	auto table = scanArchiveWithThreeMembers();
+
+	ASSERT_EQ(3, table.size());
+	ASSERT_EQ("c.txt", table.getName(0));
+	ASSERT_EQ("a.txt", table.getName(1));
+	ASSERT_EQ("b.txt", table.getName(2));
+	ASSERT_EQ((std::vector<std::uint64_t>{1, 2, 3}), table.getSizes());
+	ASSERT_EQ((std::vector<std::uint64_t>{3, 1, 2}), table.getTimestamps());
+	ASSERT_EQ((std::vector<std::uint32_t>{0644, 0600, 0755}),
+		table.getModes());
+}
+
+TEST_F(MemberTableTests,
+TableHasChecksumsOnlyWhenTheyWereComputed) {
+	ExtractionOptions options;
+	options.computeChecksums = true;
+	auto tableWithChecksums = scanMembers(
+		File::fromContentWithName(
+			"!<arch>\n"
+			"b.txt/          0           0     0     644     9         `\n"
+			"123456789\n"
+			"a.txt/          0           0     0     644     1         `\n"
+			"a\n"
+		,
+			"archive.a"
+		),
+		options
+	);
+	auto tableWithoutChecksums = scanArchiveWithThreeMembers();
+
+	tableWithChecksums.sortByName();
+
+	ASSERT_TRUE(tableWithChecksums.hasChecksums());
+	ASSERT_EQ(0xe3069283, tableWithChecksums.getChecksum(1));
+	ASSERT_FALSE(tableWithoutChecksums.hasChecksums());
+	ASSERT_THROW(tableWithoutChecksums.getChecksum(0), std::out_of_range);
+}
+
+TEST_F(MemberTableTests,
+GetNameThrowsOutOfRangeForInvalidIndex) {
+	auto table = scanArchiveWithThreeMembers();
+
+	ASSERT_THROW(table.getName(3), std::out_of_range);
+}
+
+TEST_F(MemberTableTests,
+FindReturnsIndexOfMemberOfGivenName) {
+	auto table = scanArchiveWithThreeMembers();
+
+	ASSERT_EQ(1, table.find("a.txt"));
+	ASSERT_EQ(MemberTable::npos, table.find("a.tx"));
+	ASSERT_EQ(MemberTable::npos, table.find("d.txt"));
+}
+
+TEST_F(MemberTableTests,
+GetContentViewReturnsContentOfMember) {
+	auto table = scanArchiveWithThreeMembers();
+
+	ASSERT_EQ("c", table.getContentView(0));
+	ASSERT_EQ("aa", table.getContentView(1));
+	ASSERT_EQ("bbb", table.getContentView(2));
+}
+
+TEST_F(MemberTableTests,
+ReadRangeReturnsGivenRangeOfContentOfMember) {
+	auto table = scanArchiveWithThreeMembers();
+
+	ASSERT_EQ("bb", table.readRange(2, 1, 2));
+	ASSERT_EQ("", table.readRange(2, 3, 0));
+}
+
+TEST_F(MemberTableTests,
+ReadRangeThrowsOutOfRangeForRangeOutsideOfMember) {
+	auto table = scanArchiveWithThreeMembers();
+
+	ASSERT_THROW(table.readRange(2, 2, 2), std::out_of_range);
+	ASSERT_THROW(table.readRange(2, 4, 0), std::out_of_range);
+	ASSERT_THROW(table.readRange(2, 1, UINT64_MAX), std::out_of_range);
+	ASSERT_THROW(table.readRange(3, 0, 0), std::out_of_range);
+}
+
+TEST_F(MemberTableTests,
+ReadRangeOfSortedTableReturnsRangeOfSameMember) {
+	auto table = scanArchiveWithThreeMembers();
+
+	table.sortByName();
+
+	ASSERT_EQ("a", table.readRange(0, 1, 1));
+}
+
+TEST_F(MemberTableTests,
+SortByNameReordersAllColumns) {
+	auto table = scanArchiveWithThreeMembers();
+
+	table.sortByName();
+
+	ASSERT_EQ("a.txt", table.getName(0));
+	ASSERT_EQ("b.txt", table.getName(1));
+	ASSERT_EQ("c.txt", table.getName(2));
+	ASSERT_EQ((std::vector<std::uint64_t>{2, 3, 1}), table.getSizes());
+	ASSERT_EQ((std::vector<std::uint32_t>{0600, 0755, 0644}),
+		table.getModes());
+}
+
+TEST_F(MemberTableTests,
+ToFilesReturnsFilesWithContentOfMembers) {
+	auto table = scanArchiveWithThreeMembers();
+	table.sortByName();
+
+	auto files = table.toFiles();
+
+	ASSERT_EQ(3, files.size());
+	auto it = files.begin();
+	ASSERT_EQ("a.txt", (*it)->getName());
+	ASSERT_EQ("aa", (*it)->getContent());
+	++it;
+	ASSERT_EQ("b.txt", (*it)->getName());
+	ASSERT_EQ("bbb", (*it)->getContent());
+	++it;
+	ASSERT_EQ("c.txt", (*it)->getName());
+	ASSERT_EQ("c", (*it)->getContent());
+}
+
+TEST_F(MemberTableTests,
+CopiedTableIsIndependentOfOriginal) {
+	auto table = scanArchiveWithThreeMembers();
+	auto copy = table;
+
+	table.sortByName();
+
+	ASSERT_EQ("c.txt", copy.getName(0));
+	ASSERT_EQ("c", copy.toFiles().front()->getContent());
+}
+
+TEST_F(MemberTableTests,
+ReadRangeIntoBufferCopiesRangeOfMember) {
+	auto table = scanArchiveWithThreeMembers();
+	char buffer[2] = {};
+
+	table.readRange(2, 1, 2, buffer);
+
+	ASSERT_EQ("bb", std::string(buffer, 2));
+}
+
+TEST_F(MemberTableTests,
+ReadRangeIntoBufferReadsOnlyRangeFromSourceNotInMemory) {
+	auto source = UnmappedByteSource::createWithContent(
+		ArchiveWithThreeMembers);
+	auto table = scanMembers(source);
+	const auto readByteCountAfterScan = source->getReadByteCount();
+	char buffer[2] = {};
+
+	table.readRange(2, 1, 2, buffer);
+
+	ASSERT_EQ("bb", std::string(buffer, 2));
+	ASSERT_EQ(readByteCountAfterScan + 2, source->getReadByteCount());
+	ASSERT_THROW(table.readRange(2, 2, 2, buffer), std::out_of_range);
+}
+
+TEST_F(MemberTableTests,
+ViewsOfContentOfTableFromSourceNotInMemoryThrowError) {
+	auto table = scanMembers(
+		UnmappedByteSource::createWithContent(ArchiveWithThreeMembers));
+
+	ASSERT_THROW(table.getContentView(0), Error);
+	ASSERT_THROW(table.readRange(0, 0, 1), Error);
+}
+
+TEST_F(MemberTableTests,
+ToFilesOfTableFromSourceNotInMemoryReturnsFilesReadingSource) {
+	auto table = scanMembers(
+		UnmappedByteSource::createWithContent(ArchiveWithThreeMembers));
+	table.sortByName();
+
+	auto files = table.toFiles();
+
+	ASSERT_EQ(3, files.size());
+	ASSERT_EQ("a.txt", files.front()->getName());
+	ASSERT_EQ("aa", files.front()->getContent());
+	ASSERT_EQ("c", files.back()->getContent());
+}
+
+} // namespace tests
+} // namespace ar
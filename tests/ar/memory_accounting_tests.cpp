@@ -0,0 +1,165 @@
+///
+/// @file      ar/memory_accounting_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c memory_accounting module.
+///
+
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ar/memory_accounting.h"
+
+namespace ar {
+namespace tests {
+
+///
+/// Tests for MemoryCounter.
+///
+class MemoryCounterTests: public testing::Test {};
+
+TEST_F(MemoryCounterTests,
+CounterCountsNothingAfterCreation) {
+	MemoryCounter counter;
+
+	const auto usage = counter.getUsage();
+
+	ASSERT_EQ(0, usage.allocations);
+	ASSERT_EQ(0, usage.allocatedBytes);
+	ASSERT_EQ(0, usage.heldBytes);
+	ASSERT_EQ(0, usage.peakHeldBytes);
+}
+
+TEST_F(MemoryCounterTests,
+CounterCountsAllocationsAndDeallocations) {
+	MemoryCounter counter;
+
+	counter.recordAllocation(10);
+	counter.recordAllocation(20);
+	counter.recordDeallocation(10);
+	counter.recordAllocation(5);
+
+	const auto usage = counter.getUsage();
+	ASSERT_EQ(3, usage.allocations);
+	ASSERT_EQ(35, usage.allocatedBytes);
+	ASSERT_EQ(25, usage.heldBytes);
+	ASSERT_EQ(30, usage.peakHeldBytes);
+}
+
+TEST_F(MemoryCounterTests,
+ResetPeakSetsPeakToHeldBytesAndReturnsPreviousPeak) {
+	MemoryCounter counter;
+	counter.recordAllocation(10);
+	counter.recordAllocation(20);
+	counter.recordDeallocation(20);
+
+	ASSERT_EQ(30, counter.resetPeak());
+	ASSERT_EQ(10, counter.getUsage().peakHeldBytes);
+}
+
+TEST_F(MemoryCounterTests,
+RaisePeakRaisesOnlyLowerPeak) {
+	MemoryCounter counter;
+	counter.recordAllocation(10);
+
+	counter.raisePeak(5);
+	ASSERT_EQ(10, counter.getUsage().peakHeldBytes);
+
+	counter.raisePeak(50);
+	ASSERT_EQ(50, counter.getUsage().peakHeldBytes);
+}
+
+TEST_F(MemoryCounterTests,
+CounterCountsAllocationsFromMultipleThreads) {
+	const std::size_t ThreadCount = 4;
+	const std::size_t AllocationCount = 1000;
+	MemoryCounter counter;
+
+	std::vector<std::thread> threads;
+	for (std::size_t j = 0; j < ThreadCount; ++j) {
+		threads.emplace_back([&counter] {
+			for (std::size_t k = 0; k < AllocationCount; ++k) {
+				counter.recordAllocation(2);
+				counter.recordDeallocation(1);
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	const auto usage = counter.getUsage();
+	ASSERT_EQ(ThreadCount * AllocationCount, usage.allocations);
+	ASSERT_EQ(2 * ThreadCount * AllocationCount, usage.allocatedBytes);
+	ASSERT_EQ(ThreadCount * AllocationCount, usage.heldBytes);
+	ASSERT_LE(usage.heldBytes, usage.peakHeldBytes);
+}
+
+TEST_F(MemoryCounterTests,
+RegisteredCounterIsReturned) {
+	MemoryCounter counter;
+
+	setMemoryCounter(&counter);
+	ASSERT_EQ(&counter, getMemoryCounter());
+
+	setMemoryCounter(nullptr);
+	ASSERT_EQ(nullptr, getMemoryCounter());
+}
+
+///
+/// Tests for CountingMemoryResource.
+///
+class CountingMemoryResourceTests: public testing::Test {};
+
+TEST_F(CountingMemoryResourceTests,
+DefaultResourceAllocatesFromNewDeleteResource) {
+	CountingMemoryResource resource;
+
+	ASSERT_EQ(std::pmr::new_delete_resource(), resource.getUpstream());
+}
+
+TEST_F(CountingMemoryResourceTests,
+ResourceCountsMemoryAllocatedFromIt) {
+	CountingMemoryResource resource;
+
+	{
+		std::pmr::string str(100, 'x', &resource);
+		ASSERT_EQ(1, resource.getUsage().allocations);
+		ASSERT_LE(100, resource.getUsage().heldBytes);
+	}
+
+	const auto usage = resource.getUsage();
+	ASSERT_EQ(1, usage.allocations);
+	ASSERT_LE(100, usage.allocatedBytes);
+	ASSERT_EQ(0, usage.heldBytes);
+	ASSERT_EQ(usage.allocatedBytes, usage.peakHeldBytes);
+}
+
+TEST_F(CountingMemoryResourceTests,
+ResourceAllocatesFromUpstream) {
+	CountingMemoryResource upstream;
+	CountingMemoryResource resource{&upstream};
+
+	{
+		std::pmr::vector<int> v(10, 0, &resource);
+	}
+
+	ASSERT_EQ(1, upstream.getUsage().allocations);
+	ASSERT_EQ(1, resource.getUsage().allocations);
+}
+
+TEST_F(CountingMemoryResourceTests,
+ResourceIsEqualOnlyToItself) {
+	CountingMemoryResource resource1;
+	CountingMemoryResource resource2;
+
+	ASSERT_TRUE(resource1.is_equal(resource1));
+	ASSERT_FALSE(resource1.is_equal(resource2));
+}
+
+} // namespace tests
+} // namespace ar
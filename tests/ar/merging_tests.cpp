@@ -0,0 +1,195 @@
+///
+/// @file      ar/merging_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c merging module.
+///
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/archive_editor.h"
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/member_table.h"
+#include "ar/merging.h"
+#include "ar/test_utilities/built_archive.h"
+#include "ar/test_utilities/tmp_file.h"
+
+using namespace ar::internal;
+
+namespace ar {
+namespace tests {
+
+///
+/// Tests for mergeArchives().
+///
+class MergeArchivesTests: public testing::Test {
+protected:
+	MergeArchivesTests():
+		outputFile(TmpFile::createWithContent("")) {}
+
+	/// The merged archive.
+	std::unique_ptr<TmpFile> outputFile;
+};
+
+TEST_F(MergeArchivesTests,
+MergedArchiveContainsMembersOfAllArchivesInOrder) {
+	auto tmpFile1 = TmpFile::createWithContent("!<arch>\n");
+	auto tmpFile2 = TmpFile::createWithContent("!<arch>\n");
+	{
+		ArchiveEditor editor1{tmpFile1->getPath()};
+		editor1.append("a.o", "aaa");
+		editor1.append("b.o", "bb");
+		ArchiveEditor editor2{tmpFile2->getPath()};
+		editor2.append("c.o", "c");
+		editor2.append("a.o", "second a.o");
+	}
+
+	auto report = mergeArchives({tmpFile1->getPath(), tmpFile2->getPath()},
+		outputFile->getPath());
+
+	ASSERT_EQ(Members({
+			{"a.o", "aaa"}, {"b.o", "bb"}, {"c.o", "c"}, {"a.o", "second a.o"}
+		}),
+		membersOf(outputFile->getPath()));
+	ASSERT_EQ(4, report.memberCount);
+	ASSERT_EQ(16, report.contentSize);
+	ASSERT_EQ(readFile(outputFile->getPath()).size(), report.archiveSize);
+}
+
+TEST_F(MergeArchivesTests,
+MergedArchiveKeepsAttributesOfMembers) {
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	MemberAttributes attributes;
+	attributes.timestamp = 1500000000;
+	attributes.ownerId = 1000;
+	attributes.mode = 0755;
+	ArchiveEditor{tmpFile->getPath()}.append("a.o", "aaa", attributes);
+
+	mergeArchives({tmpFile->getPath()}, outputFile->getPath());
+
+	auto table = scanMembers(File::fromFilesystem(outputFile->getPath()));
+	ASSERT_EQ(1500000000, table.getTimestamp(0));
+	ASSERT_EQ(1000, table.getOwnerId(0));
+	ASSERT_EQ(0755, table.getMode(0));
+}
+
+TEST_F(MergeArchivesTests,
+MergedArchiveStoresLongNamesOfAllArchivesInSingleFilenameTable) {
+	auto tmpFile1 = TmpFile::createWithContent("!<arch>\n");
+	auto tmpFile2 = TmpFile::createWithContent("!<arch>\n");
+	ArchiveEditor{tmpFile1->getPath()}.append("first-long-name.o", "1");
+	{
+		ArchiveEditor editor2{tmpFile2->getPath()};
+		editor2.append("second-long-name.o", "2");
+		editor2.append("first-long-name.o", "3");
+	}
+
+	mergeArchives({tmpFile1->getPath(), tmpFile2->getPath()},
+		outputFile->getPath());
+
+	ASSERT_EQ(Members({
+			{"first-long-name.o", "1"}, {"second-long-name.o", "2"},
+			{"first-long-name.o", "3"}
+		}),
+		membersOf(outputFile->getPath()));
+	const auto archive = readFile(outputFile->getPath());
+	ASSERT_NE(std::string::npos,
+		archive.find("first-long-name.o/\nsecond-long-name.o/\n"));
+	ASSERT_EQ(archive.find("first-long-name.o"),
+		archive.rfind("first-long-name.o"));
+}
+
+TEST_F(MergeArchivesTests,
+MergedArchiveContainsCombinedSymbolTable) {
+	auto tmpFile1 = TmpFile::createWithContent(archiveWithMembers(
+		{{"a.o", "aaa"}, {"b.o", "bbbb"}}, {{"funcB", 1}, {"funcA", 0}}
+	));
+	auto tmpFile2 = TmpFile::createWithContent(archiveWithMembers(
+		{{"c.o", "c"}}, {{"funcC", 0}}
+	));
+	ArchiveEditor{tmpFile2->getPath()}.append("long-name-of-member.o", "d");
+
+	auto report = mergeArchives({tmpFile1->getPath(), tmpFile2->getPath()},
+		outputFile->getPath());
+
+	ASSERT_EQ(
+		Symbols({{"funcB", "b.o"}, {"funcA", "a.o"}, {"funcC", "c.o"}}),
+		symbolsOf(outputFile->getPath())
+	);
+	ASSERT_EQ(Members({
+			{"a.o", "aaa"}, {"b.o", "bbbb"}, {"c.o", "c"},
+			{"long-name-of-member.o", "d"}
+		}),
+		membersOf(outputFile->getPath()));
+	ASSERT_EQ(3, report.symbolCount);
+}
+
+TEST_F(MergeArchivesTests,
+MergedArchiveHasNoSymbolTableWhenDisabled) {
+	auto tmpFile = TmpFile::createWithContent(archiveWithMembers(
+		{{"a.o", "aaa"}}, {{"funcA", 0}}
+	));
+	MergeOptions options;
+	options.symbolTable = false;
+
+	auto report = mergeArchives({tmpFile->getPath()}, outputFile->getPath(),
+		options);
+
+	ASSERT_TRUE(symbolsOf(outputFile->getPath()).empty());
+	ASSERT_EQ(0, report.symbolCount);
+	ASSERT_EQ(Members({{"a.o", "aaa"}}), membersOf(outputFile->getPath()));
+}
+
+TEST_F(MergeArchivesTests,
+MergingLargeMembersCopiesTheirWholeContent) {
+	std::string large(3 * 1024 * 1024 + 1, 'x');
+	large.back() = 'y';
+	auto tmpFile = TmpFile::createWithContent("!<arch>\n");
+	{
+		ArchiveEditor editor{tmpFile->getPath()};
+		editor.append("a.o", "a");
+		editor.append("large.o", large);
+	}
+
+	mergeArchives({tmpFile->getPath(), tmpFile->getPath()},
+		outputFile->getPath());
+
+	ASSERT_EQ(Members({
+			{"a.o", "a"}, {"large.o", large}, {"a.o", "a"}, {"large.o", large}
+		}),
+		membersOf(outputFile->getPath()));
+}
+
+TEST_F(MergeArchivesTests,
+MergingNoArchivesCreatesEmptyArchive) {
+	mergeArchives({}, outputFile->getPath());
+
+	ASSERT_EQ("!<arch>\n", readFile(outputFile->getPath()));
+}
+
+TEST_F(MergeArchivesTests,
+ThrowsErrorWhenMergedArchiveIsOneOfArchives) {
+	ASSERT_THROW(
+		mergeArchives({outputFile->getPath()}, outputFile->getPath()),
+		Error
+	);
+}
+
+TEST_F(MergeArchivesTests,
+ThrowsInvalidArchiveErrorWhenArchiveIsInvalid) {
+	auto tmpFile = TmpFile::createWithContent("not an archive");
+
+	ASSERT_THROW(
+		mergeArchives({tmpFile->getPath()}, outputFile->getPath()),
+		InvalidArchiveError
+	);
+}
+
+} // namespace tests
+} // namespace ar
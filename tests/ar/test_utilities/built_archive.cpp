@@ -0,0 +1,129 @@
+///
+/// @file      ar/test_utilities/built_archive.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the utilities for building archives.
+///
+
+#include <cstdint>
+#include <string_view>
+
+#include "ar/extraction.h"
+#include "ar/file.h"
+#include "ar/internal/archive_format.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/test_utilities/built_archive.h"
+
+using namespace ar::internal;
+
+namespace ar {
+namespace tests {
+
+namespace {
+
+///
+/// Returns the given content followed by its padding.
+///
+std::string padded(const std::string& content) {
+	return content.size() % 2 != 0 ? content + "\n" : content;
+}
+
+} // anonymous namespace
+
+///
+/// Returns the content of an archive with the given members (pairs of names
+/// and contents), and optionally with a symbol table of the given symbols
+/// (pairs of symbols and indexes of the members defining them).
+///
+/// The archive is laid out like the ones created by GNU ar: names longer than
+/// @c MaxShortNameSize are stored in a filename table, which follows the
+/// symbol table. Members have zero timestamps, owner and group IDs, and mode
+/// @c 644.
+///
+std::string archiveWithMembers(const Members& members,
+		const std::vector<std::pair<std::string, std::size_t>>& symbols) {
+	std::string nameTable;
+	std::vector<std::string> nameFields;
+	for (const auto& member : members) {
+		if (member.first.size() > MaxShortNameSize) {
+			nameFields.push_back("/" + std::to_string(nameTable.size()));
+			nameTable += member.first + "/\n";
+		} else {
+			nameFields.push_back(member.first + "/");
+		}
+	}
+
+	std::string membersContent;
+	if (!nameTable.empty()) {
+		membersContent = formatNameTableHeader(nameTable.size()) +
+			padded(nameTable);
+	}
+	std::uint64_t namesSize = 0;
+	for (const auto& symbol : symbols) {
+		namesSize += symbol.first.size() + 1;
+	}
+	const auto membersStart = ArchiveMagicString.size() + (symbols.empty() ?
+		0 : symbolTableSize(symbols.size(), namesSize, false));
+	std::vector<std::uint64_t> headerOffsets;
+	for (std::size_t k = 0; k < members.size(); ++k) {
+		headerOffsets.push_back(membersStart + membersContent.size());
+		membersContent += formatMemberHeader(nameFields[k], 0, 0, 0, 0644,
+			members[k].second.size()) + padded(members[k].second);
+	}
+
+	std::string archive{ArchiveMagicString};
+	if (!symbols.empty()) {
+		std::vector<Symbol> table;
+		for (const auto& symbol : symbols) {
+			table.push_back(Symbol{symbol.first, headerOffsets[symbol.second]});
+		}
+		const auto symbolTable = formatSymbolTable(table, false);
+		archive += formatSymbolTableHeader(symbolTable.size(), false) +
+			padded(symbolTable);
+	}
+	return archive + membersContent;
+}
+
+///
+/// Returns the members (pairs of names and contents) extracted from the
+/// archive in the given path.
+///
+Members membersOf(const std::string& path) {
+	Members members;
+	for (const auto& file : extract(File::fromFilesystem(path))) {
+		members.emplace_back(file->getName(), file->getContent());
+	}
+	return members;
+}
+
+///
+/// Returns the symbols from the symbol table of the archive in the given path
+/// (pairs of symbols and names of the members whose headers they refer to).
+///
+/// Returns an empty vector when the archive has no symbol table.
+///
+Symbols symbolsOf(const std::string& path) {
+	const auto archive = readFile(path);
+	const std::size_t tableStart = ArchiveMagicString.size() + 60;
+	if (!isSymbolTableName(archive.substr(ArchiveMagicString.size(), 16))) {
+		return {};
+	}
+	const auto nameTableStart = archive.find("//");
+	Symbols symbols;
+	for (const auto& symbol : parseSymbolTable(
+			std::string_view{archive}.substr(tableStart), false)) {
+		const auto nameField = archive.substr(symbol.headerOffset, 16);
+		auto name = nameField.substr(0, nameField.find('/'));
+		if (nameField[0] == '/') {
+			const auto nameStart = nameTableStart + 60 +
+				std::stoul(nameField.substr(1));
+			name = archive.substr(nameStart,
+				archive.find('/', nameStart) - nameStart);
+		}
+		symbols.emplace_back(symbol.name, name);
+	}
+	return symbols;
+}
+
+} // namespace tests
+} // namespace ar
@@ -0,0 +1,34 @@
+///
+/// @file      ar/tests/test_utilities/built_archive.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Utilities for building archives with given members.
+///
+
+#ifndef AR_TESTS_TEST_UTILITIES_BUILT_ARCHIVE_H
+#define AR_TESTS_TEST_UTILITIES_BUILT_ARCHIVE_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ar {
+namespace tests {
+
+/// Members of an archive (pairs of names and contents).
+using Members = std::vector<std::pair<std::string, std::string>>;
+
+/// Symbols of an archive (pairs of symbols and names of the members whose
+/// headers they refer to).
+using Symbols = std::vector<std::pair<std::string, std::string>>;
+
+std::string archiveWithMembers(const Members& members,
+	const std::vector<std::pair<std::string, std::size_t>>& symbols = {});
+Members membersOf(const std::string& path);
+Symbols symbolsOf(const std::string& path);
+
+} // namespace tests
+} // namespace ar
+
+#endif
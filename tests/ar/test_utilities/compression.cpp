@@ -0,0 +1,65 @@
+///
+/// @file      ar/test_utilities/compression.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the compression utilities.
+///
+
+#include <stdexcept>
+
+#include "ar/test_utilities/compression.h"
+
+#ifdef AR_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ar {
+namespace tests {
+
+///
+/// Can the tests compress content by gzip (i.e. were they built with zlib)?
+///
+bool canCompressByGzip() {
+#ifdef AR_HAVE_ZLIB
+	return true;
+#else
+	return false;
+#endif
+}
+
+///
+/// Returns the given content compressed by gzip.
+///
+/// @throws std::runtime_error When the content cannot be compressed.
+///
+std::string compressByGzip(const std::string& content) {
+#ifdef AR_HAVE_ZLIB
+	z_stream stream{};
+	// 15 is the maximal window size, and 16 makes zlib write the gzip header.
+	if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8,
+			Z_DEFAULT_STRATEGY) != Z_OK) {
+		throw std::runtime_error("cannot initialize the compression");
+	}
+
+	std::string compressed(deflateBound(&stream,
+		static_cast<uLong>(content.size())) + 32, '\0');
+	stream.next_in = reinterpret_cast<Bytef*>(
+		const_cast<char*>(content.data()));
+	stream.avail_in = static_cast<uInt>(content.size());
+	stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+	stream.avail_out = static_cast<uInt>(compressed.size());
+	const auto result = deflate(&stream, Z_FINISH);
+	compressed.resize(stream.total_out);
+	deflateEnd(&stream);
+	if (result != Z_STREAM_END) {
+		throw std::runtime_error("cannot compress the content");
+	}
+	return compressed;
+#else
+	(void)content;
+	throw std::runtime_error("the tests were built without zlib");
+#endif
+}
+
+} // namespace tests
+} // namespace ar
@@ -0,0 +1,22 @@
+///
+/// @file      ar/tests/test_utilities/compression.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Compression utilities.
+///
+
+#ifndef AR_TESTS_TEST_UTILITIES_COMPRESSION_H
+#define AR_TESTS_TEST_UTILITIES_COMPRESSION_H
+
+#include <string>
+
+namespace ar {
+namespace tests {
+
+bool canCompressByGzip();
+std::string compressByGzip(const std::string& content);
+
+} // namespace tests
+} // namespace ar
+
+#endif
@@ -0,0 +1,38 @@
+///
+/// @file      ar/test_utilities/generated_archive.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the generated-archive utilities.
+///
+
+#include <sstream>
+
+#include "ar/test_utilities/generated_archive.h"
+
+namespace ar {
+namespace tests {
+
+///
+/// Returns the content of an archive generated with the given options.
+///
+std::string generateArchiveContent(const GenerationOptions& options) {
+	std::ostringstream content;
+	generateArchive(content, options);
+	return content.str();
+}
+
+///
+/// Generates an archive with the given options into a temporary file.
+///
+/// The archive is streamed into the file, so also large archives can be
+/// generated.
+///
+std::unique_ptr<TmpFile> generateArchiveFile(
+		const GenerationOptions& options) {
+	auto file = TmpFile::createWithContent("");
+	generateArchive(file->getPath(), options);
+	return file;
+}
+
+} // namespace tests
+} // namespace ar
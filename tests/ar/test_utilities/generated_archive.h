@@ -0,0 +1,27 @@
+///
+/// @file      ar/tests/test_utilities/generated_archive.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Generated-archive utilities.
+///
+
+#ifndef AR_TESTS_TEST_UTILITIES_GENERATED_ARCHIVE_H
+#define AR_TESTS_TEST_UTILITIES_GENERATED_ARCHIVE_H
+
+#include <memory>
+#include <string>
+
+#include "ar/generation.h"
+#include "ar/test_utilities/tmp_file.h"
+
+namespace ar {
+namespace tests {
+
+std::string generateArchiveContent(const GenerationOptions& options);
+std::unique_ptr<TmpFile> generateArchiveFile(
+	const GenerationOptions& options);
+
+} // namespace tests
+} // namespace ar
+
+#endif
@@ -0,0 +1,55 @@
+///
+/// @file      ar/test_utilities/unmapped_byte_source.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Implementation of the source of bytes that are not accessible
+///            in memory.
+///
+
+#include <algorithm>
+#include <utility>
+
+#include "ar/test_utilities/unmapped_byte_source.h"
+
+namespace ar {
+namespace tests {
+
+///
+/// Constructs a source of the given bytes.
+///
+UnmappedByteSource::UnmappedByteSource(std::string content):
+	content(std::move(content)) {}
+
+std::uint64_t UnmappedByteSource::size() const {
+	return content.size();
+}
+
+std::size_t UnmappedByteSource::readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const {
+	if (offset >= content.size()) {
+		return 0;
+	}
+
+	const auto count = std::min<std::size_t>(length, content.size() - offset);
+	content.copy(buffer, count, offset);
+	readByteCount += count;
+	return count;
+}
+
+///
+/// Returns the number of bytes read from the source so far.
+///
+std::size_t UnmappedByteSource::getReadByteCount() const {
+	return readByteCount;
+}
+
+///
+/// Creates a source of the given bytes.
+///
+std::shared_ptr<UnmappedByteSource> UnmappedByteSource::createWithContent(
+		std::string content) {
+	return std::make_shared<UnmappedByteSource>(std::move(content));
+}
+
+} // namespace tests
+} // namespace ar
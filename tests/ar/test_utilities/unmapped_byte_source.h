@@ -0,0 +1,52 @@
+///
+/// @file      ar/tests/test_utilities/unmapped_byte_source.h
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Source of bytes that are not accessible in memory.
+///
+
+#ifndef AR_TESTS_TEST_UTILITIES_UNMAPPED_BYTE_SOURCE_H
+#define AR_TESTS_TEST_UTILITIES_UNMAPPED_BYTE_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ar/byte_source.h"
+
+namespace ar {
+namespace tests {
+
+///
+/// A source of the given bytes that provides them only by positioned reads,
+/// like a source reading custom storage.
+///
+/// It counts the read bytes, so tests can check that only the needed parts of
+/// the source are read.
+///
+class UnmappedByteSource: public ByteSource {
+public:
+	UnmappedByteSource(std::string content);
+
+	virtual std::uint64_t size() const override;
+	virtual std::size_t readAt(std::uint64_t offset, char* buffer,
+		std::size_t length) const override;
+
+	std::size_t getReadByteCount() const;
+
+	static std::shared_ptr<UnmappedByteSource> createWithContent(
+		std::string content);
+
+private:
+	/// Bytes of the source.
+	std::string content;
+
+	/// Number of bytes read so far.
+	mutable std::size_t readByteCount = 0;
+};
+
+} // namespace tests
+} // namespace ar
+
+#endif
@@ -0,0 +1,136 @@
+///
+/// @file      ar/tracing_tests.cpp
+/// @copyright (c) 2015 by Petr Zemek (s3rvac@gmail.com) and contributors
+/// @license   MIT, see the @c LICENSE file for more details
+/// @brief     Tests for the @c tracing module.
+///
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "ar/exceptions.h"
+#include "ar/extraction.h"
+#include "ar/file.h"
+#include "ar/internal/utilities/os.h"
+#include "ar/internal/utilities/tracing.h"
+#include "ar/test_utilities/tmp_file.h"
+#include "ar/tracing.h"
+
+using namespace ar::internal;
+
+namespace ar {
+namespace tests {
+
+///
+/// Tests for tracing.
+///
+class TracingTests: public testing::Test {
+protected:
+	TracingTests():
+		traceFile(TmpFile::createWithContent("")) {}
+
+	~TracingTests() {
+		stopTracing();
+	}
+
+	/// Stops tracing and returns the written trace.
+	std::string finishedTrace() {
+		stopTracing();
+		return readFile(traceFile->getPath());
+	}
+
+	/// The file into which the trace is written.
+	std::unique_ptr<TmpFile> traceFile;
+};
+
+TEST_F(TracingTests,
+IsTracingReturnsTrueOnlyWhileTraceIsBeingWritten) {
+	ASSERT_FALSE(isTracing());
+
+	startTracing(traceFile->getPath());
+	ASSERT_TRUE(isTracing());
+
+	stopTracing();
+	ASSERT_FALSE(isTracing());
+}
+
+TEST_F(TracingTests,
+TraceIsInChromeTraceEventFormat) {
+	startTracing(traceFile->getPath());
+
+	extract(File::fromContentWithName("!<arch>\n", "archive.a"));
+
+	const auto trace = finishedTrace();
+	ASSERT_EQ(0, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+	ASSERT_NE(std::string::npos, trace.find(
+		"{\"name\":\"extract\",\"cat\":\"ar\",\"ph\":\"X\",\"ts\":"));
+	ASSERT_NE(std::string::npos, trace.find(",\"pid\":1,\"tid\":"));
+	ASSERT_EQ(trace.size() - 4, trace.rfind("\n]}\n"));
+}
+
+TEST_F(TracingTests,
+TraceContainsSpansOfReadingOfMembers) {
+	startTracing(traceFile->getPath());
+
+	extract(File::fromContentWithName(
+		"!<arch>\n"
+		"a.txt/          0           0     0     644     1         `\n"
+		"a\n"
+		"b.txt/          0           0     0     644     1         `\n"
+		"b\n",
+		"archive.a"
+	));
+
+	const auto trace = finishedTrace();
+	ASSERT_NE(std::string::npos, trace.find("\"name\":\"scan\""));
+	ASSERT_NE(std::string::npos, trace.find("\"name\":\"materialize\""));
+	ASSERT_NE(std::string::npos, trace.find(
+		"\"name\":\"readMember\""));
+	ASSERT_NE(std::string::npos, trace.find("\"args\":{\"detail\":\"a.txt\"}"));
+	ASSERT_NE(std::string::npos, trace.find("\"args\":{\"detail\":\"b.txt\"}"));
+}
+
+TEST_F(TracingTests,
+TraceContainsSpansOfSavingOfFiles) {
+	const std::string Name{"ar-tracing-tests.txt"};
+	RemoveFileOnDestruction remover{Name};
+	startTracing(traceFile->getPath());
+
+	File::fromContentWithName("content", Name)->saveCopyTo(".");
+
+	ASSERT_NE(std::string::npos, finishedTrace().find(
+		"{\"name\":\"saveCopyTo\",\"cat\":\"ar\",\"ph\":\"X\""));
+}
+
+TEST_F(TracingTests,
+DetailsOfSpansAreEscapedInTrace) {
+	startTracing(traceFile->getPath());
+
+	{
+		TraceSpan span{"test", "a\"b\\c\n"};
+	}
+
+	ASSERT_NE(std::string::npos, finishedTrace().find(
+		"\"args\":{\"detail\":\"a\\\"b\\\\c\\u000a\"}"));
+}
+
+TEST_F(TracingTests,
+NothingIsTracedAfterTracingHasStopped) {
+	startTracing(traceFile->getPath());
+	stopTracing();
+
+	extract(File::fromContentWithName("!<arch>\n", "archive.a"));
+
+	ASSERT_EQ(std::string::npos, finishedTrace().find("\"name\""));
+}
+
+TEST_F(TracingTests,
+StartTracingThrowsIOErrorWhenTraceCannotBeWritten) {
+	ASSERT_THROW(startTracing("/nonexistent-directory/trace.json"), IOError);
+	ASSERT_FALSE(isTracing());
+}
+
+} // namespace tests
+} // namespace ar